@@ -60,17 +60,61 @@
 #define configTICK_RATE_HZ                       ((TickType_t)1000) // sets the frequency of the tick interrupt,also the length of each time slice.
 #define configMAX_PRIORITIES                     ( 7 )              // sets the number of available priorities
 #define configMINIMAL_STACK_SIZE                 ((uint16_t)128)
-#define configTOTAL_HEAP_SIZE                    ((size_t)3072)
+#define configTOTAL_HEAP_SIZE                    ((size_t)3072)       // heap_4 and heap_tlsf only, heap_5 claims the RAM left free by the linker
+#define configUSE_BLOCK_POOLS                    1       // Serve small allocations from fixed size block pools before the heap, see vPortGetBlockPoolStats()
+#define configBLOCK_POOL_16_BLOCKS               4
+#define configBLOCK_POOL_32_BLOCKS               4
+#define configBLOCK_POOL_64_BLOCKS               4
+#define configBLOCK_POOL_128_BLOCKS              4
+#define configUSE_HEAP_TRACKING                  1       // Tag heap blocks with owner, call-site and tick, per task live/peak bytes via uxPortGetHeapTaskUsage()
+#define configHEAP_TRACKING_MAX_TASKS            8
+#define configUSE_HEAP_TRACE                     1       // Binary allocation trace, streamed on RTT channel 1 by Core/Src/heap_trace.c
+#define configUSE_HEAP_FRAGMENTATION_STATS       1       // Free block histogram, largest free block and fragmentation kept up to date, see vPortGetHeapFragmentationStats()
 #define configMAX_TASK_NAME_LEN                  ( 16 )
 #define configUSE_16_BIT_TICKS                   0
 #define configUSE_MUTEXES                        1
+#define configMUTEX_INHERITANCE_CHAIN_DEPTH      4       // Inherited priorities pass through up to 4 mutex holders blocked on further mutexes
+#define configUSE_MUTEX_STATS                    1       // Per mutex hold/wait times, contention and lock order inversions, see vSemaphoreGetMutexStats()
+#define configMUTEX_LOCK_ORDER_SLOTS             8       // Mutexes whose lock order is tracked
+#define configUSE_RW_LOCKS                       1       // Reader-writer locks with writer preference and priority inheritance (rwlock.h)
+#define configRWLOCK_MAX_READERS                 4       // Readers that can hold one lock at once, each is tracked for priority inheritance
+#define configUSE_LW_MUTEXES                     1       // Mutexes taken and given with one LDREX/STREX when uncontended (lwmutex.h)
+#define configUSE_EVENT_GROUPS_64                1       // 64 bit event groups set directly from interrupts (event_groups64.h)
+#define configEVENT_GROUPS_64_MAX_CHECKS         4       // Waiting tasks checked per critical section, and by one xEventGroup64SetBitsFromISR()
+#define configTASK_NOTIFICATION_ARRAY_ENTRIES    2       // Index 1 is used by tasks waiting on wide event groups
 #define configQUEUE_REGISTRY_SIZE                8
+#define configUSE_OBJECT_REGISTRY                1       // List every task, queue, timer and stream buffer with live metrics, snapshots on RTT channel 2 by Core/Src/object_snapshot.c
+#define configOBJECT_REGISTRY_SIZE               16
+#define configUSE_WORK_QUEUES                    1       // Interrupt bottom halves run by per-queue worker tasks instead of the timer daemon (workqueue.h)
+#define configWORK_QUEUE_GET_TIME()              ( ( uint32_t ) ullPortGetClockCycles() )  // Work queue latencies in CPU cycles
 #define configUSE_PORT_OPTIMISED_TASK_SELECTION  1       // Architecture optimized implementation of the algorithm used to select the Running state task 
+#define configUSE_EDF_SCHEDULING                 1       // Tasks at configEDF_PRIORITY with a period run earliest deadline first, see vTaskSetPeriod()
+#define configEDF_PRIORITY                       3
+#define configUSE_TICKLESS_IDLE                  1       // Stop the tick interrupt while the idle task runs, see vPortGetLowPowerStats()
+#define configUSE_TICKLESS_ALT_TIMEBASE          1       // Long idle periods sleep in STOP mode timed by the RTC alarm (Core/Src/lowpower_rtc.c)
+#define configTICKLESS_ALT_TIMEBASE_MIN_TICKS    20      // Shortest idle period, in ticks, worth the STOP mode entry and clock restore cost
+#define configUSE_TRACE_FACILITY                 1       // uxTaskGetSystemState(), used by Core/Src/runtime_stats.c
+#define configCHECK_FOR_STACK_OVERFLOW           3       // Check the saved stack pointer and one canary word on each context switch
+#define configRECORD_STACK_HIGH_ADDRESS          1       // Stack sizes for xTaskScanStack(), used by Core/Src/stack_monitor.c
+#define configGENERATE_RUN_TIME_STATS            1       // Per task run time and context switch counts
+#define configRUN_TIME_COUNTER_TYPE              uint64_t
+#define configUSE_DWT_RUN_TIME_COUNTER           1       // Run time stats clocked by the DWT cycle counter, extended to 64 bits
+#define configRUN_TIME_STATS_ISR_SLOTS           ( 16 + 43 )  // Record the time spent in each exception/IRQ number (43 IRQs on the F103)
+#define configUSE_ISR_PROFILER                   1       // Per interrupt min/max/average time and histogram, nesting, longest critical section and tick latency
+#define configISR_PROFILER_MAX_IRQS              8
+#define configUSE_CRITICAL_SECTION_TRACKER       1       // Callers and cycles of the longest critical sections and scheduler suspensions
+#define configCRITICAL_SECTION_TRACKER_ENTRIES   4
+#define configUSE_LAZY_CONTEXT_SWITCH            1       // PendSV saves r4-r11 only when another task is selected
+#define configUSE_CONTEXT_SWITCH_STATS           1       // PendSV cycles for switches and same task resumes, see vPortGetContextSwitchStats()
+#define configUSE_MONOTONIC_CLOCK                1       // 64-bit ns clock from the tick and the DWT cycle counter, ullPortGetClockNs()
 
 #define configUSE_TIMERS               1                           // Include software timer functionality
 #define configTIMER_TASK_PRIORITY      (configMAX_PRIORITIES - 1)  // priority of the timer service task
 #define configTIMER_TASK_STACK_DEPTH   configMINIMAL_STACK_SIZE    //stack (in words) allocated to the timer service task.
 #define configTIMER_QUEUE_LENGTH        10                         // Maximum number of unprocessed commands that the timer command queue can hold
+#define configUSE_TIMER_PAIRING_HEAP   1                           // Keep active timers in a pairing heap, O(1) start/reset instead of a sorted list walk
+#define configTIMER_COMMAND_BATCH_SIZE  8                          // Timer commands drained from the queue at once, redundant commands for the same timer are dropped
+#define configUSE_TIMER_COMMAND_STATS   1                          // Timer queue high-water mark and coalescing counters, see vTimerGetCommandStats()
 
 
 #define configIDLE_SHOULD_YIELD                  1    // Idle task yields on each iteration of its loop if there are other Idle priority tasks in the Ready state.
@@ -88,6 +132,10 @@
 #define INCLUDE_vTaskDelayUntil             1
 #define INCLUDE_vTaskDelay                  1
 #define INCLUDE_xTaskGetSchedulerState      1
+#define INCLUDE_xTimerPendFunctionCall      1    // xEventGroupSetBitsFromISR() and the overflow of xEventGroup64SetBitsFromISR()
+#define INCLUDE_xTaskScanStack              1    // Background stack scan of all tasks by Core/Src/stack_monitor.c
+#define INCLUDE_uxTaskGetStackHighWaterMark2 1   // Task stack high-water marks in object registry snapshots
+#define INCLUDE_xTaskGetIdleTaskHandle      1    // Idle task run time for the load in Core/Src/load_governor.c
 
 /* Cortex-M specific definitions. */
 #ifdef __NVIC_PRIO_BITS
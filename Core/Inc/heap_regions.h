@@ -0,0 +1,34 @@
+/* USER CODE BEGIN Header */
+/**
+  ******************************************************************************
+  * @file    heap_regions.h
+  * @brief   heap_5 regions built from the RAM the linker leaves free.
+  ******************************************************************************
+  */
+/* USER CODE END Header */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef __HEAP_REGIONS_H
+#define __HEAP_REGIONS_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include "FreeRTOS.h"
+#include "task.h"
+
+/* Exported constants --------------------------------------------------------*/
+/* Bytes at the start of the free RAM set aside for pvPortMallocWithHint(...,
+   portHEAP_REGION_DMA), 0 to put all of it in the general region. */
+#define HEAP_REGIONS_DMA_SIZE       512U
+
+/* Exported functions prototypes ---------------------------------------------*/
+void HeapRegions_Init(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __HEAP_REGIONS_H */
@@ -0,0 +1,54 @@
+/* USER CODE BEGIN Header */
+/**
+  ******************************************************************************
+  * @file    heap_trace.h
+  * @brief   Binary heap allocation trace streamed over RTT.
+  ******************************************************************************
+  */
+/* USER CODE END Header */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef __HEAP_TRACE_H
+#define __HEAP_TRACE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include "FreeRTOS.h"
+#include "task.h"
+
+/* Exported constants --------------------------------------------------------*/
+/* RTT up channel carrying the trace, channel 0 is the text terminal. */
+#define HEAP_TRACE_RTT_CHANNEL      1U
+
+/* Size of the RTT buffer, a multiple of the 16 byte record size. */
+#define HEAP_TRACE_RTT_BUFFER_SIZE  512U
+
+/* Records kept in RAM for the debugger when the project is built without RTT. */
+#define HEAP_TRACE_RAM_RECORDS      16U
+
+/* Event of the record announcing the name of a task index, sent before the
+   first allocation record of each task using that index. */
+#define HEAP_TRACE_EVENT_TASK_NAME  ( ( uint8_t ) 0x80 )
+
+/* Exported types ------------------------------------------------------------*/
+/* Same size as HeapTraceRecord_t, with ucEvent and ucTask at the same offsets,
+   so the host reads every record as 16 bytes and decodes it by ucEvent. */
+typedef struct
+{
+  char acName[14];               /* Task name, truncated, "" for allocations made before the scheduler started */
+  uint8_t ucEvent;               /* HEAP_TRACE_EVENT_TASK_NAME */
+  uint8_t ucTask;                /* Task index used by the records that follow */
+} HeapTrace_TaskNameTypeDef;
+
+/* Exported functions prototypes ---------------------------------------------*/
+void HeapTrace_Init(void);
+uint32_t HeapTrace_GetDroppedRecords(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __HEAP_TRACE_H */
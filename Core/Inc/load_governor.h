@@ -0,0 +1,74 @@
+/* USER CODE BEGIN Header */
+/**
+  ******************************************************************************
+  * @file    load_governor.h
+  * @brief   Rolling CPU load and overload notifications.
+  ******************************************************************************
+  */
+/* USER CODE END Header */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef __LOAD_GOVERNOR_H
+#define __LOAD_GOVERNOR_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include "FreeRTOS.h"
+#include "task.h"
+
+/* Exported constants --------------------------------------------------------*/
+/* Interval between two load samples. */
+#define LOAD_GOVERNOR_SAMPLE_MS                 100U
+
+/* Weight of the samples in the rolling load, each sample moves it by
+   1/LOAD_GOVERNOR_AVERAGE_SAMPLES of the difference. */
+#define LOAD_GOVERNOR_AVERAGE_SAMPLES           8U
+
+/* Rolling load, in 0.1%, at which each level is entered and below which it
+   is left.  The gap between the two keeps the level from flapping. */
+#define LOAD_GOVERNOR_HIGH_ENTER_PERMILLE       800U
+#define LOAD_GOVERNOR_HIGH_EXIT_PERMILLE        700U
+#define LOAD_GOVERNOR_OVERLOAD_ENTER_PERMILLE   950U
+#define LOAD_GOVERNOR_OVERLOAD_EXIT_PERMILLE    850U
+
+/* Largest number of subscribers, callbacks and tasks together. */
+#define LOAD_GOVERNOR_MAX_SUBSCRIBERS           4U
+
+/* Exported types ------------------------------------------------------------*/
+typedef enum
+{
+  LOAD_LEVEL_NORMAL = 0,         /* No action needed */
+  LOAD_LEVEL_HIGH,               /* Reduce optional work, sampling rates */
+  LOAD_LEVEL_OVERLOAD,           /* Drop low priority work, deadlines are at risk */
+  LOAD_LEVEL_COUNT
+} LoadGovernor_LevelTypeDef;
+
+/* Called from the governor task when the level changes, must not block. */
+typedef void (*LoadGovernor_CallbackTypeDef)(LoadGovernor_LevelTypeDef eLevel, uint32_t ulLoadPermille, void *pvContext);
+
+typedef struct
+{
+  LoadGovernor_LevelTypeDef eLevel;
+  uint32_t ulLoadPermille;       /* Load over the last sample, in 0.1% */
+  uint32_t ulAveragePermille;    /* Rolling load the level follows, in 0.1% */
+  uint32_t ulPeakPermille;       /* Highest sample since boot, in 0.1% */
+  uint32_t ulLevelChanges;       /* Level changes since boot */
+  uint32_t ulSamplesAtLevel[LOAD_LEVEL_COUNT]; /* Time spent at each level, in samples */
+} LoadGovernor_StatsTypeDef;
+
+/* Exported functions prototypes ---------------------------------------------*/
+void LoadGovernor_Init(void);
+uint32_t LoadGovernor_GetLoad(void);
+LoadGovernor_LevelTypeDef LoadGovernor_GetLevel(void);
+void LoadGovernor_GetStats(LoadGovernor_StatsTypeDef *pStats);
+BaseType_t LoadGovernor_Subscribe(LoadGovernor_CallbackTypeDef pCallback, void *pvContext);
+BaseType_t LoadGovernor_SubscribeTask(TaskHandle_t xTask, UBaseType_t uxIndexToNotify);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __LOAD_GOVERNOR_H */
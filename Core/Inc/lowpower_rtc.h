@@ -0,0 +1,43 @@
+/* USER CODE BEGIN Header */
+/**
+  ******************************************************************************
+  * @file    lowpower_rtc.h
+  * @brief   RTC alarm timebase used by tickless idle to sleep in STOP mode.
+  ******************************************************************************
+  */
+/* USER CODE END Header */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef __LOWPOWER_RTC_H
+#define __LOWPOWER_RTC_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include "stm32f1xx_hal.h"
+
+/* Exported constants --------------------------------------------------------*/
+/* The RTC counter runs from the 32.768kHz LSE divided by (PRL + 1).  PRL = 1 is
+   the finest resolution the reference manual allows, about 61us per count. */
+#define LOWPOWER_RTC_PRESCALER      1U
+#define LOWPOWER_RTC_FREQ_HZ        (LSE_VALUE / (LOWPOWER_RTC_PRESCALER + 1U))
+
+/* Longest single sleep, in ticks.  Keeps the tick to count conversions within
+   32 bits, the idle task simply sleeps again if it has more time. */
+#define LOWPOWER_RTC_MAX_SLEEP_TICKS  0xFFFFU
+
+/* Keeps the debug interface clocked in STOP mode.  Set to 0 when measuring
+   power consumption. */
+#define LOWPOWER_RTC_DEBUG_STOP     1
+
+/* Exported functions prototypes ---------------------------------------------*/
+void LowPower_RTC_Init(void);
+void LowPower_RTC_IRQHandler(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __LOWPOWER_RTC_H */
@@ -0,0 +1,67 @@
+/* USER CODE BEGIN Header */
+/**
+  ******************************************************************************
+  * @file    object_snapshot.h
+  * @brief   Binary snapshots of the kernel object registry.
+  ******************************************************************************
+  */
+/* USER CODE END Header */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef __OBJECT_SNAPSHOT_H
+#define __OBJECT_SNAPSHOT_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include "FreeRTOS.h"
+#include "task.h"
+#include "object_registry.h"
+
+/* Exported constants --------------------------------------------------------*/
+/* RTT up channel carrying the snapshots, channels 0 and 1 are the text
+   terminal and the heap trace. */
+#define OBJECT_SNAPSHOT_RTT_CHANNEL      2U
+
+/* Size of the RTT buffer, at least one full snapshot of 32 byte records. */
+#define OBJECT_SNAPSHOT_RTT_BUFFER_SIZE  ( 32U * ( configOBJECT_REGISTRY_SIZE + 1U ) * 2U )
+
+/* Interval between two snapshots, in ms. */
+#define OBJECT_SNAPSHOT_PERIOD_MS        1000U
+
+/* First word of every snapshot, "KOBJ" in memory order. */
+#define OBJECT_SNAPSHOT_MAGIC            0x4A424F4BUL
+
+/* Exported types ------------------------------------------------------------*/
+/* Leads each snapshot and has the size of an ObjectInfo_t, so the host reads
+   the stream as 32 byte records and resynchronises on ulMagic. */
+typedef struct
+{
+  uint32_t ulMagic;              /* OBJECT_SNAPSHOT_MAGIC */
+  uint32_t ulSequence;           /* Snapshots taken since boot, gaps show dropped snapshots */
+  uint32_t ulTick;               /* Tick count when the snapshot was taken */
+  uint16_t usObjects;            /* ObjectInfo_t records that follow */
+  uint16_t usOverflow;           /* Objects missing because the registry was full */
+  uint32_t ulDropped;            /* Snapshots that did not fit the RTT buffer */
+  uint8_t ucRecordSize;          /* sizeof(ObjectInfo_t) */
+  uint8_t aucReserved[3];
+  uint64_t ullTimeNs;            /* Monotonic clock when the snapshot was taken, 0 without configUSE_MONOTONIC_CLOCK */
+} ObjectSnapshot_HeaderTypeDef;
+
+typedef struct
+{
+  ObjectSnapshot_HeaderTypeDef xHeader;
+  ObjectInfo_t xObjects[configOBJECT_REGISTRY_SIZE];
+} ObjectSnapshot_TypeDef;
+
+/* Exported functions prototypes ---------------------------------------------*/
+void ObjectSnapshot_Init(void);
+void ObjectSnapshot_Take(ObjectSnapshot_TypeDef *pSnapshot);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __OBJECT_SNAPSHOT_H */
@@ -0,0 +1,59 @@
+/* USER CODE BEGIN Header */
+/**
+  ******************************************************************************
+  * @file    runtime_stats.h
+  * @brief   Per task CPU load, context switch counts and interrupt load.
+  ******************************************************************************
+  */
+/* USER CODE END Header */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef __RUNTIME_STATS_H
+#define __RUNTIME_STATS_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include "FreeRTOS.h"
+#include "task.h"
+
+/* Exported constants --------------------------------------------------------*/
+/* Largest number of tasks reported, including the idle and timer tasks.
+   Tasks beyond it are counted in uxTasksDropped. */
+#define RUNTIME_STATS_MAX_TASKS     16U
+
+/* Interval between two reports sent over RTT, in ms. */
+#define RUNTIME_STATS_PERIOD_MS     1000U
+
+/* Exported types ------------------------------------------------------------*/
+typedef struct
+{
+  TaskHandle_t xHandle;
+  const char *pcTaskName;
+  uint32_t ulLoadPermille;       /* Share of the CPU over the sample period, in 0.1% */
+  uint32_t ulContextSwitches;    /* Times switched in over the sample period */
+  uint64_t ullRunTimeCycles;     /* Cycles spent running since the scheduler started */
+} RuntimeStats_TaskTypeDef;
+
+typedef struct
+{
+  uint64_t ullPeriodCycles;      /* Cycles since the previous sample */
+  uint32_t ulISRLoadPermille;    /* Share of the CPU taken by instrumented interrupts, in 0.1% */
+  uint32_t ulISRCount;           /* Instrumented interrupts over the sample period */
+  uint32_t ulContextSwitches;    /* Context switches over the sample period */
+  UBaseType_t uxNumberOfTasks;
+  UBaseType_t uxTasksDropped;    /* Tasks left out of xTasks[], 0 unless more than RUNTIME_STATS_MAX_TASKS exist */
+  RuntimeStats_TaskTypeDef xTasks[RUNTIME_STATS_MAX_TASKS];
+} RuntimeStats_SampleTypeDef;
+
+/* Exported functions prototypes ---------------------------------------------*/
+void RuntimeStats_Init(void);
+void RuntimeStats_Sample(RuntimeStats_SampleTypeDef *pSample);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __RUNTIME_STATS_H */
@@ -0,0 +1,57 @@
+/* USER CODE BEGIN Header */
+/**
+  ******************************************************************************
+  * @file    stack_monitor.h
+  * @brief   Background stack usage monitor for all tasks.
+  ******************************************************************************
+  */
+/* USER CODE END Header */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef __STACK_MONITOR_H
+#define __STACK_MONITOR_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include "FreeRTOS.h"
+#include "task.h"
+
+/* Exported constants --------------------------------------------------------*/
+/* Largest number of tasks monitored, including the idle and timer tasks. */
+#define STACK_MONITOR_MAX_TASKS       8U
+
+/* Interval between two scans, each scan measures the stack of one task. */
+#define STACK_MONITOR_STEP_MS         100U
+
+/* Buckets of the stack in use histogram, each one covers an equal share of
+   the stack size, the last one ends at the full stack. */
+#define STACK_MONITOR_BUCKETS         8U
+
+/* Peak usage, in percent of the stack size, reported as a warning. */
+#define STACK_MONITOR_WARN_PERCENT    90U
+
+/* Exported types ------------------------------------------------------------*/
+typedef struct
+{
+  TaskHandle_t xHandle;          /* NULL for an unused entry */
+  char pcTaskName[configMAX_TASK_NAME_LEN]; /* Copied at the scan, outlives the task */
+  UBaseType_t uxTaskNumber;
+  uint32_t ulStackDepth;         /* Stack size, in words */
+  uint32_t ulPeakUsed;           /* Most words ever used, from the painted stack */
+  uint32_t ulPeakPercent;        /* ulPeakUsed in percent of ulStackDepth */
+  uint32_t ulSamples;            /* Times the stack was scanned */
+  uint32_t ulHistogram[STACK_MONITOR_BUCKETS]; /* Stack in use at each scan */
+} StackMonitor_TaskTypeDef;
+
+/* Exported functions prototypes ---------------------------------------------*/
+void StackMonitor_Init(void);
+UBaseType_t StackMonitor_GetTasks(StackMonitor_TaskTypeDef *pTasks, UBaseType_t uxMaxTasks);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __STACK_MONITOR_H */
@@ -0,0 +1,64 @@
+/* USER CODE BEGIN Header */
+/**
+  ******************************************************************************
+  * @file    heap_regions.c
+  * @brief   heap_5 regions built from the RAM the linker leaves free.
+  *
+  *          Everything between the end of .bss (_end) and the bottom of the
+  *          main stack (_estack - _Min_Stack_Size) in STM32F103C8Tx_FLASH.ld
+  *          is handed to heap_5, so the heap grows and shrinks with the
+  *          static data instead of being sized by configTOTAL_HEAP_SIZE.
+  *          After the scheduler starts the main stack only serves interrupts.
+  *
+  *          The F103 has a single SRAM that every bus master reaches at full
+  *          speed, so the regions differ by reservation only: the first
+  *          HEAP_REGIONS_DMA_SIZE bytes form a DMA region that general
+  *          allocations use last, keeping it for DMA buffers.
+  ******************************************************************************
+  */
+/* USER CODE END Header */
+
+/* Includes ------------------------------------------------------------------*/
+#include "main.h"
+#include "heap_regions.h"
+
+#ifdef USE_HEAP_REGIONS
+
+/* Private variables ---------------------------------------------------------*/
+/* Defined by STM32F103C8Tx_FLASH.ld, _Min_Stack_Size is a size, not an address. */
+extern uint8_t _end;
+extern uint8_t _estack;
+extern uint8_t _Min_Stack_Size;
+
+/**
+  * @brief  Passes the free RAM to heap_5.
+  * @note   Call before anything is allocated, which includes creating tasks,
+  *         queues and timers.
+  * @retval None
+  */
+void HeapRegions_Init(void)
+{
+  HeapRegion_t xRegions[3] = {0};
+  uint8_t *pucStart = &_end;
+  uint8_t *pucLimit = &_estack - (uint32_t) &_Min_Stack_Size;
+  size_t xSize = (size_t) (pucLimit - pucStart);
+  UBaseType_t x = 0U;
+
+  configASSERT(xSize > HEAP_REGIONS_DMA_SIZE);
+
+#if ( HEAP_REGIONS_DMA_SIZE > 0U )
+  xRegions[x].pucStartAddress = pucStart;
+  xRegions[x].xSizeInBytes = HEAP_REGIONS_DMA_SIZE;
+  xRegions[x].uxAttributes = portHEAP_REGION_DMA;
+  x++;
+#endif
+
+  xRegions[x].pucStartAddress = pucStart + HEAP_REGIONS_DMA_SIZE;
+  xRegions[x].xSizeInBytes = xSize - HEAP_REGIONS_DMA_SIZE;
+  xRegions[x].uxAttributes = portHEAP_REGION_GENERAL;
+
+  /* The entry after the last one is left zeroed to end the array. */
+  vPortDefineHeapRegions(xRegions);
+}
+
+#endif /* USE_HEAP_REGIONS */
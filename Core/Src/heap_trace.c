@@ -0,0 +1,162 @@
+/* USER CODE BEGIN Header */
+/**
+  ******************************************************************************
+  * @file    heap_trace.c
+  * @brief   Binary heap allocation trace streamed over RTT.
+  *
+  *          With configUSE_HEAP_TRACE the heap hands every allocation, failed
+  *          allocation and free to vApplicationHeapTraceHook() as a 16 byte
+  *          HeapTraceRecord_t.  When the project is built with RTT=1 the
+  *          records are written unchanged to RTT channel
+  *          HEAP_TRACE_RTT_CHANNEL, where a host tool can replay them to
+  *          rebuild the heap layout over time.  Tasks are identified by a
+  *          small index, and a HeapTrace_TaskNameTypeDef record naming the
+  *          task is sent the first time an index is used by a task.
+  *
+  *          A record that does not fit the RTT buffer is dropped whole and
+  *          counted, the heap never waits for the host.  Without RTT the last
+  *          HEAP_TRACE_RAM_RECORDS records are kept in xHeapTraceRecords[] for
+  *          the debugger.
+  ******************************************************************************
+  */
+/* USER CODE END Header */
+
+/* Includes ------------------------------------------------------------------*/
+#include <string.h>
+#include "main.h"
+#include "heap_trace.h"
+
+#ifdef USE_SEGGER_RTT
+#include "SEGGER_RTT.h"
+#endif
+
+#if ( configUSE_HEAP_TRACE == 1 )
+
+/* Private variables ---------------------------------------------------------*/
+static volatile uint32_t ulDroppedRecords = 0;
+
+#ifdef USE_SEGGER_RTT
+static uint8_t ucTraceBuffer[HEAP_TRACE_RTT_BUFFER_SIZE];
+static BaseType_t xTraceStarted = pdFALSE;
+
+/* Task last announced for each index, the index is reused once every block
+   of its previous task has been freed. */
+static TaskHandle_t xAnnouncedTask[configHEAP_TRACKING_MAX_TASKS];
+static BaseType_t xAnnounced[configHEAP_TRACKING_MAX_TASKS];
+#else
+HeapTraceRecord_t xHeapTraceRecords[HEAP_TRACE_RAM_RECORDS];
+uint32_t ulHeapTraceNextRecord = 0;
+#endif /* USE_SEGGER_RTT */
+
+/* Private function prototypes -----------------------------------------------*/
+#ifdef USE_SEGGER_RTT
+static BaseType_t prvAnnounceTask(uint8_t ucTask);
+#endif
+
+/**
+  * @brief  Sets up the RTT channel carrying the trace.
+  * @note   Call before the first object is created, allocations made earlier
+  *         are counted as dropped.
+  * @retval None
+  */
+void HeapTrace_Init(void)
+{
+#ifdef USE_SEGGER_RTT
+  SEGGER_RTT_Init();
+  SEGGER_RTT_ConfigUpBuffer(HEAP_TRACE_RTT_CHANNEL,
+                            "HeapTrace",
+                            ucTraceBuffer,
+                            sizeof(ucTraceBuffer),
+                            SEGGER_RTT_MODE_NO_BLOCK_SKIP);
+  xTraceStarted = pdTRUE;
+#endif
+}
+
+/**
+  * @brief  Returns the number of records lost because the RTT buffer was full.
+  * @retval Number of records dropped since boot
+  */
+uint32_t HeapTrace_GetDroppedRecords(void)
+{
+  return ulDroppedRecords;
+}
+
+/**
+  * @brief  Called by the heap for every heap event, with the scheduler
+  *         suspended.
+  * @param  pxRecord: The record to stream.
+  * @retval None
+  */
+void vApplicationHeapTraceHook(const HeapTraceRecord_t *pxRecord)
+{
+#ifdef USE_SEGGER_RTT
+  if (xTraceStarted == pdFALSE)
+  {
+    ulDroppedRecords++;
+    return;
+  }
+
+  /* Only the allocating task is running when a new index is first used, so
+     the name is announced ahead of its first allocation record. */
+  if ((pxRecord->ucEvent == portHEAP_TRACE_EVENT_MALLOC) && (pxRecord->ucTask != portHEAP_TRACE_NO_TASK))
+  {
+    if (prvAnnounceTask(pxRecord->ucTask) == pdFALSE)
+    {
+      ulDroppedRecords++;
+      return;
+    }
+  }
+
+  if (SEGGER_RTT_Write(HEAP_TRACE_RTT_CHANNEL, pxRecord, sizeof(HeapTraceRecord_t)) == 0U)
+  {
+    ulDroppedRecords++;
+  }
+#else
+  xHeapTraceRecords[ulHeapTraceNextRecord] = *pxRecord;
+  ulHeapTraceNextRecord = (ulHeapTraceNextRecord + 1U) % HEAP_TRACE_RAM_RECORDS;
+#endif
+}
+
+#ifdef USE_SEGGER_RTT
+/**
+  * @brief  Sends the name of the running task for ucTask unless it was the
+  *         last task announced for that index.
+  * @param  ucTask: Index of the running task.
+  * @retval pdFALSE if the name record did not fit the RTT buffer
+  */
+static BaseType_t prvAnnounceTask(uint8_t ucTask)
+{
+  HeapTrace_TaskNameTypeDef xName;
+  TaskHandle_t xTask = NULL;
+
+  if (xTaskGetSchedulerState() != taskSCHEDULER_NOT_STARTED)
+  {
+    xTask = xTaskGetCurrentTaskHandle();
+  }
+
+  if ((xAnnounced[ucTask] != pdFALSE) && (xAnnouncedTask[ucTask] == xTask))
+  {
+    return pdTRUE;
+  }
+
+  memset(&xName, 0, sizeof(xName));
+  if (xTask != NULL)
+  {
+    strncpy(xName.acName, pcTaskGetName(xTask), sizeof(xName.acName));
+  }
+  xName.ucEvent = HEAP_TRACE_EVENT_TASK_NAME;
+  xName.ucTask = ucTask;
+
+  if (SEGGER_RTT_Write(HEAP_TRACE_RTT_CHANNEL, &xName, sizeof(xName)) == 0U)
+  {
+    return pdFALSE;
+  }
+
+  xAnnouncedTask[ucTask] = xTask;
+  xAnnounced[ucTask] = pdTRUE;
+
+  return pdTRUE;
+}
+#endif /* USE_SEGGER_RTT */
+
+#endif /* configUSE_HEAP_TRACE */
@@ -0,0 +1,328 @@
+/* USER CODE BEGIN Header */
+/**
+  ******************************************************************************
+  * @file    load_governor.c
+  * @brief   Rolling CPU load and overload notifications.
+  *
+  *          Every LOAD_GOVERNOR_SAMPLE_MS a task measures the share of the
+  *          time the CPU was not running the idle task.  The busy time is the
+  *          DWT cycle count less the run time of the idle task, and the time
+  *          elapsed comes from the tick count, so tickless sleep counts as
+  *          idle whether or not the cycle counter runs while the core sleeps.
+  *          Instrumented interrupts count as busy, the others as part of
+  *          the task they interrupted.
+  *
+  *          The samples feed a rolling load, an exponential average over about
+  *          LOAD_GOVERNOR_AVERAGE_SAMPLES samples, which moves the load level
+  *          between normal, high and overload.  Each level is entered and left
+  *          at two different loads, so a load close to a threshold does not
+  *          make the level flap.  On every change the subscribed callbacks are
+  *          called and the subscribed tasks notified with the new level, so
+  *          they can lower their sampling rates or drop low priority work.
+  *          The governor runs above the application tasks, or it would not
+  *          run when it is needed most.
+  ******************************************************************************
+  */
+/* USER CODE END Header */
+
+/* Includes ------------------------------------------------------------------*/
+#include "main.h"
+#include "load_governor.h"
+
+#ifdef USE_SEGGER_RTT
+#include "SEGGER_RTT.h"
+#endif
+
+#if ( configGENERATE_RUN_TIME_STATS == 1 ) && ( configUSE_DWT_RUN_TIME_COUNTER == 1 ) && ( INCLUDE_xTaskGetIdleTaskHandle == 1 )
+
+/* Private define ------------------------------------------------------------*/
+#define LOAD_GOVERNOR_STACK_SIZE    configMINIMAL_STACK_SIZE
+#define LOAD_GOVERNOR_PRIORITY      ( configMAX_PRIORITIES - 2 )
+
+/* Private typedef -----------------------------------------------------------*/
+typedef struct
+{
+  LoadGovernor_CallbackTypeDef pCallback; /* NULL for a task subscriber */
+  void *pvContext;
+  TaskHandle_t xTask;
+  UBaseType_t uxIndexToNotify;
+} LoadGovernor_SubscriberTypeDef;
+
+/* Private variables ---------------------------------------------------------*/
+static LoadGovernor_StatsTypeDef xGovernorStats = { LOAD_LEVEL_NORMAL };
+
+static LoadGovernor_SubscriberTypeDef xSubscribers[LOAD_GOVERNOR_MAX_SUBSCRIBERS];
+static UBaseType_t uxSubscribers = 0U;
+
+static StaticTask_t xGovernorTaskTCB;
+static StackType_t xGovernorTaskStack[LOAD_GOVERNOR_STACK_SIZE];
+
+/* Private function prototypes -----------------------------------------------*/
+static void prvGovernorTask(void *pvParameters);
+static LoadGovernor_LevelTypeDef prvNextLevel(LoadGovernor_LevelTypeDef eLevel, uint32_t ulAveragePermille);
+static void prvNotifySubscribers(LoadGovernor_LevelTypeDef eLevel, uint32_t ulAveragePermille);
+static BaseType_t prvAddSubscriber(const LoadGovernor_SubscriberTypeDef *pSubscriber);
+
+/**
+  * @brief  Starts the governor task.
+  * @note   Call before vTaskStartScheduler().
+  * @retval None
+  */
+void LoadGovernor_Init(void)
+{
+  xTaskCreateStatic(prvGovernorTask,
+                    "Governor",
+                    LOAD_GOVERNOR_STACK_SIZE,
+                    NULL,
+                    LOAD_GOVERNOR_PRIORITY,
+                    xGovernorTaskStack,
+                    &xGovernorTaskTCB);
+}
+
+/**
+  * @brief  Returns the rolling load.
+  * @retval Load in 0.1%, 0 to 1000.
+  */
+uint32_t LoadGovernor_GetLoad(void)
+{
+  return xGovernorStats.ulAveragePermille;
+}
+
+/**
+  * @brief  Returns the current load level.
+  * @retval The level.
+  */
+LoadGovernor_LevelTypeDef LoadGovernor_GetLevel(void)
+{
+  return xGovernorStats.eLevel;
+}
+
+/**
+  * @brief  Copies the governor statistics.
+  * @param  pStats: Filled with the statistics.
+  * @retval None
+  */
+void LoadGovernor_GetStats(LoadGovernor_StatsTypeDef *pStats)
+{
+  /* The governor task only updates the statistics with the scheduler running. */
+  vTaskSuspendAll();
+  {
+    *pStats = xGovernorStats;
+  }
+  (void) xTaskResumeAll();
+}
+
+/**
+  * @brief  Calls a function on every level change.
+  * @param  pCallback: Called from the governor task, it must not block, an
+  *         event loop can be told with event_post().
+  * @param  pvContext: Passed to the callback.
+  * @retval pdPASS, or pdFAIL if LOAD_GOVERNOR_MAX_SUBSCRIBERS are subscribed.
+  */
+BaseType_t LoadGovernor_Subscribe(LoadGovernor_CallbackTypeDef pCallback, void *pvContext)
+{
+  LoadGovernor_SubscriberTypeDef xSubscriber = { pCallback, pvContext, NULL, 0U };
+
+  configASSERT(pCallback != NULL);
+
+  return prvAddSubscriber(&xSubscriber);
+}
+
+/**
+  * @brief  Notifies a task on every level change.
+  * @note   The notification value at uxIndexToNotify is overwritten with the
+  *         new LoadGovernor_LevelTypeDef.
+  * @param  xTask: The task to notify.
+  * @param  uxIndexToNotify: Notification index, below
+  *         configTASK_NOTIFICATION_ARRAY_ENTRIES.
+  * @retval pdPASS, or pdFAIL if LOAD_GOVERNOR_MAX_SUBSCRIBERS are subscribed.
+  */
+BaseType_t LoadGovernor_SubscribeTask(TaskHandle_t xTask, UBaseType_t uxIndexToNotify)
+{
+  LoadGovernor_SubscriberTypeDef xSubscriber = { NULL, NULL, xTask, uxIndexToNotify };
+
+  configASSERT(xTask != NULL);
+  configASSERT(uxIndexToNotify < configTASK_NOTIFICATION_ARRAY_ENTRIES);
+
+  return prvAddSubscriber(&xSubscriber);
+}
+
+/**
+  * @brief  Samples the load every LOAD_GOVERNOR_SAMPLE_MS and moves the level.
+  * @param  pvParameters: Not used.
+  * @retval None
+  */
+static void prvGovernorTask(void *pvParameters)
+{
+  const uint64_t ullCyclesPerTick = (uint64_t) configCPU_CLOCK_HZ / configTICK_RATE_HZ;
+  TickType_t xLastWake = xTaskGetTickCount();
+  TickType_t xPrevTick = xLastWake;
+  TickType_t xTick;
+  PortRunTimeStats_t xPortStats;
+  uint64_t ullPrevCycles, ullPrevIdle, ullIdle, ullBusy, ullElapsed;
+  uint32_t ulAverageScaled = 0U;
+  uint32_t ulLoad;
+  BaseType_t xFirstSample = pdTRUE;
+  LoadGovernor_LevelTypeDef eLevel;
+
+  (void) pvParameters;
+
+  vPortGetRunTimeStats(&xPortStats);
+  ullPrevCycles = xPortStats.ullTotalCycles;
+  ullPrevIdle = ulTaskGetIdleRunTimeCounter();
+
+  for (;;)
+  {
+    vTaskDelayUntil(&xLastWake, pdMS_TO_TICKS(LOAD_GOVERNOR_SAMPLE_MS));
+
+    /* The idle task is not running, so its run time is up to date. */
+    vTaskSuspendAll();
+    {
+      xTick = xTaskGetTickCount();
+      vPortGetRunTimeStats(&xPortStats);
+      ullIdle = ulTaskGetIdleRunTimeCounter();
+    }
+    (void) xTaskResumeAll();
+
+    /* The cycle counter and the idle run time both stop, or both run, while
+       the core sleeps, the difference is the time spent in everything else. */
+    ullBusy = (xPortStats.ullTotalCycles - ullPrevCycles) - (ullIdle - ullPrevIdle);
+    ullElapsed = (uint64_t) (TickType_t) (xTick - xPrevTick) * ullCyclesPerTick;
+
+    ullPrevCycles = xPortStats.ullTotalCycles;
+    ullPrevIdle = ullIdle;
+    xPrevTick = xTick;
+
+    if (ullElapsed == 0U)
+    {
+      continue;
+    }
+
+    ulLoad = (ullBusy >= ullElapsed) ? 1000U : (uint32_t) ((ullBusy * 1000U) / ullElapsed);
+
+    if (xFirstSample != pdFALSE)
+    {
+      /* Start the average from the first sample, not from 0. */
+      ulAverageScaled = ulLoad * LOAD_GOVERNOR_AVERAGE_SAMPLES;
+      xFirstSample = pdFALSE;
+    }
+    else
+    {
+      ulAverageScaled -= ulAverageScaled / LOAD_GOVERNOR_AVERAGE_SAMPLES;
+      ulAverageScaled += ulLoad;
+    }
+
+    vTaskSuspendAll();
+    {
+      xGovernorStats.ulLoadPermille = ulLoad;
+      xGovernorStats.ulAveragePermille = ulAverageScaled / LOAD_GOVERNOR_AVERAGE_SAMPLES;
+
+      if (ulLoad > xGovernorStats.ulPeakPermille)
+      {
+        xGovernorStats.ulPeakPermille = ulLoad;
+      }
+
+      eLevel = prvNextLevel(xGovernorStats.eLevel, xGovernorStats.ulAveragePermille);
+
+      if (eLevel != xGovernorStats.eLevel)
+      {
+        xGovernorStats.eLevel = eLevel;
+        xGovernorStats.ulLevelChanges++;
+      }
+      else
+      {
+        /* Reported as no change below. */
+        eLevel = LOAD_LEVEL_COUNT;
+      }
+
+      xGovernorStats.ulSamplesAtLevel[xGovernorStats.eLevel]++;
+    }
+    (void) xTaskResumeAll();
+
+    if (eLevel != LOAD_LEVEL_COUNT)
+    {
+#ifdef USE_SEGGER_RTT
+      SEGGER_RTT_printf(0, "load level %u at %u.%u%%\n",
+                        (unsigned) eLevel,
+                        (unsigned) (xGovernorStats.ulAveragePermille / 10U),
+                        (unsigned) (xGovernorStats.ulAveragePermille % 10U));
+#endif
+
+      prvNotifySubscribers(eLevel, xGovernorStats.ulAveragePermille);
+    }
+  }
+}
+
+/**
+  * @brief  Applies the enter and exit thresholds to the rolling load.
+  * @param  eLevel: The current level.
+  * @param  ulAveragePermille: The rolling load.
+  * @retval The new level.
+  */
+static LoadGovernor_LevelTypeDef prvNextLevel(LoadGovernor_LevelTypeDef eLevel, uint32_t ulAveragePermille)
+{
+  if ((ulAveragePermille >= LOAD_GOVERNOR_OVERLOAD_ENTER_PERMILLE) ||
+      ((eLevel == LOAD_LEVEL_OVERLOAD) && (ulAveragePermille >= LOAD_GOVERNOR_OVERLOAD_EXIT_PERMILLE)))
+  {
+    return LOAD_LEVEL_OVERLOAD;
+  }
+
+  if ((ulAveragePermille >= LOAD_GOVERNOR_HIGH_ENTER_PERMILLE) ||
+      ((eLevel != LOAD_LEVEL_NORMAL) && (ulAveragePermille >= LOAD_GOVERNOR_HIGH_EXIT_PERMILLE)))
+  {
+    return LOAD_LEVEL_HIGH;
+  }
+
+  return LOAD_LEVEL_NORMAL;
+}
+
+/**
+  * @brief  Tells every subscriber about a new level.
+  * @param  eLevel: The new level.
+  * @param  ulAveragePermille: The rolling load that caused the change.
+  * @retval None
+  */
+static void prvNotifySubscribers(LoadGovernor_LevelTypeDef eLevel, uint32_t ulAveragePermille)
+{
+  UBaseType_t x;
+
+  for (x = 0U; x < uxSubscribers; x++)
+  {
+    if (xSubscribers[x].pCallback != NULL)
+    {
+      xSubscribers[x].pCallback(eLevel, ulAveragePermille, xSubscribers[x].pvContext);
+    }
+    else
+    {
+      (void) xTaskNotifyIndexed(xSubscribers[x].xTask,
+                                xSubscribers[x].uxIndexToNotify,
+                                (uint32_t) eLevel,
+                                eSetValueWithOverwrite);
+    }
+  }
+}
+
+/**
+  * @brief  Adds a subscriber to the list the governor task walks.
+  * @param  pSubscriber: The subscriber to copy.
+  * @retval pdPASS, or pdFAIL if the list is full.
+  */
+static BaseType_t prvAddSubscriber(const LoadGovernor_SubscriberTypeDef *pSubscriber)
+{
+  BaseType_t xResult = pdFAIL;
+
+  vTaskSuspendAll();
+  {
+    if (uxSubscribers < LOAD_GOVERNOR_MAX_SUBSCRIBERS)
+    {
+      xSubscribers[uxSubscribers] = *pSubscriber;
+      uxSubscribers++;
+      xResult = pdPASS;
+    }
+  }
+  (void) xTaskResumeAll();
+
+  return xResult;
+}
+
+#endif /* configGENERATE_RUN_TIME_STATS && configUSE_DWT_RUN_TIME_COUNTER && INCLUDE_xTaskGetIdleTaskHandle */
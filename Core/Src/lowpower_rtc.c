@@ -0,0 +1,220 @@
+/* USER CODE BEGIN Header */
+/**
+  ******************************************************************************
+  * @file    lowpower_rtc.c
+  * @brief   RTC alarm timebase used by tickless idle to sleep in STOP mode.
+  *
+  *          The SysTick stops in STOP mode, so long idle periods are timed by
+  *          the RTC instead.  The RTC runs from the LSE, which keeps running in
+  *          STOP mode, and its alarm wakes the MCU through EXTI line 17.  The
+  *          kernel port calls xPortAltTimebaseSleep() when
+  *          configUSE_TICKLESS_ALT_TIMEBASE is 1 and the expected idle time is
+  *          at least configTICKLESS_ALT_TIMEBASE_MIN_TICKS.
+  *
+  *          The HAL RTC driver is not used as it keeps calendar state that is
+  *          not needed here, the counter and alarm are accessed directly.
+  ******************************************************************************
+  */
+/* USER CODE END Header */
+
+/* Includes ------------------------------------------------------------------*/
+#include "main.h"
+#include "lowpower_rtc.h"
+#include "FreeRTOS.h"
+#include "task.h"
+
+#if ( configUSE_TICKLESS_IDLE == 1 ) && ( configUSE_TICKLESS_ALT_TIMEBASE == 1 )
+
+/* Private define ------------------------------------------------------------*/
+/* Counts the alarm must be ahead of the counter to be sure it is not missed
+   while the alarm registers are being written. */
+#define LOWPOWER_RTC_MIN_ALARM_COUNTS  4U
+
+/* Private variables ---------------------------------------------------------*/
+/* Part of a tick that did not make up a whole tick on the last sleep, carried
+   to the next one so the tick count does not drift behind the RTC.  Kept in
+   units of 1 / (LOWPOWER_RTC_FREQ_HZ * configTICK_RATE_HZ) seconds so no
+   precision is lost. */
+static uint32_t ulTickRemainder = 0U;
+
+/* Private function prototypes -----------------------------------------------*/
+void SystemClock_Config(void);
+static uint32_t prvReadCounter(void);
+static void prvWriteAlarm(uint32_t ulAlarm);
+static void prvWaitForSynchro(void);
+
+/**
+  * @brief  Starts the LSE, clocks the RTC from it and enables the alarm
+  *         interrupt as a wake up source from STOP mode.
+  * @retval None
+  */
+void LowPower_RTC_Init(void)
+{
+  RCC_OscInitTypeDef RCC_OscInitStruct = {0};
+  RCC_PeriphCLKInitTypeDef PeriphClkInit = {0};
+
+  /* The RTC lives in the backup domain, which is write protected. */
+  __HAL_RCC_PWR_CLK_ENABLE();
+  __HAL_RCC_BKP_CLK_ENABLE();
+  HAL_PWR_EnableBkUpAccess();
+
+  RCC_OscInitStruct.OscillatorType = RCC_OSCILLATORTYPE_LSE;
+  RCC_OscInitStruct.LSEState = RCC_LSE_ON;
+  RCC_OscInitStruct.PLL.PLLState = RCC_PLL_NONE;
+  if (HAL_RCC_OscConfig(&RCC_OscInitStruct) != HAL_OK)
+  {
+    Error_Handler();
+  }
+
+  PeriphClkInit.PeriphClockSelection = RCC_PERIPHCLK_RTC;
+  PeriphClkInit.RTCClockSelection = RCC_RTCCLKSOURCE_LSE;
+  if (HAL_RCCEx_PeriphCLKConfig(&PeriphClkInit) != HAL_OK)
+  {
+    Error_Handler();
+  }
+  __HAL_RCC_RTC_ENABLE();
+
+  prvWaitForSynchro();
+
+  /* Set the prescaler with the RTC in configuration mode. */
+  while ((RTC->CRL & RTC_CRL_RTOFF) == 0U);
+  RTC->CRL |= RTC_CRL_CNF;
+  RTC->PRLH = (LOWPOWER_RTC_PRESCALER >> 16U) & 0x000FU;
+  RTC->PRLL = LOWPOWER_RTC_PRESCALER & 0xFFFFU;
+  RTC->CRL &= ~RTC_CRL_CNF;
+  while ((RTC->CRL & RTC_CRL_RTOFF) == 0U);
+
+  /* The alarm reaches the NVIC, and wakes the MCU from STOP mode, through the
+     rising edge of EXTI line 17. */
+  RTC->CRL &= ~RTC_CRL_ALRF;
+  RTC->CRH |= RTC_CRH_ALRIE;
+  EXTI->PR = EXTI_PR_PR17;
+  EXTI->RTSR |= EXTI_RTSR_TR17;
+  EXTI->IMR |= EXTI_IMR_MR17;
+
+  /* The handler makes no RTOS calls, so any priority can be used. */
+  HAL_NVIC_SetPriority(RTC_Alarm_IRQn, configLIBRARY_LOWEST_INTERRUPT_PRIORITY, 0);
+  HAL_NVIC_EnableIRQ(RTC_Alarm_IRQn);
+
+#if (LOWPOWER_RTC_DEBUG_STOP == 1)
+  /* Keep the debugger connected while the MCU is in STOP mode. */
+  HAL_DBGMCU_EnableDBGStopMode();
+#endif
+}
+
+/**
+  * @brief  Clears the alarm flags once the alarm has woken the MCU.
+  * @retval None
+  */
+void LowPower_RTC_IRQHandler(void)
+{
+  RTC->CRL &= ~RTC_CRL_ALRF;
+  EXTI->PR = EXTI_PR_PR17;
+}
+
+/**
+  * @brief  Sleeps in STOP mode until the RTC alarm or another interrupt.
+  * @note   Called by the kernel port with interrupts disabled and the SysTick
+  *         stopped.
+  * @param  xExpectedIdleTime: Ticks until the next task must be unblocked.
+  * @retval Number of complete ticks spent asleep.
+  */
+TickType_t xPortAltTimebaseSleep(TickType_t xExpectedIdleTime)
+{
+  uint32_t ulStart, ulSleepCounts, ulCarriedCounts, ulElapsed, ulTicks;
+
+  if (xExpectedIdleTime > LOWPOWER_RTC_MAX_SLEEP_TICKS)
+  {
+    xExpectedIdleTime = LOWPOWER_RTC_MAX_SLEEP_TICKS;
+  }
+
+  /* Wake up early by the counts already carried from the last sleep. */
+  ulSleepCounts = ((uint32_t) xExpectedIdleTime * LOWPOWER_RTC_FREQ_HZ) / configTICK_RATE_HZ;
+  ulCarriedCounts = ulTickRemainder / configTICK_RATE_HZ;
+  if (ulSleepCounts > ulCarriedCounts)
+  {
+    ulSleepCounts -= ulCarriedCounts;
+  }
+  else
+  {
+    ulSleepCounts = 0U;
+  }
+
+  ulStart = prvReadCounter();
+
+  if (ulSleepCounts >= LOWPOWER_RTC_MIN_ALARM_COUNTS)
+  {
+    prvWriteAlarm(ulStart + ulSleepCounts);
+    LowPower_RTC_IRQHandler();
+
+    /* With TIMEBASE=tim the HAL tick would wake the MCU every millisecond. */
+    HAL_SuspendTick();
+    HAL_PWR_EnterSTOPMode(PWR_LOWPOWERREGULATOR_ON, PWR_STOPENTRY_WFI);
+
+    /* STOP mode leaves the MCU running from the HSI, bring the PLL back. */
+    SystemClock_Config();
+    HAL_ResumeTick();
+
+    /* The RTC registers read through APB1 are stale until resynchronised. */
+    prvWaitForSynchro();
+  }
+
+  ulElapsed = prvReadCounter() - ulStart;
+
+  /* Convert to ticks, keeping the part of a tick left over for next time. */
+  ulElapsed = (ulElapsed * configTICK_RATE_HZ) + ulTickRemainder;
+  ulTicks = ulElapsed / LOWPOWER_RTC_FREQ_HZ;
+  ulTickRemainder = ulElapsed % LOWPOWER_RTC_FREQ_HZ;
+
+  if (ulTicks > (uint32_t) xExpectedIdleTime)
+  {
+    ulTicks = (uint32_t) xExpectedIdleTime;
+    ulTickRemainder = 0U;
+  }
+
+  return (TickType_t) ulTicks;
+}
+
+/**
+  * @brief  Reads the 32-bit counter, which the RTC exposes as two halves.
+  * @retval Counter value.
+  */
+static uint32_t prvReadCounter(void)
+{
+  uint16_t usHigh, usLow;
+
+  do
+  {
+    usHigh = (uint16_t) RTC->CNTH;
+    usLow = (uint16_t) RTC->CNTL;
+  } while (usHigh != (uint16_t) RTC->CNTH);
+
+  return ((uint32_t) usHigh << 16U) | usLow;
+}
+
+/**
+  * @brief  Writes the alarm, which is only writable in configuration mode.
+  * @param  ulAlarm: Counter value at which the alarm fires.
+  * @retval None
+  */
+static void prvWriteAlarm(uint32_t ulAlarm)
+{
+  while ((RTC->CRL & RTC_CRL_RTOFF) == 0U);
+  RTC->CRL |= RTC_CRL_CNF;
+  RTC->ALRH = ulAlarm >> 16U;
+  RTC->ALRL = ulAlarm & 0xFFFFU;
+  RTC->CRL &= ~RTC_CRL_CNF;
+  while ((RTC->CRL & RTC_CRL_RTOFF) == 0U);
+}
+
+/**
+  * @brief  Waits until the RTC registers are synchronised with the APB1 clock.
+  * @retval None
+  */
+static void prvWaitForSynchro(void)
+{
+  RTC->CRL &= ~RTC_CRL_RSF;
+  while ((RTC->CRL & RTC_CRL_RSF) == 0U);
+}
+
+#endif /* configUSE_TICKLESS_IDLE && configUSE_TICKLESS_ALT_TIMEBASE */
@@ -5,6 +5,13 @@
 #include "queue.h"
 #include "semphr.h"
 #include "event_groups.h"
+#include "lowpower_rtc.h"
+#include "runtime_stats.h"
+#include "heap_trace.h"
+#include "heap_regions.h"
+#include "object_snapshot.h"
+#include "stack_monitor.h"
+#include "load_governor.h"
 
 void SystemClock_Config(void);
 static void MX_GPIO_Init(void);
@@ -20,6 +27,18 @@ int main(void)
     SystemClock_Config();
     MX_GPIO_Init();
 
+#ifdef USE_HEAP_REGIONS
+    HeapRegions_Init();
+#endif
+
+#if ( configUSE_TICKLESS_IDLE == 1 ) && ( configUSE_TICKLESS_ALT_TIMEBASE == 1 )
+    LowPower_RTC_Init();
+#endif
+
+#if ( configUSE_HEAP_TRACE == 1 )
+    HeapTrace_Init();
+#endif
+
     xTaskCreate(StartDefaultTask,
                 "Default",
                 configMINIMAL_STACK_SIZE,
@@ -34,6 +53,22 @@ int main(void)
                 2,
                 NULL);
 
+#if ( configGENERATE_RUN_TIME_STATS == 1 ) && ( configUSE_DWT_RUN_TIME_COUNTER == 1 )
+    RuntimeStats_Init();
+#endif
+
+#if ( configUSE_OBJECT_REGISTRY == 1 )
+    ObjectSnapshot_Init();
+#endif
+
+#if ( INCLUDE_xTaskScanStack == 1 )
+    StackMonitor_Init();
+#endif
+
+#if ( configGENERATE_RUN_TIME_STATS == 1 ) && ( configUSE_DWT_RUN_TIME_COUNTER == 1 ) && ( INCLUDE_xTaskGetIdleTaskHandle == 1 )
+    LoadGovernor_Init();
+#endif
+
     vTaskStartScheduler();
 
     while (1)
@@ -71,6 +106,27 @@ void vApplicationIdleHook( void )
     ulIdleCycleCount++;
 }
 
+#if ( configCHECK_FOR_STACK_OVERFLOW > 0 )
+/*
+* Called from the context switch when the stack of the task being switched
+* out has overflowed.  The stack and the memory below it can no longer be
+* trusted, so stop with the name of the task where the debugger can see it.
+*/
+volatile const char *pcStackOverflowTask = NULL;
+
+void vApplicationStackOverflowHook( TaskHandle_t xTask, char *pcTaskName )
+{
+    ( void ) xTask;
+
+    taskDISABLE_INTERRUPTS();
+    pcStackOverflowTask = pcTaskName;
+
+    for( ;; )
+    {
+    }
+}
+#endif
+
 void SystemClock_Config(void)
 {
     RCC_OscInitTypeDef RCC_OscInitStruct = {0};
@@ -127,12 +183,14 @@ static void MX_GPIO_Init(void)
 }
 
 
+#ifndef USE_RTOS_TIMEBASE
 void HAL_TIM_PeriodElapsedCallback(TIM_HandleTypeDef *htim)
 {
     if (htim->Instance == TIM1) {
     HAL_IncTick();
     }
 }
+#endif
 
 void Error_Handler(void)
 {
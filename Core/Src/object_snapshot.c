@@ -0,0 +1,136 @@
+/* USER CODE BEGIN Header */
+/**
+  ******************************************************************************
+  * @file    object_snapshot.c
+  * @brief   Binary snapshots of the kernel object registry.
+  *
+  *          With configUSE_OBJECT_REGISTRY the kernel keeps a list of every
+  *          task, queue, semaphore, mutex, timer, stream buffer and message
+  *          buffer, see object_registry.h.  A low priority task takes a
+  *          snapshot of it every OBJECT_SNAPSHOT_PERIOD_MS into
+  *          xObjectSnapshot: an ObjectSnapshot_HeaderTypeDef followed by one
+  *          32 byte ObjectInfo_t per object, with its fill level, high-water
+  *          mark and the number of tasks blocked on it.
+  *
+  *          When the project is built with RTT=1 each snapshot is also written
+  *          to RTT channel OBJECT_SNAPSHOT_RTT_CHANNEL in a single write, so
+  *          the host sees whole snapshots only.  A snapshot that does not fit
+  *          the RTT buffer is dropped and counted, the task never waits for
+  *          the host.  Without RTT the debugger can read xObjectSnapshot while
+  *          the target runs.
+  ******************************************************************************
+  */
+/* USER CODE END Header */
+
+/* Includes ------------------------------------------------------------------*/
+#include <string.h>
+#include "main.h"
+#include "object_snapshot.h"
+
+#ifdef USE_SEGGER_RTT
+#include "SEGGER_RTT.h"
+#endif
+
+#if ( configUSE_OBJECT_REGISTRY == 1 )
+
+/* Private define ------------------------------------------------------------*/
+#define OBJECT_SNAPSHOT_STACK_SIZE  configMINIMAL_STACK_SIZE
+
+/* Private variables ---------------------------------------------------------*/
+ObjectSnapshot_TypeDef xObjectSnapshot;
+
+static StaticTask_t xSnapshotTaskTCB;
+static StackType_t xSnapshotTaskStack[OBJECT_SNAPSHOT_STACK_SIZE];
+static uint32_t ulSequence = 0;
+static uint32_t ulDroppedSnapshots = 0;
+
+#ifdef USE_SEGGER_RTT
+static uint8_t ucSnapshotBuffer[OBJECT_SNAPSHOT_RTT_BUFFER_SIZE];
+#endif
+
+/* Private function prototypes -----------------------------------------------*/
+static void prvSnapshotTask(void *pvParameters);
+
+/**
+  * @brief  Sets up the RTT channel and starts the snapshot task.
+  * @note   Call before vTaskStartScheduler().
+  * @retval None
+  */
+void ObjectSnapshot_Init(void)
+{
+  configASSERT(sizeof(ObjectSnapshot_HeaderTypeDef) == sizeof(ObjectInfo_t));
+
+#ifdef USE_SEGGER_RTT
+  SEGGER_RTT_Init();
+  SEGGER_RTT_ConfigUpBuffer(OBJECT_SNAPSHOT_RTT_CHANNEL,
+                            "KernelObjects",
+                            ucSnapshotBuffer,
+                            sizeof(ucSnapshotBuffer),
+                            SEGGER_RTT_MODE_NO_BLOCK_SKIP);
+#endif
+
+  xTaskCreateStatic(prvSnapshotTask,
+                    "Objects",
+                    OBJECT_SNAPSHOT_STACK_SIZE,
+                    NULL,
+                    tskIDLE_PRIORITY + 1,
+                    xSnapshotTaskStack,
+                    &xSnapshotTaskTCB);
+}
+
+/**
+  * @brief  Takes a snapshot of the registry.
+  * @note   The scheduler is suspended while the objects are read, see
+  *         uxObjectRegistryGetSnapshot().
+  * @param  pSnapshot: Filled with the header and the objects.
+  * @retval None
+  */
+void ObjectSnapshot_Take(ObjectSnapshot_TypeDef *pSnapshot)
+{
+  UBaseType_t uxObjects;
+
+  uxObjects = uxObjectRegistryGetSnapshot(pSnapshot->xObjects, configOBJECT_REGISTRY_SIZE);
+
+  memset(&pSnapshot->xHeader, 0, sizeof(pSnapshot->xHeader));
+  pSnapshot->xHeader.ulMagic = OBJECT_SNAPSHOT_MAGIC;
+  pSnapshot->xHeader.ulSequence = ulSequence++;
+  pSnapshot->xHeader.ulTick = (uint32_t) xTaskGetTickCount();
+  pSnapshot->xHeader.usObjects = (uint16_t) uxObjects;
+  pSnapshot->xHeader.usOverflow = (uint16_t) configMIN(uxObjectRegistryGetOverflowCount(), 0xFFFFU);
+  pSnapshot->xHeader.ulDropped = ulDroppedSnapshots;
+  pSnapshot->xHeader.ucRecordSize = (uint8_t) sizeof(ObjectInfo_t);
+#if ( configUSE_MONOTONIC_CLOCK == 1 )
+  pSnapshot->xHeader.ullTimeNs = ullPortGetClockNs();
+#endif
+}
+
+/**
+  * @brief  Takes a snapshot every OBJECT_SNAPSHOT_PERIOD_MS and streams it.
+  * @param  pvParameters: Not used.
+  * @retval None
+  */
+static void prvSnapshotTask(void *pvParameters)
+{
+  TickType_t xLastWake = xTaskGetTickCount();
+
+  (void) pvParameters;
+
+  for (;;)
+  {
+    vTaskDelayUntil(&xLastWake, pdMS_TO_TICKS(OBJECT_SNAPSHOT_PERIOD_MS));
+
+    ObjectSnapshot_Take(&xObjectSnapshot);
+
+#ifdef USE_SEGGER_RTT
+    /* Header and objects are contiguous, one write keeps the snapshot whole. */
+    if (SEGGER_RTT_Write(OBJECT_SNAPSHOT_RTT_CHANNEL,
+                         &xObjectSnapshot,
+                         sizeof(ObjectInfo_t) * (1U + xObjectSnapshot.xHeader.usObjects)) == 0U)
+    {
+      ulDroppedSnapshots++;
+    }
+#endif
+  }
+}
+
+#endif /* configUSE_OBJECT_REGISTRY */
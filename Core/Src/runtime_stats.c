@@ -0,0 +1,421 @@
+/* USER CODE BEGIN Header */
+/**
+  ******************************************************************************
+  * @file    runtime_stats.c
+  * @brief   Per task CPU load, context switch counts and interrupt load.
+  *
+  *          The kernel run time stats are clocked by the DWT cycle counter
+  *          (configUSE_DWT_RUN_TIME_COUNTER), so each task's counter holds the
+  *          cycles it spent running, excluding the interrupts bracketed by
+  *          portRUN_TIME_ISR_ENTER() / portRUN_TIME_ISR_EXIT().
+  *          RuntimeStats_Sample() turns the counters into loads over the time
+  *          since the previous sample.  When the project is built with RTT=1 a
+  *          low priority task prints a report every RUNTIME_STATS_PERIOD_MS on
+  *          RTT channel 0, with a heap fragmentation line when
+  *          configUSE_HEAP_FRAGMENTATION_STATS is set and the usage of each
+  *          heap_5 region.  With configUSE_ISR_PROFILER the report ends with
+  *          the execution time histogram of each interrupt and the worst
+  *          nesting, critical section and tick latency since boot.  With
+  *          configUSE_CRITICAL_SECTION_TRACKER it also lists the functions
+  *          with the longest critical sections and scheduler suspensions,
+  *          and with configUSE_CONTEXT_SWITCH_STATS the PendSV handler times.
+  ******************************************************************************
+  */
+/* USER CODE END Header */
+
+/* Includes ------------------------------------------------------------------*/
+#include "main.h"
+#include "runtime_stats.h"
+
+#ifdef USE_SEGGER_RTT
+#include "SEGGER_RTT.h"
+#endif
+
+#if ( configGENERATE_RUN_TIME_STATS == 1 ) && ( configUSE_DWT_RUN_TIME_COUNTER == 1 )
+
+/* Private define ------------------------------------------------------------*/
+#define RUNTIME_STATS_STACK_SIZE    ( configMINIMAL_STACK_SIZE * 2 )
+
+/* Private variables ---------------------------------------------------------*/
+static TaskStatus_t xTaskStatus[RUNTIME_STATS_MAX_TASKS];
+
+/* Counters at the previous sample, the loads are computed from the deltas. */
+static TaskHandle_t xPrevHandle[RUNTIME_STATS_MAX_TASKS];
+static uint64_t ullPrevRunTime[RUNTIME_STATS_MAX_TASKS];
+static uint32_t ulPrevSwitches[RUNTIME_STATS_MAX_TASKS];
+static UBaseType_t uxPrevNumberOfTasks = 0;
+static UBaseType_t uxPrevTasksDropped = 0;
+static PortRunTimeStats_t xPrevPortStats;
+
+#ifdef USE_SEGGER_RTT
+static StaticTask_t xReportTaskTCB;
+static StackType_t xReportTaskStack[RUNTIME_STATS_STACK_SIZE];
+static RuntimeStats_SampleTypeDef xReportSample;
+
+#if ( configRUN_TIME_STATS_ISR_SLOTS > 0 )
+static uint32_t ulPrevISRCycles[configRUN_TIME_STATS_ISR_SLOTS];
+static uint32_t ulPrevISRCount[configRUN_TIME_STATS_ISR_SLOTS];
+#endif
+
+#if ( configUSE_ISR_PROFILER == 1 )
+static PortISRProfile_t xISRProfiles[configISR_PROFILER_MAX_IRQS];
+#endif
+
+#if ( configUSE_CRITICAL_SECTION_TRACKER == 1 )
+static PortCriticalSectionStats_t xCriticalSectionStats;
+#endif
+#endif /* USE_SEGGER_RTT */
+
+/* Private function prototypes -----------------------------------------------*/
+static uint32_t prvPermille(uint64_t ullPart, uint64_t ullWhole);
+#ifdef USE_SEGGER_RTT
+static void prvReportTask(void *pvParameters);
+#if ( configUSE_ISR_PROFILER == 1 )
+static void prvReportISRProfile(void);
+#endif
+#if ( configUSE_CRITICAL_SECTION_TRACKER == 1 )
+static void prvReportCriticalSections(void);
+#endif
+#endif
+
+/**
+  * @brief  Starts the RTT report task when RTT output is built in.
+  * @note   Call before vTaskStartScheduler().
+  * @retval None
+  */
+void RuntimeStats_Init(void)
+{
+#ifdef USE_SEGGER_RTT
+  SEGGER_RTT_Init();
+
+  xTaskCreateStatic(prvReportTask,
+                    "Stats",
+                    RUNTIME_STATS_STACK_SIZE,
+                    NULL,
+                    tskIDLE_PRIORITY + 1,
+                    xReportTaskStack,
+                    &xReportTaskTCB);
+#endif
+}
+
+/**
+  * @brief  Computes the load of each task and of the interrupts since the
+  *         previous call.
+  * @note   Not reentrant, call from one task only.  When more than
+  *         RUNTIME_STATS_MAX_TASKS tasks exist the snapshot is taken in a
+  *         temporary heap buffer, only the first RUNTIME_STATS_MAX_TASKS are
+  *         reported and the others are counted in uxTasksDropped.
+  * @param  pSample: Filled with the loads over the sample period.
+  * @retval None
+  */
+void RuntimeStats_Sample(RuntimeStats_SampleTypeDef *pSample)
+{
+  PortRunTimeStats_t xPortStats;
+  configRUN_TIME_COUNTER_TYPE ullTotalRunTime;
+  TaskStatus_t *pxStatus = xTaskStatus;
+  uint64_t ullPrev;
+  uint32_t ulPrev;
+  UBaseType_t uxAllTasks, uxTasks, x, y;
+
+  /* Suspend the scheduler so the task list and the cycle counts are read
+     at the same moment. */
+  vTaskSuspendAll();
+  {
+    uxAllTasks = uxTaskGetNumberOfTasks();
+
+    /* uxTaskGetSystemState() fills nothing if the array is too small, so
+       take the whole list in a heap buffer and keep the head of it. */
+    if (uxAllTasks > RUNTIME_STATS_MAX_TASKS)
+    {
+      pxStatus = pvPortMalloc(uxAllTasks * sizeof(TaskStatus_t));
+    }
+
+    if (pxStatus != NULL)
+    {
+      uxAllTasks = uxTaskGetSystemState(pxStatus, uxAllTasks, &ullTotalRunTime);
+    }
+    vPortGetRunTimeStats(&xPortStats);
+  }
+  (void) xTaskResumeAll();
+
+  uxTasks = (pxStatus != NULL) ? configMIN(uxAllTasks, RUNTIME_STATS_MAX_TASKS) : 0U;
+
+  pSample->ullPeriodCycles = xPortStats.ullTotalCycles - xPrevPortStats.ullTotalCycles;
+  pSample->ulISRLoadPermille = prvPermille(xPortStats.ullISRCycles - xPrevPortStats.ullISRCycles, pSample->ullPeriodCycles);
+  pSample->ulISRCount = xPortStats.ulISRCount - xPrevPortStats.ulISRCount;
+  pSample->ulContextSwitches = 0U;
+  pSample->uxNumberOfTasks = uxTasks;
+  pSample->uxTasksDropped = uxAllTasks - uxTasks;
+
+  for (x = 0U; x < uxTasks; x++)
+  {
+    /* Tasks created since the last sample start from zero.  A task that
+       was dropped from the last sample has no baseline either, it shows no
+       load until the next one rather than its load since boot. */
+    ullPrev = (uxPrevTasksDropped != 0U) ? pxStatus[x].ulRunTimeCounter : 0U;
+    ulPrev = (uxPrevTasksDropped != 0U) ? pxStatus[x].ulContextSwitchCount : 0U;
+    for (y = 0U; y < uxPrevNumberOfTasks; y++)
+    {
+      if (xPrevHandle[y] == pxStatus[x].xHandle)
+      {
+        ullPrev = ullPrevRunTime[y];
+        ulPrev = ulPrevSwitches[y];
+        break;
+      }
+    }
+
+    pSample->xTasks[x].xHandle = pxStatus[x].xHandle;
+    pSample->xTasks[x].pcTaskName = pxStatus[x].pcTaskName;
+    pSample->xTasks[x].ullRunTimeCycles = pxStatus[x].ulRunTimeCounter;
+    pSample->xTasks[x].ulLoadPermille = prvPermille(pxStatus[x].ulRunTimeCounter - ullPrev, pSample->ullPeriodCycles);
+    pSample->xTasks[x].ulContextSwitches = pxStatus[x].ulContextSwitchCount - ulPrev;
+    pSample->ulContextSwitches += pSample->xTasks[x].ulContextSwitches;
+  }
+
+  for (x = 0U; x < uxTasks; x++)
+  {
+    xPrevHandle[x] = pxStatus[x].xHandle;
+    ullPrevRunTime[x] = pxStatus[x].ulRunTimeCounter;
+    ulPrevSwitches[x] = pxStatus[x].ulContextSwitchCount;
+  }
+  uxPrevNumberOfTasks = uxTasks;
+  uxPrevTasksDropped = pSample->uxTasksDropped;
+  xPrevPortStats = xPortStats;
+
+  if ((pxStatus != NULL) && (pxStatus != xTaskStatus))
+  {
+    vPortFree(pxStatus);
+  }
+}
+
+/**
+  * @brief  Returns ullPart / ullWhole in 0.1% units.
+  */
+static uint32_t prvPermille(uint64_t ullPart, uint64_t ullWhole)
+{
+  if (ullWhole == 0U)
+  {
+    return 0U;
+  }
+
+  return (uint32_t) ((ullPart * 1000U) / ullWhole);
+}
+
+#ifdef USE_SEGGER_RTT
+/**
+  * @brief  Prints the loads on RTT channel 0 every RUNTIME_STATS_PERIOD_MS.
+  * @param  pvParameters: Not used.
+  * @retval None
+  */
+static void prvReportTask(void *pvParameters)
+{
+  TickType_t xLastWake = xTaskGetTickCount();
+  UBaseType_t x;
+
+  (void) pvParameters;
+
+  /* The first sample covers the time since boot, start from a clean one. */
+  RuntimeStats_Sample(&xReportSample);
+
+  for (;;)
+  {
+    vTaskDelayUntil(&xLastWake, pdMS_TO_TICKS(RUNTIME_STATS_PERIOD_MS));
+
+    RuntimeStats_Sample(&xReportSample);
+
+    SEGGER_RTT_printf(0, "--- isr %u.%u%% (%u), %u switches\n",
+                      (unsigned) (xReportSample.ulISRLoadPermille / 10U),
+                      (unsigned) (xReportSample.ulISRLoadPermille % 10U),
+                      (unsigned) xReportSample.ulISRCount,
+                      (unsigned) xReportSample.ulContextSwitches);
+
+    for (x = 0U; x < xReportSample.uxNumberOfTasks; x++)
+    {
+      SEGGER_RTT_printf(0, "%-16s %3u.%u%% %u\n",
+                        xReportSample.xTasks[x].pcTaskName,
+                        (unsigned) (xReportSample.xTasks[x].ulLoadPermille / 10U),
+                        (unsigned) (xReportSample.xTasks[x].ulLoadPermille % 10U),
+                        (unsigned) xReportSample.xTasks[x].ulContextSwitches);
+    }
+
+    if (xReportSample.uxTasksDropped != 0U)
+    {
+      SEGGER_RTT_printf(0, "%u tasks not reported\n", (unsigned) xReportSample.uxTasksDropped);
+    }
+
+#if ( configRUN_TIME_STATS_ISR_SLOTS > 0 )
+    for (x = 0U; x < configRUN_TIME_STATS_ISR_SLOTS; x++)
+    {
+      uint32_t ulCycles, ulCount, ulPermille;
+
+      vPortGetISRRunTime(x, &ulCycles, &ulCount);
+
+      if (ulCount != ulPrevISRCount[x])
+      {
+        ulPermille = prvPermille(ulCycles - ulPrevISRCycles[x], xReportSample.ullPeriodCycles);
+
+        /* Exception numbers below 16 are the Cortex-M system exceptions. */
+        SEGGER_RTT_printf(0, "%s %d: %u.%u%% (%u)\n",
+                          (x < 16U) ? "exc" : "irq",
+                          (x < 16U) ? (int) x : (int) x - 16,
+                          (unsigned) (ulPermille / 10U),
+                          (unsigned) (ulPermille % 10U),
+                          (unsigned) (ulCount - ulPrevISRCount[x]));
+      }
+
+      ulPrevISRCycles[x] = ulCycles;
+      ulPrevISRCount[x] = ulCount;
+    }
+#endif
+
+#if ( configUSE_HEAP_FRAGMENTATION_STATS == 1 )
+    {
+      HeapFragmentationStats_t xHeap;
+
+      vPortGetHeapFragmentationStats(&xHeap);
+
+      SEGGER_RTT_printf(0, "heap %u free, largest %u, %u blocks, frag %u.%u%% (max %u.%u%%)\n",
+                        (unsigned) xHeap.xAvailableHeapSpaceInBytes,
+                        (unsigned) xHeap.xSizeOfLargestFreeBlockInBytes,
+                        (unsigned) xHeap.xNumberOfFreeBlocks,
+                        (unsigned) (xHeap.xFragmentationPermille / 10U),
+                        (unsigned) (xHeap.xFragmentationPermille % 10U),
+                        (unsigned) (xHeap.xMaximumFragmentationPermille / 10U),
+                        (unsigned) (xHeap.xMaximumFragmentationPermille % 10U));
+    }
+#endif
+
+#ifdef USE_HEAP_REGIONS
+    for (x = 0U; x < uxPortGetNumberOfHeapRegions(); x++)
+    {
+      HeapRegionStats_t xRegion;
+
+      vPortGetHeapRegionStats(x, &xRegion);
+
+      SEGGER_RTT_printf(0, "region %u%s %u/%u free (min %u)\n",
+                        (unsigned) x,
+                        ((xRegion.uxAttributes & portHEAP_REGION_DMA) != 0U) ? " dma" : "",
+                        (unsigned) xRegion.xAvailableBytes,
+                        (unsigned) xRegion.xSizeInBytes,
+                        (unsigned) xRegion.xMinimumEverAvailableBytes);
+    }
+#endif
+
+#if ( configUSE_ISR_PROFILER == 1 )
+    prvReportISRProfile();
+#endif
+
+#if ( configUSE_CRITICAL_SECTION_TRACKER == 1 )
+    prvReportCriticalSections();
+#endif
+
+#if ( configUSE_CONTEXT_SWITCH_STATS == 1 )
+    {
+      PortContextSwitchStats_t xSwitches;
+
+      vPortGetContextSwitchStats(&xSwitches);
+
+      SEGGER_RTT_printf(0, "pendsv switch %u min %u avg %u max %u, same task %u min %u avg %u max %u\n",
+                        (unsigned) xSwitches.xSwitched.ulCount,
+                        (unsigned) xSwitches.xSwitched.ulMinCycles,
+                        (unsigned) ((xSwitches.xSwitched.ulCount > 0U) ? (xSwitches.xSwitched.ullTotalCycles / xSwitches.xSwitched.ulCount) : 0U),
+                        (unsigned) xSwitches.xSwitched.ulMaxCycles,
+                        (unsigned) xSwitches.xResumed.ulCount,
+                        (unsigned) xSwitches.xResumed.ulMinCycles,
+                        (unsigned) ((xSwitches.xResumed.ulCount > 0U) ? (xSwitches.xResumed.ullTotalCycles / xSwitches.xResumed.ulCount) : 0U),
+                        (unsigned) xSwitches.xResumed.ulMaxCycles);
+    }
+#endif
+  }
+}
+
+#if ( configUSE_ISR_PROFILER == 1 )
+/**
+  * @brief  Prints the interrupt profile on RTT channel 0.
+  * @note   One line per interrupt: entries, min/avg/max cycles, then the
+  *         histogram counts from the shortest bucket, whose upper bound is
+  *         2^configISR_PROFILER_HISTOGRAM_SHIFT cycles, each following bound
+  *         being twice the previous one.
+  * @retval None
+  */
+static void prvReportISRProfile(void)
+{
+  PortISRProfileSummary_t xSummary;
+  UBaseType_t uxProfiles, x, y;
+  PortISRProfile_t *pxProfile;
+
+  uxProfiles = uxPortGetISRProfile(xISRProfiles, configISR_PROFILER_MAX_IRQS, &xSummary);
+
+  SEGGER_RTT_printf(0, "isr nest %u, crit max %u, tick latency max %u avg %u, unprofiled %u\n",
+                    (unsigned) xSummary.uxMaxNesting,
+                    (unsigned) xSummary.ulMaxCriticalCycles,
+                    (unsigned) xSummary.ulMaxTickLatency,
+                    (unsigned) ((xSummary.ulTickCount > 0U) ? (xSummary.ullTotalTickLatency / xSummary.ulTickCount) : 0U),
+                    (unsigned) xSummary.ulUnprofiledEntries);
+
+  for (x = 0U; x < uxProfiles; x++)
+  {
+    pxProfile = &xISRProfiles[x];
+
+    if (pxProfile->ulCount == 0U)
+    {
+      continue;
+    }
+
+    SEGGER_RTT_printf(0, "%s %d: %u, %u/%u/%u |",
+                      (pxProfile->ulExceptionNumber < 16U) ? "exc" : "irq",
+                      (pxProfile->ulExceptionNumber < 16U) ? (int) pxProfile->ulExceptionNumber : (int) pxProfile->ulExceptionNumber - 16,
+                      (unsigned) pxProfile->ulCount,
+                      (unsigned) pxProfile->ulMinCycles,
+                      (unsigned) (pxProfile->ullTotalCycles / pxProfile->ulCount),
+                      (unsigned) pxProfile->ulMaxCycles);
+
+    for (y = 0U; y < configISR_PROFILER_HISTOGRAM_BUCKETS; y++)
+    {
+      SEGGER_RTT_printf(0, " %u", (unsigned) pxProfile->ulHistogram[y]);
+    }
+
+    SEGGER_RTT_printf(0, "\n");
+  }
+}
+#endif /* configUSE_ISR_PROFILER */
+
+#if ( configUSE_CRITICAL_SECTION_TRACKER == 1 )
+/**
+  * @brief  Prints the longest critical sections and scheduler suspensions on
+  *         RTT channel 0.
+  * @note   One line per kind, each entry being the return address into the
+  *         function that entered the section and its longest duration in
+  *         cycles.  Look the addresses up with addr2line on the ELF file.
+  * @retval None
+  */
+static void prvReportCriticalSections(void)
+{
+  UBaseType_t x;
+
+  vPortGetCriticalSectionStats(&xCriticalSectionStats);
+
+  SEGGER_RTT_printf(0, "crit %u:", (unsigned) xCriticalSectionStats.ulCriticalSections);
+
+  for (x = 0U; (x < configCRITICAL_SECTION_TRACKER_ENTRIES) && (xCriticalSectionStats.xCritical[x].ulCaller != 0U); x++)
+  {
+    SEGGER_RTT_printf(0, " 0x%08x %u",
+                      (unsigned) xCriticalSectionStats.xCritical[x].ulCaller,
+                      (unsigned) xCriticalSectionStats.xCritical[x].ulCycles);
+  }
+
+  SEGGER_RTT_printf(0, "\nsusp %u:", (unsigned) xCriticalSectionStats.ulSchedulerSuspensions);
+
+  for (x = 0U; (x < configCRITICAL_SECTION_TRACKER_ENTRIES) && (xCriticalSectionStats.xSuspended[x].ulCaller != 0U); x++)
+  {
+    SEGGER_RTT_printf(0, " 0x%08x %u",
+                      (unsigned) xCriticalSectionStats.xSuspended[x].ulCaller,
+                      (unsigned) xCriticalSectionStats.xSuspended[x].ulCycles);
+  }
+
+  SEGGER_RTT_printf(0, "\n");
+}
+#endif /* configUSE_CRITICAL_SECTION_TRACKER */
+#endif /* USE_SEGGER_RTT */
+
+#endif /* configGENERATE_RUN_TIME_STATS && configUSE_DWT_RUN_TIME_COUNTER */
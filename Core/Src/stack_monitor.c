@@ -0,0 +1,267 @@
+/* USER CODE BEGIN Header */
+/**
+  ******************************************************************************
+  * @file    stack_monitor.c
+  * @brief   Background stack usage monitor for all tasks.
+  *
+  *          A low priority task measures the stack of one task every
+  *          STACK_MONITOR_STEP_MS with xTaskScanStack(), going through all
+  *          the tasks, the idle and timer tasks included, in turn.  Each scan
+  *          updates the peak usage of the task, from its painted stack, and a
+  *          histogram of the stack in use when the task was last switched
+  *          out.  The scheduler is only suspended for the scan of one stack,
+  *          and configCHECK_FOR_STACK_OVERFLOW 3 leaves a single canary word
+  *          to check on each context switch, so stack sizing errors are
+  *          caught in the field at little cost.
+  *
+  *          The results are in xStackMonitorTasks, which the debugger can read
+  *          while the target runs, or StackMonitor_GetTasks().  When the
+  *          project is built with RTT=1 a peak above STACK_MONITOR_WARN_PERCENT
+  *          is reported on RTT channel 0 when it is measured, and every task
+  *          is listed once all of them have been scanned.
+  ******************************************************************************
+  */
+/* USER CODE END Header */
+
+/* Includes ------------------------------------------------------------------*/
+#include <string.h>
+#include "main.h"
+#include "stack_monitor.h"
+
+#ifdef USE_SEGGER_RTT
+#include "SEGGER_RTT.h"
+#endif
+
+#if ( INCLUDE_xTaskScanStack == 1 )
+
+/* Private define ------------------------------------------------------------*/
+#define STACK_MONITOR_STACK_SIZE    configMINIMAL_STACK_SIZE
+
+/* Private variables ---------------------------------------------------------*/
+StackMonitor_TaskTypeDef xStackMonitorTasks[STACK_MONITOR_MAX_TASKS];
+
+/* Tasks that did not fit xStackMonitorTasks. */
+uint32_t ulStackMonitorOverflow = 0;
+
+static StaticTask_t xMonitorTaskTCB;
+static StackType_t xMonitorTaskStack[STACK_MONITOR_STACK_SIZE];
+
+/* Round in which each entry was last scanned, entries of deleted tasks are
+   freed at the end of a round. */
+static uint32_t ulScanRound[STACK_MONITOR_MAX_TASKS];
+static uint32_t ulRound = 0;
+
+/* Private function prototypes -----------------------------------------------*/
+static void prvMonitorTask(void *pvParameters);
+static void prvRecordUsage(const TaskStackUsage_t *pxUsage);
+static void prvEndRound(void);
+
+/**
+  * @brief  Starts the monitor task.
+  * @note   Call before vTaskStartScheduler().
+  * @retval None
+  */
+void StackMonitor_Init(void)
+{
+#ifdef USE_SEGGER_RTT
+  SEGGER_RTT_Init();
+#endif
+
+  xTaskCreateStatic(prvMonitorTask,
+                    "Stacks",
+                    STACK_MONITOR_STACK_SIZE,
+                    NULL,
+                    tskIDLE_PRIORITY + 1,
+                    xMonitorTaskStack,
+                    &xMonitorTaskTCB);
+}
+
+/**
+  * @brief  Copies the stack usage of the monitored tasks.
+  * @param  pTasks: Filled with one entry per task.
+  * @param  uxMaxTasks: Number of entries in pTasks.
+  * @retval Number of entries filled.
+  */
+UBaseType_t StackMonitor_GetTasks(StackMonitor_TaskTypeDef *pTasks, UBaseType_t uxMaxTasks)
+{
+  UBaseType_t uxTasks = 0U;
+  UBaseType_t x;
+
+  /* The monitor task only updates the entries with the scheduler running. */
+  vTaskSuspendAll();
+  {
+    for (x = 0U; (x < STACK_MONITOR_MAX_TASKS) && (uxTasks < uxMaxTasks); x++)
+    {
+      if (xStackMonitorTasks[x].xHandle != NULL)
+      {
+        pTasks[uxTasks++] = xStackMonitorTasks[x];
+      }
+    }
+  }
+  (void) xTaskResumeAll();
+
+  return uxTasks;
+}
+
+/**
+  * @brief  Scans the stack of the next task every STACK_MONITOR_STEP_MS.
+  * @param  pvParameters: Not used.
+  * @retval None
+  */
+static void prvMonitorTask(void *pvParameters)
+{
+  TickType_t xLastWake = xTaskGetTickCount();
+  TaskStackUsage_t xUsage;
+  UBaseType_t uxPreviousTaskNumber = 0U;
+
+  (void) pvParameters;
+
+  for (;;)
+  {
+    vTaskDelayUntil(&xLastWake, pdMS_TO_TICKS(STACK_MONITOR_STEP_MS));
+
+    if (xTaskScanStack(uxPreviousTaskNumber, &xUsage) != pdFALSE)
+    {
+      prvRecordUsage(&xUsage);
+      uxPreviousTaskNumber = xUsage.xTaskNumber;
+    }
+    else
+    {
+      /* Every task has been scanned, start again from the first one. */
+      prvEndRound();
+      uxPreviousTaskNumber = 0U;
+    }
+  }
+}
+
+/**
+  * @brief  Updates the entry of the task just scanned.
+  * @param  pxUsage: The result of the scan.
+  * @retval None
+  */
+static void prvRecordUsage(const TaskStackUsage_t *pxUsage)
+{
+  StackMonitor_TaskTypeDef *pTask = NULL;
+  uint32_t ulBucket;
+  UBaseType_t x;
+
+  for (x = 0U; x < STACK_MONITOR_MAX_TASKS; x++)
+  {
+    if ((xStackMonitorTasks[x].xHandle != NULL) && (xStackMonitorTasks[x].uxTaskNumber == pxUsage->xTaskNumber))
+    {
+      pTask = &xStackMonitorTasks[x];
+      break;
+    }
+  }
+
+  if (pTask == NULL)
+  {
+    for (x = 0U; x < STACK_MONITOR_MAX_TASKS; x++)
+    {
+      if (xStackMonitorTasks[x].xHandle == NULL)
+      {
+        pTask = &xStackMonitorTasks[x];
+        pTask->ulSamples = 0U;
+        for (ulBucket = 0U; ulBucket < STACK_MONITOR_BUCKETS; ulBucket++)
+        {
+          pTask->ulHistogram[ulBucket] = 0U;
+        }
+        break;
+      }
+    }
+  }
+
+  if (pTask == NULL)
+  {
+    ulStackMonitorOverflow++;
+    return;
+  }
+
+  ulScanRound[x] = ulRound;
+
+  vTaskSuspendAll();
+  {
+    pTask->xHandle = pxUsage->xHandle;
+    (void) memcpy(pTask->pcTaskName, pxUsage->pcTaskName, sizeof(pTask->pcTaskName));
+    pTask->uxTaskNumber = pxUsage->xTaskNumber;
+    pTask->ulStackDepth = pxUsage->uxStackDepth;
+    pTask->ulPeakUsed = pxUsage->uxStackDepth - pxUsage->uxStackHighWaterMark;
+    pTask->ulPeakPercent = (pTask->ulPeakUsed * 100U) / pTask->ulStackDepth;
+    pTask->ulSamples++;
+
+    ulBucket = ((uint32_t) pxUsage->uxStackInUse * STACK_MONITOR_BUCKETS) / pTask->ulStackDepth;
+    pTask->ulHistogram[(ulBucket < STACK_MONITOR_BUCKETS) ? ulBucket : (STACK_MONITOR_BUCKETS - 1U)]++;
+  }
+  (void) xTaskResumeAll();
+
+#ifdef USE_SEGGER_RTT
+  if (pTask->ulPeakPercent >= STACK_MONITOR_WARN_PERCENT)
+  {
+    SEGGER_RTT_printf(0, "stack warning %s: %u/%u words\n",
+                      pTask->pcTaskName,
+                      (unsigned) pTask->ulPeakUsed,
+                      (unsigned) pTask->ulStackDepth);
+  }
+#endif
+}
+
+/**
+  * @brief  Frees the entries of the tasks deleted since the previous round
+  *         and lists the tasks on RTT.
+  * @retval None
+  */
+static void prvEndRound(void)
+{
+  UBaseType_t x;
+
+  vTaskSuspendAll();
+  {
+    for (x = 0U; x < STACK_MONITOR_MAX_TASKS; x++)
+    {
+      if ((xStackMonitorTasks[x].xHandle != NULL) && (ulScanRound[x] != ulRound))
+      {
+        xStackMonitorTasks[x].xHandle = NULL;
+      }
+    }
+  }
+  (void) xTaskResumeAll();
+
+  ulRound++;
+
+#ifdef USE_SEGGER_RTT
+  {
+    StackMonitor_TaskTypeDef *pTask;
+    UBaseType_t y;
+
+    for (x = 0U; x < STACK_MONITOR_MAX_TASKS; x++)
+    {
+      pTask = &xStackMonitorTasks[x];
+
+      if (pTask->xHandle == NULL)
+      {
+        continue;
+      }
+
+      SEGGER_RTT_printf(0, "stack %s: %u/%u words, %u%% |",
+                        pTask->pcTaskName,
+                        (unsigned) pTask->ulPeakUsed,
+                        (unsigned) pTask->ulStackDepth,
+                        (unsigned) pTask->ulPeakPercent);
+
+      for (y = 0U; y < STACK_MONITOR_BUCKETS; y++)
+      {
+        SEGGER_RTT_printf(0, " %u", (unsigned) pTask->ulHistogram[y]);
+      }
+
+      SEGGER_RTT_printf(0, "\n");
+    }
+
+    if (ulStackMonitorOverflow != 0U)
+    {
+      SEGGER_RTT_printf(0, "stack monitor full, %u scans dropped\n", (unsigned) ulStackMonitorOverflow);
+    }
+  }
+#endif
+}
+
+#endif /* INCLUDE_xTaskScanStack */
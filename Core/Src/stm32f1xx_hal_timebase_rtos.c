@@ -0,0 +1,168 @@
+/* USER CODE BEGIN Header */
+/**
+  ******************************************************************************
+  * @file    stm32f1xx_hal_timebase_rtos.c
+  * @brief   HAL time base derived from the FreeRTOS tick.
+  *
+  *          Replaces stm32f1xx_hal_timebase_tim.c when the project is built
+  *          with TIMEBASE=rtos, so the SysTick driven RTOS tick is the only
+  *          periodic interrupt and TIM1 is left free for the application.
+  *
+  *          Once the scheduler runs HAL_GetTick() is the RTOS tick count in
+  *          ms, which tickless idle keeps right across sleeps, and HAL_Delay()
+  *          blocks the calling task with vTaskDelay().  Before the scheduler
+  *          starts there is no tick interrupt, so HAL_GetTick() counts DWT
+  *          cycles instead, which is enough for the timeouts of the clock
+  *          setup in SystemClock_Config().  The port restarts the cycle
+  *          counter when the scheduler starts, after which HAL_GetTick()
+  *          carries on from the last value it returned.
+  *
+  *          The tick count does not move while the scheduler is suspended or
+  *          interrupts are masked, so neither do HAL timeouts started there.
+  ******************************************************************************
+  */
+/* USER CODE END Header */
+
+/* Includes ------------------------------------------------------------------*/
+#include "stm32f1xx_hal.h"
+#include "FreeRTOS.h"
+#include "task.h"
+
+/* Private variables ---------------------------------------------------------*/
+/* Cycles per ms at the current SystemCoreClock, set by HAL_InitTick(). */
+static uint32_t ulCyclesPerMs = 0U;
+
+/* Pre-scheduler time base: ms counted so far, the cycles of a partly elapsed
+   ms and the cycle counter when it was last read. */
+static uint32_t ulPreSchedulerMs = 0U;
+static uint32_t ulPreSchedulerCycles = 0U;
+static uint32_t ulLastCycleCount = 0U;
+
+/* Private function prototypes -----------------------------------------------*/
+static void prvCountCycles(void);
+
+/* Private functions ---------------------------------------------------------*/
+
+/**
+  * @brief  Starts the cycle counter used until the scheduler runs and by
+  *         HAL_Delay() busy waits.
+  * @note   Called by HAL_Init() and again by HAL_RCC_ClockConfig() whenever
+  *         the clock changes, no interrupt is set up.
+  * @param  TickPriority: Recorded for the HAL, the RTOS tick priority is set by
+  *         the port from configKERNEL_INTERRUPT_PRIORITY.
+  * @retval HAL status
+  */
+HAL_StatusTypeDef HAL_InitTick(uint32_t TickPriority)
+{
+  /* HAL_GetTick() counts portTICK_PERIOD_MS per tick. */
+  configASSERT((1000U % configTICK_RATE_HZ) == 0U);
+
+  if (TickPriority >= (1UL << __NVIC_PRIO_BITS))
+  {
+    return HAL_ERROR;
+  }
+  uwTickPrio = TickPriority;
+
+  if (xTaskGetSchedulerState() == taskSCHEDULER_NOT_STARTED)
+  {
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
+    /* Cycles counted at the old clock are converted at the old rate, the
+       first call only takes the starting count. */
+    prvCountCycles();
+  }
+
+  ulCyclesPerMs = SystemCoreClock / 1000U;
+
+  return HAL_OK;
+}
+
+/**
+  * @brief  Provides a tick value in millisecond.
+  * @note   Safe to call from interrupts.
+  * @retval tick value
+  */
+uint32_t HAL_GetTick(void)
+{
+  if (xTaskGetSchedulerState() == taskSCHEDULER_NOT_STARTED)
+  {
+    prvCountCycles();
+    return ulPreSchedulerMs;
+  }
+
+  return ulPreSchedulerMs + ((uint32_t) xTaskGetTickCount() * portTICK_PERIOD_MS);
+}
+
+/**
+  * @brief  Waits for at least Delay ms.
+  * @note   Blocks the calling task once the scheduler runs.  Before the
+  *         scheduler starts, in interrupts and while the scheduler is
+  *         suspended a task cannot block and the tick count may not move, so
+  *         the delay is a busy wait on the cycle counter.
+  * @param  Delay: specifies the delay time length, in milliseconds.
+  * @retval None
+  */
+void HAL_Delay(uint32_t Delay)
+{
+  uint32_t ulStart;
+
+  if ((xTaskGetSchedulerState() == taskSCHEDULER_RUNNING) && (xPortIsInsideInterrupt() == pdFALSE))
+  {
+    /* The next tick can come at once, wait one more as HAL_Delay() does. */
+    vTaskDelay(pdMS_TO_TICKS(Delay) + 1U);
+    return;
+  }
+
+  ulStart = DWT->CYCCNT;
+  while (Delay > 0U)
+  {
+    while ((DWT->CYCCNT - ulStart) < ulCyclesPerMs)
+    {
+    }
+    ulStart += ulCyclesPerMs;
+    Delay--;
+  }
+}
+
+/**
+  * @brief  Suspend Tick increment.
+  * @note   The RTOS tick is stopped and corrected by the kernel, nothing to do.
+  * @retval None
+  */
+void HAL_SuspendTick(void)
+{
+}
+
+/**
+  * @brief  Resume Tick increment.
+  * @note   The RTOS tick is stopped and corrected by the kernel, nothing to do.
+  * @retval None
+  */
+void HAL_ResumeTick(void)
+{
+}
+
+/**
+  * @brief  Adds the cycles elapsed since the last call to the pre-scheduler
+  *         ms count.
+  * @note   The 32 bit counter wraps after about a minute at 72 MHz, calls
+  *         must be closer together than that.
+  * @retval None
+  */
+static void prvCountCycles(void)
+{
+  uint32_t ulNow = DWT->CYCCNT;
+
+  if (ulCyclesPerMs == 0U)
+  {
+    ulLastCycleCount = ulNow;
+    return;
+  }
+
+  ulPreSchedulerCycles += ulNow - ulLastCycleCount;
+  ulLastCycleCount = ulNow;
+
+  ulPreSchedulerMs += ulPreSchedulerCycles / ulCyclesPerMs;
+  ulPreSchedulerCycles %= ulCyclesPerMs;
+}
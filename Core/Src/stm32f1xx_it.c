@@ -22,6 +22,8 @@
 #include "stm32f1xx_it.h"
 /* Private includes ----------------------------------------------------------*/
 /* USER CODE BEGIN Includes */
+#include "FreeRTOS.h"
+#include "lowpower_rtc.h"
 /* USER CODE END Includes */
 
 /* Private typedef -----------------------------------------------------------*/
@@ -55,7 +57,9 @@
 /* USER CODE END 0 */
 
 /* External variables --------------------------------------------------------*/
+#ifndef USE_RTOS_TIMEBASE
 extern TIM_HandleTypeDef htim1;
+#endif
 
 /* USER CODE BEGIN EV */
 
@@ -159,19 +163,35 @@ void DebugMon_Handler(void)
 /* please refer to the startup file (startup_stm32f1xx.s).                    */
 /******************************************************************************/
 
+#ifndef USE_RTOS_TIMEBASE
 /**
   * @brief This function handles TIM1 update interrupt.
   */
 void TIM1_UP_IRQHandler(void)
 {
   /* USER CODE BEGIN TIM1_UP_IRQn 0 */
-
+  portRUN_TIME_ISR_ENTER();
   /* USER CODE END TIM1_UP_IRQn 0 */
   HAL_TIM_IRQHandler(&htim1);
   /* USER CODE BEGIN TIM1_UP_IRQn 1 */
-
+  portRUN_TIME_ISR_EXIT();
   /* USER CODE END TIM1_UP_IRQn 1 */
 }
+#endif /* USE_RTOS_TIMEBASE */
+
+/**
+  * @brief This function handles RTC alarm interrupt through EXTI line 17.
+  */
+void RTC_Alarm_IRQHandler(void)
+{
+  /* USER CODE BEGIN RTC_Alarm_IRQn 0 */
+  portRUN_TIME_ISR_ENTER();
+  /* USER CODE END RTC_Alarm_IRQn 0 */
+  LowPower_RTC_IRQHandler();
+  /* USER CODE BEGIN RTC_Alarm_IRQn 1 */
+  portRUN_TIME_ISR_EXIT();
+  /* USER CODE END RTC_Alarm_IRQn 1 */
+}
 
 /* USER CODE BEGIN 1 */
 
@@ -0,0 +1,278 @@
+#include "Coroutine.h" /* stackless coroutine interface */
+#include "object_registry.h"
+
+/* Posted to the scheduler's queue to make it look at its coroutines again,
+ * told apart from the application's events by its address */
+static event_t const co_wake_event = { INIT_SIG };
+
+/*..........................................................................*/
+/* Returns pdTRUE and sets timed_out if the timeout of the wait has passed */
+static BaseType_t co_wait_expired(co_t * const me, TickType_t now) {
+    if ((me->wait_ticks != portMAX_DELAY) && ((TickType_t)(now - me->wait_start) >= me->wait_ticks)) {
+        me->timed_out = pdTRUE;
+        return pdTRUE;
+    }
+    return pdFALSE;
+}
+
+/*..........................................................................*/
+/* Returns pdTRUE if the coroutine can resume, after collecting what it waited for */
+static BaseType_t co_is_ready(co_t * const me, TickType_t now) {
+    me->timed_out = pdFALSE;
+
+    switch (me->wait) {
+        case CO_WAIT_YIELD:
+            return pdTRUE;
+
+        case CO_WAIT_TIME:
+            return ((TickType_t)(now - me->wait_start) >= me->wait_ticks) ? pdTRUE : pdFALSE;
+
+        case CO_WAIT_QUEUE:
+            if (xQueueReceive(me->queue, me->item, 0U) == pdPASS) {
+                return pdTRUE;
+            }
+            return co_wait_expired(me, now);
+
+        case CO_WAIT_NOTIFY:
+            if (me->notify_bits != 0U) {
+                taskENTER_CRITICAL();
+                me->notified = me->notify_bits;
+                me->notify_bits = 0U;
+                taskEXIT_CRITICAL();
+                return pdTRUE;
+            }
+            return co_wait_expired(me, now);
+
+        case CO_WAIT_EVENT:
+            /* resumed by co_sched_dispatch() when the event comes */
+            if (co_wait_expired(me, now) == pdTRUE) {
+                me->event = (event_t const *)0;
+                return pdTRUE;
+            }
+            return pdFALSE;
+
+        default:
+            return pdFALSE;
+    }
+}
+
+/*..........................................................................*/
+/* Resumes every coroutine that can resume, once, and removes the finished ones.
+ * Returns how long the scheduler can sleep: 0 if a coroutine ran, since it may
+ * have made another one ready, or else until the nearest timeout */
+static TickType_t co_sched_pass(co_sched_t * const me) {
+    TickType_t const now = xTaskGetTickCount();
+    TickType_t sleep = portMAX_DELAY;
+    co_t **link = &me->head;
+    co_t *co;
+
+    while ((co = *link) != (co_t *)0) {
+        if (co_is_ready(co, now) == pdTRUE) {
+            (*co->run)(co);
+            sleep = 0U;
+        }
+
+        if (co->wait == CO_WAIT_DONE) {
+            *link = co->next; /* unlink, the coroutine can be spawned again */
+            continue;
+        }
+
+        if ((co->wait != CO_WAIT_YIELD) && (co->wait_ticks != portMAX_DELAY)) {
+            TickType_t const elapsed = (TickType_t)(xTaskGetTickCount() - co->wait_start);
+            TickType_t const left = (elapsed < co->wait_ticks) ? (co->wait_ticks - elapsed) : 0U;
+
+            if (left < sleep) {
+                sleep = left;
+            }
+        }
+        else if (co->wait == CO_WAIT_YIELD) {
+            sleep = 0U;
+        }
+
+        link = &co->next;
+    }
+
+    return sleep;
+}
+
+/*..........................................................................*/
+/* Resumes the coroutines waiting for the signal of the event */
+static void co_sched_dispatch(co_sched_t * const me, event_t const * const event) {
+    co_t *co;
+
+    for (co = me->head; co != (co_t *)0; co = co->next) {
+        if ((co->wait == CO_WAIT_EVENT) && (co->sig == event->sig)) {
+            co->event = event;
+            co->timed_out = pdFALSE;
+            (*co->run)(co);
+        }
+    }
+}
+
+/*..........................................................................*/
+static void co_sched_loop(void *pvParameters)
+{
+    co_sched_t *me = (co_sched_t *)pvParameters;
+    TickType_t sleep;
+
+    configASSERT(me);
+
+    for (;;)
+    {
+        event_t const *event;
+
+        sleep = co_sched_pass(me);
+
+        /* wait for an event, a wake-up or the nearest timeout */
+        if (xQueueReceive(me->super.queue, &event, sleep) == pdPASS) {
+            configASSERT(event != (event_t const *)0);
+
+            if (event == &co_wake_event) {
+                me->wake_pending = pdFALSE;
+            }
+            else {
+                co_sched_dispatch(me, event);
+            }
+        }
+    }
+}
+
+/*..........................................................................*/
+void co_sched_start(co_sched_t * const me, event_loop_args_t * loop_args)
+{
+    StackType_t *stack_buffer = loop_args->stack_buffer;
+    uint32_t stack_depth = (loop_args->stack_size / sizeof(StackType_t));
+
+    (void)loop_args->opt; /* unused parameter do this for warnings */
+
+    me->super.dispatch = (dispatch_handler)0; /* events go to the coroutines */
+    me->wake_pending = pdFALSE;
+
+    me->super.queue = xQueueCreateStatic(loop_args->queue_len,              // queue length
+                                         sizeof(event_t *),                 // item size
+                                         (uint8_t *)loop_args->queue_buffer, // queue storage - provided by user
+                                         &me->super.queue_cb);              // queue control block
+
+    configASSERT(me->super.queue);
+
+    me->super.thread = xTaskCreateStatic(&co_sched_loop,                    // the thread function
+                                         "Coroutines",                      // the name of the task
+                                         stack_depth,                       // stack depth
+                                         me,                                // the 'pvParameters' parameter
+                                         loop_args->priority + tskIDLE_PRIORITY, // FreeRTOS priority
+                                         stack_buffer,                      // stack storage - provided by user
+                                         &me->super.thread_cb);             // task control block
+
+    configASSERT(me->super.thread);
+
+#if ( configUSE_OBJECT_REGISTRY == 1 )
+    /* list the queue as an event loop in the object registry, under the thread name */
+    (void)xObjectRegistryDescribe(me->super.queue, registryTYPE_EVENT_LOOP, pcTaskGetName(me->super.thread));
+#endif
+}
+
+/*..........................................................................*/
+/* Call before the scheduler runs, or from a coroutine of the same scheduler */
+void co_spawn(co_sched_t * const sched, co_t * const me, co_handler run)
+{
+    co_t **link = &sched->head;
+
+    me->run = run;
+    me->sched = sched;
+    me->next = (co_t *)0;
+    me->lc = 0U;
+    me->wait = CO_WAIT_YIELD; /* first runs on the next pass */
+    me->timed_out = pdFALSE;
+    me->notify_bits = 0U;
+    me->notified = 0U;
+
+    /* append, so coroutines run in the order they were spawned */
+    while (*link != (co_t *)0) {
+        link = &(*link)->next;
+    }
+    *link = me;
+}
+
+/*..........................................................................*/
+void co_sched_wake(co_sched_t * const me)
+{
+    event_t const *event = &co_wake_event;
+    BaseType_t post = pdFALSE;
+
+    taskENTER_CRITICAL();
+    if (me->wake_pending == pdFALSE) {
+        me->wake_pending = pdTRUE;
+        post = pdTRUE;
+    }
+    taskEXIT_CRITICAL();
+
+    /* a full queue wakes the scheduler anyway, and it runs a pass per event */
+    if ((post == pdTRUE) && (xQueueSendToBack(me->super.queue, (void *)&event, 0U) != pdPASS)) {
+        me->wake_pending = pdFALSE;
+    }
+}
+
+/*..........................................................................*/
+void co_sched_wakeFromISR(co_sched_t * const me, BaseType_t *pxHigherPriorityTaskWoken)
+{
+    event_t const *event = &co_wake_event;
+    UBaseType_t saved;
+    BaseType_t post = pdFALSE;
+
+    saved = taskENTER_CRITICAL_FROM_ISR();
+    if (me->wake_pending == pdFALSE) {
+        me->wake_pending = pdTRUE;
+        post = pdTRUE;
+    }
+    taskEXIT_CRITICAL_FROM_ISR(saved);
+
+    if ((post == pdTRUE) && (xQueueSendToBackFromISR(me->super.queue, (void *)&event, pxHigherPriorityTaskWoken) != pdPASS)) {
+        me->wake_pending = pdFALSE;
+    }
+}
+
+/*..........................................................................*/
+void co_notify(co_t * const me, uint32_t bits)
+{
+    taskENTER_CRITICAL();
+    me->notify_bits |= bits;
+    taskEXIT_CRITICAL();
+
+    co_sched_wake(me->sched);
+}
+
+/*..........................................................................*/
+void co_notifyFromISR(co_t * const me, uint32_t bits, BaseType_t *pxHigherPriorityTaskWoken)
+{
+    UBaseType_t saved;
+
+    saved = taskENTER_CRITICAL_FROM_ISR();
+    me->notify_bits |= bits;
+    taskEXIT_CRITICAL_FROM_ISR(saved);
+
+    co_sched_wakeFromISR(me->sched, pxHigherPriorityTaskWoken);
+}
+
+/*..........................................................................*/
+BaseType_t co_queue_send(co_sched_t * const sched, QueueHandle_t queue, void const *item, TickType_t ticks)
+{
+    BaseType_t status = xQueueSendToBack(queue, item, ticks);
+
+    if (status == pdPASS) {
+        co_sched_wake(sched);
+    }
+
+    return status;
+}
+
+/*..........................................................................*/
+BaseType_t co_queue_sendFromISR(co_sched_t * const sched, QueueHandle_t queue, void const *item, BaseType_t *pxHigherPriorityTaskWoken)
+{
+    BaseType_t status = xQueueSendToBackFromISR(queue, item, pxHigherPriorityTaskWoken);
+
+    if (status == pdPASS) {
+        co_sched_wakeFromISR(sched, pxHigherPriorityTaskWoken);
+    }
+
+    return status;
+}
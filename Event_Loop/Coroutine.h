@@ -0,0 +1,132 @@
+
+#ifndef COROUTINE_H
+#define COROUTINE_H
+
+#include "Event.h"
+
+/*---------------------------------------------------------------------------*/
+/* Stackless coroutines...
+ *
+ * A coroutine is a function that returns each time it waits and resumes at
+ * the wait on its next call, through a switch on the line of the wait, so it
+ * needs no stack of its own.  Local variables do not survive a wait: keep the
+ * state in a struct that starts with co_t, as active objects start with
+ * event_loop_handle_t.  All the coroutines of a co_sched_t run one after the
+ * other in its single task, which sleeps until one of them can resume:
+ *
+ *  typedef struct {
+ *      co_t super;
+ *      uint8_t byte;
+ *  } echo_co_t;
+ *
+ *  static void echo(co_t * const co) {
+ *      echo_co_t * const me = (echo_co_t *)co;
+ *
+ *      CO_BEGIN(co);
+ *      for (;;) {
+ *          CO_AWAIT_QUEUE(co, rx_queue, &me->byte, portMAX_DELAY);
+ *          ...
+ *          CO_AWAIT_DELAY(co, pdMS_TO_TICKS(10));
+ *      }
+ *      CO_END(co);
+ *  }
+ *
+ * A coroutine must not call blocking FreeRTOS functions, it would block
+ * every coroutine of its scheduler, and cannot use two waits on one line.
+ */
+
+typedef struct co_t co_t;
+typedef struct co_sched_t co_sched_t;
+
+/* Pointer to the coroutine function, called again at each resume */
+typedef void (*co_handler)(co_t * const me);
+
+/* What a coroutine is waiting for */
+typedef enum {
+    CO_WAIT_YIELD,  /* nothing, resumes on the next pass */
+    CO_WAIT_TIME,   /* wait_ticks to pass */
+    CO_WAIT_EVENT,  /* an event with signal 'sig' posted to the scheduler */
+    CO_WAIT_QUEUE,  /* an item in 'queue' */
+    CO_WAIT_NOTIFY, /* a co_notify() */
+    CO_WAIT_DONE    /* CO_END reached, removed from the scheduler */
+} co_wait_t;
+
+struct co_t {
+    co_handler run;                 /* the coroutine function */
+    co_t *next;                     /* next coroutine of the scheduler */
+    co_sched_t *sched;              /* scheduler running this coroutine */
+    uint16_t lc;                    /* line of the wait to resume at, 0 to start */
+    uint8_t wait;                   /* co_wait_t */
+    uint8_t timed_out;              /* pdTRUE if the last wait timed out */
+    TickType_t wait_start;          /* tick count when the wait started */
+    TickType_t wait_ticks;          /* timeout of the wait, portMAX_DELAY for none */
+    signal_t sig;                   /* CO_WAIT_EVENT: awaited signal */
+    event_t const *event;           /* CO_WAIT_EVENT: the event, valid until the next wait */
+    QueueHandle_t queue;            /* CO_WAIT_QUEUE: awaited queue */
+    void *item;                     /* CO_WAIT_QUEUE: where the item is copied */
+    volatile uint32_t notify_bits;  /* bits set by co_notify() and not taken yet */
+    uint32_t notified;              /* CO_WAIT_NOTIFY: bits taken by the wait */
+};
+
+/* The scheduler is an event loop: events posted to it with event_post()
+ * resume the coroutines waiting for their signal, time_event_t included */
+struct co_sched_t {
+    event_loop_handle_t super;      /* inherit event_loop_handle_t */
+    co_t *head;                     /* coroutines, in the order they run */
+    volatile BaseType_t wake_pending; /* a wake-up is in the queue already */
+};
+
+void co_sched_start(co_sched_t * const me, event_loop_args_t * loop_args);
+void co_spawn(co_sched_t * const sched, co_t * const me, co_handler run);
+void co_sched_wake(co_sched_t * const me);
+void co_sched_wakeFromISR(co_sched_t * const me, BaseType_t *pxHigherPriorityTaskWoken);
+
+void co_notify(co_t * const me, uint32_t bits);
+void co_notifyFromISR(co_t * const me, uint32_t bits, BaseType_t *pxHigherPriorityTaskWoken);
+
+BaseType_t co_queue_send(co_sched_t * const sched, QueueHandle_t queue, void const *item, TickType_t ticks);
+BaseType_t co_queue_sendFromISR(co_sched_t * const sched, QueueHandle_t queue, void const *item, BaseType_t *pxHigherPriorityTaskWoken);
+
+/*---------------------------------------------------------------------------*/
+/* Coroutine body... */
+
+#define CO_BEGIN(co_)   switch ((co_)->lc) { case 0U:
+
+#define CO_END(co_)     } (co_)->wait = CO_WAIT_DONE; return
+
+/* Return to the scheduler, which resumes at the case on the same line */
+#define CO_SUSPEND_(co_, wait_, ticks_)      \
+    (co_)->wait = (wait_);                   \
+    (co_)->wait_ticks = (ticks_);            \
+    (co_)->wait_start = xTaskGetTickCount(); \
+    (co_)->lc = (uint16_t)__LINE__;          \
+    return;                                  \
+    case __LINE__:
+
+/* Let the other coroutines run */
+#define CO_YIELD(co_) \
+    do { CO_SUSPEND_(co_, CO_WAIT_YIELD, 0U); } while (0)
+
+#define CO_AWAIT_DELAY(co_, ticks_) \
+    do { CO_SUSPEND_(co_, CO_WAIT_TIME, ticks_); } while (0)
+
+/* Wait for an event with signal sig_ posted to the scheduler, in (co_)->event */
+#define CO_AWAIT_EVENT(co_, sig_, ticks_) \
+    do { (co_)->sig = (sig_); CO_SUSPEND_(co_, CO_WAIT_EVENT, ticks_); } while (0)
+
+/* Wait for an item of queue_, copied to item_.  Items must be sent with
+ * co_queue_send(), or followed by co_sched_wake(), to wake the scheduler */
+#define CO_AWAIT_QUEUE(co_, queue_, item_, ticks_)                       \
+    do {                                                                 \
+        (co_)->queue = (queue_);                                         \
+        (co_)->item = (item_);                                           \
+        CO_SUSPEND_(co_, CO_WAIT_QUEUE, ticks_);                         \
+    } while (0)
+
+/* Wait for co_notify(), the bits set since the last wait are in (co_)->notified */
+#define CO_AWAIT_NOTIFY(co_, ticks_) \
+    do { CO_SUSPEND_(co_, CO_WAIT_NOTIFY, ticks_); } while (0)
+
+#define CO_TIMED_OUT(co_)   ((co_)->timed_out != pdFALSE)
+
+#endif /* COROUTINE_H */
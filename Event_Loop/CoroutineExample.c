@@ -0,0 +1,145 @@
+#include "FreeRTOSConfig.h"
+#include "Coroutine.h"
+
+/* Eight line protocol handlers, a heartbeat and a button, all run by one
+ * task.  Each handler takes a line of bytes from its own queue, filled by a
+ * receive ISR with co_queue_sendFromISR(), and counts the lines that end in
+ * '\r' for the heartbeat.  A handler costs its struct and its queue, not a
+ * task stack.  Not built by the Makefile, like Example.c. */
+
+#define LINE_HANDLERS   8U
+#define LINE_MAX        32U
+
+enum event_signals {
+    HEARTBEAT_SIG = USER_SIG,
+};
+
+typedef struct {
+    co_t super;
+    QueueHandle_t rx;               /* bytes received on this line */
+    uint8_t byte;                   /* last byte received */
+    uint8_t len;                    /* bytes in line[] */
+    uint8_t line[LINE_MAX];
+} line_co_t;
+
+typedef struct {
+    co_t super;
+    uint32_t lines;                 /* complete lines seen since the last beat */
+} heartbeat_co_t;
+
+static co_sched_t protocol_sched;
+static line_co_t line_co[LINE_HANDLERS];
+static heartbeat_co_t heartbeat_co;
+static co_t button_co;
+static time_event_t heartbeat_te;
+
+static StaticQueue_t line_queue_cb[LINE_HANDLERS];
+static uint8_t line_queue_buffer[LINE_HANDLERS][16];
+
+static StackType_t protocol_stack[configMINIMAL_STACK_SIZE];   /* one stack for every handler */
+static event_t *protocol_queue[8];
+
+static void line_handler(co_t * const co)
+{
+    line_co_t * const me = (line_co_t *)co;
+
+    CO_BEGIN(co);
+    for (;;) {
+        me->len = 0U;
+
+        /* a line must complete within a second, or it is dropped */
+        do {
+            CO_AWAIT_QUEUE(co, me->rx, &me->byte, pdMS_TO_TICKS(1000));
+            if (CO_TIMED_OUT(co)) {
+                break;
+            }
+            if (me->len < LINE_MAX) {
+                me->line[me->len++] = me->byte;
+            }
+        } while (me->byte != '\r');
+
+        if (!CO_TIMED_OUT(co)) {
+            /* parse me->line here, the coroutines share one task */
+            heartbeat_co.lines++;
+        }
+    }
+    CO_END(co);
+}
+
+static void heartbeat(co_t * const co)
+{
+    heartbeat_co_t * const me = (heartbeat_co_t *)co;
+
+    CO_BEGIN(co);
+    time_event_arm(&heartbeat_te, 1000U);
+    for (;;) {
+        /* the heartbeat time event is posted to the scheduler like any event */
+        CO_AWAIT_EVENT(co, HEARTBEAT_SIG, portMAX_DELAY);
+        // toggle the LED, report me->lines
+        me->lines = 0U;
+    }
+    CO_END(co);
+}
+
+static void button(co_t * const co)
+{
+    CO_BEGIN(co);
+    for (;;) {
+        CO_AWAIT_NOTIFY(co, portMAX_DELAY);
+        /* debounce: ignore the presses of the next 50 ms */
+        CO_AWAIT_DELAY(co, pdMS_TO_TICKS(50));
+        taskENTER_CRITICAL();
+        co->notify_bits = 0U;
+        taskEXIT_CRITICAL();
+    }
+    CO_END(co);
+}
+
+/* the receive interrupt of line n */
+void line_rxFromISR(uint32_t n, uint8_t byte)
+{
+    BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+
+    (void)co_queue_sendFromISR(&protocol_sched, line_co[n].rx, &byte, &xHigherPriorityTaskWoken);
+    portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
+}
+
+/* the button interrupt */
+void button_pressedFromISR(void)
+{
+    BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+
+    co_notifyFromISR(&button_co, 1U, &xHigherPriorityTaskWoken);
+    portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
+}
+
+/* the main function =======================================================*/
+int main() {
+    uint32_t n;
+
+    BSP_init(); /* initialize the BSP */
+
+    for (n = 0U; n < LINE_HANDLERS; n++) {
+        line_co[n].rx = xQueueCreateStatic(sizeof(line_queue_buffer[n]), 1U, line_queue_buffer[n], &line_queue_cb[n]);
+        co_spawn(&protocol_sched, &line_co[n].super, &line_handler);
+    }
+    co_spawn(&protocol_sched, &heartbeat_co.super, &heartbeat);
+    co_spawn(&protocol_sched, &button_co, &button);
+
+    heartbeat_te.type = TYPE_PERIODIC;
+    time_event_init(&heartbeat_te, HEARTBEAT_SIG, &protocol_sched.super);
+
+    event_loop_args_t loop_args = {
+        1U,
+        protocol_queue,
+        sizeof(protocol_queue)/sizeof(protocol_queue[0]),
+        protocol_stack,
+        sizeof(protocol_stack),
+        0U
+    };
+    co_sched_start(&protocol_sched, &loop_args);
+
+    vTaskStartScheduler(); /* start the FreeRTOS scheduler... */
+
+    return 0; /* NOTE: the scheduler does NOT return */
+}
@@ -1,5 +1,6 @@
 
 #include "Event.h" /* Free Active Object interface */
+#include "object_registry.h"
 
 /*..........................................................................*/
 void event_loop_init(event_loop_handle_t * const me, dispatch_handler dispatch) {
@@ -55,6 +56,11 @@ void event_loop_start(event_loop_handle_t * const me, event_loop_args_t * loop_a
                                    &me->thread_cb);                         // task control block 
 
     configASSERT(me->thread);       
+
+#if ( configUSE_OBJECT_REGISTRY == 1 )
+    /* list the queue as the event loop in the object registry, under the thread name */
+    (void)xObjectRegistryDescribe(me->queue, registryTYPE_EVENT_LOOP, pcTaskGetName(me->thread));
+#endif
 }
 
 /*..........................................................................*/
@@ -81,6 +87,9 @@ static void time_event_callback(TimerHandle_t xTimer);
 void time_event_init(time_event_t * const me, signal_t sig, event_loop_handle_t *loop_handle) {
     me->super.sig = sig;
     me->loop_handle = loop_handle;
+#if ( configUSE_MONOTONIC_CLOCK == 1 )
+    me->fired_ns = 0U;
+#endif
 
     /* Create a timer object */
     me->timer = xTimerCreateStatic("TE", 1U, me->type, me, time_event_callback, &me->timer_cb);
@@ -141,6 +150,12 @@ static void time_event_callback(TimerHandle_t xTimer) {
     /* Also can use pvTimerGetTimerID(xTimer) */
     time_event_t * const t = GET_TIME_EVENT_HEAD(xTimer);
 
+#if ( configUSE_MONOTONIC_CLOCK == 1 )
+    /* Stamped before posting so the dispatch handler can tell how long
+     * the event waited in the queue */
+    t->fired_ns = ullPortGetClockNs();
+#endif
+
     /* Callback always called from non-interrupt context so no need
      * to check xPortIsInsideInterrupt
      */
@@ -70,6 +70,9 @@ typedef struct {
     TimerHandle_t timer;                     // private timer handle 
     StaticTimer_t timer_cb;                  // timer control-block (FreeRTOS static alloc) 
     timer_type_t  type;                      // timer type, periodic or one-shot 
+#if ( configUSE_MONOTONIC_CLOCK == 1 )
+    uint64_t fired_ns;                       // monotonic clock when the timer last fired 
+#endif
 } time_event_t;
 
 void time_event_init(time_event_t * const me, signal_t sig, event_loop_handle_t *loop_handle);
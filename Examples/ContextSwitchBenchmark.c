@@ -0,0 +1,106 @@
+#include "main.h"
+#include "FreeRTOS.h"
+#include "task.h"
+
+/*
+    Measures the cost of taskYIELD() on the Cortex-M3 port, from the task's
+    point of view and inside the PendSV handler.  Build with
+    configUSE_CONTEXT_SWITCH_STATS set to 1, once with
+    configUSE_LAZY_CONTEXT_SWITCH set to 0 and once with it set to 1, and read
+    the results in the debugger once xBenchmarkDone is pdTRUE.  The difference
+    between the two builds is the gain of the lazy context switch.
+
+    Same task: the benchmark task is the only task of its priority, so each
+    yield pends PendSV, which selects the same task again.  This is the case
+    the lazy context switch returns from without saving or restoring r4-r11.
+
+    Switch: a partner task of the same priority yields straight back, so each
+    yield of the benchmark task is two context switches, which are timed
+    together and halved.
+
+    The task side figures are averages over benchITERATIONS yields and include
+    the exception entry and exit and the odd tick interrupt.  The PendSV side
+    figures come from vPortGetContextSwitchStats() and only cover the handler.
+*/
+
+#define benchITERATIONS     10000
+
+/* Task side average cycles per yield, and per switch. */
+volatile uint32_t ulSameTaskYieldCycles;
+volatile uint32_t ulSwitchCycles;
+volatile BaseType_t xBenchmarkDone = pdFALSE;
+
+/* PendSV side times of each phase. */
+PortContextSwitchStats_t xSameTaskStats;
+PortContextSwitchStats_t xSwitchStats;
+
+static TaskHandle_t xPartnerTask;
+
+static void prvPartnerTask( void *pvParameters )
+{
+    ( void ) pvParameters;
+
+    for( ;; )
+    {
+        taskYIELD();
+    }
+}
+
+static void prvBenchmarkTask( void *pvParameters )
+{
+    uint32_t ulStart;
+    uint32_t i;
+
+    ( void ) pvParameters;
+
+    /* Enable the DWT cycle counter. */
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CYCCNT = 0;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
+    /* The partner is suspended, this task is alone at its priority. */
+    vPortResetContextSwitchStats();
+    ulStart = DWT->CYCCNT;
+
+    for( i = 0; i < benchITERATIONS; i++ )
+    {
+        taskYIELD();
+    }
+
+    ulSameTaskYieldCycles = ( DWT->CYCCNT - ulStart ) / benchITERATIONS;
+    vPortGetContextSwitchStats( &xSameTaskStats );
+
+    /* Each yield now runs the partner, which yields back. */
+    vTaskResume( xPartnerTask );
+    vPortResetContextSwitchStats();
+    ulStart = DWT->CYCCNT;
+
+    for( i = 0; i < benchITERATIONS; i++ )
+    {
+        taskYIELD();
+    }
+
+    ulSwitchCycles = ( DWT->CYCCNT - ulStart ) / ( benchITERATIONS * 2 );
+    vPortGetContextSwitchStats( &xSwitchStats );
+    vTaskSuspend( xPartnerTask );
+
+    xBenchmarkDone = pdTRUE;
+
+    for( ;; )
+    {
+        vTaskDelay( portMAX_DELAY );
+    }
+}
+
+int main( void )
+{
+    HAL_Init();
+
+    xTaskCreate( prvBenchmarkTask, "Bench", configMINIMAL_STACK_SIZE, NULL, tskIDLE_PRIORITY + 2, NULL );
+    xTaskCreate( prvPartnerTask, "Partner", configMINIMAL_STACK_SIZE, NULL, tskIDLE_PRIORITY + 2, &xPartnerTask );
+    vTaskSuspend( xPartnerTask );
+
+    vTaskStartScheduler();
+
+    for( ;; );
+}
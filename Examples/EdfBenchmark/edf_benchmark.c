@@ -0,0 +1,339 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "FreeRTOS.h"
+#include "task.h"
+
+/*
+    Host side benchmark comparing how many random periodic task sets meet all
+    their deadlines under rate monotonic priorities and under the earliest
+    deadline first class of tasks.c.  Build and run it on the development
+    machine with "make run" from this directory, it does not run on the target.
+
+    The kernel is the real tasks.c, but no task code ever runs: the port layer
+    in host/ only records that a yield was requested, and the main loop below
+    plays the part of the tick interrupt and of the tasks.  Each tick the
+    running task consumes one tick of its job, xTaskIncrementTick() is called,
+    a task whose job is done calls vTaskWaitForNextPeriod() as it would on the
+    target, and vTaskSwitchContext() picks the next task when the kernel asks
+    for a switch.  The decisions are therefore exactly the ones the scheduler
+    takes on the Blue Pill.
+
+    For each total utilisation from 0.60 to 1.00 benchSETS task sets of
+    benchTASKS tasks are drawn with UUniFast, with periods between
+    benchMIN_PERIOD and benchMAX_PERIOD ticks and deadlines equal to the
+    periods.  Every set runs twice, once with one priority per task by period
+    (rate monotonic) and once with all the tasks at configEDF_PRIORITY, and is
+    counted as schedulable if no job misses its deadline in benchHORIZON
+    ticks.  Rate monotonic is only guaranteed up to the Liu and Layland bound,
+    EDF up to a utilisation of 1.
+*/
+
+#define benchTASKS          5
+#define benchSETS           200
+#define benchMIN_PERIOD     10
+#define benchMAX_PERIOD     100
+#define benchHORIZON        4000
+#define benchSEED           0x2545F491UL
+
+/* Utilisations are in hundredths. */
+#define benchMIN_UTILISATION    60
+#define benchMAX_UTILISATION    100
+#define benchUTILISATION_STEP   5
+
+typedef struct
+{
+    TickType_t xPeriod;
+    TickType_t xCost;
+    TickType_t xRemaining;      /* Ticks left in the current job. */
+    TaskHandle_t xHandle;
+    StaticTask_t xTCB;
+    StackType_t xStack[ configMINIMAL_STACK_SIZE ];
+} BenchTask_t;
+
+typedef enum
+{
+    eRateMonotonic,
+    eEarliestDeadlineFirst
+} Policy_t;
+
+volatile BaseType_t xPortYieldRequested = pdFALSE;
+
+static BenchTask_t xTasks[ benchTASKS ];
+static uint32_t ulSeed = benchSEED;
+
+static StaticTask_t xIdleTaskTCB;
+static StackType_t xIdleTaskStack[ configMINIMAL_STACK_SIZE ];
+
+/* Schedulable sets for each utilisation and policy. */
+static uint32_t ulSchedulable[ 2 ][ ( benchMAX_UTILISATION - benchMIN_UTILISATION ) / benchUTILISATION_STEP + 1 ];
+
+/* The tasks never run, the main loop accounts for their execution. */
+static void prvTask( void *pvParameters )
+{
+    ( void ) pvParameters;
+}
+
+StackType_t *pxPortInitialiseStack( StackType_t *pxTopOfStack, TaskFunction_t pxCode, void *pvParameters )
+{
+    ( void ) pxCode;
+    ( void ) pvParameters;
+    return pxTopOfStack;
+}
+
+void vPortEndScheduler( void )
+{
+}
+
+void vApplicationGetIdleTaskMemory( StaticTask_t **ppxIdleTaskTCBBuffer,
+                                    StackType_t **ppxIdleTaskStackBuffer,
+                                    uint32_t *pulIdleTaskStackSize )
+{
+    *ppxIdleTaskTCBBuffer = &xIdleTaskTCB;
+    *ppxIdleTaskStackBuffer = xIdleTaskStack;
+    *pulIdleTaskStackSize = configMINIMAL_STACK_SIZE;
+}
+
+static uint32_t prvRandom( void )
+{
+    /* xorshift32, so the sequence is the same on every host. */
+    ulSeed ^= ulSeed << 13;
+    ulSeed ^= ulSeed >> 17;
+    ulSeed ^= ulSeed << 5;
+    return ulSeed;
+}
+
+static double prvRandomUnit( void )
+{
+    return ( double ) prvRandom() / 4294967296.0;
+}
+
+/* Draws a task set whose utilisation, once the costs are rounded to whole
+   ticks, is within half a step of ulUtilisation hundredths and no more than 1.
+   Returns the utilisation of the set. */
+static double prvGenerateSet( uint32_t ulUtilisation )
+{
+    double dTarget = ulUtilisation / 100.0;
+    double dSum, dNext, dTotal;
+    int i;
+
+    for( ;; )
+    {
+        dSum = dTarget;
+        dTotal = 0.0;
+
+        /* UUniFast: utilisations uniformly distributed over the simplex. */
+        for( i = 0; i < benchTASKS; i++ )
+        {
+            double dTaskUtilisation;
+
+            if( i < benchTASKS - 1 )
+            {
+                dNext = dSum * pow( prvRandomUnit(), 1.0 / ( benchTASKS - 1 - i ) );
+                dTaskUtilisation = dSum - dNext;
+                dSum = dNext;
+            }
+            else
+            {
+                dTaskUtilisation = dSum;
+            }
+
+            xTasks[ i ].xPeriod = benchMIN_PERIOD + prvRandom() % ( benchMAX_PERIOD - benchMIN_PERIOD + 1 );
+            xTasks[ i ].xCost = ( TickType_t ) lround( dTaskUtilisation * xTasks[ i ].xPeriod );
+
+            if( xTasks[ i ].xCost == 0 )
+            {
+                xTasks[ i ].xCost = 1;
+            }
+
+            dTotal += ( double ) xTasks[ i ].xCost / xTasks[ i ].xPeriod;
+        }
+
+        if( ( dTotal <= 1.0 ) && ( fabs( dTotal - dTarget ) <= benchUTILISATION_STEP / 200.0 ) )
+        {
+            return dTotal;
+        }
+    }
+}
+
+static BenchTask_t *prvFindTask( TaskHandle_t xHandle )
+{
+    int i;
+
+    for( i = 0; i < benchTASKS; i++ )
+    {
+        if( xTasks[ i ].xHandle == xHandle )
+        {
+            return &xTasks[ i ];
+        }
+    }
+
+    /* The idle task. */
+    return NULL;
+}
+
+/* Runs the current set under xPolicy and returns the number of missed
+   deadlines, jobs still running past their deadline at the end included. */
+static uint32_t prvRunSet( Policy_t xPolicy )
+{
+    TaskPeriodStats_t xStats;
+    BenchTask_t *pxTask;
+    UBaseType_t uxPriority;
+    BaseType_t xSwitchRequired;
+    uint32_t ulMisses = 0;
+    TickType_t xTick;
+    int i, j;
+
+    for( i = 0; i < benchTASKS; i++ )
+    {
+        if( xPolicy == eEarliestDeadlineFirst )
+        {
+            uxPriority = configEDF_PRIORITY;
+        }
+        else
+        {
+            /* Rate monotonic, above the EDF class: the shorter the period
+               the higher the priority, ties broken by position. */
+            uxPriority = configMAX_PRIORITIES - 1;
+
+            for( j = 0; j < benchTASKS; j++ )
+            {
+                if( ( xTasks[ j ].xPeriod < xTasks[ i ].xPeriod ) ||
+                    ( ( xTasks[ j ].xPeriod == xTasks[ i ].xPeriod ) && ( j < i ) ) )
+                {
+                    uxPriority--;
+                }
+            }
+        }
+
+        xTasks[ i ].xRemaining = xTasks[ i ].xCost;
+        xTasks[ i ].xHandle = xTaskCreateStatic( prvTask, "Bench", configMINIMAL_STACK_SIZE, NULL, uxPriority,
+                                                 xTasks[ i ].xStack, &xTasks[ i ].xTCB );
+    }
+
+    /* Every first job is released on the same tick, the worst case. */
+    for( i = 0; i < benchTASKS; i++ )
+    {
+        vTaskSetPeriod( xTasks[ i ].xHandle, xTasks[ i ].xPeriod, 0 );
+    }
+
+    xPortYieldRequested = pdFALSE;
+    vTaskSwitchContext();
+
+    for( xTick = 0; xTick < benchHORIZON; xTick++ )
+    {
+        pxTask = prvFindTask( xTaskGetCurrentTaskHandle() );
+
+        if( pxTask != NULL )
+        {
+            pxTask->xRemaining--;
+        }
+
+        xSwitchRequired = xTaskIncrementTick();
+
+        /* The task that ran in the tick just ended finishes its job. */
+        if( ( pxTask != NULL ) && ( pxTask->xRemaining == 0 ) )
+        {
+            pxTask->xRemaining = pxTask->xCost;
+            vTaskWaitForNextPeriod();
+        }
+
+        if( ( xSwitchRequired != pdFALSE ) || ( xPortYieldRequested != pdFALSE ) )
+        {
+            xPortYieldRequested = pdFALSE;
+            vTaskSwitchContext();
+        }
+    }
+
+    for( i = 0; i < benchTASKS; i++ )
+    {
+        vTaskGetPeriodStats( xTasks[ i ].xHandle, &xStats );
+        ulMisses += xStats.ulDeadlineMisses;
+
+        if( ( xTasks[ i ].xRemaining != xTasks[ i ].xCost ) &&
+            ( ( int32_t ) ( xTaskGetTickCount() - xStats.xAbsoluteDeadline ) > 0 ) )
+        {
+            ulMisses++;
+        }
+    }
+
+    /* Leave the idle task running so every task of the set can be deleted. */
+    for( i = 0; i < benchTASKS; i++ )
+    {
+        vTaskSuspend( xTasks[ i ].xHandle );
+    }
+
+    xPortYieldRequested = pdFALSE;
+    vTaskSwitchContext();
+
+    for( i = 0; i < benchTASKS; i++ )
+    {
+        vTaskDelete( xTasks[ i ].xHandle );
+        xTasks[ i ].xHandle = NULL;
+    }
+
+    return ulMisses;
+}
+
+BaseType_t xPortStartScheduler( void )
+{
+    uint32_t ulUtilisation, ulSet;
+    size_t xBin;
+
+    for( ulUtilisation = benchMIN_UTILISATION; ulUtilisation <= benchMAX_UTILISATION; ulUtilisation += benchUTILISATION_STEP )
+    {
+        xBin = ( ulUtilisation - benchMIN_UTILISATION ) / benchUTILISATION_STEP;
+
+        for( ulSet = 0; ulSet < benchSETS; ulSet++ )
+        {
+            ( void ) prvGenerateSet( ulUtilisation );
+
+            if( prvRunSet( eRateMonotonic ) == 0 )
+            {
+                ulSchedulable[ eRateMonotonic ][ xBin ]++;
+            }
+
+            if( prvRunSet( eEarliestDeadlineFirst ) == 0 )
+            {
+                ulSchedulable[ eEarliestDeadlineFirst ][ xBin ]++;
+            }
+        }
+    }
+
+    /* Back to main() rather than into the first task. */
+    return pdFALSE;
+}
+
+int main( void )
+{
+    uint32_t ulUtilisation;
+    size_t xBin;
+
+    printf( "%u tasks, periods %u-%u ticks, deadline = period, %u sets per utilisation, %u ticks each\n",
+            ( unsigned ) benchTASKS,
+            ( unsigned ) benchMIN_PERIOD,
+            ( unsigned ) benchMAX_PERIOD,
+            ( unsigned ) benchSETS,
+            ( unsigned ) benchHORIZON );
+    printf( "rate monotonic bound %.3f\n", benchTASKS * ( pow( 2.0, 1.0 / benchTASKS ) - 1.0 ) );
+
+    vTaskStartScheduler();
+
+    printf( "  U      RM     EDF  (schedulable sets)\n" );
+
+    for( ulUtilisation = benchMIN_UTILISATION; ulUtilisation <= benchMAX_UTILISATION; ulUtilisation += benchUTILISATION_STEP )
+    {
+        xBin = ( ulUtilisation - benchMIN_UTILISATION ) / benchUTILISATION_STEP;
+
+        printf( "  %u.%02u  %5.1f%%  %5.1f%%\n",
+                ( unsigned ) ( ulUtilisation / 100 ),
+                ( unsigned ) ( ulUtilisation % 100 ),
+                100.0 * ulSchedulable[ eRateMonotonic ][ xBin ] / benchSETS,
+                100.0 * ulSchedulable[ eEarliestDeadlineFirst ][ xBin ] / benchSETS );
+    }
+
+    printf( "final tick count 0x%08x\n", ( unsigned ) xTaskGetTickCount() );
+
+    return 0;
+}
@@ -0,0 +1,35 @@
+#ifndef FREERTOS_CONFIG_H
+#define FREERTOS_CONFIG_H
+
+/* Host build configuration for the EDF benchmark.  The scheduler runs with
+   the priorities of the Blue Pill build, the rest takes the kernel
+   defaults. */
+
+#include <assert.h>
+
+#define configUSE_PREEMPTION                     1
+#define configUSE_PORT_OPTIMISED_TASK_SELECTION  1
+#define configSUPPORT_STATIC_ALLOCATION          1
+#define configSUPPORT_DYNAMIC_ALLOCATION         0
+#define configUSE_IDLE_HOOK                      0
+#define configUSE_TICK_HOOK                      0
+#define configTICK_RATE_HZ                       ((TickType_t)1000)
+#define configMAX_PRIORITIES                     ( 7 )
+#define configMINIMAL_STACK_SIZE                 ((uint16_t)64)
+#define configMAX_TASK_NAME_LEN                  ( 16 )
+#define configUSE_16_BIT_TICKS                   0
+#define configUSE_MUTEXES                        1
+#define configUSE_TIMERS                         0
+#define configUSE_EDF_SCHEDULING                 1
+#define configEDF_PRIORITY                       1
+
+/* Start close to the end of the tick range so the run crosses an overflow. */
+#define configINITIAL_TICK_COUNT                 ( ( TickType_t ) 0xFFFF0000UL )
+
+#define INCLUDE_vTaskDelete                      1
+#define INCLUDE_vTaskSuspend                     1
+#define INCLUDE_xTaskGetCurrentTaskHandle        1
+
+#define configASSERT( x ) assert( x )
+
+#endif /* FREERTOS_CONFIG_H */
@@ -0,0 +1,45 @@
+/* Port layer that lets the scheduler run on the host without running the
+   tasks: yields only record that the benchmark has to call
+   vTaskSwitchContext(), see edf_benchmark.c. */
+#ifndef PORTMACRO_H
+#define PORTMACRO_H
+#include <stdint.h>
+#define portCHAR char
+#define portFLOAT float
+#define portDOUBLE double
+#define portLONG long
+#define portSHORT short
+#define portSTACK_TYPE uint32_t
+#define portBASE_TYPE long
+typedef portSTACK_TYPE StackType_t;
+typedef long BaseType_t;
+typedef unsigned long UBaseType_t;
+typedef uint32_t TickType_t;
+#define portMAX_DELAY ( TickType_t ) 0xffffffffUL
+#define portTICK_TYPE_IS_ATOMIC 1
+#define portSTACK_GROWTH ( -1 )
+#define portTICK_PERIOD_MS ( ( TickType_t ) 1000 / configTICK_RATE_HZ )
+#define portBYTE_ALIGNMENT 8
+extern volatile BaseType_t xPortYieldRequested;
+#define portYIELD() ( xPortYieldRequested = 1 )
+#define portYIELD_WITHIN_API() portYIELD()
+#define portEND_SWITCHING_ISR( x ) do { if( x ) { portYIELD(); } } while( 0 )
+#define portYIELD_FROM_ISR( x ) portEND_SWITCHING_ISR( x )
+#define portSET_INTERRUPT_MASK_FROM_ISR() 0
+#define portCLEAR_INTERRUPT_MASK_FROM_ISR( x ) (void)(x)
+#define portDISABLE_INTERRUPTS()
+#define portENABLE_INTERRUPTS()
+#define portENTER_CRITICAL()
+#define portEXIT_CRITICAL()
+#define portTASK_FUNCTION_PROTO( vFunction, pvParameters ) void vFunction( void * pvParameters )
+#define portTASK_FUNCTION( vFunction, pvParameters ) void vFunction( void * pvParameters )
+#define portNOP()
+#define portINLINE __inline
+#define portFORCE_INLINE inline __attribute__( ( always_inline ) )
+#define portMEMORY_BARRIER()
+#define portPOINTER_SIZE_TYPE uintptr_t
+#define portRECORD_READY_PRIORITY( uxPriority, uxReadyPriorities ) ( uxReadyPriorities ) |= ( 1UL << ( uxPriority ) )
+#define portRESET_READY_PRIORITY( uxPriority, uxReadyPriorities ) ( uxReadyPriorities ) &= ~( 1UL << ( uxPriority ) )
+#define portGET_HIGHEST_PRIORITY( uxTopPriority, uxReadyPriorities ) uxTopPriority = ( 31UL - ( uint32_t ) __builtin_clz( ( uxReadyPriorities ) ) )
+static inline BaseType_t xPortIsInsideInterrupt(void){return 0;}
+#endif
@@ -0,0 +1,165 @@
+#include "main.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include "event_groups.h"
+#include "event_groups64.h"
+
+/*
+    Compares the latency from an interrupt setting event bits to the waiting
+    task running, for a standard event group, where xEventGroupSetBitsFromISR()
+    passes the work to the timer daemon task, and for a wide event group, where
+    xEventGroup64SetBitsFromISR() wakes the task itself.  Build with
+    configUSE_EVENT_GROUPS_64 and INCLUDE_xTimerPendFunctionCall set to 1 and
+    read the results in the debugger once xBenchmarkDone is pdTRUE.
+
+    The interrupt is EXTI0, pended from software so no pin is involved.  The
+    cycles are counted from the first instruction of the handler to the return
+    from the wait in the woken task.  ulIsrCycles[] holds the time spent in the
+    handler itself, which for the wide event group includes the wake.
+
+    The woken task runs at tskIDLE_PRIORITY + 2, below the daemon task, as most
+    application tasks do.  The deferred latency therefore includes the daemon
+    task queue send, a switch to the daemon task and a second switch to the
+    woken task.
+*/
+
+#define benchITERATIONS     200
+#define benchEVENT_BIT      ( 1UL << 0 )
+#define benchIRQn           EXTI0_IRQn
+
+typedef enum
+{
+    eBenchDeferred = 0,
+    eBenchDirect,
+    eBenchNumPaths
+} BenchPath_t;
+
+/* Results, indexed by BenchPath_t. */
+volatile uint32_t ulAverageLatencyCycles[ eBenchNumPaths ];
+volatile uint32_t ulWorstLatencyCycles[ eBenchNumPaths ];
+volatile uint32_t ulIsrCycles[ eBenchNumPaths ];
+volatile BaseType_t xBenchmarkDone = pdFALSE;
+
+static EventGroupHandle_t xEventGroup;
+static EventGroup64Handle_t xEventGroup64;
+
+static TaskHandle_t xBenchmarkTask;
+static volatile BenchPath_t eCurrentPath;
+static volatile uint32_t ulIsrEntry;
+static volatile uint32_t ulLatency;
+
+void EXTI0_IRQHandler( void )
+{
+    BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+    uint32_t ulEntry = DWT->CYCCNT;
+
+    ulIsrEntry = ulEntry;
+
+    if( eCurrentPath == eBenchDeferred )
+    {
+        xEventGroupSetBitsFromISR( xEventGroup, benchEVENT_BIT, &xHigherPriorityTaskWoken );
+    }
+    else
+    {
+        xEventGroup64SetBitsFromISR( xEventGroup64, benchEVENT_BIT, &xHigherPriorityTaskWoken );
+    }
+
+    ulIsrCycles[ eCurrentPath ] = DWT->CYCCNT - ulEntry;
+
+    portYIELD_FROM_ISR( xHigherPriorityTaskWoken );
+}
+
+static void prvWaitingTask( void *pvParameters )
+{
+    ( void ) pvParameters;
+
+    for( ;; )
+    {
+        if( eCurrentPath == eBenchDeferred )
+        {
+            xEventGroupWaitBits( xEventGroup, benchEVENT_BIT, pdTRUE, pdFALSE, portMAX_DELAY );
+        }
+        else
+        {
+            xEventGroup64WaitBits( xEventGroup64, benchEVENT_BIT, pdTRUE, pdFALSE, portMAX_DELAY );
+        }
+
+        ulLatency = DWT->CYCCNT - ulIsrEntry;
+
+        xTaskNotifyGive( xBenchmarkTask );
+    }
+}
+
+static void prvBenchmarkTask( void *pvParameters )
+{
+    uint32_t ulTotal, ulWorst;
+    uint32_t i;
+    BenchPath_t ePath;
+
+    ( void ) pvParameters;
+
+    /* Enable the DWT cycle counter. */
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CYCCNT = 0;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
+    HAL_NVIC_SetPriority( benchIRQn, configLIBRARY_MAX_SYSCALL_INTERRUPT_PRIORITY + 1, 0 );
+    HAL_NVIC_EnableIRQ( benchIRQn );
+
+    for( ePath = eBenchDeferred; ePath < eBenchNumPaths; ePath++ )
+    {
+        ulTotal = 0;
+        ulWorst = 0;
+
+        /* The waiting task is still blocked on the standard group, release it
+           so it starts waiting on the wide one. */
+        if( ePath != eCurrentPath )
+        {
+            eCurrentPath = ePath;
+            xEventGroupSetBits( xEventGroup, benchEVENT_BIT );
+            ulTaskNotifyTake( pdTRUE, portMAX_DELAY );
+        }
+
+        for( i = 0; i < benchITERATIONS; i++ )
+        {
+            HAL_NVIC_SetPendingIRQ( benchIRQn );
+
+            ulTaskNotifyTake( pdTRUE, portMAX_DELAY );
+
+            ulTotal += ulLatency;
+
+            if( ulLatency > ulWorst )
+            {
+                ulWorst = ulLatency;
+            }
+        }
+
+        ulAverageLatencyCycles[ ePath ] = ulTotal / benchITERATIONS;
+        ulWorstLatencyCycles[ ePath ] = ulWorst;
+    }
+
+    HAL_NVIC_DisableIRQ( benchIRQn );
+
+    xBenchmarkDone = pdTRUE;
+
+    for( ;; )
+    {
+        vTaskDelay( portMAX_DELAY );
+    }
+}
+
+int main( void )
+{
+    HAL_Init();
+
+    xEventGroup = xEventGroupCreate();
+    xEventGroup64 = xEventGroup64Create();
+    configASSERT( xEventGroup && xEventGroup64 );
+
+    xTaskCreate( prvBenchmarkTask, "Bench", configMINIMAL_STACK_SIZE * 2, NULL, tskIDLE_PRIORITY + 1, &xBenchmarkTask );
+    xTaskCreate( prvWaitingTask, "Wait", configMINIMAL_STACK_SIZE, NULL, tskIDLE_PRIORITY + 2, NULL );
+
+    vTaskStartScheduler();
+
+    for( ;; );
+}
@@ -0,0 +1,262 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "FreeRTOS.h"
+#include "task.h"
+
+/*
+    Host side benchmark comparing the allocation latency of heap_4.c and
+    heap_tlsf.c.  Build and run it on the development machine with "make run"
+    from this directory, it does not run on the target.
+
+    Both heaps replay the same random sequence of allocations and frees.  The
+    sizes are a mix of many small blocks (queue items, timers, event groups),
+    fewer medium blocks (TCBs, queue storage) and a few large ones (task
+    stacks), scaled to the heap size.  Up to benchLIVE_SLOTS blocks are live at
+    once, and the target number of live blocks drifts up and down so the heap
+    goes through phases of filling and draining, which is what fragments
+    heap_4's free list.
+
+    Every call is timed on its own and the latency distribution of pvPortMalloc()
+    and vPortFree() is printed for each heap, together with the number of
+    failed allocations and the state of the free space at the end.  The times
+    include the cost of reading the clock, which is measured and printed too.
+*/
+
+#define benchOPERATIONS     200000
+#define benchLIVE_SLOTS     64
+#define benchSEED           0x2545F491UL
+
+typedef struct
+{
+    const char *pcName;
+    void *( *pvMalloc )( size_t xSize );
+    void ( *vFree )( void *pv );
+    void ( *vGetHeapStats )( HeapStats_t *pxHeapStats );
+} Heap_t;
+
+typedef struct
+{
+    uint32_t *pulMallocNs;
+    uint32_t *pulFreeNs;
+    uint32_t ulMallocs;
+    uint32_t ulFrees;
+    uint32_t ulFailures;
+} Results_t;
+
+/* The renamed APIs of the two heaps, see the Makefile. */
+void *pvHeap4Malloc( size_t xSize );
+void vHeap4Free( void *pv );
+void vHeap4GetHeapStats( HeapStats_t *pxHeapStats );
+void *pvTlsfMalloc( size_t xSize );
+void vTlsfFree( void *pv );
+void vTlsfGetHeapStats( HeapStats_t *pxHeapStats );
+
+static const Heap_t xHeaps[] =
+{
+    { "heap_4",    pvHeap4Malloc, vHeap4Free, vHeap4GetHeapStats },
+    { "heap_tlsf", pvTlsfMalloc,  vTlsfFree,  vTlsfGetHeapStats  },
+};
+
+/* The heaps only ever run from one thread here. */
+void vTaskSuspendAll( void )
+{
+}
+
+BaseType_t xTaskResumeAll( void )
+{
+    return pdFALSE;
+}
+
+static uint32_t prvRandom( uint32_t *pulState )
+{
+    /* xorshift32, so the sequence is the same on every host. */
+    *pulState ^= *pulState << 13;
+    *pulState ^= *pulState >> 17;
+    *pulState ^= *pulState << 5;
+    return *pulState;
+}
+
+static size_t prvRandomSize( uint32_t *pulState )
+{
+    uint32_t ulClass = prvRandom( pulState ) % 100U;
+    size_t xScale = configTOTAL_HEAP_SIZE / 3072U;
+
+    if( xScale == 0U )
+    {
+        xScale = 1U;
+    }
+
+    if( ulClass < 70U )
+    {
+        return 8U + ( prvRandom( pulState ) % 56U );
+    }
+    else if( ulClass < 95U )
+    {
+        return ( 64U + ( prvRandom( pulState ) % 192U ) ) * xScale;
+    }
+    else
+    {
+        return ( 256U + ( prvRandom( pulState ) % 512U ) ) * xScale;
+    }
+}
+
+static uint64_t prvNow( void )
+{
+    struct timespec xTime;
+
+    clock_gettime( CLOCK_MONOTONIC, &xTime );
+    return ( ( uint64_t ) xTime.tv_sec * 1000000000ULL ) + ( uint64_t ) xTime.tv_nsec;
+}
+
+static void prvRun( const Heap_t *pxHeap, Results_t *pxResults )
+{
+    void *pvLive[ benchLIVE_SLOTS ] = { NULL };
+    uint32_t ulState = benchSEED;
+    uint32_t ulLive = 0, ulTarget = benchLIVE_SLOTS / 2;
+    uint32_t i, ulSlot;
+    uint64_t ullStart, ullEnd;
+    void *pv;
+
+    for( i = 0; i < benchOPERATIONS; i++ )
+    {
+        /* Let the target number of live blocks wander. */
+        if( ( prvRandom( &ulState ) % 1000U ) == 0U )
+        {
+            ulTarget = 1U + ( prvRandom( &ulState ) % benchLIVE_SLOTS );
+        }
+
+        ulSlot = prvRandom( &ulState ) % benchLIVE_SLOTS;
+
+        if( pvLive[ ulSlot ] == NULL )
+        {
+            /* Allocate more often while below the target. */
+            if( ( ulLive < ulTarget ) || ( ( prvRandom( &ulState ) & 3U ) == 0U ) )
+            {
+                size_t xSize = prvRandomSize( &ulState );
+
+                ullStart = prvNow();
+                pv = pxHeap->pvMalloc( xSize );
+                ullEnd = prvNow();
+
+                pxResults->pulMallocNs[ pxResults->ulMallocs++ ] = ( uint32_t ) ( ullEnd - ullStart );
+
+                if( pv != NULL )
+                {
+                    /* Touch the block so a corrupted heap shows up. */
+                    memset( pv, ( int ) ulSlot, xSize );
+                    pvLive[ ulSlot ] = pv;
+                    ulLive++;
+                }
+                else
+                {
+                    pxResults->ulFailures++;
+                }
+            }
+        }
+        else
+        {
+            ullStart = prvNow();
+            pxHeap->vFree( pvLive[ ulSlot ] );
+            ullEnd = prvNow();
+
+            pxResults->pulFreeNs[ pxResults->ulFrees++ ] = ( uint32_t ) ( ullEnd - ullStart );
+            pvLive[ ulSlot ] = NULL;
+            ulLive--;
+        }
+    }
+
+    for( ulSlot = 0; ulSlot < benchLIVE_SLOTS; ulSlot++ )
+    {
+        if( pvLive[ ulSlot ] != NULL )
+        {
+            pxHeap->vFree( pvLive[ ulSlot ] );
+        }
+    }
+}
+
+static int prvCompare( const void *pv1, const void *pv2 )
+{
+    uint32_t ul1 = *( const uint32_t * ) pv1, ul2 = *( const uint32_t * ) pv2;
+
+    return ( ul1 > ul2 ) - ( ul1 < ul2 );
+}
+
+static void prvPrintDistribution( const char *pcLabel, uint32_t *pulNs, uint32_t ulCount )
+{
+    if( ulCount == 0U )
+    {
+        return;
+    }
+
+    qsort( pulNs, ulCount, sizeof( uint32_t ), prvCompare );
+
+    printf( "  %-8s n=%-7u p50=%-6u p90=%-6u p99=%-6u p99.9=%-6u max=%u ns\n",
+            pcLabel,
+            ( unsigned ) ulCount,
+            ( unsigned ) pulNs[ ulCount / 2U ],
+            ( unsigned ) pulNs[ ( ulCount * 90U ) / 100U ],
+            ( unsigned ) pulNs[ ( ulCount * 99U ) / 100U ],
+            ( unsigned ) pulNs[ ( ulCount * 999U ) / 1000U ],
+            ( unsigned ) pulNs[ ulCount - 1U ] );
+}
+
+int main( void )
+{
+    Results_t xResults;
+    HeapStats_t xStats;
+    uint64_t ullStart, ullOverhead = ~0ULL;
+    size_t x;
+    int i;
+
+    /* The cheapest back to back clock read is the floor of every figure. */
+    for( i = 0; i < 1000; i++ )
+    {
+        ullStart = prvNow();
+        ullStart = prvNow() - ullStart;
+
+        if( ullStart < ullOverhead )
+        {
+            ullOverhead = ullStart;
+        }
+    }
+
+    printf( "heap %u bytes, %u operations, clock overhead %u ns\n",
+            ( unsigned ) configTOTAL_HEAP_SIZE,
+            ( unsigned ) benchOPERATIONS,
+            ( unsigned ) ullOverhead );
+
+    xResults.pulMallocNs = malloc( benchOPERATIONS * sizeof( uint32_t ) );
+    xResults.pulFreeNs = malloc( benchOPERATIONS * sizeof( uint32_t ) );
+
+    if( ( xResults.pulMallocNs == NULL ) || ( xResults.pulFreeNs == NULL ) )
+    {
+        return 1;
+    }
+
+    for( x = 0; x < sizeof( xHeaps ) / sizeof( xHeaps[ 0 ] ); x++ )
+    {
+        xResults.ulMallocs = 0;
+        xResults.ulFrees = 0;
+        xResults.ulFailures = 0;
+
+        prvRun( &xHeaps[ x ], &xResults );
+        xHeaps[ x ].vGetHeapStats( &xStats );
+
+        printf( "%s\n", xHeaps[ x ].pcName );
+        prvPrintDistribution( "malloc", xResults.pulMallocNs, xResults.ulMallocs );
+        prvPrintDistribution( "free", xResults.pulFreeNs, xResults.ulFrees );
+        printf( "  failed allocations %u, minimum ever free %u bytes\n",
+                ( unsigned ) xResults.ulFailures,
+                ( unsigned ) xStats.xMinimumEverFreeBytesRemaining );
+        printf( "  after freeing everything: %u bytes free in %u block(s)\n",
+                ( unsigned ) xStats.xAvailableHeapSpaceInBytes,
+                ( unsigned ) xStats.xNumberOfFreeBlocks );
+    }
+
+    free( xResults.pulMallocNs );
+    free( xResults.pulFreeNs );
+
+    return 0;
+}
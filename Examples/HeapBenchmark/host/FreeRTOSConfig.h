@@ -0,0 +1,30 @@
+#ifndef FREERTOS_CONFIG_H
+#define FREERTOS_CONFIG_H
+
+/* Host build configuration for the heap benchmark.  Only what the heap
+   implementations need is defined, the rest takes the kernel defaults. */
+
+#include <assert.h>
+
+#ifndef HEAP_SIZE
+#define HEAP_SIZE   3072
+#endif
+
+#define configUSE_PREEMPTION                     1
+#define configSUPPORT_STATIC_ALLOCATION          0
+#define configSUPPORT_DYNAMIC_ALLOCATION         1
+#define configUSE_IDLE_HOOK                      0
+#define configUSE_TICK_HOOK                      0
+#define configTICK_RATE_HZ                       ((TickType_t)1000)
+#define configMAX_PRIORITIES                     ( 7 )
+#define configMINIMAL_STACK_SIZE                 ((uint16_t)128)
+#define configTOTAL_HEAP_SIZE                    ((size_t)HEAP_SIZE)
+#define configMAX_TASK_NAME_LEN                  ( 16 )
+#define configUSE_16_BIT_TICKS                   0
+#define configUSE_MUTEXES                        1
+#define configUSE_TIMERS                         0
+#define configTLSF_FL_INDEX_MAX                  24
+
+#define configASSERT( x ) assert( x )
+
+#endif /* FREERTOS_CONFIG_H */
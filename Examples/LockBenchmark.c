@@ -0,0 +1,212 @@
+#include "main.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include "semphr.h"
+#include "lwmutex.h"
+#include "rwlock.h"
+
+/*
+    Compares the queue based mutex of semphr.h with the lightweight mutex of
+    lwmutex.h and the two sides of the reader-writer lock of rwlock.h.  Build
+    with configUSE_LW_MUTEXES and configUSE_RW_LOCKS set to 1 and read the
+    results in the debugger once xBenchmarkDone is pdTRUE.
+
+    Uncontended: the average cycles of one take followed by one give, with no
+    other task interested in the lock.
+
+    Handoff: the benchmark task holds the lock and wakes the contender, which
+    runs at a higher priority, tries to take the lock, inherits its priority to
+    the benchmark task and blocks.  The cycles are counted from just before the
+    benchmark task gives the lock to the moment the contender returns from its
+    take, so they cover the give slow path, the priority disinheritance and the
+    context switch.
+
+    Contention statistics gathered along the way are left in xLwMutexStats and
+    xRWLockStats.
+*/
+
+#define benchITERATIONS     1000
+#define benchHANDOFFS       100
+
+typedef enum
+{
+    eBenchQueueMutex = 0,
+    eBenchLwMutex,
+    eBenchRWLockRead,
+    eBenchRWLockWrite,
+    eBenchNumLocks
+} BenchLock_t;
+
+/* Results, indexed by BenchLock_t. */
+volatile uint32_t ulUncontendedCycles[ eBenchNumLocks ];
+volatile uint32_t ulAverageHandoffCycles[ eBenchNumLocks ];
+volatile uint32_t ulWorstHandoffCycles[ eBenchNumLocks ];
+volatile BaseType_t xBenchmarkDone = pdFALSE;
+
+LwMutexStats_t xLwMutexStats;
+RWLockStats_t xRWLockStats;
+
+static SemaphoreHandle_t xQueueMutex;
+static LwMutexHandle_t xLwMutex;
+static RWLockHandle_t xRWLock;
+
+static TaskHandle_t xBenchmarkTask;
+static TaskHandle_t xContenderTask;
+static volatile BenchLock_t eCurrentLock;
+static volatile uint32_t ulGiveStart;
+static volatile uint32_t ulHandoffCycles;
+
+static void prvTake( BenchLock_t eLock )
+{
+    switch( eLock )
+    {
+        case eBenchQueueMutex:
+            xSemaphoreTake( xQueueMutex, portMAX_DELAY );
+            break;
+
+        case eBenchLwMutex:
+            xLwMutexTake( xLwMutex, portMAX_DELAY );
+            break;
+
+        case eBenchRWLockRead:
+            xRWLockReadLock( xRWLock, portMAX_DELAY );
+            break;
+
+        default:
+            xRWLockWriteLock( xRWLock, portMAX_DELAY );
+            break;
+    }
+}
+
+static void prvGive( BenchLock_t eLock )
+{
+    switch( eLock )
+    {
+        case eBenchQueueMutex:
+            xSemaphoreGive( xQueueMutex );
+            break;
+
+        case eBenchLwMutex:
+            xLwMutexGive( xLwMutex );
+            break;
+
+        case eBenchRWLockRead:
+            xRWLockReadUnlock( xRWLock );
+            break;
+
+        default:
+            xRWLockWriteUnlock( xRWLock );
+            break;
+    }
+}
+
+static void prvContenderTask( void *pvParameters )
+{
+    ( void ) pvParameters;
+
+    for( ;; )
+    {
+        ulTaskNotifyTake( pdTRUE, portMAX_DELAY );
+
+        /* Readers share the lock, so the read handoff is measured with the
+           contender asking for the write side. */
+        if( eCurrentLock == eBenchRWLockRead )
+        {
+            prvTake( eBenchRWLockWrite );
+            ulHandoffCycles = DWT->CYCCNT - ulGiveStart;
+            prvGive( eBenchRWLockWrite );
+        }
+        else
+        {
+            prvTake( eCurrentLock );
+            ulHandoffCycles = DWT->CYCCNT - ulGiveStart;
+            prvGive( eCurrentLock );
+        }
+
+        xTaskNotifyGive( xBenchmarkTask );
+    }
+}
+
+static void prvBenchmarkTask( void *pvParameters )
+{
+    uint32_t ulStart, ulTotal, ulWorst;
+    uint32_t i;
+    BenchLock_t eLock;
+
+    ( void ) pvParameters;
+
+    /* Enable the DWT cycle counter. */
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CYCCNT = 0;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
+    for( eLock = eBenchQueueMutex; eLock < eBenchNumLocks; eLock++ )
+    {
+        ulStart = DWT->CYCCNT;
+
+        for( i = 0; i < benchITERATIONS; i++ )
+        {
+            prvTake( eLock );
+            prvGive( eLock );
+        }
+
+        ulUncontendedCycles[ eLock ] = ( DWT->CYCCNT - ulStart ) / benchITERATIONS;
+    }
+
+    for( eLock = eBenchQueueMutex; eLock < eBenchNumLocks; eLock++ )
+    {
+        eCurrentLock = eLock;
+        ulTotal = 0;
+        ulWorst = 0;
+
+        for( i = 0; i < benchHANDOFFS; i++ )
+        {
+            prvTake( eLock );
+
+            /* The contender preempts this task and blocks on the lock. */
+            xTaskNotifyGive( xContenderTask );
+
+            ulGiveStart = DWT->CYCCNT;
+            prvGive( eLock );
+
+            ulTaskNotifyTake( pdTRUE, portMAX_DELAY );
+
+            ulTotal += ulHandoffCycles;
+
+            if( ulHandoffCycles > ulWorst )
+            {
+                ulWorst = ulHandoffCycles;
+            }
+        }
+
+        ulAverageHandoffCycles[ eLock ] = ulTotal / benchHANDOFFS;
+        ulWorstHandoffCycles[ eLock ] = ulWorst;
+    }
+
+    vLwMutexGetStats( xLwMutex, &xLwMutexStats );
+    vRWLockGetStats( xRWLock, &xRWLockStats );
+
+    xBenchmarkDone = pdTRUE;
+
+    for( ;; )
+    {
+        vTaskDelay( portMAX_DELAY );
+    }
+}
+
+int main( void )
+{
+    HAL_Init();
+
+    xQueueMutex = xSemaphoreCreateMutex();
+    xLwMutex = xLwMutexCreate();
+    xRWLock = xRWLockCreate();
+    configASSERT( xQueueMutex && xLwMutex && xRWLock );
+
+    xTaskCreate( prvBenchmarkTask, "Bench", configMINIMAL_STACK_SIZE * 2, NULL, tskIDLE_PRIORITY + 1, &xBenchmarkTask );
+    xTaskCreate( prvContenderTask, "Contend", configMINIMAL_STACK_SIZE, NULL, tskIDLE_PRIORITY + 2, &xContenderTask );
+
+    vTaskStartScheduler();
+
+    for( ;; );
+}
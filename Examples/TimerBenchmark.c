@@ -0,0 +1,134 @@
+#include "main.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include "timers.h"
+
+/*
+    Measures how long it takes to restart one software timer while a growing
+    number of other timers are active.  Build it once with
+    configUSE_TIMER_PAIRING_HEAP set to 0 and once with it set to 1 and compare
+    the contents of ulAverageResetCycles[] in the debugger.
+
+    The benchmark task runs below the daemon task, so xTimerReset() returns
+    only after the daemon has received and processed the command.  The cycles
+    measured therefore include the queue send, two context switches and the
+    insertion into the active timer list.  Only the insertion depends on the
+    number of active timers: with sorted lists it grows linearly, with the
+    pairing heap it stays flat.
+
+    The probe timer has the longest period, which is the worst case for the
+    sorted list as the insertion walks every active timer.  The Blue Pill only
+    has 20K of RAM, so the sweep stops at 200 timers - raise benchMAX_TIMERS on
+    a part with more memory.
+*/
+
+#define benchMAX_TIMERS         200
+#define benchRESETS_PER_POINT   100
+#define benchPROBE_PERIOD       pdMS_TO_TICKS( 60000 )
+#define benchBACKGROUND_PERIOD  pdMS_TO_TICKS( 10000 )
+
+static const uint16_t usTimerCounts[] = { 10, 25, 50, 100, 150, 200 };
+#define benchNUM_POINTS         ( sizeof( usTimerCounts ) / sizeof( usTimerCounts[ 0 ] ) )
+
+static StaticTimer_t xTimerBuffers[ benchMAX_TIMERS ];
+static TimerHandle_t xTimers[ benchMAX_TIMERS ];
+
+/* Results, one entry per entry in usTimerCounts[]. */
+volatile uint32_t ulAverageResetCycles[ benchNUM_POINTS ];
+volatile uint32_t ulWorstResetCycles[ benchNUM_POINTS ];
+volatile BaseType_t xBenchmarkDone = pdFALSE;
+
+static void prvTimerCallback( TimerHandle_t xTimer )
+{
+    ( void ) xTimer;
+}
+
+static void prvBenchmarkTask( void *pvParameters )
+{
+    TimerHandle_t xProbe;
+    uint32_t ulStart, ulCycles, ulTotal, ulWorst;
+    uint32_t ulActive;
+    uint32_t i, ulPoint;
+
+    ( void ) pvParameters;
+
+    /* Enable the DWT cycle counter. */
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CYCCNT = 0;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
+    for( i = 0; i < benchMAX_TIMERS; i++ )
+    {
+        /* Spread the background expiry times so the timers do not all sit on
+           the same tick. */
+        xTimers[ i ] = xTimerCreateStatic( "Bench",
+                                           benchBACKGROUND_PERIOD + i,
+                                           pdFALSE,
+                                           NULL,
+                                           prvTimerCallback,
+                                           &xTimerBuffers[ i ] );
+        configASSERT( xTimers[ i ] );
+    }
+
+    /* The last timer is the one being measured. */
+    xProbe = xTimers[ benchMAX_TIMERS - 1 ];
+    xTimerChangePeriod( xProbe, benchPROBE_PERIOD, portMAX_DELAY );
+
+    ulActive = 0;
+
+    for( ulPoint = 0; ulPoint < benchNUM_POINTS; ulPoint++ )
+    {
+        /* Bring the number of active timers, excluding the probe, up to the
+           next point of the sweep. */
+        while( ulActive < ( uint32_t ) ( usTimerCounts[ ulPoint ] - 1U ) )
+        {
+            xTimerStart( xTimers[ ulActive ], portMAX_DELAY );
+            ulActive++;
+        }
+
+        ulTotal = 0;
+        ulWorst = 0;
+
+        for( i = 0; i < benchRESETS_PER_POINT; i++ )
+        {
+            ulStart = DWT->CYCCNT;
+            xTimerReset( xProbe, portMAX_DELAY );
+            ulCycles = DWT->CYCCNT - ulStart;
+
+            ulTotal += ulCycles;
+
+            if( ulCycles > ulWorst )
+            {
+                ulWorst = ulCycles;
+            }
+        }
+
+        ulAverageResetCycles[ ulPoint ] = ulTotal / benchRESETS_PER_POINT;
+        ulWorstResetCycles[ ulPoint ] = ulWorst;
+    }
+
+    for( i = 0; i < benchMAX_TIMERS; i++ )
+    {
+        xTimerStop( xTimers[ i ], portMAX_DELAY );
+    }
+
+    xBenchmarkDone = pdTRUE;
+
+    for( ;; )
+    {
+        vTaskDelay( portMAX_DELAY );
+    }
+}
+
+int main( void )
+{
+    HAL_Init();
+
+    /* The benchmark task must run below the daemon task so each timer
+       command has been processed by the time the API call returns. */
+    xTaskCreate( prvBenchmarkTask, "Bench", configMINIMAL_STACK_SIZE * 2, NULL, configTIMER_TASK_PRIORITY - 1, NULL );
+
+    vTaskStartScheduler();
+
+    for( ;; );
+}
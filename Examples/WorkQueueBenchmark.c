@@ -0,0 +1,212 @@
+#include "main.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include "timers.h"
+#include "workqueue.h"
+
+/*
+    Compares the latency from an interrupt deferring work to the start of that
+    work, for a function pended to the timer daemon task with
+    xTimerPendFunctionCallFromISR() and for a work item submitted to a work
+    queue with xWorkQueueSubmitFromISR().  Build with configUSE_WORK_QUEUES and
+    INCLUDE_xTimerPendFunctionCall set to 1 and read the results in the
+    debugger once xBenchmarkDone is pdTRUE.
+
+    The interrupt is EXTI0, pended from software so no pin is involved.  The
+    cycles are counted from the first instruction of the handler to the first
+    instruction of the deferred work.  Each path runs twice, on an idle system
+    and with benchLOAD_TIMERS auto-reload timers expiring every tick, each with
+    a callback that runs for about benchLOAD_CYCLES cycles.  The timers keep
+    the daemon task busy the way a loaded application does, and fill its
+    command queue when they are restarted.
+
+    The work queue worker runs at the priority of the daemon task, so the
+    difference under load is the time spent behind timer callbacks and timer
+    commands, not a priority advantage.  ulPendFailures[] counts the deferrals
+    that were lost because the timer command queue was full, the work queue
+    cannot lose one.
+*/
+
+#define benchITERATIONS     200
+#define benchLOAD_TIMERS    4
+#define benchLOAD_CYCLES    2000
+#define benchIRQn           EXTI0_IRQn
+
+typedef enum
+{
+    eBenchPendIdle = 0,
+    eBenchWorkQueueIdle,
+    eBenchPendLoaded,
+    eBenchWorkQueueLoaded,
+    eBenchNumPaths
+} BenchPath_t;
+
+/* Results, indexed by BenchPath_t. */
+volatile uint32_t ulAverageLatencyCycles[ eBenchNumPaths ];
+volatile uint32_t ulWorstLatencyCycles[ eBenchNumPaths ];
+volatile uint32_t ulPendFailures[ eBenchNumPaths ];
+volatile BaseType_t xBenchmarkDone = pdFALSE;
+
+WorkQueueStats_t xWorkQueueStats;
+
+static WorkQueueHandle_t xWorkQueue;
+static WorkItem_t xWorkItem;
+static TimerHandle_t xLoadTimers[ benchLOAD_TIMERS ];
+
+static TaskHandle_t xBenchmarkTask;
+static volatile BenchPath_t eCurrentPath;
+static volatile uint32_t ulIsrEntry;
+static volatile uint32_t ulLatency;
+
+static void prvDeferredWork( void *pvParameter )
+{
+    ulLatency = DWT->CYCCNT - ulIsrEntry;
+
+    ( void ) pvParameter;
+
+    xTaskNotifyGive( xBenchmarkTask );
+}
+
+static void prvPendedFunction( void *pvParameter1, uint32_t ulParameter2 )
+{
+    ( void ) ulParameter2;
+
+    prvDeferredWork( pvParameter1 );
+}
+
+static void prvLoadTimerCallback( TimerHandle_t xTimer )
+{
+    uint32_t ulStart = DWT->CYCCNT;
+
+    ( void ) xTimer;
+
+    while( ( DWT->CYCCNT - ulStart ) < benchLOAD_CYCLES )
+    {
+    }
+}
+
+void EXTI0_IRQHandler( void )
+{
+    BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+
+    ulIsrEntry = DWT->CYCCNT;
+
+    if( ( eCurrentPath == eBenchPendIdle ) || ( eCurrentPath == eBenchPendLoaded ) )
+    {
+        if( xTimerPendFunctionCallFromISR( prvPendedFunction, NULL, 0, &xHigherPriorityTaskWoken ) != pdPASS )
+        {
+            ulPendFailures[ eCurrentPath ]++;
+
+            /* The deferral was lost, let the benchmark task move on. */
+            vTaskNotifyGiveFromISR( xBenchmarkTask, &xHigherPriorityTaskWoken );
+        }
+    }
+    else
+    {
+        ( void ) xWorkQueueSubmitFromISR( xWorkQueue, &xWorkItem, &xHigherPriorityTaskWoken );
+    }
+
+    portYIELD_FROM_ISR( xHigherPriorityTaskWoken );
+}
+
+static void prvBenchmarkTask( void *pvParameters )
+{
+    uint32_t ulTotal, ulWorst, ulCompleted;
+    uint32_t i;
+    BenchPath_t ePath;
+
+    ( void ) pvParameters;
+
+    /* Enable the DWT cycle counter. */
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
+    HAL_NVIC_SetPriority( benchIRQn, configLIBRARY_MAX_SYSCALL_INTERRUPT_PRIORITY + 1, 0 );
+    HAL_NVIC_EnableIRQ( benchIRQn );
+
+    for( ePath = eBenchPendIdle; ePath < eBenchNumPaths; ePath++ )
+    {
+        if( ePath == eBenchPendLoaded )
+        {
+            for( i = 0; i < benchLOAD_TIMERS; i++ )
+            {
+                xTimerStart( xLoadTimers[ i ], portMAX_DELAY );
+            }
+        }
+
+        eCurrentPath = ePath;
+        ulTotal = 0;
+        ulWorst = 0;
+        ulCompleted = 0;
+
+        for( i = 0; i < benchITERATIONS; i++ )
+        {
+            ulLatency = 0;
+
+            HAL_NVIC_SetPendingIRQ( benchIRQn );
+
+            ulTaskNotifyTake( pdTRUE, portMAX_DELAY );
+
+            if( ulLatency != 0 )
+            {
+                ulTotal += ulLatency;
+                ulCompleted++;
+
+                if( ulLatency > ulWorst )
+                {
+                    ulWorst = ulLatency;
+                }
+            }
+
+            /* Restarting a timer is the command traffic that competes with
+               pended functions for the daemon task queue. */
+            if( ePath >= eBenchPendLoaded )
+            {
+                xTimerReset( xLoadTimers[ i % benchLOAD_TIMERS ], 0 );
+            }
+        }
+
+        ulAverageLatencyCycles[ ePath ] = ( ulCompleted > 0 ) ? ( ulTotal / ulCompleted ) : 0;
+        ulWorstLatencyCycles[ ePath ] = ulWorst;
+    }
+
+    for( i = 0; i < benchLOAD_TIMERS; i++ )
+    {
+        xTimerStop( xLoadTimers[ i ], portMAX_DELAY );
+    }
+
+    HAL_NVIC_DisableIRQ( benchIRQn );
+
+    vWorkQueueGetStats( xWorkQueue, &xWorkQueueStats );
+
+    xBenchmarkDone = pdTRUE;
+
+    for( ;; )
+    {
+        vTaskDelay( portMAX_DELAY );
+    }
+}
+
+int main( void )
+{
+    uint32_t i;
+
+    HAL_Init();
+
+    xWorkQueue = xWorkQueueCreate( "Work", configTIMER_TASK_PRIORITY, configMINIMAL_STACK_SIZE );
+    configASSERT( xWorkQueue );
+
+    vWorkItemInitialise( &xWorkItem, prvDeferredWork, NULL );
+
+    for( i = 0; i < benchLOAD_TIMERS; i++ )
+    {
+        xLoadTimers[ i ] = xTimerCreate( "Load", 1, pdTRUE, NULL, prvLoadTimerCallback );
+        configASSERT( xLoadTimers[ i ] );
+    }
+
+    xTaskCreate( prvBenchmarkTask, "Bench", configMINIMAL_STACK_SIZE * 2, NULL, tskIDLE_PRIORITY + 1, &xBenchmarkTask );
+
+    vTaskStartScheduler();
+
+    for( ;; );
+}
@@ -0,0 +1,720 @@
+/*
+ * FreeRTOS Kernel V10.5.1
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/*
+ * Wide event groups, see event_groups64.h.
+ *
+ * A task that has to wait fills an EventWait64_t on its own stack and links it
+ * into xWaiters through the list item it contains, then blocks on task
+ * notification configEVENT_GROUPS_64_NOTIFY_INDEX.  Setting bits starts a
+ * walk of xWaiters.  Each record whose condition is met is unlinked, marked as
+ * done with the event bits it saw, and its task notified.  The waiting task
+ * only trusts xDone, so a notification left over from an earlier wait, or one
+ * arriving after the task timed out, is harmless.
+ *
+ * The walk is done in steps of at most configEVENT_GROUPS_64_MAX_CHECKS
+ * records, each in its own critical section, and pxWalkNext keeps the place
+ * where the last step stopped.  xEventGroup64SetBitsFromISR() takes one step
+ * and passes the rest of the walk to the daemon task, while task level calls
+ * finish the walk with the scheduler suspended, so interrupts are never masked
+ * for longer than one step whatever the number of waiting tasks.  The bits that
+ * woken tasks asked to clear are kept in uxDeferredClearBits until the walk
+ * reaches the end of the list, so a task later in the list sees the same bits
+ * it would have seen had the walk been done at once.  Bits set while a walk is
+ * in progress make it start again from the head once it reaches the end, and
+ * the bits are only cleared at the end of that second pass.
+ */
+
+/* Standard includes. */
+#include <stdlib.h>
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+ * all the API functions to use the MPU wrappers.  That should only be done when
+ * task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "timers.h"
+#include "event_groups64.h"
+
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+#if ( configUSE_EVENT_GROUPS_64 == 1 )
+
+#if ( configEVENT_GROUPS_64_NOTIFY_INDEX >= configTASK_NOTIFICATION_ARRAY_ENTRIES )
+    #error configEVENT_GROUPS_64_NOTIFY_INDEX must be less than configTASK_NOTIFICATION_ARRAY_ENTRIES
+#endif
+
+typedef struct EventGroup64Def_t
+{
+    EventBits64_t uxEventBits;
+    EventBits64_t uxDeferredClearBits; /*< Bits to clear once the walk in progress reaches the end of xWaiters. */
+    List_t xWaiters;                   /*< EventWait64_t records of the waiting tasks, in the order they started to wait. */
+    ListItem_t * pxWalkNext;           /*< The next record the walk in progress checks, NULL if no walk is in progress. */
+    BaseType_t xWalkAgain;             /*< pdTRUE if bits were set after the walk in progress started. */
+    BaseType_t xWakePending;           /*< pdTRUE while a call to vEventGroup64WakeWaitersCallback() is queued. */
+
+    #if ( ( configSUPPORT_STATIC_ALLOCATION == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
+        uint8_t ucStaticallyAllocated; /*< Set to pdTRUE if the event group is statically allocated to ensure no attempt is made to free the memory. */
+    #endif
+} EventGroup64_t;
+
+/* The wait record of a blocked task, on the stack of that task. */
+typedef struct xEVENT_WAIT_64
+{
+    ListItem_t xWaitListItem; /*< Links the record into xWaiters, owned by the record. */
+    TaskHandle_t xTask;
+    EventBits64_t uxBitsToWaitFor;
+    EventBits64_t uxEventBits; /*< The event bits when the condition was met. */
+    BaseType_t xClearOnExit;
+    BaseType_t xWaitForAllBits;
+    volatile BaseType_t xDone; /*< Set when the record is removed from xWaiters by a setter. */
+} EventWait64_t;
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Returns pdTRUE if uxCurrentEventBits meets the condition described by
+ * uxBitsToWaitFor and xWaitForAllBits.
+ */
+static BaseType_t prvTestWaitCondition( const EventBits64_t uxCurrentEventBits,
+                                        const EventBits64_t uxBitsToWaitFor,
+                                        const BaseType_t xWaitForAllBits ) PRIVILEGED_FUNCTION;
+
+/*
+ * Starts a walk of xWaiters after bits were set, or makes the walk in progress
+ * start again from the head once it reaches the end.  Must be called from a
+ * critical section.
+ */
+static void prvStartWalk( EventGroup64_t * pxEventBits ) PRIVILEGED_FUNCTION;
+
+/*
+ * Takes one step of the walk in progress, checking at most
+ * configEVENT_GROUPS_64_MAX_CHECKS records and waking the tasks whose
+ * condition is met by the current event bits.  Must be called from a critical
+ * section.  Tasks are notified from an interrupt if pxHigherPriorityTaskWoken
+ * is not NULL.  Returns pdTRUE if no walk is left in progress.
+ */
+static BaseType_t prvContinueWalk( EventGroup64_t * pxEventBits,
+                                   BaseType_t * pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+/*
+ * Sets uxBitsToSet, which may be 0, then finishes the walk in progress with
+ * the scheduler suspended, one step per critical section.  Returns the event
+ * bits once the walk is finished.
+ */
+static EventBits64_t prvSetBitsAndFinishWalk( EventGroup64_t * pxEventBits,
+                                              const EventBits64_t uxBitsToSet ) PRIVILEGED_FUNCTION;
+
+/*
+ * Unlinks a record from xWaiters, moving the walk in progress past it first.
+ * Must be called from a critical section.
+ */
+static void prvRemoveWaiter( EventGroup64_t * pxEventBits,
+                             EventWait64_t * pxWait ) PRIVILEGED_FUNCTION;
+
+/*-----------------------------------------------------------*/
+
+static void prvInitialiseEventGroup( EventGroup64_t * pxEventBits ) /* PRIVILEGED_FUNCTION */
+{
+    pxEventBits->uxEventBits = 0;
+    pxEventBits->uxDeferredClearBits = 0;
+    vListInitialise( &( pxEventBits->xWaiters ) );
+    pxEventBits->pxWalkNext = NULL;
+    pxEventBits->xWalkAgain = pdFALSE;
+    pxEventBits->xWakePending = pdFALSE;
+}
+/*-----------------------------------------------------------*/
+
+#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+
+    EventGroup64Handle_t xEventGroup64CreateStatic( StaticEventGroup64_t * pxEventGroupBuffer )
+    {
+        EventGroup64_t * pxEventBits;
+
+        configASSERT( pxEventGroupBuffer );
+
+        #if ( configASSERT_DEFINED == 1 )
+        {
+            /* Sanity check that the size of the structure used to declare a
+             * variable of type StaticEventGroup64_t equals the size of the real
+             * event group structure. */
+            volatile size_t xSize = sizeof( StaticEventGroup64_t );
+            configASSERT( xSize == sizeof( EventGroup64_t ) );
+        } /*lint !e529 xSize is referenced if configASSERT() is defined. */
+        #endif /* configASSERT_DEFINED */
+
+        pxEventBits = ( EventGroup64_t * ) pxEventGroupBuffer; /*lint !e740 !e9087 EventGroup64_t and StaticEventGroup64_t are deliberately aliased for data hiding purposes and guaranteed to have the same size and alignment requirement - checked by configASSERT(). */
+
+        if( pxEventBits != NULL )
+        {
+            prvInitialiseEventGroup( pxEventBits );
+
+            #if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+            {
+                pxEventBits->ucStaticallyAllocated = pdTRUE;
+            }
+            #endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+
+            traceEVENT_GROUP_CREATE( pxEventBits );
+        }
+        else
+        {
+            traceEVENT_GROUP_CREATE_FAILED();
+        }
+
+        return pxEventBits;
+    }
+
+#endif /* configSUPPORT_STATIC_ALLOCATION */
+/*-----------------------------------------------------------*/
+
+#if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+
+    EventGroup64Handle_t xEventGroup64Create( void )
+    {
+        EventGroup64_t * pxEventBits;
+
+        pxEventBits = ( EventGroup64_t * ) pvPortMalloc( sizeof( EventGroup64_t ) );
+
+        if( pxEventBits != NULL )
+        {
+            prvInitialiseEventGroup( pxEventBits );
+
+            #if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+            {
+                pxEventBits->ucStaticallyAllocated = pdFALSE;
+            }
+            #endif /* configSUPPORT_STATIC_ALLOCATION */
+
+            traceEVENT_GROUP_CREATE( pxEventBits );
+        }
+        else
+        {
+            traceEVENT_GROUP_CREATE_FAILED();
+        }
+
+        return pxEventBits;
+    }
+
+#endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+/*-----------------------------------------------------------*/
+
+EventBits64_t xEventGroup64WaitBits( EventGroup64Handle_t xEventGroup,
+                                     const EventBits64_t uxBitsToWaitFor,
+                                     const BaseType_t xClearOnExit,
+                                     const BaseType_t xWaitForAllBits,
+                                     TickType_t xTicksToWait )
+{
+    EventGroup64_t * const pxEventBits = xEventGroup;
+    EventWait64_t xWait;
+    TimeOut_t xTimeOut;
+    EventBits64_t uxReturn;
+    BaseType_t xWaiting = pdFALSE;
+
+    configASSERT( pxEventBits );
+    configASSERT( uxBitsToWaitFor != 0 );
+
+    #if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
+    {
+        configASSERT( !( ( xTaskGetSchedulerState() == taskSCHEDULER_SUSPENDED ) && ( xTicksToWait != 0 ) ) );
+    }
+    #endif
+
+    /* Finish a walk left by an interrupt first, so the bits tested below have
+     * been seen by every task already waiting. */
+    if( pxEventBits->pxWalkNext != NULL )
+    {
+        ( void ) prvSetBitsAndFinishWalk( pxEventBits, 0 );
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    taskENTER_CRITICAL();
+    {
+        uxReturn = pxEventBits->uxEventBits;
+
+        if( prvTestWaitCondition( uxReturn, uxBitsToWaitFor, xWaitForAllBits ) != pdFALSE )
+        {
+            if( xClearOnExit != pdFALSE )
+            {
+                pxEventBits->uxEventBits &= ~uxBitsToWaitFor;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else if( xTicksToWait == ( TickType_t ) 0 )
+        {
+            /* The condition is not met and no block time was given. */
+            mtCOVERAGE_TEST_MARKER();
+        }
+        else
+        {
+            xWait.xTask = xTaskGetCurrentTaskHandle();
+            xWait.uxBitsToWaitFor = uxBitsToWaitFor;
+            xWait.uxEventBits = 0;
+            xWait.xClearOnExit = xClearOnExit;
+            xWait.xWaitForAllBits = xWaitForAllBits;
+            xWait.xDone = pdFALSE;
+
+            vListInitialiseItem( &( xWait.xWaitListItem ) );
+            listSET_LIST_ITEM_OWNER( &( xWait.xWaitListItem ), &xWait );
+            vListInsertEnd( &( pxEventBits->xWaiters ), &( xWait.xWaitListItem ) );
+
+            /* A notification pending from an earlier wait would end the
+             * first block early. */
+            ( void ) xTaskNotifyStateClearIndexed( NULL, configEVENT_GROUPS_64_NOTIFY_INDEX );
+            vTaskSetTimeOutState( &xTimeOut );
+            xWaiting = pdTRUE;
+        }
+    }
+    taskEXIT_CRITICAL();
+
+    while( xWaiting != pdFALSE )
+    {
+        traceEVENT_GROUP_WAIT_BITS_BLOCK( xEventGroup, uxBitsToWaitFor );
+        ( void ) xTaskNotifyWaitIndexed( configEVENT_GROUPS_64_NOTIFY_INDEX, 0UL, 0UL, NULL, xTicksToWait );
+
+        taskENTER_CRITICAL();
+        {
+            if( xWait.xDone != pdFALSE )
+            {
+                /* A setter removed the record, and cleared the bits if asked
+                 * to. */
+                uxReturn = xWait.uxEventBits;
+                xWaiting = pdFALSE;
+            }
+            else if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) != pdFALSE )
+            {
+                prvRemoveWaiter( pxEventBits, &xWait );
+                uxReturn = pxEventBits->uxEventBits;
+                xWaiting = pdFALSE;
+            }
+            else
+            {
+                /* Woken by a notification meant for an earlier wait. */
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        taskEXIT_CRITICAL();
+    }
+
+    return uxReturn;
+}
+/*-----------------------------------------------------------*/
+
+EventBits64_t xEventGroup64SetBits( EventGroup64Handle_t xEventGroup,
+                                    const EventBits64_t uxBitsToSet )
+{
+    EventGroup64_t * const pxEventBits = xEventGroup;
+
+    configASSERT( pxEventBits );
+
+    return prvSetBitsAndFinishWalk( pxEventBits, uxBitsToSet );
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xEventGroup64SetBitsFromISR( EventGroup64Handle_t xEventGroup,
+                                        const EventBits64_t uxBitsToSet,
+                                        BaseType_t * pxHigherPriorityTaskWoken )
+{
+    EventGroup64_t * const pxEventBits = xEventGroup;
+    UBaseType_t uxSavedInterruptStatus;
+    BaseType_t xLocalTaskWoken = pdFALSE;
+
+    configASSERT( pxEventBits );
+
+    portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
+
+    if( pxHigherPriorityTaskWoken == NULL )
+    {
+        pxHigherPriorityTaskWoken = &xLocalTaskWoken;
+    }
+
+    uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+    {
+        pxEventBits->uxEventBits |= uxBitsToSet;
+        prvStartWalk( pxEventBits );
+
+        if( prvContinueWalk( pxEventBits, pxHigherPriorityTaskWoken ) == pdFALSE )
+        {
+            /* A callback already queued finishes the walk, including the
+             * records before the place where this step started. */
+            if( pxEventBits->xWakePending == pdFALSE )
+            {
+                if( xTimerPendFunctionCallFromISR( vEventGroup64WakeWaitersCallback, pxEventBits, 0UL, pxHigherPriorityTaskWoken ) != pdFAIL )
+                {
+                    pxEventBits->xWakePending = pdTRUE;
+                }
+                else
+                {
+                    /* The daemon task queue is full.  The walk stays where it
+                     * stopped, the next set takes another step and the next
+                     * task level set or wait finishes it. */
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+    portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+
+    traceEVENT_GROUP_SET_BITS_FROM_ISR( xEventGroup, uxBitsToSet );
+
+    return pdPASS;
+}
+/*-----------------------------------------------------------*/
+
+void vEventGroup64WakeWaitersCallback( void * pvEventGroup,
+                                       const uint32_t ulUnused )
+{
+    EventGroup64_t * const pxEventBits = ( EventGroup64_t * ) pvEventGroup;
+
+    ( void ) ulUnused;
+
+    taskENTER_CRITICAL();
+    {
+        pxEventBits->xWakePending = pdFALSE;
+    }
+    taskEXIT_CRITICAL();
+
+    ( void ) prvSetBitsAndFinishWalk( pxEventBits, 0 );
+}
+/*-----------------------------------------------------------*/
+
+EventBits64_t xEventGroup64ClearBits( EventGroup64Handle_t xEventGroup,
+                                      const EventBits64_t uxBitsToClear )
+{
+    EventGroup64_t * const pxEventBits = xEventGroup;
+    EventBits64_t uxReturn;
+
+    configASSERT( pxEventBits );
+
+    taskENTER_CRITICAL();
+    {
+        traceEVENT_GROUP_CLEAR_BITS( xEventGroup, uxBitsToClear );
+
+        uxReturn = pxEventBits->uxEventBits;
+        pxEventBits->uxEventBits &= ~uxBitsToClear;
+    }
+    taskEXIT_CRITICAL();
+
+    return uxReturn;
+}
+/*-----------------------------------------------------------*/
+
+EventBits64_t xEventGroup64ClearBitsFromISR( EventGroup64Handle_t xEventGroup,
+                                             const EventBits64_t uxBitsToClear )
+{
+    EventGroup64_t * const pxEventBits = xEventGroup;
+    UBaseType_t uxSavedInterruptStatus;
+    EventBits64_t uxReturn;
+
+    configASSERT( pxEventBits );
+
+    uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+    {
+        traceEVENT_GROUP_CLEAR_BITS_FROM_ISR( xEventGroup, uxBitsToClear );
+
+        uxReturn = pxEventBits->uxEventBits;
+        pxEventBits->uxEventBits &= ~uxBitsToClear;
+    }
+    portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+
+    return uxReturn;
+}
+/*-----------------------------------------------------------*/
+
+EventBits64_t xEventGroup64GetBits( EventGroup64Handle_t xEventGroup )
+{
+    EventGroup64_t const * const pxEventBits = xEventGroup;
+    EventBits64_t uxReturn;
+
+    configASSERT( pxEventBits );
+
+    taskENTER_CRITICAL();
+    {
+        uxReturn = pxEventBits->uxEventBits;
+    }
+    taskEXIT_CRITICAL();
+
+    return uxReturn;
+}
+/*-----------------------------------------------------------*/
+
+EventBits64_t xEventGroup64GetBitsFromISR( EventGroup64Handle_t xEventGroup )
+{
+    EventGroup64_t const * const pxEventBits = xEventGroup;
+    UBaseType_t uxSavedInterruptStatus;
+    EventBits64_t uxReturn;
+
+    configASSERT( pxEventBits );
+
+    uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+    {
+        uxReturn = pxEventBits->uxEventBits;
+    }
+    portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+
+    return uxReturn;
+}
+/*-----------------------------------------------------------*/
+
+void vEventGroup64Delete( EventGroup64Handle_t xEventGroup )
+{
+    EventGroup64_t * pxEventBits = xEventGroup;
+    EventWait64_t * pxWait;
+
+    configASSERT( pxEventBits );
+
+    /* A wake passed to the daemon task would use the freed memory. */
+    configASSERT( pxEventBits->xWakePending == pdFALSE );
+
+    traceEVENT_GROUP_DELETE( xEventGroup );
+
+    taskENTER_CRITICAL();
+    {
+        while( listCURRENT_LIST_LENGTH( &( pxEventBits->xWaiters ) ) > ( UBaseType_t ) 0 )
+        {
+            pxWait = ( EventWait64_t * ) listGET_OWNER_OF_HEAD_ENTRY( &( pxEventBits->xWaiters ) ); /*lint !e9087 The owner of every item in xWaiters is its EventWait64_t. */
+            prvRemoveWaiter( pxEventBits, pxWait );
+            pxWait->uxEventBits = 0;
+            pxWait->xDone = pdTRUE;
+            ( void ) xTaskNotifyIndexed( pxWait->xTask, configEVENT_GROUPS_64_NOTIFY_INDEX, 0UL, eNoAction );
+        }
+
+        pxEventBits->pxWalkNext = NULL;
+    }
+    taskEXIT_CRITICAL();
+
+    #if ( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 0 ) )
+    {
+        vPortFree( pxEventBits );
+    }
+    #elif ( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) )
+    {
+        if( pxEventBits->ucStaticallyAllocated == ( uint8_t ) pdFALSE )
+        {
+            vPortFree( pxEventBits );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+    #endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+}
+/*-----------------------------------------------------------*/
+
+static void prvStartWalk( EventGroup64_t * pxEventBits )
+{
+    if( pxEventBits->pxWalkNext == NULL )
+    {
+        pxEventBits->pxWalkNext = listGET_HEAD_ENTRY( &( pxEventBits->xWaiters ) );
+    }
+    else
+    {
+        /* Records the walk has passed have not seen the new bits. */
+        pxEventBits->xWalkAgain = pdTRUE;
+    }
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvContinueWalk( EventGroup64_t * pxEventBits,
+                                   BaseType_t * pxHigherPriorityTaskWoken )
+{
+    const ListItem_t * pxListEnd = listGET_END_MARKER( &( pxEventBits->xWaiters ) ); /*lint !e9087 The end marker is only compared against. */
+    ListItem_t * pxListItem;
+    EventWait64_t * pxWait;
+    UBaseType_t uxChecks = 0;
+
+    while( ( pxEventBits->pxWalkNext != NULL ) && ( uxChecks < ( UBaseType_t ) configEVENT_GROUPS_64_MAX_CHECKS ) )
+    {
+        pxListItem = pxEventBits->pxWalkNext;
+
+        if( pxListItem == pxListEnd )
+        {
+            if( pxEventBits->xWalkAgain != pdFALSE )
+            {
+                /* The records at the head have not seen the bits set since
+                 * the walk started, so nothing is cleared yet. */
+                pxEventBits->xWalkAgain = pdFALSE;
+                pxEventBits->pxWalkNext = listGET_HEAD_ENTRY( &( pxEventBits->xWaiters ) );
+            }
+            else
+            {
+                /* Every waiter has seen the bits, they can now be cleared. */
+                pxEventBits->uxEventBits &= ~( pxEventBits->uxDeferredClearBits );
+                pxEventBits->uxDeferredClearBits = 0;
+                pxEventBits->pxWalkNext = NULL;
+            }
+        }
+        else
+        {
+            pxEventBits->pxWalkNext = listGET_NEXT( pxListItem );
+            pxWait = ( EventWait64_t * ) listGET_LIST_ITEM_OWNER( pxListItem ); /*lint !e9087 The owner of every item in xWaiters is its EventWait64_t. */
+            uxChecks++;
+
+            if( prvTestWaitCondition( pxEventBits->uxEventBits, pxWait->uxBitsToWaitFor, pxWait->xWaitForAllBits ) != pdFALSE )
+            {
+                if( pxWait->xClearOnExit != pdFALSE )
+                {
+                    pxEventBits->uxDeferredClearBits |= pxWait->uxBitsToWaitFor;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                ( void ) uxListRemove( pxListItem );
+                pxWait->uxEventBits = pxEventBits->uxEventBits;
+                pxWait->xDone = pdTRUE;
+
+                if( pxHigherPriorityTaskWoken != NULL )
+                {
+                    ( void ) xTaskNotifyIndexedFromISR( pxWait->xTask, configEVENT_GROUPS_64_NOTIFY_INDEX, 0UL, eNoAction, pxHigherPriorityTaskWoken );
+                }
+                else
+                {
+                    ( void ) xTaskNotifyIndexed( pxWait->xTask, configEVENT_GROUPS_64_NOTIFY_INDEX, 0UL, eNoAction );
+                }
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+    }
+
+    return ( pxEventBits->pxWalkNext == NULL ) ? pdTRUE : pdFALSE;
+}
+/*-----------------------------------------------------------*/
+
+static EventBits64_t prvSetBitsAndFinishWalk( EventGroup64_t * pxEventBits,
+                                              const EventBits64_t uxBitsToSet )
+{
+    EventBits64_t uxReturn;
+    BaseType_t xFinished;
+
+    /* Tasks cannot leave xWaiters while the scheduler is suspended, and
+     * interrupts only ever take steps of the same walk. */
+    vTaskSuspendAll();
+    {
+        taskENTER_CRITICAL();
+        {
+            if( uxBitsToSet != ( EventBits64_t ) 0 )
+            {
+                pxEventBits->uxEventBits |= uxBitsToSet;
+                prvStartWalk( pxEventBits );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        taskEXIT_CRITICAL();
+
+        do
+        {
+            taskENTER_CRITICAL();
+            {
+                xFinished = prvContinueWalk( pxEventBits, NULL );
+                uxReturn = pxEventBits->uxEventBits;
+            }
+            taskEXIT_CRITICAL();
+        } while( xFinished == pdFALSE );
+    }
+    ( void ) xTaskResumeAll();
+
+    return uxReturn;
+}
+/*-----------------------------------------------------------*/
+
+static void prvRemoveWaiter( EventGroup64_t * pxEventBits,
+                             EventWait64_t * pxWait )
+{
+    if( pxEventBits->pxWalkNext == &( pxWait->xWaitListItem ) )
+    {
+        pxEventBits->pxWalkNext = listGET_NEXT( &( pxWait->xWaitListItem ) );
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    ( void ) uxListRemove( &( pxWait->xWaitListItem ) );
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvTestWaitCondition( const EventBits64_t uxCurrentEventBits,
+                                        const EventBits64_t uxBitsToWaitFor,
+                                        const BaseType_t xWaitForAllBits )
+{
+    BaseType_t xWaitConditionMet = pdFALSE;
+
+    if( xWaitForAllBits == pdFALSE )
+    {
+        if( ( uxCurrentEventBits & uxBitsToWaitFor ) != ( EventBits64_t ) 0 )
+        {
+            xWaitConditionMet = pdTRUE;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+    else
+    {
+        if( ( uxCurrentEventBits & uxBitsToWaitFor ) == uxBitsToWaitFor )
+        {
+            xWaitConditionMet = pdTRUE;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+
+    return xWaitConditionMet;
+}
+/*-----------------------------------------------------------*/
+
+#endif /* configUSE_EVENT_GROUPS_64 */
@@ -237,6 +237,10 @@
     #define INCLUDE_uxTaskGetStackHighWaterMark2    0
 #endif
 
+#ifndef INCLUDE_xTaskScanStack
+    #define INCLUDE_xTaskScanStack    0
+#endif
+
 #ifndef INCLUDE_eTaskGetState
     #define INCLUDE_eTaskGetState    0
 #endif
@@ -287,6 +291,27 @@
     #define configUSE_TIMERS    0
 #endif
 
+#ifndef configUSE_TIMER_PAIRING_HEAP
+
+/* By default active timers are held in sorted lists.  Set to 1 to hold them
+ * in a pairing heap instead, making timer start/reset O(1) rather than
+ * O(number of active timers). */
+    #define configUSE_TIMER_PAIRING_HEAP    0
+#endif
+
+#ifndef configTIMER_COMMAND_BATCH_SIZE
+
+/* The maximum number of commands the timer service task removes from the
+ * timer queue in one go.  Commands within a batch that are made redundant by a
+ * later command for the same timer are dropped.  1 processes the commands one
+ * at a time, as the standard kernel does. */
+    #define configTIMER_COMMAND_BATCH_SIZE    1
+#endif
+
+#ifndef configUSE_TIMER_COMMAND_STATS
+    #define configUSE_TIMER_COMMAND_STATS    0
+#endif
+
 #ifndef configUSE_COUNTING_SEMAPHORES
     #define configUSE_COUNTING_SEMAPHORES    0
 #endif
@@ -338,6 +363,17 @@
     #define portSOFTWARE_BARRIER()
 #endif
 
+/* Called by vTaskSuspendAll() when it suspends the scheduler, and by
+ * xTaskResumeAll() when it resumes it, so the port can time the windows in
+ * which the scheduler is suspended. */
+#ifndef portSCHEDULER_SUSPENDED_HOOK
+    #define portSCHEDULER_SUSPENDED_HOOK()
+#endif
+
+#ifndef portSCHEDULER_RESUMED_HOOK
+    #define portSCHEDULER_RESUMED_HOOK()
+#endif
+
 /* The timers module relies on xTaskGetSchedulerState(). */
 #if configUSE_TIMERS == 1
 
@@ -458,6 +494,14 @@
     #define traceTASK_PRIORITY_DISINHERIT( pxTCBOfMutexHolder, uxOriginalPriority )
 #endif
 
+#ifndef traceMUTEX_LOCK_ORDER_INVERSION
+
+/* Called when the running task takes mutex xTaken while holding mutex xHeld,
+ * after a task had earlier taken xHeld while holding xTaken.  Only called when
+ * configUSE_MUTEX_STATS is 1. */
+    #define traceMUTEX_LOCK_ORDER_INVERSION( xHeld, xTaken )
+#endif
+
 #ifndef traceBLOCKING_ON_QUEUE_RECEIVE
 
 /* Task is about to block because it cannot read from a
@@ -807,6 +851,10 @@
     #define traceSTREAM_BUFFER_RECEIVE_FROM_ISR( xStreamBuffer, xReceivedLength )
 #endif
 
+#ifndef traceSTREAM_BUFFER_DRAIN
+    #define traceSTREAM_BUFFER_DRAIN( xStreamBuffer, xMessagesDrained )
+#endif
+
 #ifndef configGENERATE_RUN_TIME_STATS
     #define configGENERATE_RUN_TIME_STATS    0
 #endif
@@ -833,6 +881,130 @@
     #define configUSE_MALLOC_FAILED_HOOK    0
 #endif
 
+#ifndef configUSE_BLOCK_POOLS
+    #define configUSE_BLOCK_POOLS    0
+#endif
+
+#ifndef configUSE_HEAP_TRACKING
+    #define configUSE_HEAP_TRACKING    0
+#endif
+
+#ifndef configHEAP_TRACKING_MAX_TASKS
+    #define configHEAP_TRACKING_MAX_TASKS    8
+#endif
+
+#ifndef configUSE_HEAP_TRACE
+    #define configUSE_HEAP_TRACE    0
+#endif
+
+#ifndef configUSE_HEAP_FRAGMENTATION_STATS
+    #define configUSE_HEAP_FRAGMENTATION_STATS    0
+#endif
+
+#if ( configUSE_HEAP_TRACE == 1 ) && ( configUSE_HEAP_TRACKING == 0 )
+    #error configUSE_HEAP_TRACE requires configUSE_HEAP_TRACKING to be set to 1
+#endif
+
+#ifndef configUSE_RW_LOCKS
+    #define configUSE_RW_LOCKS    0
+#endif
+
+#ifndef configRWLOCK_MAX_READERS
+    #define configRWLOCK_MAX_READERS    4
+#endif
+
+#ifndef configUSE_LW_MUTEXES
+    #define configUSE_LW_MUTEXES    0
+#endif
+
+#if ( ( configUSE_RW_LOCKS == 1 ) || ( configUSE_LW_MUTEXES == 1 ) ) && ( configUSE_MUTEXES == 0 )
+    #error configUSE_RW_LOCKS and configUSE_LW_MUTEXES require configUSE_MUTEXES to be set to 1
+#endif
+
+#ifndef configUSE_EVENT_GROUPS_64
+    #define configUSE_EVENT_GROUPS_64    0
+#endif
+
+#ifndef configEVENT_GROUPS_64_MAX_CHECKS
+    #define configEVENT_GROUPS_64_MAX_CHECKS    4
+#endif
+
+#ifndef configEVENT_GROUPS_64_NOTIFY_INDEX
+    #define configEVENT_GROUPS_64_NOTIFY_INDEX    ( configTASK_NOTIFICATION_ARRAY_ENTRIES - 1 )
+#endif
+
+#if ( configUSE_EVENT_GROUPS_64 == 1 ) && ( ( configUSE_TIMERS == 0 ) || ( INCLUDE_xTimerPendFunctionCall == 0 ) )
+    #error configUSE_EVENT_GROUPS_64 requires configUSE_TIMERS and INCLUDE_xTimerPendFunctionCall to be set to 1
+#endif
+
+#ifndef configMUTEX_INHERITANCE_CHAIN_DEPTH
+    #define configMUTEX_INHERITANCE_CHAIN_DEPTH    1
+#endif
+
+#ifndef configUSE_MUTEX_STATS
+    #define configUSE_MUTEX_STATS    0
+#endif
+
+#ifndef configMUTEX_LOCK_ORDER_SLOTS
+    #define configMUTEX_LOCK_ORDER_SLOTS    16
+#endif
+
+#if ( ( configMUTEX_INHERITANCE_CHAIN_DEPTH > 1 ) || ( configUSE_MUTEX_STATS == 1 ) ) && ( configUSE_MUTEXES == 0 )
+    #error configMUTEX_INHERITANCE_CHAIN_DEPTH above 1 and configUSE_MUTEX_STATS require configUSE_MUTEXES to be set to 1
+#endif
+
+#if ( configMUTEX_LOCK_ORDER_SLOTS > 32 )
+    #error configMUTEX_LOCK_ORDER_SLOTS cannot be above 32
+#endif
+
+#ifndef configUSE_OBJECT_REGISTRY
+    #define configUSE_OBJECT_REGISTRY    0
+#endif
+
+#ifndef configOBJECT_REGISTRY_SIZE
+    #define configOBJECT_REGISTRY_SIZE    16
+#endif
+
+#if ( configUSE_OBJECT_REGISTRY == 1 ) && ( configUSE_TRACE_FACILITY == 0 )
+    #error configUSE_OBJECT_REGISTRY requires configUSE_TRACE_FACILITY to be set to 1
+#endif
+
+#if ( configUSE_OBJECT_REGISTRY == 1 ) && ( INCLUDE_uxTaskGetStackHighWaterMark2 == 0 )
+    #error configUSE_OBJECT_REGISTRY requires INCLUDE_uxTaskGetStackHighWaterMark2 to be set to 1
+#endif
+
+#ifndef configUSE_WORK_QUEUES
+    #define configUSE_WORK_QUEUES    0
+#endif
+
+/* The clock work queue latencies and run times are measured with, read from
+ * tasks and interrupts.  Any free running 32-bit counter can be used. */
+#ifndef configWORK_QUEUE_GET_TIME
+    #define configWORK_QUEUE_GET_TIME()    ( ( uint32_t ) xTaskGetTickCountFromISR() )
+#endif
+
+#if ( configUSE_WORK_QUEUES == 1 ) && defined( configUSE_TASK_NOTIFICATIONS ) && ( configUSE_TASK_NOTIFICATIONS == 0 )
+    #error configUSE_WORK_QUEUES requires configUSE_TASK_NOTIFICATIONS to be set to 1
+#endif
+
+#ifndef configUSE_EDF_SCHEDULING
+    #define configUSE_EDF_SCHEDULING    0
+#endif
+
+/* The priority of the earliest deadline first scheduling class, see
+ * vTaskSetPeriod(). */
+#ifndef configEDF_PRIORITY
+    #define configEDF_PRIORITY    1
+#endif
+
+#if ( configUSE_EDF_SCHEDULING == 1 ) && ( ( configEDF_PRIORITY < 1 ) || ( configEDF_PRIORITY >= configMAX_PRIORITIES ) )
+    #error configEDF_PRIORITY must be above the idle priority and below configMAX_PRIORITIES
+#endif
+
+#if ( INCLUDE_xTaskScanStack == 1 ) && ( ( configUSE_TRACE_FACILITY == 0 ) || ( ( portSTACK_GROWTH < 0 ) && ( configRECORD_STACK_HIGH_ADDRESS == 0 ) ) )
+    #error INCLUDE_xTaskScanStack requires configUSE_TRACE_FACILITY and configRECORD_STACK_HIGH_ADDRESS to be set to 1
+#endif
+
 #ifndef portPRIVILEGE_BIT
     #define portPRIVILEGE_BIT    ( ( UBaseType_t ) 0x00 )
 #endif
@@ -857,6 +1029,17 @@
     #define configUSE_TICKLESS_IDLE    0
 #endif
 
+#ifndef configUSE_TICKLESS_ALT_TIMEBASE
+
+/* Set to 1 to have the port hand long idle periods to an application supplied
+ * timebase that keeps running in a deeper sleep state than the SysTick can. */
+    #define configUSE_TICKLESS_ALT_TIMEBASE    0
+#endif
+
+#ifndef configTICKLESS_ALT_TIMEBASE_MIN_TICKS
+    #define configTICKLESS_ALT_TIMEBASE_MIN_TICKS    ( ( TickType_t ) 50 )
+#endif
+
 #ifndef configPRE_SUPPRESS_TICKS_AND_SLEEP_PROCESSING
     #define configPRE_SUPPRESS_TICKS_AND_SLEEP_PROCESSING( x )
 #endif
@@ -1274,6 +1457,9 @@ typedef struct xSTATIC_TCB
     #endif
     #if ( configUSE_MUTEXES == 1 )
         UBaseType_t uxDummy12[ 2 ];
+        #if ( configMUTEX_INHERITANCE_CHAIN_DEPTH > 1 )
+            void * pvDummy13;
+        #endif
     #endif
     #if ( configUSE_APPLICATION_TASK_TAG == 1 )
         void * pxDummy14;
@@ -1283,6 +1469,7 @@ typedef struct xSTATIC_TCB
     #endif
     #if ( configGENERATE_RUN_TIME_STATS == 1 )
         configRUN_TIME_COUNTER_TYPE ulDummy16;
+        uint32_t ulDummy21;
     #endif
     #if ( ( configUSE_NEWLIB_REENTRANT == 1 ) || ( configUSE_C_RUNTIME_TLS_SUPPORT == 1 ) )
         configTLS_BLOCK_TYPE xDummy17;
@@ -1301,6 +1488,10 @@ typedef struct xSTATIC_TCB
     #if ( configUSE_POSIX_ERRNO == 1 )
         int iDummy22;
     #endif
+    #if ( configUSE_EDF_SCHEDULING == 1 )
+        TickType_t xDummy23[ 5 ];
+        uint32_t ulDummy24[ 2 ];
+    #endif
 } StaticTask_t;
 
 /*
@@ -1343,6 +1534,20 @@ typedef struct xSTATIC_QUEUE
         UBaseType_t uxDummy8;
         uint8_t ucDummy9;
     #endif
+
+    #if ( configUSE_MUTEX_STATS == 1 )
+        struct
+        {
+            uint32_t ulDummy1[ 4 ];
+            configRUN_TIME_COUNTER_TYPE ulDummy2[ 4 ];
+        } xDummy10;
+        configRUN_TIME_COUNTER_TYPE ulDummy11;
+        UBaseType_t uxDummy12;
+    #endif
+
+    #if ( configUSE_OBJECT_REGISTRY == 1 )
+        UBaseType_t uxDummy13;
+    #endif
 } StaticQueue_t;
 typedef StaticQueue_t StaticSemaphore_t;
 
@@ -1398,6 +1603,10 @@ typedef struct xSTATIC_TIMER
     #if ( configUSE_TRACE_FACILITY == 1 )
         UBaseType_t uxDummy7;
     #endif
+    #if ( configUSE_TIMER_PAIRING_HEAP == 1 )
+        void * pvDummy9[ 4 ];
+        UBaseType_t uxDummy10;
+    #endif
     uint8_t ucDummy8;
 } StaticTimer_t;
 
@@ -1426,11 +1635,80 @@ typedef struct xSTATIC_STREAM_BUFFER
     #if ( configUSE_SB_COMPLETED_CALLBACK == 1 )
         void * pvDummy5[ 2 ];
     #endif
+    #if ( configUSE_OBJECT_REGISTRY == 1 )
+        size_t uxDummy6;
+    #endif
 } StaticStreamBuffer_t;
 
 /* Message buffers are built on stream buffers. */
 typedef StaticStreamBuffer_t StaticMessageBuffer_t;
 
+/*
+ * In line with software engineering best practice, FreeRTOS implements a strict
+ * data hiding policy, so the reader-writer lock structure is not accessible to
+ * application code.  StaticRWLock_t has the size and alignment of the real
+ * structure and is provided to allow locks to be created without dynamic
+ * memory allocation.
+ */
+typedef struct xSTATIC_RW_LOCK
+{
+    struct
+    {
+        void * pvDummy1;
+        BaseType_t xDummy2;
+    } xDummy1[ configRWLOCK_MAX_READERS + 1 ];
+    UBaseType_t uxDummy2;
+    StaticList_t xDummy3[ 2 ];
+    uint32_t ulDummy4[ 7 ];
+    #if ( ( configSUPPORT_STATIC_ALLOCATION == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
+        uint8_t ucDummy5;
+    #endif
+} StaticRWLock_t;
+
+/*
+ * As above, StaticLwMutex_t has the size and alignment of the lightweight mutex
+ * structure.
+ */
+typedef struct xSTATIC_LW_MUTEX
+{
+    uint32_t ulDummy1;
+    StaticList_t xDummy2;
+    uint32_t ulDummy3[ 4 ];
+    #if ( ( configSUPPORT_STATIC_ALLOCATION == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
+        uint8_t ucDummy4;
+    #endif
+} StaticLwMutex_t;
+
+/*
+ * As above, StaticEventGroup64_t has the size and alignment of the wide event
+ * group structure.
+ */
+typedef struct xSTATIC_EVENT_GROUP_64
+{
+    uint64_t ullDummy1[ 2 ];
+    StaticList_t xDummy2;
+    void * pvDummy3;
+    BaseType_t xDummy4[ 2 ];
+    #if ( ( configSUPPORT_STATIC_ALLOCATION == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
+        uint8_t ucDummy5;
+    #endif
+} StaticEventGroup64_t;
+
+/*
+ * As above, StaticWorkQueue_t has the size and alignment of the work queue
+ * structure.
+ */
+typedef struct xSTATIC_WORK_QUEUE
+{
+    void * pvDummy1[ 3 ];
+    uint64_t ullDummy2;
+    uint32_t ulDummy3[ 6 ];
+    UBaseType_t uxDummy4[ 2 ];
+    #if ( ( configSUPPORT_STATIC_ALLOCATION == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
+        uint8_t ucDummy5;
+    #endif
+} StaticWorkQueue_t;
+
 /* *INDENT-OFF* */
 #ifdef __cplusplus
     }
@@ -0,0 +1,224 @@
+/*
+ * FreeRTOS Kernel V10.5.1
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+#ifndef EVENT_GROUPS_64_H
+#define EVENT_GROUPS_64_H
+
+#ifndef INC_FREERTOS_H
+    #error "include FreeRTOS.h" must appear in source files before "include event_groups64.h"
+#endif
+
+/* FreeRTOS includes. */
+#include "task.h"
+
+/* *INDENT-OFF* */
+#ifdef __cplusplus
+    extern "C" {
+#endif
+/* *INDENT-ON* */
+
+/**
+ * A wide event group is an event group holding 64 event bits, all of which can
+ * be used, that can also be set from an interrupt without deferring the work
+ * to the timer daemon task.
+ *
+ * The waiting condition of a task blocked on a standard event group is kept in
+ * the task's own event list item, which leaves 24 bits for events, and the list
+ * of waiting tasks is only protected by suspending the scheduler, which is why
+ * xEventGroupSetBitsFromISR() has to pass the work to the daemon task.  A task
+ * blocked on a wide event group instead links a wait record on its own stack
+ * into the group and blocks on a task notification.  The records are only
+ * changed inside critical sections, so xEventGroup64SetBitsFromISR() can wake
+ * waiting tasks itself.  The waiting tasks are checked in steps of at most
+ * configEVENT_GROUPS_64_MAX_CHECKS tasks, each in its own critical section,
+ * so interrupts are masked for a bounded time however many tasks wait.  An
+ * interrupt takes one step and leaves the rest to the daemon task.
+ *
+ * Waiting tasks block on task notification index
+ * configEVENT_GROUPS_64_NOTIFY_INDEX, which should not be used for anything
+ * else.  Tasks are woken in the order in which they started to wait.
+ */
+struct EventGroup64Def_t;
+typedef struct EventGroup64Def_t * EventGroup64Handle_t;
+
+typedef uint64_t EventBits64_t;
+
+/**
+ * EventGroup64Handle_t xEventGroup64Create( void );
+ *
+ * Creates a wide event group with all bits clear, allocating it from the
+ * FreeRTOS heap.
+ *
+ * @return The handle of the event group, or NULL if there was not enough heap.
+ */
+#if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+    EventGroup64Handle_t xEventGroup64Create( void ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * EventGroup64Handle_t xEventGroup64CreateStatic( StaticEventGroup64_t * pxEventGroupBuffer );
+ *
+ * Creates a wide event group with all bits clear in memory provided by the
+ * application.
+ *
+ * @param pxEventGroupBuffer The StaticEventGroup64_t that holds the event group.
+ *
+ * @return The handle of the event group.
+ */
+#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+    EventGroup64Handle_t xEventGroup64CreateStatic( StaticEventGroup64_t * pxEventGroupBuffer ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * EventBits64_t xEventGroup64WaitBits( EventGroup64Handle_t xEventGroup,
+ *                                      const EventBits64_t uxBitsToWaitFor,
+ *                                      const BaseType_t xClearOnExit,
+ *                                      const BaseType_t xWaitForAllBits,
+ *                                      TickType_t xTicksToWait );
+ *
+ * Waits for one or all of the bits in uxBitsToWaitFor to be set, as
+ * xEventGroupWaitBits() does for a standard event group.
+ *
+ * @param xEventGroup The event group to wait on.
+ *
+ * @param uxBitsToWaitFor The bits to wait for, must not be 0.
+ *
+ * @param xClearOnExit pdTRUE to clear the bits in uxBitsToWaitFor when the
+ * condition is met.
+ *
+ * @param xWaitForAllBits pdTRUE to wait for all of uxBitsToWaitFor, pdFALSE to
+ * wait for any of them.
+ *
+ * @param xTicksToWait The maximum time to wait for the condition to be met.
+ *
+ * @return The event bits at the moment the condition was met, before any were
+ * cleared, or the event bits when the block time expired.
+ */
+EventBits64_t xEventGroup64WaitBits( EventGroup64Handle_t xEventGroup,
+                                     const EventBits64_t uxBitsToWaitFor,
+                                     const BaseType_t xClearOnExit,
+                                     const BaseType_t xWaitForAllBits,
+                                     TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * EventBits64_t xEventGroup64SetBits( EventGroup64Handle_t xEventGroup,
+ *                                     const EventBits64_t uxBitsToSet );
+ *
+ * Sets bits in the event group and wakes every task whose condition is then
+ * met.
+ *
+ * @param xEventGroup The event group in which bits are set.
+ *
+ * @param uxBitsToSet The bits to set.
+ *
+ * @return The event bits when the call returns, after the bits the woken tasks
+ * asked for were cleared.
+ */
+EventBits64_t xEventGroup64SetBits( EventGroup64Handle_t xEventGroup,
+                                    const EventBits64_t uxBitsToSet ) PRIVILEGED_FUNCTION;
+
+/**
+ * BaseType_t xEventGroup64SetBitsFromISR( EventGroup64Handle_t xEventGroup,
+ *                                         const EventBits64_t uxBitsToSet,
+ *                                         BaseType_t * pxHigherPriorityTaskWoken );
+ *
+ * Sets bits in the event group from an interrupt.  Up to
+ * configEVENT_GROUPS_64_MAX_CHECKS waiting tasks are checked, and those whose
+ * condition is met woken, directly.  If more tasks are left to check, the rest
+ * of the work is passed to the timer daemon task, and bits that woken tasks
+ * asked to clear are only cleared once every waiting task has been checked.
+ *
+ * @param xEventGroup The event group in which bits are set.
+ *
+ * @param uxBitsToSet The bits to set.
+ *
+ * @param pxHigherPriorityTaskWoken Set to pdTRUE if a task was woken with a
+ * priority above the interrupted task, in which case a context switch should be
+ * requested before the interrupt exits.
+ *
+ * @return pdPASS.  The bits are always set.  If the daemon task queue is full
+ * the remaining tasks are checked by the next call that sets bits or waits on
+ * the group.
+ */
+BaseType_t xEventGroup64SetBitsFromISR( EventGroup64Handle_t xEventGroup,
+                                        const EventBits64_t uxBitsToSet,
+                                        BaseType_t * pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+/**
+ * EventBits64_t xEventGroup64ClearBits( EventGroup64Handle_t xEventGroup,
+ *                                       const EventBits64_t uxBitsToClear );
+ * EventBits64_t xEventGroup64ClearBitsFromISR( EventGroup64Handle_t xEventGroup,
+ *                                              const EventBits64_t uxBitsToClear );
+ *
+ * Clears bits in the event group.  Clearing bits cannot wake a task, so the
+ * interrupt version does the work directly as well.
+ *
+ * @param xEventGroup The event group in which bits are cleared.
+ *
+ * @param uxBitsToClear The bits to clear.
+ *
+ * @return The event bits before they were cleared.
+ */
+EventBits64_t xEventGroup64ClearBits( EventGroup64Handle_t xEventGroup,
+                                      const EventBits64_t uxBitsToClear ) PRIVILEGED_FUNCTION;
+EventBits64_t xEventGroup64ClearBitsFromISR( EventGroup64Handle_t xEventGroup,
+                                             const EventBits64_t uxBitsToClear ) PRIVILEGED_FUNCTION;
+
+/**
+ * EventBits64_t xEventGroup64GetBits( EventGroup64Handle_t xEventGroup );
+ * EventBits64_t xEventGroup64GetBitsFromISR( EventGroup64Handle_t xEventGroup );
+ *
+ * @return The current event bits.  The two halves are read together, so the
+ * value is never torn by a concurrent set or clear.
+ */
+EventBits64_t xEventGroup64GetBits( EventGroup64Handle_t xEventGroup ) PRIVILEGED_FUNCTION;
+EventBits64_t xEventGroup64GetBitsFromISR( EventGroup64Handle_t xEventGroup ) PRIVILEGED_FUNCTION;
+
+/**
+ * void vEventGroup64Delete( EventGroup64Handle_t xEventGroup );
+ *
+ * Deletes an event group, freeing its memory if it was created by
+ * xEventGroup64Create().  Tasks waiting on the group are woken and their wait
+ * returns 0.
+ *
+ * @param xEventGroup The event group being deleted.
+ */
+void vEventGroup64Delete( EventGroup64Handle_t xEventGroup ) PRIVILEGED_FUNCTION;
+
+/* For internal use only, executes the part of xEventGroup64SetBitsFromISR()
+ * passed to the timer daemon task. */
+void vEventGroup64WakeWaitersCallback( void * pvEventGroup,
+                                       const uint32_t ulUnused ) PRIVILEGED_FUNCTION;
+
+/* *INDENT-OFF* */
+#ifdef __cplusplus
+    }
+#endif
+/* *INDENT-ON* */
+
+#endif /* EVENT_GROUPS_64_H */
@@ -0,0 +1,164 @@
+/*
+ * FreeRTOS Kernel V10.5.1
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+#ifndef LW_MUTEX_H
+#define LW_MUTEX_H
+
+#ifndef INC_FREERTOS_H
+    #error "include FreeRTOS.h" must appear in source files before "include lwmutex.h"
+#endif
+
+/* FreeRTOS includes. */
+#include "task.h"
+
+/* *INDENT-OFF* */
+#ifdef __cplusplus
+    extern "C" {
+#endif
+/* *INDENT-ON* */
+
+/**
+ * A lightweight mutex is a non-recursive mutex for tasks whose uncontended
+ * take and give are a single exclusive load/store compare-and-swap on the
+ * holder word, without entering a critical section or the queue code used by
+ * xSemaphoreCreateMutex().  Only when the mutex is already held does the
+ * taking task fall back to a kernel wait list, where it inherits its priority
+ * to the holder exactly as a queue based mutex does.  Ownership is handed
+ * directly to the highest priority waiting task when the holder gives the
+ * mutex, so a lower priority task cannot take it in between.
+ *
+ * Lightweight mutexes cannot be used from interrupts or while the scheduler is
+ * suspended.
+ */
+struct LwMutexDef_t;
+typedef struct LwMutexDef_t * LwMutexHandle_t;
+
+/*
+ * Contention statistics kept by every lightweight mutex.
+ */
+typedef struct xLW_MUTEX_STATS
+{
+    uint32_t ulTakes;                /*<< Successful takes. */
+    uint32_t ulContendedTakes;       /*<< Takes that found the mutex held and had to block. */
+    uint32_t ulTimeouts;             /*<< Takes that gave up because the block time expired. */
+    uint32_t ulPriorityInheritances; /*<< Takes that raised the priority of the holder. */
+} LwMutexStats_t;
+
+/**
+ * LwMutexHandle_t xLwMutexCreate( void );
+ *
+ * Creates a lightweight mutex, allocating it from the FreeRTOS heap.
+ *
+ * @return The handle of the mutex, or NULL if there was not enough heap.
+ */
+#if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+    LwMutexHandle_t xLwMutexCreate( void ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * LwMutexHandle_t xLwMutexCreateStatic( StaticLwMutex_t * pxMutexBuffer );
+ *
+ * Creates a lightweight mutex in memory provided by the application.
+ *
+ * @param pxMutexBuffer The StaticLwMutex_t that holds the mutex.
+ *
+ * @return The handle of the mutex.
+ */
+#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+    LwMutexHandle_t xLwMutexCreateStatic( StaticLwMutex_t * pxMutexBuffer ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * BaseType_t xLwMutexTake( LwMutexHandle_t xMutex, TickType_t xTicksToWait );
+ *
+ * Takes the mutex, blocking for up to xTicksToWait ticks if another task holds
+ * it.  The mutex is not recursive, a task must not take a mutex it holds.
+ *
+ * @param xMutex The mutex to take.
+ *
+ * @param xTicksToWait The maximum time to wait for the mutex, 0 to return
+ * immediately and portMAX_DELAY to wait indefinitely when INCLUDE_vTaskSuspend
+ * is 1.
+ *
+ * @return pdPASS if the mutex was taken, pdFAIL if the block time expired
+ * first.
+ */
+BaseType_t xLwMutexTake( LwMutexHandle_t xMutex,
+                         TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * BaseType_t xLwMutexGive( LwMutexHandle_t xMutex );
+ *
+ * Gives a mutex the calling task holds.  If tasks are waiting the highest
+ * priority one becomes the holder, and any priority the calling task inherited
+ * through this mutex is dropped.
+ *
+ * @param xMutex The mutex to give.
+ *
+ * @return pdPASS if the mutex was given, pdFAIL if the calling task does not
+ * hold it.
+ */
+BaseType_t xLwMutexGive( LwMutexHandle_t xMutex ) PRIVILEGED_FUNCTION;
+
+/**
+ * TaskHandle_t xLwMutexGetHolder( LwMutexHandle_t xMutex );
+ *
+ * @return The task holding the mutex, or NULL if the mutex is free.  The value
+ * can be out of date by the time it is used unless the caller is the holder.
+ */
+TaskHandle_t xLwMutexGetHolder( LwMutexHandle_t xMutex ) PRIVILEGED_FUNCTION;
+
+/**
+ * void vLwMutexGetStats( LwMutexHandle_t xMutex, LwMutexStats_t * pxStats );
+ *
+ * Copies the contention statistics of the mutex.
+ *
+ * @param xMutex The mutex being queried.
+ *
+ * @param pxStats The structure into which the statistics are copied.
+ */
+void vLwMutexGetStats( LwMutexHandle_t xMutex,
+                       LwMutexStats_t * pxStats ) PRIVILEGED_FUNCTION;
+
+/**
+ * void vLwMutexDelete( LwMutexHandle_t xMutex );
+ *
+ * Deletes a mutex that no task holds or is waiting for, freeing its memory if
+ * it was created by xLwMutexCreate().
+ *
+ * @param xMutex The mutex being deleted.
+ */
+void vLwMutexDelete( LwMutexHandle_t xMutex ) PRIVILEGED_FUNCTION;
+
+/* *INDENT-OFF* */
+#ifdef __cplusplus
+    }
+#endif
+/* *INDENT-ON* */
+
+#endif /* LW_MUTEX_H */
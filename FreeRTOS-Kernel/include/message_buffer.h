@@ -766,6 +766,99 @@ typedef StreamBufferHandle_t MessageBufferHandle_t;
 #define xMessageBufferNextLengthBytes( xMessageBuffer ) \
     xStreamBufferNextMessageLengthBytes( xMessageBuffer ) PRIVILEGED_FUNCTION;
 
+/**
+ * message_buffer.h
+ * @code{c}
+ * size_t xMessageBufferPeek( MessageBufferHandle_t xMessageBuffer,
+ *                            StreamBufferSpans_t * const pxSpans,
+ *                            TickType_t xTicksToWait );
+ * @endcode
+ *
+ * Returns the oldest message in a message buffer without copying it out.  The
+ * message is described by pxSpans: it starts at pxSpans->pucSpan[ 0 ] and, if
+ * it wraps around the end of the buffer's storage area, continues at
+ * pxSpans->pucSpan[ 1 ].  The message stays in the buffer, and the spans stay
+ * valid, until it is removed by vMessageBufferRelease().  Peeking again
+ * without releasing returns the same message.
+ *
+ * As with xMessageBufferReceive() there can only be one reader.  Use
+ * xMessageBufferPeek() and vMessageBufferRelease() from an interrupt with an
+ * xTicksToWait of 0 and vMessageBufferReleaseFromISR().
+ *
+ * @param xMessageBuffer The handle of the message buffer to read from.
+ *
+ * @param pxSpans Set to describe the message.
+ *
+ * @param xTicksToWait The maximum time to wait for a message if the buffer is
+ * empty.
+ *
+ * @return The length of the message, 0 if there was no message.
+ *
+ * \defgroup xMessageBufferPeek xMessageBufferPeek
+ * \ingroup MessageBufferManagement
+ */
+#define xMessageBufferPeek( xMessageBuffer, pxSpans, xTicksToWait ) \
+    xStreamBufferPeekMessage( xMessageBuffer, pxSpans, xTicksToWait )
+
+/**
+ * message_buffer.h
+ * @code{c}
+ * void vMessageBufferRelease( MessageBufferHandle_t xMessageBuffer );
+ * void vMessageBufferReleaseFromISR( MessageBufferHandle_t xMessageBuffer,
+ *                                    BaseType_t * pxHigherPriorityTaskWoken );
+ * @endcode
+ *
+ * Removes the message returned by xMessageBufferPeek() from the message
+ * buffer, unblocking a task waiting for space as xMessageBufferReceive() does.
+ * There must be a message in the buffer.
+ *
+ * @param xMessageBuffer The handle of the message buffer read from.
+ *
+ * @param pxHigherPriorityTaskWoken Set to pdTRUE if the release unblocked a
+ * task with a priority above the interrupted task.
+ *
+ * \defgroup vMessageBufferRelease vMessageBufferRelease
+ * \ingroup MessageBufferManagement
+ */
+#define vMessageBufferRelease( xMessageBuffer ) \
+    vStreamBufferReleaseMessage( xMessageBuffer )
+#define vMessageBufferReleaseFromISR( xMessageBuffer, pxHigherPriorityTaskWoken ) \
+    vStreamBufferReleaseMessageFromISR( xMessageBuffer, pxHigherPriorityTaskWoken )
+
+/**
+ * message_buffer.h
+ * @code{c}
+ * size_t xMessageBufferDrain( MessageBufferHandle_t xMessageBuffer,
+ *                             StreamBufferMessageCallback_t pxCallback,
+ *                             void * pvContext,
+ *                             TickType_t xTicksToWait );
+ * @endcode
+ *
+ * Passes every message in a message buffer to pxCallback in place, oldest
+ * first, then removes them all at once.  Compared to a loop of
+ * xMessageBufferReceive() no message is copied and a task waiting for space
+ * is notified once rather than once per message.  Messages written while the
+ * buffer is being drained are left for the next call.
+ *
+ * @param xMessageBuffer The handle of the message buffer to drain.
+ *
+ * @param pxCallback Called for each message with a description of the message
+ * in place, its length and pvContext.  Returning pdFALSE stops the drain after
+ * that message, leaving the later ones in the buffer.
+ *
+ * @param pvContext Passed to pxCallback.
+ *
+ * @param xTicksToWait The maximum time to wait for a message if the buffer is
+ * empty.
+ *
+ * @return The number of messages removed.
+ *
+ * \defgroup xMessageBufferDrain xMessageBufferDrain
+ * \ingroup MessageBufferManagement
+ */
+#define xMessageBufferDrain( xMessageBuffer, pxCallback, pvContext, xTicksToWait ) \
+    xStreamBufferDrainMessages( xMessageBuffer, pxCallback, pvContext, xTicksToWait )
+
 /**
  * message_buffer.h
  *
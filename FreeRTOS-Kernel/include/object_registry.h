@@ -0,0 +1,173 @@
+/*
+ * FreeRTOS Kernel V10.5.1
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+#ifndef OBJECT_REGISTRY_H
+#define OBJECT_REGISTRY_H
+
+#ifndef INC_FREERTOS_H
+    #error "include FreeRTOS.h" must appear in source files before "include object_registry.h"
+#endif
+
+/* FreeRTOS includes. */
+#include "task.h"
+#include "queue.h"
+#include "timers.h"
+#include "stream_buffer.h"
+
+/* *INDENT-OFF* */
+#ifdef __cplusplus
+    extern "C" {
+#endif
+/* *INDENT-ON* */
+
+/**
+ * The object registry records every task, queue, semaphore, mutex, software
+ * timer, stream buffer and message buffer while it exists, so a debug tool can
+ * list them with their live metrics without knowing the application.  The
+ * kernel adds an object when it is created and removes it when it is deleted,
+ * the application only has to name the objects that have no name of their own
+ * or mark a queue as the queue of an event loop, see xObjectRegistryDescribe().
+ *
+ * The registry holds configOBJECT_REGISTRY_SIZE objects.  Objects created while
+ * it is full are counted, see uxObjectRegistryGetOverflowCount(), but not
+ * listed.
+ */
+
+/* Values of ObjectInfo_t.ucType. */
+#define registryTYPE_TASK              ( ( uint8_t ) 1U )
+#define registryTYPE_QUEUE             ( ( uint8_t ) 2U )
+#define registryTYPE_SEMAPHORE         ( ( uint8_t ) 3U )
+#define registryTYPE_MUTEX             ( ( uint8_t ) 4U )
+#define registryTYPE_TIMER             ( ( uint8_t ) 5U )
+#define registryTYPE_STREAM_BUFFER     ( ( uint8_t ) 6U )
+#define registryTYPE_MESSAGE_BUFFER    ( ( uint8_t ) 7U )
+#define registryTYPE_EVENT_LOOP        ( ( uint8_t ) 8U )
+
+/* Length of ObjectInfo_t.acName. */
+#define registryNAME_LENGTH            14
+
+/*
+ * The state of one object, 32 bytes with no padding so it can be streamed to a
+ * host as it is.  The meaning of the metrics depends on the type:
+ *
+ * Type              Capacity        Level               HighWater           State
+ * Task              base priority   current priority    min free stack      eTaskState
+ * Queue/EventLoop   length          items waiting       max items waiting   queue type
+ * Semaphore/Mutex   max count       count               max count reached   queue type
+ * Timer             period (ticks)  0                   0                   pdTRUE if active
+ * Stream/Message    size (bytes)    bytes in buffer     max bytes reached   0
+ *
+ * Storage is the stack of a task, the storage area of a queue or stream buffer
+ * and 0 for the rest.  Values above 0xFFFF are reported as 0xFFFF.  Stream and
+ * message buffers have at most one waiting sender and one waiting receiver.
+ */
+typedef struct xOBJECT_INFO
+{
+    uint32_t ulHandle;                  /*< Handle of the object, the address of its control block. */
+    uint32_t ulStorage;                 /*< Address of the memory the object stores its data in. */
+    uint16_t usCapacity;
+    uint16_t usLevel;
+    uint16_t usHighWater;
+    uint8_t ucType;                     /*< One of the registryTYPE_ values. */
+    uint8_t ucState;
+    uint8_t ucWaitingToSend;            /*< Tasks blocked to send to or give the object. */
+    uint8_t ucWaitingToReceive;         /*< Tasks blocked to receive from or take the object. */
+    char acName[ registryNAME_LENGTH ]; /*< Truncated, not terminated when it fills the array, "" if the object has no name. */
+} ObjectInfo_t;
+
+/**
+ * BaseType_t xObjectRegistryDescribe( void * pvObject,
+ *                                     uint8_t ucType,
+ *                                     const char * pcName );
+ *
+ * Names a registered object, and optionally changes how it is listed.  The
+ * name overrides the name of a task or timer and the queue registry name of a
+ * queue.
+ *
+ * @param pvObject The handle of the object.
+ *
+ * @param ucType registryTYPE_EVENT_LOOP to list a queue as the queue of an
+ * event loop, 0 to keep the type.
+ *
+ * @param pcName The name, which is referenced rather than copied, or NULL to
+ * keep the name.
+ *
+ * @return pdPASS if the object was found in the registry, otherwise pdFAIL.
+ */
+BaseType_t xObjectRegistryDescribe( void * pvObject,
+                                    uint8_t ucType,
+                                    const char * pcName ) PRIVILEGED_FUNCTION;
+
+/**
+ * UBaseType_t uxObjectRegistryGetSnapshot( ObjectInfo_t * const pxObjectArray,
+ *                                          const UBaseType_t uxArraySize );
+ *
+ * Fills pxObjectArray with the state of the registered objects, in the order
+ * they were registered in free entries.  The scheduler is suspended while the
+ * array is filled, so no object can be deleted part way through.  The stack of
+ * each task is then scanned for its high-water mark with the scheduler
+ * suspended for one stack at a time, so the call should be made from a low
+ * priority task.  Interrupts are not disabled, so the metrics of objects used
+ * by interrupts can change while they are read.
+ *
+ * @param pxObjectArray The array to fill.
+ *
+ * @param uxArraySize The number of entries in pxObjectArray.
+ *
+ * @return The number of entries filled, at most uxArraySize.
+ */
+UBaseType_t uxObjectRegistryGetSnapshot( ObjectInfo_t * const pxObjectArray,
+                                         const UBaseType_t uxArraySize ) PRIVILEGED_FUNCTION;
+
+/**
+ * UBaseType_t uxObjectRegistryGetOverflowCount( void );
+ *
+ * @return The number of objects that were created while the registry was full
+ * and so are not listed.
+ */
+UBaseType_t uxObjectRegistryGetOverflowCount( void ) PRIVILEGED_FUNCTION;
+
+/* For internal use only, called by the kernel when an object is created or
+ * deleted. */
+void vObjectRegistryAdd( void * pvObject,
+                         uint8_t ucType ) PRIVILEGED_FUNCTION;
+void vObjectRegistryRemove( void * pvObject ) PRIVILEGED_FUNCTION;
+
+/* For internal use only, fill the metrics of one queue or stream buffer. */
+void vQueueGetObjectInfo( QueueHandle_t xQueue,
+                          ObjectInfo_t * pxInfo ) PRIVILEGED_FUNCTION;
+void vStreamBufferGetObjectInfo( StreamBufferHandle_t xStreamBuffer,
+                                 ObjectInfo_t * pxInfo ) PRIVILEGED_FUNCTION;
+
+/* *INDENT-OFF* */
+#ifdef __cplusplus
+    }
+#endif
+/* *INDENT-ON* */
+
+#endif /* OBJECT_REGISTRY_H */
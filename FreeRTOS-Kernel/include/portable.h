@@ -131,13 +131,34 @@
 #endif /* if ( portUSING_MPU_WRAPPERS == 1 ) */
 
 /* Used by heap_5.c to define the start address and size of each memory region
- * that together comprise the total FreeRTOS heap space. */
+ * that together comprise the total FreeRTOS heap space.  uxAttributes is a
+ * combination of the portHEAP_REGION_ values below and can be left out of the
+ * initialiser, in which case the region is a general one. */
 typedef struct HeapRegion
 {
     uint8_t * pucStartAddress;
     size_t xSizeInBytes;
+    UBaseType_t uxAttributes;
 } HeapRegion_t;
 
+/* Heap region attributes, also used as placement hints by
+ * pvPortMallocWithHint(). */
+#define portHEAP_REGION_GENERAL    ( ( UBaseType_t ) 0x00 ) /* No particular property, the default for pvPortMalloc(). */
+#define portHEAP_REGION_DMA        ( ( UBaseType_t ) 0x01 ) /* The DMA controllers can read and write the region. */
+#define portHEAP_REGION_FAST       ( ( UBaseType_t ) 0x02 ) /* The region has the fastest access, for example tightly coupled memory. */
+
+/* Used to pass the usage of one heap_5.c region out of vPortGetHeapRegionStats(). */
+typedef struct xHeapRegionStats
+{
+    uint8_t * pucStartAddress;             /* The start of the region, after alignment. */
+    size_t xSizeInBytes;                   /* The bytes available for allocation when the region is empty. */
+    UBaseType_t uxAttributes;              /* The portHEAP_REGION_ attributes of the region. */
+    size_t xAvailableBytes;                /* The bytes currently free in the region. */
+    size_t xMinimumEverAvailableBytes;     /* The lowest value xAvailableBytes has reached. */
+    size_t xNumberOfSuccessfulAllocations; /* The number of blocks allocated from the region. */
+    size_t xNumberOfSuccessfulFrees;       /* The number of blocks returned to the region. */
+} HeapRegionStats_t;
+
 /* Used to pass information about the heap out of vPortGetHeapStats(). */
 typedef struct xHeapStats
 {
@@ -150,6 +171,84 @@ typedef struct xHeapStats
     size_t xNumberOfSuccessfulFrees;        /* The number of calls to vPortFree() that has successfully freed a block of memory. */
 } HeapStats_t;
 
+/* Used to pass information about one block pool out of vPortGetBlockPoolStats(). */
+typedef struct xBlockPoolStats
+{
+    size_t xBlockSize;                 /* The size, in bytes, of every block in the pool. */
+    size_t xNumberOfBlocks;            /* The number of blocks the pool holds. */
+    size_t xBlocksInUse;               /* The number of blocks currently allocated from the pool. */
+    size_t xMaximumBlocksInUse;        /* The largest number of blocks that have been allocated from the pool at once. */
+    size_t xNumberOfAllocations;       /* The number of allocations the pool has served. */
+    size_t xNumberOfFailedAllocations; /* The number of allocations that fitted the pool but found it empty. */
+} BlockPoolStats_t;
+
+/* The number of free block size classes counted in HeapFragmentationStats_t. */
+#define portHEAP_FRAGMENTATION_BINS    8
+
+/* The xFreeBlocksBySize[] entry that counts a free block of xBlockSize bytes,
+ * shared by the heap implementations.  xBlockSize is evaluated more than
+ * once. */
+#define portHEAP_FRAGMENTATION_BIN( xBlockSize )                        \
+    ( ( ( xBlockSize ) < ( size_t ) 32U ) ? ( UBaseType_t ) 0U :        \
+      ( ( xBlockSize ) < ( size_t ) 64U ) ? ( UBaseType_t ) 1U :        \
+      ( ( xBlockSize ) < ( size_t ) 128U ) ? ( UBaseType_t ) 2U :       \
+      ( ( xBlockSize ) < ( size_t ) 256U ) ? ( UBaseType_t ) 3U :       \
+      ( ( xBlockSize ) < ( size_t ) 512U ) ? ( UBaseType_t ) 4U :       \
+      ( ( xBlockSize ) < ( size_t ) 1024U ) ? ( UBaseType_t ) 5U :      \
+      ( ( xBlockSize ) < ( size_t ) 2048U ) ? ( UBaseType_t ) 6U :      \
+      ( UBaseType_t ) 7U )
+
+/* Used to pass the free space layout out of vPortGetHeapFragmentationStats().
+ * Every member is kept up to date as blocks are allocated and freed, so
+ * reading it does not walk the free list. */
+typedef struct xHeapFragmentationStats
+{
+    size_t xAvailableHeapSpaceInBytes;                    /* The total heap size currently available - this is the sum of all the free blocks, not the largest block that can be allocated. */
+    size_t xSizeOfLargestFreeBlockInBytes;                /* The maximum size, in bytes, of all the free blocks within the heap at the time vPortGetHeapFragmentationStats() is called. */
+    size_t xNumberOfFreeBlocks;                           /* The number of free memory blocks within the heap at the time vPortGetHeapFragmentationStats() is called. */
+    size_t xFragmentationPermille;                        /* External fragmentation, 1000 * ( 1 - largest free block / available space ), 0 when the free space is in one block. */
+    size_t xMaximumFragmentationPermille;                 /* The largest value xFragmentationPermille has reached. */
+    size_t xFreeBlocksBySize[ portHEAP_FRAGMENTATION_BINS ]; /* Free blocks by size, entry 0 counts blocks under 32 bytes, entry n blocks from 2^(n+4) to 2^(n+5)-1 bytes, and the last entry every larger block. */
+} HeapFragmentationStats_t;
+
+/* Used to pass the heap usage of one task out of uxPortGetHeapTaskUsage(). */
+typedef struct xHeapTaskUsage
+{
+    struct tskTaskControlBlock * xTask; /* The task the entry belongs to, NULL for allocations made before the scheduler started. */
+    size_t xLiveBytes;                  /* The bytes, including block headers, the task has allocated and not yet freed.  A block pool block counts as the pool's block size. */
+    size_t xPeakLiveBytes;              /* The largest value xLiveBytes has reached. */
+    size_t xNumberOfAllocations;        /* The number of blocks the task has allocated. */
+    size_t xNumberOfFrees;              /* The number of the task's blocks that have been freed, by any task. */
+} HeapTaskUsage_t;
+
+/* The owner, call-site and time of an allocated block when
+ * configUSE_HEAP_TRACKING is 1.  heap_4.c, heap_5.c and heap_tlsf.c keep it
+ * in the block header, block_pools.c beside the pool as pool blocks have no
+ * header. */
+typedef struct xHeapBlockTag
+{
+    void * pvCaller;       /* The return address of the pvPortMalloc() call that allocated the block. */
+    TickType_t xTimeStamp; /* The tick count when the block was allocated. */
+    UBaseType_t uxOwner;   /* The accounting slot of the allocating task, portHEAP_TRACE_NO_TASK if there was none. */
+} HeapBlockTag_t;
+
+/* One record of the allocation trace passed to vApplicationHeapTraceHook().
+ * The record is 16 bytes with no padding so it can be streamed as it is. */
+typedef struct xHeapTraceRecord
+{
+    uint32_t ulTimeStamp; /* The tick count at the time of the call, or the monotonic clock in microseconds, wrapping every 71 minutes, with configUSE_MONOTONIC_CLOCK. */
+    uint32_t ulAddress;   /* The address returned by pvPortMalloc() or passed to vPortFree(), 0 if the allocation failed. */
+    uint32_t ulCaller;    /* The return address of the pvPortMalloc() or vPortFree() call. */
+    uint16_t usBlockSize; /* The size of the block including its header, the pool's block size for a block pool block, or the requested size if the allocation failed. */
+    uint8_t ucEvent;      /* One of the portHEAP_TRACE_EVENT_ values. */
+    uint8_t ucTask;       /* The owner of the block as an index into the uxPortGetHeapTaskUsage() array, portHEAP_TRACE_NO_TASK if none. */
+} HeapTraceRecord_t;
+
+#define portHEAP_TRACE_EVENT_MALLOC           ( ( uint8_t ) 0 )
+#define portHEAP_TRACE_EVENT_FREE             ( ( uint8_t ) 1 )
+#define portHEAP_TRACE_EVENT_MALLOC_FAILED    ( ( uint8_t ) 2 )
+#define portHEAP_TRACE_NO_TASK                ( ( uint8_t ) 0xff )
+
 /*
  * Used to define multiple heap regions for use by heap_5.c.  This function
  * must be called before any calls to pvPortMalloc() - not creating a task,
@@ -163,12 +262,60 @@ typedef struct xHeapStats
  */
 void vPortDefineHeapRegions( const HeapRegion_t * const pxHeapRegions ) PRIVILEGED_FUNCTION;
 
+/*
+ * Region placement provided by heap_5.c.  pvPortMallocWithHint() allocates
+ * only from regions that have every attribute in uxHint, while pvPortMalloc()
+ * prefers general regions and falls back to the others when they are full.
+ * vPortGetHeapRegionStats() reports the usage of region uxRegion, numbered
+ * in the order the regions were passed to vPortDefineHeapRegions().
+ */
+void * pvPortMallocWithHint( size_t xSize,
+                             UBaseType_t uxHint ) PRIVILEGED_FUNCTION;
+UBaseType_t uxPortGetNumberOfHeapRegions( void );
+void vPortGetHeapRegionStats( UBaseType_t uxRegion,
+                              HeapRegionStats_t * pxRegionStats );
+
 /*
  * Returns a HeapStats_t structure filled with information about the current
  * heap state.
  */
 void vPortGetHeapStats( HeapStats_t * pxHeapStats );
 
+/*
+ * Fixed size block pools placed in front of the heap when configUSE_BLOCK_POOLS
+ * is 1 - see block_pools.c.  pvPortBlockPoolAlloc() returns NULL if xSize does
+ * not fit a pool or the pools that fit it are empty, and xPortBlockPoolFree()
+ * returns pdFALSE if pv was not allocated from a pool.  Both can be called
+ * from interrupts.  With configUSE_HEAP_TRACKING, pxPortBlockPoolGetTag()
+ * returns the tag the heap keeps for a pool block and sets *pxBlockSize to the
+ * pool's block size, or returns NULL if pv is not in a pool.
+ */
+void * pvPortBlockPoolAlloc( size_t xSize );
+BaseType_t xPortBlockPoolFree( void * pv );
+HeapBlockTag_t * pxPortBlockPoolGetTag( const void * pv,
+                                        size_t * pxBlockSize );
+UBaseType_t uxPortGetNumberOfBlockPools( void );
+void vPortGetBlockPoolStats( UBaseType_t uxPool,
+                             BlockPoolStats_t * pxPoolStats );
+
+/*
+ * Returns a HeapFragmentationStats_t structure describing the free space of
+ * heap_4.c when configUSE_HEAP_FRAGMENTATION_STATS is 1.  The members are
+ * maintained as the heap changes, so this only copies them in a short
+ * critical section and can be called periodically from a monitoring task.
+ */
+void vPortGetHeapFragmentationStats( HeapFragmentationStats_t * pxFragmentationStats );
+
+/*
+ * Per task heap accounting provided by heap_4.c, heap_5.c and heap_tlsf.c
+ * when configUSE_HEAP_TRACKING is 1, block pool blocks included.  Fills pxTaskUsageArray with one entry per accounting slot, so the
+ * array index of an entry is the task index used in HeapTraceRecord_t, and
+ * returns the number of entries written.  Entries that have never been used
+ * have xNumberOfAllocations set to 0.
+ */
+UBaseType_t uxPortGetHeapTaskUsage( HeapTaskUsage_t * const pxTaskUsageArray,
+                                    const UBaseType_t uxArraySize );
+
 /*
  * Map to the memory management routines required for the port.
  */
@@ -201,6 +348,22 @@ size_t xPortGetMinimumEverFreeHeapSize( void ) PRIVILEGED_FUNCTION;
     void vApplicationMallocFailedHook( void ); /*lint !e526 Symbol not defined as it is an application callback. */
 #endif
 
+#if ( configUSE_HEAP_TRACE == 1 )
+
+/**
+ * portable.h
+ * @code{c}
+ * void vApplicationHeapTraceHook( const HeapTraceRecord_t * pxRecord )
+ * @endcode
+ *
+ * This hook function is called by heap_4.c, heap_5.c and heap_tlsf.c for every
+ * allocation, failed allocation and free of a heap or block pool block.  It is called with the scheduler
+ * suspended so it must not block, and should do no more than copy the record
+ * out, for example into an RTT buffer.
+ */
+    void vApplicationHeapTraceHook( const HeapTraceRecord_t * pxRecord ); /*lint !e526 Symbol not defined as it is an application callback. */
+#endif
+
 /*
  * Setup the hardware ready for the scheduler to take control.  This generally
  * sets up a tick interrupt and sets timers for the correct tick frequency.
@@ -1466,6 +1466,29 @@ BaseType_t xQueueSemaphoreTake( QueueHandle_t xQueue,
 TaskHandle_t xQueueGetMutexHolder( QueueHandle_t xSemaphore ) PRIVILEGED_FUNCTION;
 TaskHandle_t xQueueGetMutexHolderFromISR( QueueHandle_t xSemaphore ) PRIVILEGED_FUNCTION;
 
+/*
+ * Statistics kept by every mutex when configUSE_MUTEX_STATS is 1.  Times are
+ * in run time counter units when configGENERATE_RUN_TIME_STATS is 1, and in
+ * ticks otherwise.  For internal use only, use vSemaphoreGetMutexStats()
+ * instead of calling vQueueGetMutexStats() directly.
+ */
+typedef struct xMUTEX_STATS
+{
+    uint32_t ulTakes;                           /*<< Successful takes, a recursive mutex counts only the outermost take. */
+    uint32_t ulContendedTakes;                  /*<< Takes that found the mutex held and had to block. */
+    uint32_t ulTimeouts;                        /*<< Takes that gave up because the block time expired. */
+    uint32_t ulLockOrderInversions;             /*<< Takes that reversed the order in which this and another mutex were taken before. */
+    configRUN_TIME_COUNTER_TYPE ulTotalHoldTime;
+    configRUN_TIME_COUNTER_TYPE ulMaxHoldTime;
+    configRUN_TIME_COUNTER_TYPE ulTotalWaitTime; /*<< Time spent blocked by takes that had to block, timed out or not. */
+    configRUN_TIME_COUNTER_TYPE ulMaxWaitTime;
+} MutexStats_t;
+
+#if ( configUSE_MUTEX_STATS == 1 )
+    void vQueueGetMutexStats( QueueHandle_t xMutex,
+                              MutexStats_t * pxStats ) PRIVILEGED_FUNCTION;
+#endif
+
 /*
  * For internal use only.  Use xSemaphoreTakeMutexRecursive() or
  * xSemaphoreGiveMutexRecursive() instead of calling these functions directly.
@@ -1705,6 +1728,9 @@ QueueSetMemberHandle_t xQueueSelectFromSetFromISR( QueueSetHandle_t xQueueSet )
 void vQueueWaitForMessageRestricted( QueueHandle_t xQueue,
                                      TickType_t xTicksToWait,
                                      const BaseType_t xWaitIndefinitely ) PRIVILEGED_FUNCTION;
+UBaseType_t uxQueueReceiveBatchRestricted( QueueHandle_t xQueue,
+                                           void * const pvBuffer,
+                                           const UBaseType_t uxMaxItems ) PRIVILEGED_FUNCTION;
 BaseType_t xQueueGenericReset( QueueHandle_t xQueue,
                                BaseType_t xNewQueue ) PRIVILEGED_FUNCTION;
 void vQueueSetQueueNumber( QueueHandle_t xQueue,
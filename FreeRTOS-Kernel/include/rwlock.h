@@ -0,0 +1,187 @@
+/*
+ * FreeRTOS Kernel V10.5.1
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+#ifndef RW_LOCK_H
+#define RW_LOCK_H
+
+#ifndef INC_FREERTOS_H
+    #error "include FreeRTOS.h" must appear in source files before "include rwlock.h"
+#endif
+
+/* FreeRTOS includes. */
+#include "task.h"
+
+/* *INDENT-OFF* */
+#ifdef __cplusplus
+    extern "C" {
+#endif
+/* *INDENT-ON* */
+
+/**
+ * A reader-writer lock lets up to configRWLOCK_MAX_READERS tasks hold it for
+ * reading at the same time, or a single task hold it for writing.  It suits
+ * data that is read far more often than it is changed, such as configuration
+ * tables, which a mutex would serialise entirely.
+ *
+ * Writers have preference: once a writer is waiting no new reader is let in,
+ * and when the lock is released a waiting writer is always served before
+ * waiting readers.  Readers can therefore be starved by a continuous stream
+ * of writers, but a writer never waits for more than the readers that held the
+ * lock when it arrived.
+ *
+ * A task that blocks raises the priority of the writer holding the lock, or of
+ * every reader holding it, in the same way as a mutex.  Readers are tracked
+ * individually for this purpose, which is what bounds the number of readers.
+ *
+ * Reader-writer locks cannot be used from interrupts, and are not recursive.
+ */
+struct RWLockDef_t;
+typedef struct RWLockDef_t * RWLockHandle_t;
+
+/*
+ * Contention statistics kept by every reader-writer lock.
+ */
+typedef struct xRW_LOCK_STATS
+{
+    uint32_t ulReadLocks;            /*<< Successful read locks. */
+    uint32_t ulWriteLocks;           /*<< Successful write locks. */
+    uint32_t ulContendedReadLocks;   /*<< Read locks that had to block. */
+    uint32_t ulContendedWriteLocks;  /*<< Write locks that had to block. */
+    uint32_t ulTimeouts;             /*<< Read or write locks that gave up because the block time expired. */
+    uint32_t ulPriorityInheritances; /*<< Read or write locks that raised the priority of a holder. */
+    uint32_t ulMaxConcurrentReaders; /*<< The most readers that held the lock at once. */
+} RWLockStats_t;
+
+/**
+ * RWLockHandle_t xRWLockCreate( void );
+ *
+ * Creates a reader-writer lock, allocating it from the FreeRTOS heap.
+ *
+ * @return The handle of the lock, or NULL if there was not enough heap.
+ */
+#if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+    RWLockHandle_t xRWLockCreate( void ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * RWLockHandle_t xRWLockCreateStatic( StaticRWLock_t * pxLockBuffer );
+ *
+ * Creates a reader-writer lock in memory provided by the application.
+ *
+ * @param pxLockBuffer The StaticRWLock_t that holds the lock.
+ *
+ * @return The handle of the lock.
+ */
+#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+    RWLockHandle_t xRWLockCreateStatic( StaticRWLock_t * pxLockBuffer ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * BaseType_t xRWLockReadLock( RWLockHandle_t xLock, TickType_t xTicksToWait );
+ *
+ * Takes the lock for reading, blocking for up to xTicksToWait ticks while a
+ * writer holds or is waiting for the lock, or configRWLOCK_MAX_READERS readers
+ * hold it.
+ *
+ * @param xLock The lock to take.
+ *
+ * @param xTicksToWait The maximum time to wait for the lock.
+ *
+ * @return pdPASS if the lock was taken, pdFAIL if the block time expired first.
+ */
+BaseType_t xRWLockReadLock( RWLockHandle_t xLock,
+                            TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * BaseType_t xRWLockReadUnlock( RWLockHandle_t xLock );
+ *
+ * Releases a read lock held by the calling task.
+ *
+ * @param xLock The lock to release.
+ *
+ * @return pdPASS if the lock was released, pdFAIL if the calling task does not
+ * hold it for reading.
+ */
+BaseType_t xRWLockReadUnlock( RWLockHandle_t xLock ) PRIVILEGED_FUNCTION;
+
+/**
+ * BaseType_t xRWLockWriteLock( RWLockHandle_t xLock, TickType_t xTicksToWait );
+ *
+ * Takes the lock for writing, blocking for up to xTicksToWait ticks while any
+ * task holds it.
+ *
+ * @param xLock The lock to take.
+ *
+ * @param xTicksToWait The maximum time to wait for the lock.
+ *
+ * @return pdPASS if the lock was taken, pdFAIL if the block time expired first.
+ */
+BaseType_t xRWLockWriteLock( RWLockHandle_t xLock,
+                             TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * BaseType_t xRWLockWriteUnlock( RWLockHandle_t xLock );
+ *
+ * Releases the write lock held by the calling task.
+ *
+ * @param xLock The lock to release.
+ *
+ * @return pdPASS if the lock was released, pdFAIL if the calling task does not
+ * hold it for writing.
+ */
+BaseType_t xRWLockWriteUnlock( RWLockHandle_t xLock ) PRIVILEGED_FUNCTION;
+
+/**
+ * void vRWLockGetStats( RWLockHandle_t xLock, RWLockStats_t * pxStats );
+ *
+ * Copies the contention statistics of the lock.
+ *
+ * @param xLock The lock being queried.
+ *
+ * @param pxStats The structure into which the statistics are copied.
+ */
+void vRWLockGetStats( RWLockHandle_t xLock,
+                      RWLockStats_t * pxStats ) PRIVILEGED_FUNCTION;
+
+/**
+ * void vRWLockDelete( RWLockHandle_t xLock );
+ *
+ * Deletes a lock that no task holds or is waiting for, freeing its memory if
+ * it was created by xRWLockCreate().
+ *
+ * @param xLock The lock being deleted.
+ */
+void vRWLockDelete( RWLockHandle_t xLock ) PRIVILEGED_FUNCTION;
+
+/* *INDENT-OFF* */
+#ifdef __cplusplus
+    }
+#endif
+/* *INDENT-ON* */
+
+#endif /* RW_LOCK_H */
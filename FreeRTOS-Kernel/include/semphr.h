@@ -1162,6 +1162,30 @@ typedef QueueHandle_t SemaphoreHandle_t;
     #define xSemaphoreGetMutexHolderFromISR( xSemaphore )    xQueueGetMutexHolderFromISR( ( xSemaphore ) )
 #endif
 
+/**
+ * semphr.h
+ * @code{c}
+ * void vSemaphoreGetMutexStats( SemaphoreHandle_t xMutex, MutexStats_t *pxStats );
+ * @endcode
+ *
+ * Copies the statistics of a mutex or recursive mutex into *pxStats: how often
+ * it was taken, how often a take had to wait or timed out, how long it was held
+ * and how long tasks waited for it.
+ *
+ * ulLockOrderInversions counts the takes of this mutex made while holding a
+ * second mutex that had earlier been taken while this one was held.  Tasks
+ * taking two mutexes in opposite orders can deadlock, and even when they do
+ * not the later task can wait for the whole of both critical regions.  The
+ * pairs are also reported to traceMUTEX_LOCK_ORDER_INVERSION() as they
+ * happen.  Order is tracked for up to configMUTEX_LOCK_ORDER_SLOTS mutexes,
+ * in the order they are first taken.
+ *
+ * Only available when configUSE_MUTEX_STATS is 1.
+ */
+#if ( configUSE_MUTEX_STATS == 1 )
+    #define vSemaphoreGetMutexStats( xMutex, pxStats )    vQueueGetMutexStats( ( xMutex ), ( pxStats ) )
+#endif
+
 /**
  * semphr.h
  * @code{c}
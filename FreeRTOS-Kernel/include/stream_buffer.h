@@ -78,6 +78,28 @@ typedef void (* StreamBufferCallbackFunction_t)( StreamBufferHandle_t xStreamBuf
                                                  BaseType_t xIsInsideISR,
                                                  BaseType_t * const pxHigherPriorityTaskWoken );
 
+/**
+ * Describes a region of a stream buffer's storage area, as returned by
+ * xStreamBufferAcquireWriteSpans() and xStreamBufferAcquireReadSpans().  The
+ * region is contiguous unless it wraps around the end of the storage area, in
+ * which case it continues at pucSpan[ 1 ].  pucSpan[ 1 ] is NULL and
+ * xSpanLength[ 1 ] is 0 when the region does not wrap.
+ */
+typedef struct xSTREAM_BUFFER_SPANS
+{
+    uint8_t * pucSpan[ 2 ];
+    size_t xSpanLength[ 2 ];
+} StreamBufferSpans_t;
+
+/**
+ * Type of the function xStreamBufferDrainMessages() calls for each message.
+ * pxMessage describes the message in place and xLength is its length.
+ * Returning pdFALSE stops the drain after this message.
+ */
+typedef BaseType_t (* StreamBufferMessageCallback_t)( const StreamBufferSpans_t * pxMessage,
+                                                      size_t xLength,
+                                                      void * pvContext );
+
 /**
  * stream_buffer.h
  *
@@ -798,6 +820,159 @@ size_t xStreamBufferBytesAvailable( StreamBufferHandle_t xStreamBuffer ) PRIVILE
 BaseType_t xStreamBufferSetTriggerLevel( StreamBufferHandle_t xStreamBuffer,
                                          size_t xTriggerLevel ) PRIVILEGED_FUNCTION;
 
+/**
+ * stream_buffer.h
+ *
+ * @code{c}
+ * size_t xStreamBufferAcquireWriteSpans( StreamBufferHandle_t xStreamBuffer, StreamBufferSpans_t * const pxSpans, TickType_t xTicksToWait );
+ * @endcode
+ *
+ * Returns the free space of a stream buffer as up to two spans that can be
+ * filled in place, for example by a DMA channel, instead of copying the data
+ * in with xStreamBufferSend().  Nothing is added to the stream buffer until
+ * vStreamBufferCommitWrite() or vStreamBufferCommitWriteFromISR() is called
+ * with the number of bytes written, starting at pucSpan[ 0 ] and continuing
+ * at pucSpan[ 1 ].  The spans remain valid until then, as only the writer
+ * can reduce the free space.  Stream buffers have a single writer, so calls to
+ * xStreamBufferSend() must not be mixed with an acquired write.
+ *
+ * Can only be used with stream buffers, not message buffers.  Can be called
+ * from an interrupt if xTicksToWait is 0.
+ *
+ * @param xStreamBuffer The handle of the stream buffer to be written to.
+ *
+ * @param pxSpans Set to describe the free space.
+ *
+ * @param xTicksToWait The maximum time to wait for the stream buffer to have
+ * any free space if it is full.
+ *
+ * @return The number of bytes free, the sum of the two span lengths.
+ *
+ * \defgroup xStreamBufferAcquireWriteSpans xStreamBufferAcquireWriteSpans
+ * \ingroup StreamBufferManagement
+ */
+size_t xStreamBufferAcquireWriteSpans( StreamBufferHandle_t xStreamBuffer,
+                                       StreamBufferSpans_t * const pxSpans,
+                                       TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * stream_buffer.h
+ *
+ * @code{c}
+ * void vStreamBufferCommitWrite( StreamBufferHandle_t xStreamBuffer, size_t xBytesWritten );
+ * void vStreamBufferCommitWriteFromISR( StreamBufferHandle_t xStreamBuffer, size_t xBytesWritten, BaseType_t * const pxHigherPriorityTaskWoken );
+ * @endcode
+ *
+ * Adds bytes written into the spans returned by
+ * xStreamBufferAcquireWriteSpans() to the stream buffer.  As with
+ * xStreamBufferSend(), a task waiting to read is unblocked once the stream
+ * buffer holds at least its trigger level.  A write can be committed in
+ * several parts, for example from the half and full transfer interrupts of a
+ * DMA channel, as long as the parts follow each other from the start of the
+ * spans.
+ *
+ * @param xStreamBuffer The handle of the stream buffer written to.
+ *
+ * @param xBytesWritten The number of bytes written, at most the number of
+ * bytes returned by xStreamBufferAcquireWriteSpans() less any already
+ * committed.
+ *
+ * @param pxHigherPriorityTaskWoken Set to pdTRUE if the commit unblocked a
+ * task with a priority above the interrupted task, in which case a context
+ * switch should be requested before the interrupt is exited.
+ *
+ * \defgroup vStreamBufferCommitWrite vStreamBufferCommitWrite
+ * \ingroup StreamBufferManagement
+ */
+void vStreamBufferCommitWrite( StreamBufferHandle_t xStreamBuffer,
+                               size_t xBytesWritten ) PRIVILEGED_FUNCTION;
+
+void vStreamBufferCommitWriteFromISR( StreamBufferHandle_t xStreamBuffer,
+                                      size_t xBytesWritten,
+                                      BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+/**
+ * stream_buffer.h
+ *
+ * @code{c}
+ * size_t xStreamBufferAcquireReadSpans( StreamBufferHandle_t xStreamBuffer, StreamBufferSpans_t * const pxSpans, TickType_t xTicksToWait );
+ * @endcode
+ *
+ * Returns the data in a stream buffer as up to two spans that can be used in
+ * place, for example as the source of a DMA transfer, instead of copying the
+ * data out with xStreamBufferReceive().  The data stays in the stream buffer
+ * until vStreamBufferReleaseRead() or vStreamBufferReleaseReadFromISR() is
+ * called with the number of bytes consumed.  The spans remain valid until
+ * then, as only the reader can remove data.
+ *
+ * Can only be used with stream buffers, not message buffers.  Can be called
+ * from an interrupt if xTicksToWait is 0.
+ *
+ * @param xStreamBuffer The handle of the stream buffer to be read from.
+ *
+ * @param pxSpans Set to describe the data.
+ *
+ * @param xTicksToWait The maximum time to wait for data if the stream buffer
+ * is empty.
+ *
+ * @return The number of bytes available, the sum of the two span lengths.
+ *
+ * \defgroup xStreamBufferAcquireReadSpans xStreamBufferAcquireReadSpans
+ * \ingroup StreamBufferManagement
+ */
+size_t xStreamBufferAcquireReadSpans( StreamBufferHandle_t xStreamBuffer,
+                                      StreamBufferSpans_t * const pxSpans,
+                                      TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * stream_buffer.h
+ *
+ * @code{c}
+ * void vStreamBufferReleaseRead( StreamBufferHandle_t xStreamBuffer, size_t xBytesRead );
+ * void vStreamBufferReleaseReadFromISR( StreamBufferHandle_t xStreamBuffer, size_t xBytesRead, BaseType_t * const pxHigherPriorityTaskWoken );
+ * @endcode
+ *
+ * Removes bytes consumed from the spans returned by
+ * xStreamBufferAcquireReadSpans() from the stream buffer, unblocking a task
+ * waiting for space as xStreamBufferReceive() does.  A read can be released in
+ * several parts, as long as the parts follow each other from the start of the
+ * spans.
+ *
+ * @param xStreamBuffer The handle of the stream buffer read from.
+ *
+ * @param xBytesRead The number of bytes consumed, at most the number of bytes
+ * returned by xStreamBufferAcquireReadSpans() less any already released.
+ *
+ * @param pxHigherPriorityTaskWoken Set to pdTRUE if the release unblocked a
+ * task with a priority above the interrupted task, in which case a context
+ * switch should be requested before the interrupt is exited.
+ *
+ * \defgroup vStreamBufferReleaseRead vStreamBufferReleaseRead
+ * \ingroup StreamBufferManagement
+ */
+void vStreamBufferReleaseRead( StreamBufferHandle_t xStreamBuffer,
+                               size_t xBytesRead ) PRIVILEGED_FUNCTION;
+
+void vStreamBufferReleaseReadFromISR( StreamBufferHandle_t xStreamBuffer,
+                                      size_t xBytesRead,
+                                      BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+/* Message buffer in place access, see xMessageBufferPeek(),
+ * vMessageBufferRelease() and xMessageBufferDrain() in message_buffer.h. */
+size_t xStreamBufferPeekMessage( StreamBufferHandle_t xStreamBuffer,
+                                 StreamBufferSpans_t * const pxSpans,
+                                 TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+void vStreamBufferReleaseMessage( StreamBufferHandle_t xStreamBuffer ) PRIVILEGED_FUNCTION;
+
+void vStreamBufferReleaseMessageFromISR( StreamBufferHandle_t xStreamBuffer,
+                                         BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+size_t xStreamBufferDrainMessages( StreamBufferHandle_t xStreamBuffer,
+                                   StreamBufferMessageCallback_t pxCallback,
+                                   void * pvContext,
+                                   TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
 /**
  * stream_buffer.h
  *
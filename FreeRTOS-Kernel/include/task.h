@@ -160,6 +160,7 @@ typedef struct xTASK_STATUS
     UBaseType_t uxCurrentPriority;                /* The priority at which the task was running (may be inherited) when the structure was populated. */
     UBaseType_t uxBasePriority;                   /* The priority to which the task will return if the task's current priority has been inherited to avoid unbounded priority inversion when obtaining a mutex.  Only valid if configUSE_MUTEXES is defined as 1 in FreeRTOSConfig.h. */
     configRUN_TIME_COUNTER_TYPE ulRunTimeCounter; /* The total run time allocated to the task so far, as defined by the run time stats clock.  See https://www.FreeRTOS.org/rtos-run-time-stats.html.  Only valid when configGENERATE_RUN_TIME_STATS is defined as 1 in FreeRTOSConfig.h. */
+    uint32_t ulContextSwitchCount;                /* The number of times the task has been switched in.  Only valid when configGENERATE_RUN_TIME_STATS is defined as 1 in FreeRTOSConfig.h. */
     StackType_t * pxStackBase;                    /* Points to the lowest address of the task's stack area. */
     #if ( ( portSTACK_GROWTH > 0 ) && ( configRECORD_STACK_HIGH_ADDRESS == 1 ) )
         StackType_t * pxTopOfStack;               /* Points to the top address of the task's stack area. */
@@ -168,6 +169,30 @@ typedef struct xTASK_STATUS
     configSTACK_DEPTH_TYPE usStackHighWaterMark;  /* The minimum amount of stack space that has remained for the task since the task was created.  The closer this value is to zero the closer the task has come to overflowing its stack. */
 } TaskStatus_t;
 
+/* Used with the xTaskScanStack() function to return the stack usage of one
+ * task.  All the sizes are in words. */
+typedef struct xTASK_STACK_USAGE
+{
+    TaskHandle_t xHandle;                        /* The handle of the task to which the rest of the information in the structure relates. */
+    char pcTaskName[ configMAX_TASK_NAME_LEN ];  /* A copy of the task's name, still valid if the task is deleted after the scan. */ /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+    UBaseType_t xTaskNumber;                     /* A number unique to the task, pass it to the next xTaskScanStack() call. */
+    configSTACK_DEPTH_TYPE uxStackDepth;         /* The size of the task's stack. */
+    configSTACK_DEPTH_TYPE uxStackInUse;         /* The stack in use when the task was last switched out. */
+    configSTACK_DEPTH_TYPE uxStackHighWaterMark; /* The minimum amount of stack space that has remained for the task since the task was created. */
+} TaskStackUsage_t;
+
+/* Used with the vTaskGetPeriodStats() function to return the deadline
+ * statistics of a periodic task.  All the times are in ticks. */
+typedef struct xTASK_PERIOD_STATS
+{
+    TickType_t xPeriod;           /* The period of the task, 0 if the task is not periodic. */
+    TickType_t xRelativeDeadline; /* The deadline of each job relative to its release. */
+    TickType_t xAbsoluteDeadline; /* The deadline of the current job. */
+    TickType_t xMaxLateness;      /* The longest time a job completed after its deadline. */
+    uint32_t ulJobsCompleted;     /* The number of jobs completed since vTaskSetPeriod() was called. */
+    uint32_t ulDeadlineMisses;    /* The number of jobs that completed after their deadline. */
+} TaskPeriodStats_t;
+
 /* Possible return values for eTaskConfirmSleepModeStatus(). */
 typedef enum
 {
@@ -903,6 +928,102 @@ BaseType_t xTaskDelayUntil( TickType_t * const pxPreviousWakeTime,
  */
 BaseType_t xTaskAbortDelay( TaskHandle_t xTask ) PRIVILEGED_FUNCTION;
 
+/**
+ * task. h
+ * @code{c}
+ * void vTaskSetPeriod( TaskHandle_t xTask, TickType_t xPeriod, TickType_t xRelativeDeadline );
+ * @endcode
+ *
+ * configUSE_EDF_SCHEDULING must be defined as 1 for this function to be
+ * available.
+ *
+ * Makes a task periodic.  The task runs one job per period: the first job is
+ * released when vTaskSetPeriod() is called, and each job ends with a call to
+ * vTaskWaitForNextPeriod().  Each job must complete within xRelativeDeadline
+ * of its release, jobs that complete later are counted as deadline misses.
+ *
+ * The tasks at priority configEDF_PRIORITY are scheduled earliest deadline
+ * first: the one whose current job has the earliest deadline runs, and a task
+ * released with an earlier deadline preempts it.  A set of such tasks meets
+ * all its deadlines as long as the sum of the execution time of each job
+ * divided by its period stays at or below 1 (when the deadlines are the
+ * periods), where rate monotonic priorities may fail from about 0.7.  Tasks
+ * at other priorities keep the fixed priority scheduling, so tasks above
+ * configEDF_PRIORITY preempt the EDF class and tasks below it only run when
+ * no EDF task is ready.  A periodic task at another priority still has its
+ * deadline misses counted.
+ *
+ * @param xTask The handle of the task, or NULL for the calling task.
+ *
+ * @param xPeriod The time between the releases of two jobs, or 0 to make the
+ * task no longer periodic.
+ *
+ * @param xRelativeDeadline The deadline of each job relative to its release,
+ * at most xPeriod, or 0 to use xPeriod.
+ *
+ * Example usage:
+ * @code{c}
+ * void vControlLoop( void * pvParameters )
+ * {
+ *  // Run every 5 ticks, each run to complete within 4 ticks.
+ *  vTaskSetPeriod( NULL, 5, 4 );
+ *
+ *  for( ;; )
+ *  {
+ *      vRunControlLoop();
+ *      vTaskWaitForNextPeriod();
+ *  }
+ * }
+ * @endcode
+ * \defgroup vTaskSetPeriod vTaskSetPeriod
+ * \ingroup TaskCtrl
+ */
+void vTaskSetPeriod( TaskHandle_t xTask,
+                     TickType_t xPeriod,
+                     TickType_t xRelativeDeadline ) PRIVILEGED_FUNCTION;
+
+/**
+ * task. h
+ * @code{c}
+ * void vTaskWaitForNextPeriod( void );
+ * @endcode
+ *
+ * configUSE_EDF_SCHEDULING must be defined as 1 for this function to be
+ * available.
+ *
+ * Completes the current job of the calling task, which must be periodic, and
+ * blocks the task until its next job is released.  If the next job was due
+ * already the function returns at once and the task, whose deadline is now
+ * later, may be preempted.  See vTaskSetPeriod().
+ *
+ * \defgroup vTaskWaitForNextPeriod vTaskWaitForNextPeriod
+ * \ingroup TaskCtrl
+ */
+void vTaskWaitForNextPeriod( void ) PRIVILEGED_FUNCTION;
+
+/**
+ * task. h
+ * @code{c}
+ * void vTaskGetPeriodStats( TaskHandle_t xTask, TaskPeriodStats_t * pxPeriodStats );
+ * @endcode
+ *
+ * configUSE_EDF_SCHEDULING must be defined as 1 for this function to be
+ * available.
+ *
+ * Returns the period, deadlines and deadline misses of a task.  A job that is
+ * already late but has not completed is not counted as a miss yet, compare
+ * xAbsoluteDeadline to the tick count to detect it.
+ *
+ * @param xTask The handle of the task, or NULL for the calling task.
+ *
+ * @param pxPeriodStats Filled with the statistics of the task.
+ *
+ * \defgroup vTaskGetPeriodStats vTaskGetPeriodStats
+ * \ingroup TaskCtrl
+ */
+void vTaskGetPeriodStats( TaskHandle_t xTask,
+                          TaskPeriodStats_t * pxPeriodStats ) PRIVILEGED_FUNCTION;
+
 /**
  * task. h
  * @code{c}
@@ -1567,6 +1688,41 @@ UBaseType_t uxTaskGetStackHighWaterMark( TaskHandle_t xTask ) PRIVILEGED_FUNCTIO
  */
 configSTACK_DEPTH_TYPE uxTaskGetStackHighWaterMark2( TaskHandle_t xTask ) PRIVILEGED_FUNCTION;
 
+/**
+ * task.h
+ * @code{c}
+ * BaseType_t xTaskScanStack( UBaseType_t uxPreviousTaskNumber, TaskStackUsage_t * pxStackUsage );
+ * @endcode
+ *
+ * INCLUDE_xTaskScanStack, configUSE_TRACE_FACILITY and, on ports whose stack
+ * grows down, configRECORD_STACK_HIGH_ADDRESS must be set to 1 in
+ * FreeRTOSConfig.h for this function to be available.
+ *
+ * Measures the stack of one task: the task that has the lowest task number
+ * above uxPreviousTaskNumber.  Calling xTaskScanStack() in a loop, passing the
+ * xTaskNumber it returned each time, measures the stacks of all the tasks one
+ * by one, including the idle and timer tasks, and tasks created or deleted
+ * between two calls are neither skipped nor measured twice.  The scheduler is
+ * suspended while the list of tasks is searched and the stack of that one task
+ * is scanned a word at a time for the high water mark, so unlike
+ * uxTaskGetSystemState() the time the scheduler is suspended for does not grow
+ * with the number of tasks.
+ *
+ * The stack in use is measured from the stack pointer saved when the task was
+ * last switched out, so it is a sample of the current usage rather than the
+ * worst case, and is stale for the calling task.
+ *
+ * @param uxPreviousTaskNumber 0 to measure the first task, otherwise the
+ * xTaskNumber of the task measured by the previous call.
+ *
+ * @param pxStackUsage Filled with the stack usage of the task.
+ *
+ * @return pdTRUE if a task was measured, pdFALSE if no task has a task number
+ * above uxPreviousTaskNumber, in which case pxStackUsage is not changed.
+ */
+BaseType_t xTaskScanStack( UBaseType_t uxPreviousTaskNumber,
+                           TaskStackUsage_t * pxStackUsage ) PRIVILEGED_FUNCTION;
+
 /* When using trace macros it is sometimes necessary to include task.h before
  * FreeRTOS.h.  When this is done TaskHookFunction_t will not yet have been defined,
  * so the following two prototypes will cause a compilation error.  This can be
@@ -3103,6 +3259,22 @@ eSleepModeStatus eTaskConfirmSleepModeStatus( void ) PRIVILEGED_FUNCTION;
  */
 TaskHandle_t pvTaskIncrementMutexHeldCount( void ) PRIVILEGED_FUNCTION;
 
+/*
+ * For internal use only.  Increment the mutex held count of a task other than
+ * the running task.  Called from within a critical section by the lock types
+ * of rwlock.c and lwmutex.c when the holder inherits a priority.
+ */
+void vTaskIncrementMutexHeldCountOf( TaskHandle_t xMutexHolder ) PRIVILEGED_FUNCTION;
+
+/*
+ * For internal use only.  Record the mutex the running task is about to block
+ * on, or NULL once it stops waiting, and return the mutex a task is blocked
+ * on.  Used by queue.c to pass inherited priorities along chains of mutex
+ * holders that are themselves blocked on mutexes.
+ */
+void vTaskSetBlockedOnMutex( void * pvMutex ) PRIVILEGED_FUNCTION;
+void * pvTaskGetBlockedOnMutex( TaskHandle_t xTask ) PRIVILEGED_FUNCTION;
+
 /*
  * For internal use only.  Same as vTaskSetTimeOutState(), but without a critical
  * section.
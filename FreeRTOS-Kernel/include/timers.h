@@ -1323,6 +1323,41 @@ TickType_t xTimerGetPeriod( TimerHandle_t xTimer ) PRIVILEGED_FUNCTION;
  */
 TickType_t xTimerGetExpiryTime( TimerHandle_t xTimer ) PRIVILEGED_FUNCTION;
 
+#if ( configUSE_TIMER_COMMAND_STATS == 1 )
+
+/*
+ * Statistics on the timer command queue, gathered when
+ * configUSE_TIMER_COMMAND_STATS is set to 1.
+ */
+    typedef struct xTIMER_COMMAND_STATS
+    {
+        UBaseType_t uxQueueHighWaterMark; /*<< The most commands found waiting in the timer queue when the timer service task started to drain it. */
+        UBaseType_t uxLargestBatch;       /*<< The most commands removed from the timer queue in one batch. */
+        uint32_t ulCommandsReceived;      /*<< Commands, including pended function calls, removed from the timer queue. */
+        uint32_t ulCommandsCoalesced;     /*<< Commands dropped because a later command in the same batch made them redundant. */
+        uint32_t ulBatchesProcessed;      /*<< Batches of commands removed from the timer queue. */
+        uint32_t ulSendFailures;          /*<< Commands that could not be posted because the timer queue was full. */
+    } TimerCommandStats_t;
+
+/**
+ * void vTimerGetCommandStats( TimerCommandStats_t * pxStats );
+ *
+ * Takes a consistent snapshot of the timer command queue statistics.  Use it
+ * to size configTIMER_QUEUE_LENGTH and configTIMER_COMMAND_BATCH_SIZE.
+ *
+ * @param pxStats The structure into which the statistics are copied.
+ */
+    void vTimerGetCommandStats( TimerCommandStats_t * pxStats ) PRIVILEGED_FUNCTION;
+
+/**
+ * void vTimerResetCommandStats( void );
+ *
+ * Clears the timer command queue statistics.
+ */
+    void vTimerResetCommandStats( void ) PRIVILEGED_FUNCTION;
+
+#endif /* configUSE_TIMER_COMMAND_STATS */
+
 /*
  * Functions beyond this part are not part of the public API and are intended
  * for use by the kernel only.
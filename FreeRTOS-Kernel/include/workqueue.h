@@ -0,0 +1,280 @@
+/*
+ * FreeRTOS Kernel V10.5.1
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+#ifndef WORK_QUEUE_H
+#define WORK_QUEUE_H
+
+#ifndef INC_FREERTOS_H
+    #error "include FreeRTOS.h" must appear in source files before "include workqueue.h"
+#endif
+
+/* FreeRTOS includes. */
+#include "task.h"
+
+/* *INDENT-OFF* */
+#ifdef __cplusplus
+    extern "C" {
+#endif
+/* *INDENT-ON* */
+
+/**
+ * A work queue passes work from interrupts to a worker task of its own, the
+ * deferred interrupt handling otherwise done with
+ * xTimerPendFunctionCallFromISR().  Pended function calls share the timer
+ * daemon task and its command queue with every timer command, so the time
+ * until a pended function runs depends on the timer load and the call fails
+ * when the command queue is full.  Each work queue instead has a worker task
+ * at the priority given when the queue is created, so bottom halves can be
+ * given priorities above and below each other and the timers, and no work item
+ * can be lost to a full queue.
+ *
+ * Work is described by a WorkItem_t the application allocates and initialises
+ * once with vWorkItemInitialise().  Submitting links the item into the queue,
+ * which takes constant time with interrupts masked for a few instructions.  An
+ * item can only be queued once at a time: submitting an item that is already
+ * pending, to any work queue, fails and is counted as coalesced, so an
+ * interrupt that fires again before its bottom half has run does not need to
+ * track whether the work is already queued.  The item is no longer pending
+ * when its function is called, so the function or the interrupt can submit it
+ * again.
+ *
+ * Items run in the order they were submitted.  The worker blocks on its task
+ * notification at index 0 when the queue is empty, so work functions must not
+ * use that notification.  Work queues are not deleted, they are expected to
+ * live as long as the application.
+ */
+struct WorkQueueDef_t;
+typedef struct WorkQueueDef_t * WorkQueueHandle_t;
+
+typedef void (* WorkFunction_t)( void * pvParameter );
+
+/*
+ * A unit of deferred work.  The members are private to workqueue.c and are
+ * only public so the application can allocate items.
+ */
+typedef struct xWORK_ITEM
+{
+    struct xWORK_ITEM * pxNext;   /*<< The next item in the queue the item is pending on. */
+    WorkFunction_t pxFunction;    /*<< The function run by the worker. */
+    void * pvParameter;           /*<< Passed to pxFunction. */
+    void * volatile pvOwner;      /*<< The queue the item is pending on, NULL when it is not pending. */
+    uint32_t ulSubmitTime;        /*<< configWORK_QUEUE_GET_TIME() when the item was submitted. */
+} WorkItem_t;
+
+/*
+ * Statistics kept by every work queue.  Times are in the units of
+ * configWORK_QUEUE_GET_TIME().
+ */
+typedef struct xWORK_QUEUE_STATS
+{
+    uint64_t ullTotalLatency; /*<< Sum of the latencies of the executed items, divide by ulExecuted for the average. */
+    uint32_t ulSubmitted;     /*<< Items queued. */
+    uint32_t ulCoalesced;     /*<< Submits that failed because the item was already pending. */
+    uint32_t ulExecuted;      /*<< Items whose function has been called. */
+    uint32_t ulLastLatency;   /*<< Time from submit to the start of the function, for the last item executed. */
+    uint32_t ulMaxLatency;    /*<< The longest latency. */
+    uint32_t ulMaxRunTime;    /*<< The longest time spent in a work function. */
+    UBaseType_t uxDepth;      /*<< Items pending now. */
+    UBaseType_t uxMaxDepth;   /*<< The most items that have been pending at once. */
+} WorkQueueStats_t;
+
+/**
+ * void vWorkItemInitialise( WorkItem_t * pxItem,
+ *                           WorkFunction_t pxFunction,
+ *                           void * pvParameter );
+ *
+ * Prepares a work item for use.  Must not be called while the item is
+ * pending.
+ *
+ * @param pxItem The item to initialise.
+ *
+ * @param pxFunction The function the worker calls for the item.
+ *
+ * @param pvParameter The parameter passed to pxFunction.
+ */
+void vWorkItemInitialise( WorkItem_t * pxItem,
+                          WorkFunction_t pxFunction,
+                          void * pvParameter ) PRIVILEGED_FUNCTION;
+
+/**
+ * WorkQueueHandle_t xWorkQueueCreate( const char * const pcName,
+ *                                     UBaseType_t uxPriority,
+ *                                     configSTACK_DEPTH_TYPE usStackDepth );
+ *
+ * Creates a work queue and its worker task, allocating both from the FreeRTOS
+ * heap.
+ *
+ * @param pcName The name of the worker task.
+ *
+ * @param uxPriority The priority of the worker task.
+ *
+ * @param usStackDepth The stack size of the worker task, in words, which must
+ * be enough for the deepest work function.
+ *
+ * @return The handle of the work queue, or NULL if there was not enough heap.
+ */
+#if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+    WorkQueueHandle_t xWorkQueueCreate( const char * const pcName,
+                                        UBaseType_t uxPriority,
+                                        configSTACK_DEPTH_TYPE usStackDepth ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * WorkQueueHandle_t xWorkQueueCreateStatic( const char * const pcName,
+ *                                           UBaseType_t uxPriority,
+ *                                           uint32_t ulStackDepth,
+ *                                           StackType_t * puxStackBuffer,
+ *                                           StaticTask_t * pxTaskBuffer,
+ *                                           StaticWorkQueue_t * pxWorkQueueBuffer );
+ *
+ * Creates a work queue and its worker task in memory provided by the
+ * application.
+ *
+ * @param pcName The name of the worker task.
+ *
+ * @param uxPriority The priority of the worker task.
+ *
+ * @param ulStackDepth The number of words in puxStackBuffer.
+ *
+ * @param puxStackBuffer The stack of the worker task.
+ *
+ * @param pxTaskBuffer The StaticTask_t that holds the worker task.
+ *
+ * @param pxWorkQueueBuffer The StaticWorkQueue_t that holds the work queue.
+ *
+ * @return The handle of the work queue.
+ */
+#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+    WorkQueueHandle_t xWorkQueueCreateStatic( const char * const pcName,
+                                              UBaseType_t uxPriority,
+                                              uint32_t ulStackDepth,
+                                              StackType_t * puxStackBuffer,
+                                              StaticTask_t * pxTaskBuffer,
+                                              StaticWorkQueue_t * pxWorkQueueBuffer ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * BaseType_t xWorkQueueSubmit( WorkQueueHandle_t xWorkQueue,
+ *                              WorkItem_t * pxItem );
+ *
+ * Queues a work item from a task.  Never blocks.
+ *
+ * @param xWorkQueue The work queue whose worker runs the item.
+ *
+ * @param pxItem The item to queue.
+ *
+ * @return pdPASS if the item was queued, pdFAIL if it was already pending.
+ */
+BaseType_t xWorkQueueSubmit( WorkQueueHandle_t xWorkQueue,
+                             WorkItem_t * pxItem ) PRIVILEGED_FUNCTION;
+
+/**
+ * BaseType_t xWorkQueueSubmitFromISR( WorkQueueHandle_t xWorkQueue,
+ *                                     WorkItem_t * pxItem,
+ *                                     BaseType_t * pxHigherPriorityTaskWoken );
+ *
+ * A version of xWorkQueueSubmit() that can be called from an interrupt whose
+ * priority is at or below configMAX_SYSCALL_INTERRUPT_PRIORITY.
+ *
+ * @param xWorkQueue The work queue whose worker runs the item.
+ *
+ * @param pxItem The item to queue.
+ *
+ * @param pxHigherPriorityTaskWoken Set to pdTRUE if the worker was woken and
+ * has a priority above the interrupted task, in which case a context switch
+ * should be requested before the interrupt exits.
+ *
+ * @return pdPASS if the item was queued, pdFAIL if it was already pending.
+ */
+BaseType_t xWorkQueueSubmitFromISR( WorkQueueHandle_t xWorkQueue,
+                                    WorkItem_t * pxItem,
+                                    BaseType_t * pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+/**
+ * BaseType_t xWorkQueueCancel( WorkQueueHandle_t xWorkQueue,
+ *                              WorkItem_t * pxItem );
+ *
+ * Removes a pending item from a work queue before its function runs.  The
+ * queue is searched, so the time taken grows with the number of pending
+ * items.  An item whose function is already running is not affected.
+ *
+ * @param xWorkQueue The work queue the item was submitted to.
+ *
+ * @param pxItem The item to remove.
+ *
+ * @return pdPASS if the item was removed, pdFAIL if it was not pending on
+ * xWorkQueue.
+ */
+BaseType_t xWorkQueueCancel( WorkQueueHandle_t xWorkQueue,
+                             WorkItem_t * pxItem ) PRIVILEGED_FUNCTION;
+
+/**
+ * BaseType_t xWorkItemIsPending( const WorkItem_t * pxItem );
+ *
+ * @return pdTRUE if the item is queued and its function has not yet been
+ * called, otherwise pdFALSE.
+ */
+BaseType_t xWorkItemIsPending( const WorkItem_t * pxItem ) PRIVILEGED_FUNCTION;
+
+/**
+ * TaskHandle_t xWorkQueueGetWorkerHandle( WorkQueueHandle_t xWorkQueue );
+ *
+ * @return The handle of the worker task, for example to change its priority.
+ */
+TaskHandle_t xWorkQueueGetWorkerHandle( WorkQueueHandle_t xWorkQueue ) PRIVILEGED_FUNCTION;
+
+/**
+ * void vWorkQueueGetStats( WorkQueueHandle_t xWorkQueue,
+ *                          WorkQueueStats_t * pxStats );
+ *
+ * Copies the statistics of the work queue.
+ *
+ * @param xWorkQueue The work queue being queried.
+ *
+ * @param pxStats The structure into which the statistics are copied.
+ */
+void vWorkQueueGetStats( WorkQueueHandle_t xWorkQueue,
+                         WorkQueueStats_t * pxStats ) PRIVILEGED_FUNCTION;
+
+/**
+ * void vWorkQueueResetStats( WorkQueueHandle_t xWorkQueue );
+ *
+ * Clears the statistics of the work queue, apart from uxDepth, and starts
+ * uxMaxDepth again from the current depth.
+ *
+ * @param xWorkQueue The work queue whose statistics are cleared.
+ */
+void vWorkQueueResetStats( WorkQueueHandle_t xWorkQueue ) PRIVILEGED_FUNCTION;
+
+/* *INDENT-OFF* */
+#ifdef __cplusplus
+    }
+#endif
+/* *INDENT-ON* */
+
+#endif /* WORK_QUEUE_H */
@@ -0,0 +1,587 @@
+/*
+ * FreeRTOS Kernel V10.5.1
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/*
+ * Lightweight mutexes, see lwmutex.h.
+ *
+ * The whole state of an uncontended mutex is ulOwner, the handle of the
+ * holding task or 0 when the mutex is free.  Take swaps 0 for the handle of the
+ * calling task and give swaps it back, each with one exclusive load/store pair
+ * on ports that define portHAS_EXCLUSIVE_ACCESS, so neither masks interrupts.
+ *
+ * Task handles are word aligned, which leaves the two low bits of ulOwner for
+ * flags.  A task that finds the mutex held sets lwmutexWAITERS_BIT before it
+ * blocks, and lwmutexINHERITED_BIT if the holder inherited its priority.  With
+ * either bit set the holder's swap on give fails and it takes the slow path,
+ * which drops the inherited priority and hands the mutex to the task at the
+ * head of xTasksWaiting.  The flags are only changed inside critical sections
+ * and the reservation taken by the exclusive load is lost on every exception,
+ * so a fast path swap interrupted by a task setting a flag always fails.
+ *
+ * There is no spinning before blocking.  On a single core the holder cannot
+ * make progress while the waiter spins, so the spin would only delay the
+ * switch to the holder.
+ */
+
+/* Standard includes. */
+#include <stdlib.h>
+#include <string.h>
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+ * all the API functions to use the MPU wrappers.  That should only be done when
+ * task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "lwmutex.h"
+
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+#if ( configUSE_LW_MUTEXES == 1 )
+
+/* Flags kept in the low bits of ulOwner. */
+#define lwmutexWAITERS_BIT      ( 0x01UL )
+#define lwmutexINHERITED_BIT    ( 0x02UL )
+#define lwmutexFLAG_BITS        ( lwmutexWAITERS_BIT | lwmutexINHERITED_BIT )
+
+#define lwmutexHOLDER( ulOwner )    ( ( TaskHandle_t ) ( ( ulOwner ) & ~lwmutexFLAG_BITS ) )
+
+typedef struct LwMutexDef_t
+{
+    volatile uint32_t ulOwner; /*< Handle of the holding task ORed with the lwmutex flags, 0 when free. */
+    List_t xTasksWaiting;      /*< Tasks blocked on the mutex, in priority order. */
+    LwMutexStats_t xStats;
+
+    #if ( ( configSUPPORT_STATIC_ALLOCATION == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
+        uint8_t ucStaticallyAllocated; /*< Set to pdTRUE if the mutex is statically allocated to ensure no attempt is made to free the memory. */
+    #endif
+} LwMutex_t;
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Sets *pulTarget to ulDesired if it holds ulExpected.  Returns pdTRUE if the
+ * store was made.
+ */
+static portFORCE_INLINE BaseType_t prvCompareAndSwap( volatile uint32_t * pulTarget,
+                                                      uint32_t ulExpected,
+                                                      uint32_t ulDesired ) PRIVILEGED_FUNCTION;
+
+/*
+ * Called by a task that gave up waiting after its priority had been inherited
+ * by the holder.  Lowers the holder to the priority of the highest priority
+ * task still waiting.
+ */
+static void prvDisinheritAfterTimeout( LwMutex_t * pxMutex,
+                                       uint32_t ulOwner ) PRIVILEGED_FUNCTION;
+
+/*-----------------------------------------------------------*/
+
+static void prvInitialiseMutex( LwMutex_t * pxMutex ) /* PRIVILEGED_FUNCTION */
+{
+    pxMutex->ulOwner = 0UL;
+    vListInitialise( &( pxMutex->xTasksWaiting ) );
+    ( void ) memset( &( pxMutex->xStats ), 0x00, sizeof( pxMutex->xStats ) );
+}
+/*-----------------------------------------------------------*/
+
+#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+
+    LwMutexHandle_t xLwMutexCreateStatic( StaticLwMutex_t * pxMutexBuffer )
+    {
+        LwMutex_t * pxMutex;
+
+        configASSERT( pxMutexBuffer );
+
+        #if ( configASSERT_DEFINED == 1 )
+        {
+            /* Sanity check that the size of the structure used to declare a
+             * variable of type StaticLwMutex_t equals the size of the real
+             * mutex structure. */
+            volatile size_t xSize = sizeof( StaticLwMutex_t );
+            configASSERT( xSize == sizeof( LwMutex_t ) );
+        } /*lint !e529 xSize is referenced if configASSERT() is defined. */
+        #endif /* configASSERT_DEFINED */
+
+        pxMutex = ( LwMutex_t * ) pxMutexBuffer; /*lint !e740 !e9087 LwMutex_t and StaticLwMutex_t are deliberately aliased for data hiding purposes and guaranteed to have the same size and alignment requirement - checked by configASSERT(). */
+
+        if( pxMutex != NULL )
+        {
+            prvInitialiseMutex( pxMutex );
+
+            #if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+            {
+                pxMutex->ucStaticallyAllocated = pdTRUE;
+            }
+            #endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+        }
+
+        return pxMutex;
+    }
+
+#endif /* configSUPPORT_STATIC_ALLOCATION */
+/*-----------------------------------------------------------*/
+
+#if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+
+    LwMutexHandle_t xLwMutexCreate( void )
+    {
+        LwMutex_t * pxMutex;
+
+        pxMutex = ( LwMutex_t * ) pvPortMalloc( sizeof( LwMutex_t ) );
+
+        if( pxMutex != NULL )
+        {
+            prvInitialiseMutex( pxMutex );
+
+            #if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+            {
+                pxMutex->ucStaticallyAllocated = pdFALSE;
+            }
+            #endif /* configSUPPORT_STATIC_ALLOCATION */
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return pxMutex;
+    }
+
+#endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+/*-----------------------------------------------------------*/
+
+BaseType_t xLwMutexTake( LwMutexHandle_t xMutex,
+                         TickType_t xTicksToWait )
+{
+    LwMutex_t * const pxMutex = xMutex;
+    const uint32_t ulSelf = ( uint32_t ) xTaskGetCurrentTaskHandle();
+    BaseType_t xEntryTimeSet = pdFALSE;
+    BaseType_t xInheritanceOccurred = pdFALSE;
+    BaseType_t xBlock;
+    TimeOut_t xTimeOut;
+    uint32_t ulOwner;
+
+    configASSERT( pxMutex );
+    configASSERT( ( ulSelf != 0UL ) && ( ( ulSelf & lwmutexFLAG_BITS ) == 0UL ) );
+
+    #if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
+    {
+        configASSERT( !( ( xTaskGetSchedulerState() == taskSCHEDULER_SUSPENDED ) && ( xTicksToWait != 0 ) ) );
+    }
+    #endif
+
+    /* Uncontended path. */
+    if( prvCompareAndSwap( &( pxMutex->ulOwner ), 0UL, ulSelf ) != pdFALSE )
+    {
+        /* Only the holder writes ulTakes. */
+        pxMutex->xStats.ulTakes++;
+        return pdPASS;
+    }
+
+    /* The mutex is not recursive. */
+    configASSERT( lwmutexHOLDER( pxMutex->ulOwner ) != ( TaskHandle_t ) ulSelf );
+
+    /*lint -save -e904 This function relaxes the coding standard somewhat to allow return
+     * statements within the function itself.  This is done in the interest
+     * of execution time efficiency. */
+    for( ; ; )
+    {
+        taskENTER_CRITICAL();
+        {
+            ulOwner = pxMutex->ulOwner;
+
+            /* Either the mutex was given, or the task that gave it handed it
+             * to this task while this task was blocked. */
+            if( ( ulOwner == 0UL ) || ( lwmutexHOLDER( ulOwner ) == ( TaskHandle_t ) ulSelf ) )
+            {
+                if( ulOwner == 0UL )
+                {
+                    pxMutex->ulOwner = ulSelf;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                pxMutex->xStats.ulTakes++;
+                taskEXIT_CRITICAL();
+                return pdPASS;
+            }
+            else if( xTicksToWait == ( TickType_t ) 0 )
+            {
+                if( xEntryTimeSet != pdFALSE )
+                {
+                    pxMutex->xStats.ulTimeouts++;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                if( xInheritanceOccurred != pdFALSE )
+                {
+                    prvDisinheritAfterTimeout( pxMutex, ulOwner );
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                taskEXIT_CRITICAL();
+                return pdFAIL;
+            }
+            else if( xEntryTimeSet == pdFALSE )
+            {
+                vTaskInternalSetTimeOutState( &xTimeOut );
+                xEntryTimeSet = pdTRUE;
+                pxMutex->xStats.ulContendedTakes++;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        taskEXIT_CRITICAL();
+
+        vTaskSuspendAll();
+
+        if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE )
+        {
+            xBlock = pdFALSE;
+
+            /* The holder cannot run while the scheduler is suspended, so if the
+             * mutex is still held here it is still held when this task has been
+             * placed on the wait list. */
+            taskENTER_CRITICAL();
+            {
+                ulOwner = pxMutex->ulOwner;
+
+                if( ulOwner != 0UL )
+                {
+                    if( xTaskPriorityInherit( lwmutexHOLDER( ulOwner ) ) != pdFALSE )
+                    {
+                        if( xInheritanceOccurred == pdFALSE )
+                        {
+                            xInheritanceOccurred = pdTRUE;
+                            pxMutex->xStats.ulPriorityInheritances++;
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
+
+                        /* Count the mutex in the holder's uxMutexesHeld once, so
+                         * giving it only restores the base priority when no
+                         * other mutex the holder inherited through is held. */
+                        if( ( ulOwner & lwmutexINHERITED_BIT ) == 0UL )
+                        {
+                            vTaskIncrementMutexHeldCountOf( lwmutexHOLDER( ulOwner ) );
+                            ulOwner |= lwmutexINHERITED_BIT;
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+
+                    pxMutex->ulOwner = ulOwner | lwmutexWAITERS_BIT;
+                    xBlock = pdTRUE;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            taskEXIT_CRITICAL();
+
+            if( xBlock != pdFALSE )
+            {
+                vTaskPlaceOnEventList( &( pxMutex->xTasksWaiting ), xTicksToWait );
+
+                if( xTaskResumeAll() == pdFALSE )
+                {
+                    portYIELD_WITHIN_API();
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else
+            {
+                /* The mutex was given since the critical section above, try
+                 * again. */
+                ( void ) xTaskResumeAll();
+            }
+        }
+        else
+        {
+            /* Timed out.  The next pass of the loop still takes the mutex if it
+             * was handed to this task as the block time expired. */
+            ( void ) xTaskResumeAll();
+        }
+    } /*lint -restore */
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xLwMutexGive( LwMutexHandle_t xMutex )
+{
+    LwMutex_t * const pxMutex = xMutex;
+    const uint32_t ulSelf = ( uint32_t ) xTaskGetCurrentTaskHandle();
+    BaseType_t xReturn = pdPASS;
+    BaseType_t xYieldRequired = pdFALSE;
+    uint32_t ulOwner, ulNewOwner;
+
+    configASSERT( pxMutex );
+
+    /* Uncontended path, fails if a flag is set. */
+    if( prvCompareAndSwap( &( pxMutex->ulOwner ), ulSelf, 0UL ) != pdFALSE )
+    {
+        return pdPASS;
+    }
+
+    taskENTER_CRITICAL();
+    {
+        ulOwner = pxMutex->ulOwner;
+
+        if( lwmutexHOLDER( ulOwner ) != ( TaskHandle_t ) ulSelf )
+        {
+            /* Only the holder can give the mutex. */
+            xReturn = pdFAIL;
+        }
+        else
+        {
+            if( ( ulOwner & lwmutexINHERITED_BIT ) != 0UL )
+            {
+                /* Balances the vTaskIncrementMutexHeldCountOf() made when the
+                 * priority was inherited. */
+                if( xTaskPriorityDisinherit( ( TaskHandle_t ) ulSelf ) != pdFALSE )
+                {
+                    xYieldRequired = pdTRUE;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            if( listLIST_IS_EMPTY( &( pxMutex->xTasksWaiting ) ) == pdFALSE )
+            {
+                /* Hand the mutex to the highest priority waiting task.  It has
+                 * the highest priority of the remaining waiters too, so nothing
+                 * is inherited yet. */
+                ulNewOwner = ( uint32_t ) listGET_OWNER_OF_HEAD_ENTRY( &( pxMutex->xTasksWaiting ) );
+
+                if( xTaskRemoveFromEventList( &( pxMutex->xTasksWaiting ) ) != pdFALSE )
+                {
+                    xYieldRequired = pdTRUE;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                if( listLIST_IS_EMPTY( &( pxMutex->xTasksWaiting ) ) == pdFALSE )
+                {
+                    ulNewOwner |= lwmutexWAITERS_BIT;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                pxMutex->ulOwner = ulNewOwner;
+            }
+            else
+            {
+                /* The waiters timed out. */
+                pxMutex->ulOwner = 0UL;
+            }
+        }
+    }
+    taskEXIT_CRITICAL();
+
+    #if ( configUSE_PREEMPTION == 1 )
+    {
+        if( xYieldRequired != pdFALSE )
+        {
+            portYIELD_WITHIN_API();
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+    #endif /* configUSE_PREEMPTION */
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+TaskHandle_t xLwMutexGetHolder( LwMutexHandle_t xMutex )
+{
+    LwMutex_t * const pxMutex = xMutex;
+
+    configASSERT( pxMutex );
+
+    return lwmutexHOLDER( pxMutex->ulOwner );
+}
+/*-----------------------------------------------------------*/
+
+void vLwMutexGetStats( LwMutexHandle_t xMutex,
+                       LwMutexStats_t * pxStats )
+{
+    LwMutex_t * const pxMutex = xMutex;
+
+    configASSERT( pxMutex );
+    configASSERT( pxStats );
+
+    taskENTER_CRITICAL();
+    {
+        *pxStats = pxMutex->xStats;
+    }
+    taskEXIT_CRITICAL();
+}
+/*-----------------------------------------------------------*/
+
+void vLwMutexDelete( LwMutexHandle_t xMutex )
+{
+    LwMutex_t * const pxMutex = xMutex;
+
+    configASSERT( pxMutex );
+    configASSERT( pxMutex->ulOwner == 0UL );
+    configASSERT( listLIST_IS_EMPTY( &( pxMutex->xTasksWaiting ) ) != pdFALSE );
+
+    #if ( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 0 ) )
+    {
+        vPortFree( pxMutex );
+    }
+    #elif ( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) )
+    {
+        if( pxMutex->ucStaticallyAllocated == ( uint8_t ) pdFALSE )
+        {
+            vPortFree( pxMutex );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+    #endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+}
+/*-----------------------------------------------------------*/
+
+static void prvDisinheritAfterTimeout( LwMutex_t * pxMutex,
+                                       uint32_t ulOwner )
+{
+    UBaseType_t uxHighestPriorityOfWaitingTasks;
+
+    /* The holder may have given the mutex since, in which case it has already
+     * dropped the inherited priority. */
+    if( ( ulOwner & lwmutexINHERITED_BIT ) != 0UL )
+    {
+        /* The task timing out is no longer on the wait list. */
+        if( listLIST_IS_EMPTY( &( pxMutex->xTasksWaiting ) ) == pdFALSE )
+        {
+            uxHighestPriorityOfWaitingTasks = ( UBaseType_t ) configMAX_PRIORITIES - ( UBaseType_t ) listGET_ITEM_VALUE_OF_HEAD_ENTRY( &( pxMutex->xTasksWaiting ) );
+        }
+        else
+        {
+            uxHighestPriorityOfWaitingTasks = tskIDLE_PRIORITY;
+        }
+
+        vTaskPriorityDisinheritAfterTimeout( lwmutexHOLDER( ulOwner ), uxHighestPriorityOfWaitingTasks );
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+}
+/*-----------------------------------------------------------*/
+
+#if ( portHAS_EXCLUSIVE_ACCESS == 1 )
+
+    static portFORCE_INLINE BaseType_t prvCompareAndSwap( volatile uint32_t * pulTarget,
+                                                          uint32_t ulExpected,
+                                                          uint32_t ulDesired )
+    {
+        do
+        {
+            if( ulPortLoadExclusive( pulTarget ) != ulExpected )
+            {
+                vPortClearExclusive();
+                return pdFALSE;
+            }
+
+            /* The store only fails if an exception was taken since the load,
+             * in which case the value is read again. */
+        } while( xPortStoreExclusive( pulTarget, ulDesired ) == pdFALSE );
+
+        return pdTRUE;
+    }
+
+#else /* portHAS_EXCLUSIVE_ACCESS */
+
+    static portFORCE_INLINE BaseType_t prvCompareAndSwap( volatile uint32_t * pulTarget,
+                                                          uint32_t ulExpected,
+                                                          uint32_t ulDesired )
+    {
+        BaseType_t xReturn = pdFALSE;
+
+        taskENTER_CRITICAL();
+        {
+            if( *pulTarget == ulExpected )
+            {
+                *pulTarget = ulDesired;
+                xReturn = pdTRUE;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        taskEXIT_CRITICAL();
+
+        return xReturn;
+    }
+
+#endif /* portHAS_EXCLUSIVE_ACCESS */
+/*-----------------------------------------------------------*/
+
+#endif /* configUSE_LW_MUTEXES */
@@ -0,0 +1,382 @@
+/*
+ * FreeRTOS Kernel V10.5.1
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/*
+ * Object registry, see object_registry.h.
+ *
+ * The registry is a fixed array of handles, found by a linear search when an
+ * object is added or removed, which is only done when objects are created or
+ * deleted.  The metrics are not copied into the registry, they are read from
+ * the objects themselves when a snapshot is taken, so registering an object
+ * costs nothing on its send, receive, take or give paths beyond keeping the
+ * high-water mark.
+ */
+
+/* Standard includes. */
+#include <string.h>
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+ * all the API functions to use the MPU wrappers.  That should only be done when
+ * task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+#include "timers.h"
+#include "stream_buffer.h"
+#include "object_registry.h"
+
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+#if ( configUSE_OBJECT_REGISTRY == 1 )
+
+/* Metrics are reported in 16 bits. */
+#define registryCLAMP( x )    ( ( uint16_t ) ( ( ( x ) > 0xFFFFU ) ? 0xFFFFU : ( x ) ) )
+
+typedef struct xREGISTRY_ENTRY
+{
+    void * pvObject;     /*< NULL for a free entry. */
+    const char * pcName; /*< Set by xObjectRegistryDescribe(), NULL to use the name the object has. */
+    uint8_t ucType;      /*< The registryTYPE_ value the object was added or described with. */
+} RegistryEntry_t;
+
+PRIVILEGED_DATA static RegistryEntry_t xRegistry[ configOBJECT_REGISTRY_SIZE ];
+PRIVILEGED_DATA static UBaseType_t uxOverflowCount = ( UBaseType_t ) 0U;
+
+/*
+ * Fill pxInfo for a task or a timer, using their public API.  The stack
+ * high-water mark of a task is left to prvGetStackHighWater().
+ */
+static void prvGetTaskInfo( TaskHandle_t xTask,
+                            ObjectInfo_t * pxInfo ) PRIVILEGED_FUNCTION;
+
+/*
+ * Fill in the stack high-water mark of a task listed in a snapshot, with the
+ * scheduler suspended only for the scan of that one stack.  Left at 0 if the
+ * task has been deleted since the snapshot was taken.
+ */
+static void prvGetStackHighWater( ObjectInfo_t * pxInfo ) PRIVILEGED_FUNCTION;
+#if ( configUSE_TIMERS == 1 )
+    static void prvGetTimerInfo( TimerHandle_t xTimer,
+                                 ObjectInfo_t * pxInfo ) PRIVILEGED_FUNCTION;
+#endif
+
+/*-----------------------------------------------------------*/
+
+void vObjectRegistryAdd( void * pvObject,
+                         uint8_t ucType )
+{
+    UBaseType_t ux;
+
+    taskENTER_CRITICAL();
+    {
+        for( ux = ( UBaseType_t ) 0U; ux < ( UBaseType_t ) configOBJECT_REGISTRY_SIZE; ux++ )
+        {
+            if( xRegistry[ ux ].pvObject == NULL )
+            {
+                xRegistry[ ux ].pvObject = pvObject;
+                xRegistry[ ux ].pcName = NULL;
+                xRegistry[ ux ].ucType = ucType;
+                break;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+
+        if( ux == ( UBaseType_t ) configOBJECT_REGISTRY_SIZE )
+        {
+            uxOverflowCount++;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+    taskEXIT_CRITICAL();
+}
+/*-----------------------------------------------------------*/
+
+void vObjectRegistryRemove( void * pvObject )
+{
+    UBaseType_t ux;
+
+    taskENTER_CRITICAL();
+    {
+        for( ux = ( UBaseType_t ) 0U; ux < ( UBaseType_t ) configOBJECT_REGISTRY_SIZE; ux++ )
+        {
+            if( xRegistry[ ux ].pvObject == pvObject )
+            {
+                xRegistry[ ux ].pvObject = NULL;
+                break;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+    }
+    taskEXIT_CRITICAL();
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xObjectRegistryDescribe( void * pvObject,
+                                    uint8_t ucType,
+                                    const char * pcName )
+{
+    UBaseType_t ux;
+    BaseType_t xReturn = pdFAIL;
+
+    configASSERT( pvObject );
+
+    taskENTER_CRITICAL();
+    {
+        for( ux = ( UBaseType_t ) 0U; ux < ( UBaseType_t ) configOBJECT_REGISTRY_SIZE; ux++ )
+        {
+            if( xRegistry[ ux ].pvObject == pvObject )
+            {
+                if( ucType != ( uint8_t ) 0U )
+                {
+                    xRegistry[ ux ].ucType = ucType;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                if( pcName != NULL )
+                {
+                    xRegistry[ ux ].pcName = pcName;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                xReturn = pdPASS;
+                break;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+    }
+    taskEXIT_CRITICAL();
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+UBaseType_t uxObjectRegistryGetSnapshot( ObjectInfo_t * const pxObjectArray,
+                                         const UBaseType_t uxArraySize )
+{
+    UBaseType_t ux, uxFilled = ( UBaseType_t ) 0U;
+    ObjectInfo_t * pxInfo;
+    const char * pcName;
+    void * pvObject;
+
+    configASSERT( pxObjectArray );
+
+    /* Objects are only deleted by tasks, so none can be freed while the
+     * scheduler is suspended. */
+    vTaskSuspendAll();
+    {
+        for( ux = ( UBaseType_t ) 0U; ( ux < ( UBaseType_t ) configOBJECT_REGISTRY_SIZE ) && ( uxFilled < uxArraySize ); ux++ )
+        {
+            pvObject = xRegistry[ ux ].pvObject;
+
+            if( pvObject != NULL )
+            {
+                pxInfo = &( pxObjectArray[ uxFilled ] );
+                ( void ) memset( pxInfo, 0x00, sizeof( ObjectInfo_t ) );
+                pxInfo->ulHandle = ( uint32_t ) ( portPOINTER_SIZE_TYPE ) pvObject;
+                pcName = NULL;
+
+                switch( xRegistry[ ux ].ucType )
+                {
+                    case registryTYPE_TASK:
+                        prvGetTaskInfo( ( TaskHandle_t ) pvObject, pxInfo );
+                        pcName = pcTaskGetName( ( TaskHandle_t ) pvObject );
+                        break;
+
+                    #if ( configUSE_TIMERS == 1 )
+                        case registryTYPE_TIMER:
+                            prvGetTimerInfo( ( TimerHandle_t ) pvObject, pxInfo );
+                            pcName = pcTimerGetName( ( TimerHandle_t ) pvObject );
+                            break;
+                    #endif
+
+                    case registryTYPE_STREAM_BUFFER:
+                        vStreamBufferGetObjectInfo( ( StreamBufferHandle_t ) pvObject, pxInfo );
+                        break;
+
+                    default:
+                        /* Queues, semaphores, mutexes and the queues of event
+                         * loops. */
+                        vQueueGetObjectInfo( ( QueueHandle_t ) pvObject, pxInfo );
+
+                        #if ( configQUEUE_REGISTRY_SIZE > 0 )
+                        {
+                            pcName = pcQueueGetName( ( QueueHandle_t ) pvObject );
+                        }
+                        #endif
+
+                        if( xRegistry[ ux ].ucType == registryTYPE_EVENT_LOOP )
+                        {
+                            pxInfo->ucType = registryTYPE_EVENT_LOOP;
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
+
+                        break;
+                }
+
+                if( xRegistry[ ux ].pcName != NULL )
+                {
+                    pcName = xRegistry[ ux ].pcName;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                if( pcName != NULL )
+                {
+                    ( void ) strncpy( pxInfo->acName, pcName, sizeof( pxInfo->acName ) );
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                uxFilled++;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+    }
+    ( void ) xTaskResumeAll();
+
+    for( ux = ( UBaseType_t ) 0U; ux < uxFilled; ux++ )
+    {
+        if( pxObjectArray[ ux ].ucType == registryTYPE_TASK )
+        {
+            prvGetStackHighWater( &( pxObjectArray[ ux ] ) );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+
+    return uxFilled;
+}
+/*-----------------------------------------------------------*/
+
+UBaseType_t uxObjectRegistryGetOverflowCount( void )
+{
+    return uxOverflowCount;
+}
+/*-----------------------------------------------------------*/
+
+static void prvGetTaskInfo( TaskHandle_t xTask,
+                            ObjectInfo_t * pxInfo )
+{
+    TaskStatus_t xStatus;
+
+    vTaskGetInfo( xTask, &xStatus, pdFALSE, eInvalid );
+
+    pxInfo->ulStorage = ( uint32_t ) ( portPOINTER_SIZE_TYPE ) xStatus.pxStackBase;
+    #if ( configUSE_MUTEXES == 1 )
+    {
+        pxInfo->usCapacity = registryCLAMP( xStatus.uxBasePriority );
+    }
+    #else
+    {
+        pxInfo->usCapacity = registryCLAMP( xStatus.uxCurrentPriority );
+    }
+    #endif
+
+    pxInfo->usLevel = registryCLAMP( xStatus.uxCurrentPriority );
+    pxInfo->ucType = registryTYPE_TASK;
+    pxInfo->ucState = ( uint8_t ) xStatus.eCurrentState;
+}
+/*-----------------------------------------------------------*/
+
+static void prvGetStackHighWater( ObjectInfo_t * pxInfo )
+{
+    UBaseType_t ux;
+    void * pvObject;
+
+    vTaskSuspendAll();
+    {
+        /* A deleted task is removed from the registry before its memory is
+         * freed, so the task is only scanned if it is still listed. */
+        for( ux = ( UBaseType_t ) 0U; ux < ( UBaseType_t ) configOBJECT_REGISTRY_SIZE; ux++ )
+        {
+            pvObject = xRegistry[ ux ].pvObject;
+
+            if( ( pvObject != NULL ) &&
+                ( xRegistry[ ux ].ucType == registryTYPE_TASK ) &&
+                ( ( uint32_t ) ( portPOINTER_SIZE_TYPE ) pvObject == pxInfo->ulHandle ) )
+            {
+                pxInfo->usHighWater = registryCLAMP( uxTaskGetStackHighWaterMark2( ( TaskHandle_t ) pvObject ) );
+                break;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+    }
+    ( void ) xTaskResumeAll();
+}
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TIMERS == 1 )
+
+    static void prvGetTimerInfo( TimerHandle_t xTimer,
+                                 ObjectInfo_t * pxInfo )
+    {
+        pxInfo->usCapacity = registryCLAMP( xTimerGetPeriod( xTimer ) );
+        pxInfo->ucType = registryTYPE_TIMER;
+        pxInfo->ucState = ( uint8_t ) ( ( xTimerIsTimerActive( xTimer ) != pdFALSE ) ? pdTRUE : pdFALSE );
+    }
+
+#endif /* configUSE_TIMERS */
+/*-----------------------------------------------------------*/
+
+#endif /* configUSE_OBJECT_REGISTRY */
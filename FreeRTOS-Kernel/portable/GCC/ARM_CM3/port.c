@@ -58,6 +58,13 @@
 #define portNVIC_PENDSV_PRI                   ( ( ( uint32_t ) configKERNEL_INTERRUPT_PRIORITY ) << 16UL )
 #define portNVIC_SYSTICK_PRI                  ( ( ( uint32_t ) configKERNEL_INTERRUPT_PRIORITY ) << 24UL )
 
+/* Constants required to use the DWT cycle counter as the run time stats clock. */
+#define portDEMCR_REG                         ( *( ( volatile uint32_t * ) 0xe000edfc ) )
+#define portDWT_CTRL_REG                      ( *( ( volatile uint32_t * ) 0xe0001000 ) )
+#define portDWT_CYCCNT_REG                    ( *( ( volatile uint32_t * ) 0xe0001004 ) )
+#define portDEMCR_TRCENA_BIT                  ( 1UL << 24UL )
+#define portDWT_CYCCNTENA_BIT                 ( 1UL << 0UL )
+
 /* Constants required to check the validity of an interrupt priority. */
 #define portFIRST_USER_INTERRUPT_NUMBER       ( 16 )
 #define portNVIC_IP_REGISTERS_OFFSET_16       ( 0xE000E3F0 )
@@ -160,6 +167,154 @@ static UBaseType_t uxCriticalNesting = 0xaaaaaaaa;
     static uint32_t ulStoppedTimerCompensation = 0;
 #endif /* configUSE_TICKLESS_IDLE */
 
+/*
+ * Residency counters for each power state (low power functionality only).
+ */
+#if ( configUSE_TICKLESS_IDLE == 1 )
+    static PortLowPowerStats_t xLowPowerStats = { 0 };
+    static TickType_t xLowPowerStatsResetTime = 0;
+#endif /* configUSE_TICKLESS_IDLE */
+
+/*
+ * Hand an idle period to the application supplied alternate timebase, which
+ * can sleep longer and deeper than the SysTick allows.
+ */
+#if ( ( configUSE_TICKLESS_IDLE == 1 ) && ( configUSE_TICKLESS_ALT_TIMEBASE == 1 ) )
+    static void prvSuppressTicksAndDeepSleep( TickType_t xExpectedIdleTime );
+#endif
+
+/*
+ * State of the 64-bit extension of the DWT cycle counter and of the time spent
+ * in instrumented interrupts (run time stats only).
+ */
+#if ( configUSE_DWT_RUN_TIME_COUNTER == 1 )
+    static uint32_t ulLastCycleCount = 0;
+    static uint32_t ulCycleCountWraps = 0;
+    static uint64_t ullISRCycles = 0;
+    static uint64_t ullISRNestStartTime = 0;
+    static uint32_t ulISRCount = 0;
+    static UBaseType_t uxISRNesting = 0;
+
+    #if ( configRUN_TIME_STATS_ISR_SLOTS > 0 )
+        static uint32_t ulISRSlotCycles[ configRUN_TIME_STATS_ISR_SLOTS ];
+        static uint32_t ulISRSlotCount[ configRUN_TIME_STATS_ISR_SLOTS ];
+        static uint32_t ulISRSlotStartTime[ configRUN_TIME_STATS_ISR_SLOTS ];
+    #endif
+
+/*
+ * Read the cycle counter, extended to 64 bits.  Must be called with interrupts
+ * masked, and at least once per wrap of the 32-bit counter.
+ */
+    static uint64_t prvReadCycleCounter( void );
+#endif /* configUSE_DWT_RUN_TIME_COUNTER */
+
+/*
+ * State of the interrupt profiler.  Profiles are given to exception numbers in
+ * the order in which they are first seen.
+ */
+#if ( configUSE_ISR_PROFILER == 1 )
+    static PortISRProfile_t xISRProfiles[ configISR_PROFILER_MAX_IRQS ];
+    static uint32_t ulISRProfileStartTime[ configISR_PROFILER_MAX_IRQS ];
+    static UBaseType_t uxISRProfilesUsed = 0;
+    static PortISRProfileSummary_t xISRProfileSummary = { 0 };
+
+    #if ( configUSE_TICKLESS_IDLE == 1 )
+        static BaseType_t xSkipTickLatency = pdFALSE;
+    #endif
+
+/*
+ * Returns the profile of the exception, allocating one the first time the
+ * exception is seen, or NULL if all the profiles are in use.  Must be called
+ * with interrupts masked.
+ */
+    static PortISRProfile_t * prvGetISRProfile( uint32_t ulExceptionNumber );
+#endif /* configUSE_ISR_PROFILER */
+
+/*
+ * Cycle counter value when the outermost critical section was entered.
+ */
+#if ( ( configUSE_ISR_PROFILER == 1 ) || ( configUSE_CRITICAL_SECTION_TRACKER == 1 ) )
+    static uint32_t ulCriticalStartTime = 0;
+#endif
+
+/*
+ * State of the critical section tracker.  The longest critical sections and
+ * scheduler suspensions are kept in order, longest first, one per caller.
+ */
+#if ( configUSE_CRITICAL_SECTION_TRACKER == 1 )
+    static PortCriticalSectionStats_t xCriticalSectionStats = { 0 };
+    static void * pvCriticalCaller = NULL;
+    static uint32_t ulSuspendedStartTime = 0;
+    static void * pvSuspendedCaller = NULL;
+
+/*
+ * Adds a section to pxRecords, which holds configCRITICAL_SECTION_TRACKER_ENTRIES
+ * records, if it is among the longest.  Must be called with interrupts masked.
+ */
+    static void prvRecordSection( PortCriticalSectionRecord_t * pxRecords,
+                                  void * pvCaller,
+                                  uint32_t ulCycles );
+#endif /* configUSE_CRITICAL_SECTION_TRACKER */
+
+/*
+ * State of the monotonic clock.  The tick interrupt publishes the number of
+ * ticks since the scheduler started together with the cycle counter value at
+ * that tick into one of two anchors, then moves ulClockSequence on to select
+ * it, so readers never see an anchor while it is being written.
+ */
+#if ( configUSE_MONOTONIC_CLOCK == 1 )
+    typedef struct xCLOCK_ANCHOR
+    {
+        uint64_t ullTicks;
+        uint32_t ulCycleCount;
+    } ClockAnchor_t;
+
+    static ClockAnchor_t xClockAnchor[ 2 ] = { { 0 } };
+    static volatile uint32_t ulClockSequence = 0;
+
+/* The cycles in one tick period, and the fixed point factors, in integer and
+ * 1/2^32 parts, used to convert between cycles and nanoseconds. */
+    static uint32_t ulClockCyclesPerTick = 0;
+    static uint32_t ulClockNsPerCycle = 0;
+    static uint32_t ulClockNsPerCycleFraction = 0;
+    static uint32_t ulClockCyclesPerNs = 0;
+    static uint32_t ulClockCyclesPerNsFraction = 0;
+
+/*
+ * Start the clock from zero.  Called by xPortStartScheduler() with interrupts
+ * disabled.
+ */
+    static void prvClockStart( void );
+
+/*
+ * Move the clock anchor on by xTicks tick periods.  Must be called with
+ * interrupts masked.
+ */
+    static void prvClockAdvance( TickType_t xTicks );
+
+/*
+ * Read the ticks and the cycles since the last tick, the latter limited to one
+ * tick period less one cycle so the clock never runs past the next tick.
+ */
+    static void prvClockRead( uint64_t * pullTicks,
+                              uint32_t * pulCycles );
+#endif /* configUSE_MONOTONIC_CLOCK */
+
+/*
+ * Context switch statistics, updated by the PendSV handler only.
+ */
+#if ( configUSE_CONTEXT_SWITCH_STATS == 1 )
+    static PortContextSwitchStats_t xContextSwitchStats = { 0 };
+
+/*
+ * Adds the time since ulStartTime to the statistics of switches to another
+ * task if xSwitched is not 0, or else of switches back to the same task.
+ * Called by the PendSV handler, so not static.
+ */
+    void vPortRecordContextSwitch( uint32_t ulStartTime,
+                                   uint32_t xSwitched );
+#endif /* configUSE_CONTEXT_SWITCH_STATS */
+
 /*
  * Used by the portASSERT_IF_INTERRUPT_PRIORITY_INVALID() macro to ensure
  * FreeRTOS API functions are not called from interrupts that have been assigned
@@ -336,6 +491,21 @@ BaseType_t xPortStartScheduler( void )
     portNVIC_SHPR3_REG |= portNVIC_PENDSV_PRI;
     portNVIC_SHPR3_REG |= portNVIC_SYSTICK_PRI;
 
+    #if ( configUSE_MONOTONIC_CLOCK == 1 )
+    {
+        prvClockStart();
+    }
+    #endif
+
+    #if ( ( configUSE_CRITICAL_SECTION_TRACKER == 1 ) || ( configUSE_CONTEXT_SWITCH_STATS == 1 ) )
+    {
+        /* The sections and the context switches are timed with the cycle
+         * counter. */
+        portDEMCR_REG |= portDEMCR_TRCENA_BIT;
+        portDWT_CTRL_REG |= portDWT_CYCCNTENA_BIT;
+    }
+    #endif
+
     /* Start the timer that generates the tick ISR.  Interrupts are disabled
      * here already. */
     vPortSetupTimerInterrupt();
@@ -381,6 +551,20 @@ void vPortEnterCritical( void )
     if( uxCriticalNesting == 1 )
     {
         configASSERT( ( portNVIC_INT_CTRL_REG & portVECTACTIVE_MASK ) == 0 );
+
+        #if ( ( configUSE_ISR_PROFILER == 1 ) || ( configUSE_CRITICAL_SECTION_TRACKER == 1 ) )
+        {
+            ulCriticalStartTime = portDWT_CYCCNT_REG;
+        }
+        #endif
+
+        #if ( configUSE_CRITICAL_SECTION_TRACKER == 1 )
+        {
+            /* taskENTER_CRITICAL() is a macro, so this is the function that
+             * entered the critical section. */
+            pvCriticalCaller = __builtin_return_address( 0 );
+        }
+        #endif
     }
 }
 /*-----------------------------------------------------------*/
@@ -392,6 +576,32 @@ void vPortExitCritical( void )
 
     if( uxCriticalNesting == 0 )
     {
+        #if ( ( configUSE_ISR_PROFILER == 1 ) || ( configUSE_CRITICAL_SECTION_TRACKER == 1 ) )
+        {
+            uint32_t ulCycles = portDWT_CYCCNT_REG - ulCriticalStartTime;
+
+            #if ( configUSE_ISR_PROFILER == 1 )
+            {
+                if( ulCycles > xISRProfileSummary.ulMaxCriticalCycles )
+                {
+                    xISRProfileSummary.ulMaxCriticalCycles = ulCycles;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            #endif
+
+            #if ( configUSE_CRITICAL_SECTION_TRACKER == 1 )
+            {
+                xCriticalSectionStats.ulCriticalSections++;
+                prvRecordSection( xCriticalSectionStats.xCritical, pvCriticalCaller, ulCycles );
+            }
+            #endif
+        }
+        #endif
+
         portENABLE_INTERRUPTS();
     }
 }
@@ -406,29 +616,67 @@ void xPortPendSVHandler( void )
         "	mrs r0, psp							\n"
         "	isb									\n"
         "										\n"
+        #if ( configUSE_CONTEXT_SWITCH_STATS == 1 )
+            "	ldr r12, portDWTCycCntConst			\n"/* Start time of the switch, kept in r12 across vTaskSwitchContext(). */
+            "	ldr r12, [r12]						\n"
+            "										\n"
+        #endif
         "	ldr	r3, pxCurrentTCBConst			\n"/* Get the location of the current TCB. */
         "	ldr	r2, [r3]						\n"
         "										\n"
-        "	stmdb r0!, {r4-r11}					\n"/* Save the remaining registers. */
-        "	str r0, [r2]						\n"/* Save the new top of stack into the first member of the TCB. */
+        #if ( configUSE_LAZY_CONTEXT_SWITCH == 1 )
+            "	sub r0, r0, #32						\n"/* r4-r11 stay in place until another task is selected, but */
+            "	str r0, [r2]						\n"/* the stack overflow check needs the top of stack they leave. */
+        #else
+            "	stmdb r0!, {r4-r11}					\n"/* Save the remaining registers. */
+            "	str r0, [r2]						\n"/* Save the new top of stack into the first member of the TCB. */
+        #endif
         "										\n"
-        "	stmdb sp!, {r3, r14}				\n"
+        #if ( ( configUSE_LAZY_CONTEXT_SWITCH == 1 ) || ( configUSE_CONTEXT_SWITCH_STATS == 1 ) )
+            "	stmdb sp!, {r2, r3, r12, r14}		\n"/* Keep the previous TCB and the start time. */
+        #else
+            "	stmdb sp!, {r3, r14}				\n"
+        #endif
         "	mov r0, %0							\n"
         "	msr basepri, r0						\n"
         "	bl vTaskSwitchContext				\n"
         "	mov r0, #0							\n"
         "	msr basepri, r0						\n"
-        "	ldmia sp!, {r3, r14}				\n"
+        #if ( ( configUSE_LAZY_CONTEXT_SWITCH == 1 ) || ( configUSE_CONTEXT_SWITCH_STATS == 1 ) )
+            "	ldmia sp!, {r2, r3, r12, r14}		\n"
+        #else
+            "	ldmia sp!, {r3, r14}				\n"
+        #endif
         "										\n"/* Restore the context, including the critical nesting count. */
         "	ldr r1, [r3]						\n"
+        #if ( configUSE_LAZY_CONTEXT_SWITCH == 1 )
+            "	cmp r1, r2							\n"/* The same task's registers are all still in place. */
+            "	beq 1f								\n"
+            "	ldr r0, [r2]						\n"/* Save r4-r11 of the previous task below its exception frame. */
+            "	stmia r0, {r4-r11}					\n"
+        #endif
         "	ldr r0, [r1]						\n"/* The first item in pxCurrentTCB is the task top of stack. */
         "	ldmia r0!, {r4-r11}					\n"/* Pop the registers. */
         "	msr psp, r0							\n"
         "	isb									\n"
+        #if ( configUSE_LAZY_CONTEXT_SWITCH == 1 )
+            "1:										\n"
+        #endif
+        #if ( configUSE_CONTEXT_SWITCH_STATS == 1 )
+            "										\n"
+            "	mov r0, r12							\n"
+            "	sub r1, r1, r2						\n"/* Not 0 if another task was selected. */
+            "	stmdb sp!, {r3, r14}				\n"
+            "	bl vPortRecordContextSwitch			\n"/* r4-r11 are preserved by the call. */
+            "	ldmia sp!, {r3, r14}				\n"
+        #endif
         "	bx r14								\n"
         "										\n"
         "	.align 4							\n"
         "pxCurrentTCBConst: .word pxCurrentTCB	\n"
+        #if ( configUSE_CONTEXT_SWITCH_STATS == 1 )
+            "portDWTCycCntConst: .word 0xe0001004	\n"
+        #endif
         ::"i" ( configMAX_SYSCALL_INTERRUPT_PRIORITY )
     );
 }
@@ -436,12 +684,62 @@ void xPortPendSVHandler( void )
 
 void xPortSysTickHandler( void )
 {
+    #if ( configUSE_ISR_PROFILER == 1 )
+        /* The SysTick counts down from its reload value again as soon as it
+         * reaches zero, so the counts since the reload are the time the tick
+         * interrupt waited to be taken. */
+        uint32_t ulTickLatency = portNVIC_SYSTICK_LOAD_REG - portNVIC_SYSTICK_CURRENT_VALUE_REG;
+    #endif
+
+    portRUN_TIME_ISR_ENTER();
+
     /* The SysTick runs at the lowest interrupt priority, so when this interrupt
      * executes all interrupts must be unmasked.  There is therefore no need to
      * save and then restore the interrupt mask value as its value is already
      * known. */
     portDISABLE_INTERRUPTS();
     {
+        #if ( configUSE_DWT_RUN_TIME_COUNTER == 1 )
+        {
+            /* The cycle counter wraps in less than a minute at typical clock
+             * rates.  Reading it on every tick guarantees no wrap is missed. */
+            ( void ) prvReadCycleCounter();
+        }
+        #endif
+
+        #if ( configUSE_MONOTONIC_CLOCK == 1 )
+        {
+            prvClockAdvance( ( TickType_t ) 1 );
+        }
+        #endif
+
+        #if ( configUSE_ISR_PROFILER == 1 )
+        {
+            #if ( configUSE_TICKLESS_IDLE == 1 )
+                /* The first tick after a sleep ends a period that was loaded
+                 * with the remainder of a tick, not with the reload value. */
+                if( xSkipTickLatency != pdFALSE )
+                {
+                    xSkipTickLatency = pdFALSE;
+                }
+                else
+            #endif
+            {
+                xISRProfileSummary.ulTickCount++;
+                xISRProfileSummary.ullTotalTickLatency += ulTickLatency;
+
+                if( ulTickLatency > xISRProfileSummary.ulMaxTickLatency )
+                {
+                    xISRProfileSummary.ulMaxTickLatency = ulTickLatency;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+        }
+        #endif
+
         /* Increment the RTOS tick. */
         if( xTaskIncrementTick() != pdFALSE )
         {
@@ -451,6 +749,8 @@ void xPortSysTickHandler( void )
         }
     }
     portENABLE_INTERRUPTS();
+
+    portRUN_TIME_ISR_EXIT();
 }
 /*-----------------------------------------------------------*/
 
@@ -461,6 +761,19 @@ void xPortSysTickHandler( void )
         uint32_t ulReloadValue, ulCompleteTickPeriods, ulCompletedSysTickDecrements, ulSysTickDecrementsLeft;
         TickType_t xModifiableIdleTime;
 
+        #if ( configUSE_TICKLESS_ALT_TIMEBASE == 1 )
+        {
+            /* Idle periods that are long enough to repay the cost of entering
+             * and leaving the deeper sleep state, or that are longer than the
+             * SysTick can time, go to the alternate timebase. */
+            if( xExpectedIdleTime >= configTICKLESS_ALT_TIMEBASE_MIN_TICKS )
+            {
+                prvSuppressTicksAndDeepSleep( xExpectedIdleTime );
+                return;
+            }
+        }
+        #endif /* configUSE_TICKLESS_ALT_TIMEBASE */
+
         /* Make sure the SysTick reload value does not overflow the counter. */
         if( xExpectedIdleTime > xMaximumPossibleSuppressedTicks )
         {
@@ -477,6 +790,8 @@ void xPortSysTickHandler( void )
          * to be unsuspended then abandon the low power entry. */
         if( eTaskConfirmSleepModeStatus() == eAbortSleep )
         {
+            xLowPowerStats.ulAbortedEntries++;
+
             /* Re-enable interrupts - see comments above the cpsid instruction
              * above. */
             __asm volatile ( "cpsie i" ::: "memory" );
@@ -596,6 +911,9 @@ void xPortSysTickHandler( void )
                  * function exits, the tick value maintained by the tick is stepped
                  * forward by one less than the time spent waiting. */
                 ulCompleteTickPeriods = xExpectedIdleTime - 1UL;
+
+                /* The pending tick was slept through too. */
+                xLowPowerStats.ulTicksAsleep++;
             }
             else
             {
@@ -667,6 +985,30 @@ void xPortSysTickHandler( void )
             /* Step the tick to account for any tick periods that elapsed. */
             vTaskStepTick( ulCompleteTickPeriods );
 
+            #if ( configUSE_ISR_PROFILER == 1 )
+            {
+                xSkipTickLatency = pdTRUE;
+            }
+            #endif
+
+            #if ( configUSE_CRITICAL_SECTION_TRACKER == 1 )
+            {
+                /* The idle task suspends the scheduler around the sleep, which
+                 * ends as soon as an interrupt occurs, so only the time awake
+                 * counts. */
+                vPortRestartSchedulerSuspendedWindow();
+            }
+            #endif
+
+            #if ( configUSE_MONOTONIC_CLOCK == 1 )
+            {
+                prvClockAdvance( ( TickType_t ) ulCompleteTickPeriods );
+            }
+            #endif
+
+            xLowPowerStats.ulSleepEntries++;
+            xLowPowerStats.ulTicksAsleep += ulCompleteTickPeriods;
+
             /* Exit with interrupts enabled. */
             __asm volatile ( "cpsie i" ::: "memory" );
         }
@@ -675,6 +1017,141 @@ void xPortSysTickHandler( void )
 #endif /* configUSE_TICKLESS_IDLE */
 /*-----------------------------------------------------------*/
 
+#if ( ( configUSE_TICKLESS_IDLE == 1 ) && ( configUSE_TICKLESS_ALT_TIMEBASE == 1 ) )
+
+    static void prvSuppressTicksAndDeepSleep( TickType_t xExpectedIdleTime )
+    {
+        TickType_t xCompleteTickPeriods, xModifiableIdleTime;
+        uint32_t ulTickPending;
+
+        /* Enter a critical section but don't use the taskENTER_CRITICAL()
+         * method as that will mask interrupts that should exit sleep mode. */
+        __asm volatile ( "cpsid i" ::: "memory" );
+        __asm volatile ( "dsb" );
+        __asm volatile ( "isb" );
+
+        /* If a context switch is pending or a task is waiting for the scheduler
+         * to be unsuspended then abandon the low power entry. */
+        if( eTaskConfirmSleepModeStatus() == eAbortSleep )
+        {
+            xLowPowerStats.ulAbortedEntries++;
+            __asm volatile ( "cpsie i" ::: "memory" );
+        }
+        else
+        {
+            /* The SysTick does not run in the deeper sleep state so stop it.  A
+             * tick that is already pending has elapsed but not been counted, so
+             * clear it and count it here instead, otherwise it would be counted
+             * on top of the time measured by the alternate timebase. */
+            portNVIC_SYSTICK_CTRL_REG = ( portNVIC_SYSTICK_CLK_BIT_CONFIG | portNVIC_SYSTICK_INT_BIT );
+
+            if( ( portNVIC_INT_CTRL_REG & portNVIC_PEND_SYSTICK_SET_BIT ) != 0 )
+            {
+                portNVIC_INT_CTRL_REG = portNVIC_PEND_SYSTICK_CLEAR_BIT;
+                ulTickPending = 1UL;
+            }
+            else
+            {
+                ulTickPending = 0UL;
+            }
+
+            /* The alternate timebase executes the sleep instruction itself, so
+             * configPRE_SLEEP_PROCESSING() is only given the chance to prepare
+             * peripherals here. */
+            xModifiableIdleTime = xExpectedIdleTime;
+            configPRE_SLEEP_PROCESSING( xModifiableIdleTime );
+            ( void ) xModifiableIdleTime;
+
+            xCompleteTickPeriods = xPortAltTimebaseSleep( xExpectedIdleTime ) + ( TickType_t ) ulTickPending;
+
+            configPOST_SLEEP_PROCESSING( xExpectedIdleTime );
+
+            if( xCompleteTickPeriods > xExpectedIdleTime )
+            {
+                xCompleteTickPeriods = xExpectedIdleTime;
+            }
+
+            /* Restart the SysTick for a full tick period.  The part of a tick
+             * period that was in progress when the SysTick was stopped is kept
+             * by the alternate timebase and returned on a later sleep. */
+            portNVIC_SYSTICK_CURRENT_VALUE_REG = 0UL;
+            portNVIC_SYSTICK_LOAD_REG = ulTimerCountsForOneTick - 1UL;
+            portNVIC_SYSTICK_CTRL_REG = ( portNVIC_SYSTICK_CLK_BIT_CONFIG | portNVIC_SYSTICK_INT_BIT | portNVIC_SYSTICK_ENABLE_BIT );
+
+            /* Step the tick to account for the tick periods that elapsed.  If
+             * the whole expected idle time passed, vTaskStepTick() leaves the
+             * last tick pending so the delayed task is unblocked by the tick
+             * processing. */
+            if( xCompleteTickPeriods > ( TickType_t ) 0 )
+            {
+                vTaskStepTick( xCompleteTickPeriods );
+
+                #if ( configUSE_MONOTONIC_CLOCK == 1 )
+                {
+                    prvClockAdvance( xCompleteTickPeriods );
+                }
+                #endif
+            }
+
+            #if ( configUSE_CRITICAL_SECTION_TRACKER == 1 )
+            {
+                vPortRestartSchedulerSuspendedWindow();
+            }
+            #endif
+
+            xLowPowerStats.ulDeepSleepEntries++;
+            xLowPowerStats.ulTicksInDeepSleep += ( uint32_t ) xCompleteTickPeriods;
+
+            /* Exit with interrupts enabled.  The interrupt that ended the sleep
+             * executes now. */
+            __asm volatile ( "cpsie i" ::: "memory" );
+        }
+    }
+
+#endif /* ( configUSE_TICKLESS_IDLE == 1 ) && ( configUSE_TICKLESS_ALT_TIMEBASE == 1 ) */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TICKLESS_IDLE == 1 )
+
+    void vPortGetLowPowerStats( PortLowPowerStats_t * pxStats )
+    {
+        TickType_t xElapsed;
+
+        portENTER_CRITICAL();
+        {
+            *pxStats = xLowPowerStats;
+            xElapsed = xTaskGetTickCount() - xLowPowerStatsResetTime;
+        }
+        portEXIT_CRITICAL();
+
+        /* Every tick that was not suppressed was spent with the tick interrupt
+         * running. */
+        pxStats->ulTicksAwake = ( uint32_t ) xElapsed - pxStats->ulTicksAsleep - pxStats->ulTicksInDeepSleep;
+    }
+
+#endif /* configUSE_TICKLESS_IDLE */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TICKLESS_IDLE == 1 )
+
+    void vPortResetLowPowerStats( void )
+    {
+        portENTER_CRITICAL();
+        {
+            xLowPowerStats.ulTicksAwake = 0;
+            xLowPowerStats.ulTicksAsleep = 0;
+            xLowPowerStats.ulTicksInDeepSleep = 0;
+            xLowPowerStats.ulSleepEntries = 0;
+            xLowPowerStats.ulDeepSleepEntries = 0;
+            xLowPowerStats.ulAbortedEntries = 0;
+            xLowPowerStatsResetTime = xTaskGetTickCount();
+        }
+        portEXIT_CRITICAL();
+    }
+
+#endif /* configUSE_TICKLESS_IDLE */
+/*-----------------------------------------------------------*/
+
 /*
  * Setup the systick timer to generate the tick interrupts at the required
  * frequency.
@@ -700,6 +1177,664 @@ __attribute__( ( weak ) ) void vPortSetupTimerInterrupt( void )
 }
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_DWT_RUN_TIME_COUNTER == 1 )
+
+    void vPortConfigureRunTimeCounter( void )
+    {
+        /* Enable the trace block, then start the cycle counter from zero. */
+        portDEMCR_REG |= portDEMCR_TRCENA_BIT;
+        portDWT_CYCCNT_REG = 0;
+        portDWT_CTRL_REG |= portDWT_CYCCNTENA_BIT;
+
+        ulLastCycleCount = 0;
+        ulCycleCountWraps = 0;
+    }
+/*-----------------------------------------------------------*/
+
+    static uint64_t prvReadCycleCounter( void )
+    {
+        uint32_t ulCycleCount = portDWT_CYCCNT_REG;
+
+        if( ulCycleCount < ulLastCycleCount )
+        {
+            ulCycleCountWraps++;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        ulLastCycleCount = ulCycleCount;
+
+        return ( ( uint64_t ) ulCycleCountWraps << 32 ) | ulCycleCount;
+    }
+/*-----------------------------------------------------------*/
+
+    uint64_t ullPortGetRunTimeCounter( void )
+    {
+        uint64_t ullNow, ullTaskTime;
+        UBaseType_t uxSavedInterruptStatus;
+
+        uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+        {
+            ullNow = prvReadCycleCounter();
+
+            /* Only the time spent outside instrumented interrupts counts as
+             * task run time, including the part of an interrupt that is still
+             * executing. */
+            ullTaskTime = ullNow - ullISRCycles;
+
+            if( uxISRNesting > 0 )
+            {
+                ullTaskTime -= ( ullNow - ullISRNestStartTime );
+            }
+        }
+        portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+
+        return ullTaskTime;
+    }
+/*-----------------------------------------------------------*/
+
+    void vPortGetRunTimeStats( PortRunTimeStats_t * pxStats )
+    {
+        UBaseType_t uxSavedInterruptStatus;
+
+        uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+        {
+            pxStats->ullTotalCycles = prvReadCycleCounter();
+            pxStats->ullISRCycles = ullISRCycles;
+            pxStats->ulISRCount = ulISRCount;
+        }
+        portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+    }
+/*-----------------------------------------------------------*/
+
+    void vPortGetISRRunTime( uint32_t ulExceptionNumber,
+                             uint32_t * pulCycles,
+                             uint32_t * pulCount )
+    {
+        #if ( configRUN_TIME_STATS_ISR_SLOTS > 0 )
+        {
+            UBaseType_t uxSavedInterruptStatus;
+
+            if( ulExceptionNumber < configRUN_TIME_STATS_ISR_SLOTS )
+            {
+                uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+                {
+                    *pulCycles = ulISRSlotCycles[ ulExceptionNumber ];
+                    *pulCount = ulISRSlotCount[ ulExceptionNumber ];
+                }
+                portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+            }
+            else
+            {
+                *pulCycles = 0;
+                *pulCount = 0;
+            }
+        }
+        #else /* if ( configRUN_TIME_STATS_ISR_SLOTS > 0 ) */
+        {
+            ( void ) ulExceptionNumber;
+            *pulCycles = 0;
+            *pulCount = 0;
+        }
+        #endif /* configRUN_TIME_STATS_ISR_SLOTS */
+    }
+/*-----------------------------------------------------------*/
+
+    void vPortRunTimeISREnter( void )
+    {
+        uint64_t ullNow;
+        UBaseType_t uxSavedInterruptStatus;
+
+        uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+        {
+            ullNow = prvReadCycleCounter();
+
+            /* Nested interrupts are already inside the outermost interval. */
+            if( uxISRNesting == 0 )
+            {
+                ullISRNestStartTime = ullNow;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            uxISRNesting++;
+            ulISRCount++;
+
+            #if ( configUSE_ISR_PROFILER == 1 )
+            {
+                PortISRProfile_t * pxProfile;
+                uint32_t ulExceptionNumber;
+
+                __asm volatile ( "mrs %0, ipsr" : "=r" ( ulExceptionNumber )::"memory" );
+
+                if( uxISRNesting > xISRProfileSummary.uxMaxNesting )
+                {
+                    xISRProfileSummary.uxMaxNesting = uxISRNesting;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                pxProfile = prvGetISRProfile( ulExceptionNumber );
+
+                if( pxProfile != NULL )
+                {
+                    ulISRProfileStartTime[ pxProfile - xISRProfiles ] = ( uint32_t ) ullNow;
+                }
+                else
+                {
+                    xISRProfileSummary.ulUnprofiledEntries++;
+                }
+            }
+            #endif
+
+            #if ( configRUN_TIME_STATS_ISR_SLOTS > 0 )
+            {
+                uint32_t ulExceptionNumber;
+
+                __asm volatile ( "mrs %0, ipsr" : "=r" ( ulExceptionNumber )::"memory" );
+
+                if( ulExceptionNumber < configRUN_TIME_STATS_ISR_SLOTS )
+                {
+                    ulISRSlotStartTime[ ulExceptionNumber ] = ( uint32_t ) ullNow;
+                    ulISRSlotCount[ ulExceptionNumber ]++;
+                }
+            }
+            #endif
+        }
+        portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+    }
+/*-----------------------------------------------------------*/
+
+    void vPortRunTimeISRExit( void )
+    {
+        uint64_t ullNow;
+        UBaseType_t uxSavedInterruptStatus;
+
+        uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+        {
+            ullNow = prvReadCycleCounter();
+
+            configASSERT( uxISRNesting > 0 );
+            uxISRNesting--;
+
+            if( uxISRNesting == 0 )
+            {
+                ullISRCycles += ullNow - ullISRNestStartTime;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            #if ( configRUN_TIME_STATS_ISR_SLOTS > 0 )
+            {
+                uint32_t ulExceptionNumber;
+
+                __asm volatile ( "mrs %0, ipsr" : "=r" ( ulExceptionNumber )::"memory" );
+
+                /* Per interrupt times include the time spent in interrupts
+                 * that nested inside them. */
+                if( ulExceptionNumber < configRUN_TIME_STATS_ISR_SLOTS )
+                {
+                    ulISRSlotCycles[ ulExceptionNumber ] += ( uint32_t ) ullNow - ulISRSlotStartTime[ ulExceptionNumber ];
+                }
+            }
+            #endif
+
+            #if ( configUSE_ISR_PROFILER == 1 )
+            {
+                PortISRProfile_t * pxProfile;
+                uint32_t ulExceptionNumber, ulCycles, ulBucket;
+
+                __asm volatile ( "mrs %0, ipsr" : "=r" ( ulExceptionNumber )::"memory" );
+
+                pxProfile = prvGetISRProfile( ulExceptionNumber );
+
+                if( pxProfile != NULL )
+                {
+                    /* As above, the time includes nested interrupts. */
+                    ulCycles = ( uint32_t ) ullNow - ulISRProfileStartTime[ pxProfile - xISRProfiles ];
+
+                    pxProfile->ulCount++;
+                    pxProfile->ullTotalCycles += ulCycles;
+
+                    if( ( ulCycles < pxProfile->ulMinCycles ) || ( pxProfile->ulCount == 1UL ) )
+                    {
+                        pxProfile->ulMinCycles = ulCycles;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+
+                    if( ulCycles > pxProfile->ulMaxCycles )
+                    {
+                        pxProfile->ulMaxCycles = ulCycles;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+
+                    /* Bucket 0 holds times below 2^configISR_PROFILER_HISTOGRAM_SHIFT
+                     * cycles and each following bucket twice the range of the
+                     * one before, the last one everything longer. */
+                    ulCycles >>= configISR_PROFILER_HISTOGRAM_SHIFT;
+                    ulBucket = ( ulCycles == 0UL ) ? 0UL : ( 32UL - ( uint32_t ) __builtin_clz( ulCycles ) );
+
+                    if( ulBucket >= configISR_PROFILER_HISTOGRAM_BUCKETS )
+                    {
+                        ulBucket = configISR_PROFILER_HISTOGRAM_BUCKETS - 1UL;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+
+                    pxProfile->ulHistogram[ ulBucket ]++;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            #endif
+        }
+        portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+    }
+
+#endif /* configUSE_DWT_RUN_TIME_COUNTER */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_MONOTONIC_CLOCK == 1 )
+
+    static void prvClockStart( void )
+    {
+        uint32_t ulClockHz = ( uint32_t ) configCPU_CLOCK_HZ;
+
+        /* The cycle counter may already run for the run time stats, starting
+         * it again leaves its value alone. */
+        portDEMCR_REG |= portDEMCR_TRCENA_BIT;
+        portDWT_CTRL_REG |= portDWT_CYCCNTENA_BIT;
+
+        ulClockCyclesPerTick = ulClockHz / ( uint32_t ) configTICK_RATE_HZ;
+        configASSERT( ulClockCyclesPerTick > 0UL );
+
+        ulClockNsPerCycle = portCLOCK_NS_PER_SECOND / ulClockHz;
+        ulClockNsPerCycleFraction = ( uint32_t ) ( ( ( uint64_t ) ( portCLOCK_NS_PER_SECOND % ulClockHz ) << 32 ) / ulClockHz );
+        ulClockCyclesPerNs = ulClockHz / portCLOCK_NS_PER_SECOND;
+        ulClockCyclesPerNsFraction = ( uint32_t ) ( ( ( uint64_t ) ( ulClockHz % portCLOCK_NS_PER_SECOND ) << 32 ) / portCLOCK_NS_PER_SECOND );
+
+        xClockAnchor[ 1 ].ullTicks = 0;
+        xClockAnchor[ 1 ].ulCycleCount = portDWT_CYCCNT_REG;
+        __asm volatile ( "dmb" ::: "memory" );
+        ulClockSequence = 1;
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvClockAdvance( TickType_t xTicks )
+    {
+        uint32_t ulSequence = ulClockSequence;
+        const ClockAnchor_t * pxCurrent = &( xClockAnchor[ ulSequence & 1UL ] );
+        ClockAnchor_t * pxNext = &( xClockAnchor[ ( ulSequence + 1UL ) & 1UL ] );
+
+        /* Readers only ever use the anchor selected by ulClockSequence, so the
+         * other one can be written without a lock.  A reader that was using it
+         * two updates ago sees the sequence change and reads again. */
+        pxNext->ullTicks = pxCurrent->ullTicks + ( uint64_t ) xTicks;
+        pxNext->ulCycleCount = portDWT_CYCCNT_REG;
+        __asm volatile ( "dmb" ::: "memory" );
+        ulClockSequence = ulSequence + 1UL;
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvClockRead( uint64_t * pullTicks,
+                              uint32_t * pulCycles )
+    {
+        uint32_t ulSequence, ulCycles;
+        uint64_t ullTicks;
+
+        do
+        {
+            ulSequence = ulClockSequence;
+            __asm volatile ( "dmb" ::: "memory" );
+
+            ullTicks = xClockAnchor[ ulSequence & 1UL ].ullTicks;
+            ulCycles = portDWT_CYCCNT_REG - xClockAnchor[ ulSequence & 1UL ].ulCycleCount;
+
+            __asm volatile ( "dmb" ::: "memory" );
+        } while( ulSequence != ulClockSequence );
+
+        /* The cycle counter stops in sleep and STOP mode, and the tick that is
+         * due may be held off by a critical section.  Holding the clock just
+         * short of the next tick keeps it monotonic in both cases, the tick
+         * interrupt or the tick step after sleeping then brings it up to
+         * date. */
+        if( ulCycles >= ulClockCyclesPerTick )
+        {
+            ulCycles = ( ulClockCyclesPerTick > 0UL ) ? ( ulClockCyclesPerTick - 1UL ) : 0UL;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        *pullTicks = ullTicks;
+        *pulCycles = ulCycles;
+    }
+/*-----------------------------------------------------------*/
+
+    uint64_t ullPortGetClockCycles( void )
+    {
+        uint64_t ullTicks;
+        uint32_t ulCycles;
+
+        prvClockRead( &ullTicks, &ulCycles );
+
+        return ( ullTicks * ulClockCyclesPerTick ) + ulCycles;
+    }
+/*-----------------------------------------------------------*/
+
+    uint64_t ullPortGetClockNs( void )
+    {
+        uint64_t ullTicks;
+        uint32_t ulCycles;
+
+        /* Whole ticks convert exactly, so the conversion error is limited to
+         * the part of a tick period that has elapsed. */
+        prvClockRead( &ullTicks, &ulCycles );
+
+        return portCLOCK_TICKS_TO_NS( ullTicks ) + ullPortClockCyclesToNs( ulCycles );
+    }
+/*-----------------------------------------------------------*/
+
+    uint64_t ullPortClockCyclesToNs( uint64_t ullCycles )
+    {
+        uint64_t ullNs;
+
+        /* Multiply by the integer part, then by the 32-bit fraction one half of
+         * the cycles at a time so nothing overflows 64 bits. */
+        ullNs = ullCycles * ulClockNsPerCycle;
+        ullNs += ( ullCycles >> 32 ) * ulClockNsPerCycleFraction;
+        ullNs += ( ( ullCycles & 0xffffffffULL ) * ulClockNsPerCycleFraction ) >> 32;
+
+        return ullNs;
+    }
+/*-----------------------------------------------------------*/
+
+    uint64_t ullPortClockNsToCycles( uint64_t ullNs )
+    {
+        uint64_t ullCycles;
+
+        ullCycles = ullNs * ulClockCyclesPerNs;
+        ullCycles += ( ullNs >> 32 ) * ulClockCyclesPerNsFraction;
+        ullCycles += ( ( ullNs & 0xffffffffULL ) * ulClockCyclesPerNsFraction ) >> 32;
+
+        return ullCycles;
+    }
+
+#endif /* configUSE_MONOTONIC_CLOCK */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_ISR_PROFILER == 1 )
+
+    static PortISRProfile_t * prvGetISRProfile( uint32_t ulExceptionNumber )
+    {
+        PortISRProfile_t * pxProfile = NULL;
+        UBaseType_t x;
+
+        for( x = 0; x < uxISRProfilesUsed; x++ )
+        {
+            if( xISRProfiles[ x ].ulExceptionNumber == ulExceptionNumber )
+            {
+                pxProfile = &( xISRProfiles[ x ] );
+                break;
+            }
+        }
+
+        if( ( pxProfile == NULL ) && ( uxISRProfilesUsed < configISR_PROFILER_MAX_IRQS ) )
+        {
+            pxProfile = &( xISRProfiles[ uxISRProfilesUsed ] );
+            pxProfile->ulExceptionNumber = ulExceptionNumber;
+            uxISRProfilesUsed++;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return pxProfile;
+    }
+/*-----------------------------------------------------------*/
+
+    UBaseType_t uxPortGetISRProfile( PortISRProfile_t * pxProfiles,
+                                     UBaseType_t uxMaxProfiles,
+                                     PortISRProfileSummary_t * pxSummary )
+    {
+        UBaseType_t uxSavedInterruptStatus, x;
+
+        uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+        {
+            for( x = 0; ( x < uxISRProfilesUsed ) && ( x < uxMaxProfiles ); x++ )
+            {
+                pxProfiles[ x ] = xISRProfiles[ x ];
+            }
+
+            if( pxSummary != NULL )
+            {
+                *pxSummary = xISRProfileSummary;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+
+        return x;
+    }
+/*-----------------------------------------------------------*/
+
+    void vPortResetISRProfile( void )
+    {
+        const PortISRProfile_t xEmptyProfile = { 0 };
+        const PortISRProfileSummary_t xEmptySummary = { 0 };
+        UBaseType_t uxSavedInterruptStatus, x;
+
+        uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+        {
+            /* The exception numbers keep their profiles, so an interrupt that
+             * is executing now still finds its start time on exit. */
+            for( x = 0; x < uxISRProfilesUsed; x++ )
+            {
+                uint32_t ulExceptionNumber = xISRProfiles[ x ].ulExceptionNumber;
+
+                xISRProfiles[ x ] = xEmptyProfile;
+                xISRProfiles[ x ].ulExceptionNumber = ulExceptionNumber;
+            }
+
+            /* The current nesting depth is not a maximum of the new period. */
+            xISRProfileSummary = xEmptySummary;
+        }
+        portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+    }
+
+#endif /* configUSE_ISR_PROFILER */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_CRITICAL_SECTION_TRACKER == 1 )
+
+    static void prvRecordSection( PortCriticalSectionRecord_t * pxRecords,
+                                  void * pvCaller,
+                                  uint32_t ulCycles )
+    {
+        const uint32_t ulCaller = ( uint32_t ) pvCaller;
+        PortCriticalSectionRecord_t xRecord;
+        UBaseType_t x;
+
+        /* Most sections are shorter than the shortest kept, and a caller that
+         * is kept already has a time at least as long. */
+        if( ulCycles > pxRecords[ configCRITICAL_SECTION_TRACKER_ENTRIES - 1 ].ulCycles )
+        {
+            /* Replace the record of the same caller, or else the shortest. */
+            for( x = 0; x < ( configCRITICAL_SECTION_TRACKER_ENTRIES - 1 ); x++ )
+            {
+                if( pxRecords[ x ].ulCaller == ulCaller )
+                {
+                    break;
+                }
+            }
+
+            if( ulCycles > pxRecords[ x ].ulCycles )
+            {
+                xRecord.ulCaller = ulCaller;
+                xRecord.ulCycles = ulCycles;
+
+                /* Move the record up to its place. */
+                while( ( x > 0 ) && ( pxRecords[ x - 1 ].ulCycles < ulCycles ) )
+                {
+                    pxRecords[ x ] = pxRecords[ x - 1 ];
+                    x--;
+                }
+
+                pxRecords[ x ] = xRecord;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    void vPortSchedulerSuspended( void * pvCaller )
+    {
+        ulSuspendedStartTime = portDWT_CYCCNT_REG;
+        pvSuspendedCaller = pvCaller;
+    }
+/*-----------------------------------------------------------*/
+
+    void vPortSchedulerResumed( void )
+    {
+        /* Called from the critical section in xTaskResumeAll(). */
+        xCriticalSectionStats.ulSchedulerSuspensions++;
+        prvRecordSection( xCriticalSectionStats.xSuspended, pvSuspendedCaller, portDWT_CYCCNT_REG - ulSuspendedStartTime );
+    }
+/*-----------------------------------------------------------*/
+
+    void vPortRestartSchedulerSuspendedWindow( void )
+    {
+        ulSuspendedStartTime = portDWT_CYCCNT_REG;
+    }
+/*-----------------------------------------------------------*/
+
+    void vPortGetCriticalSectionStats( PortCriticalSectionStats_t * pxStats )
+    {
+        UBaseType_t uxSavedInterruptStatus;
+
+        /* Masked without taskENTER_CRITICAL() so the copy is not recorded. */
+        uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+        {
+            *pxStats = xCriticalSectionStats;
+        }
+        portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+    }
+/*-----------------------------------------------------------*/
+
+    void vPortResetCriticalSectionStats( void )
+    {
+        const PortCriticalSectionStats_t xEmptyStats = { 0 };
+        UBaseType_t uxSavedInterruptStatus;
+
+        uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+        {
+            xCriticalSectionStats = xEmptyStats;
+        }
+        portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+    }
+
+#endif /* configUSE_CRITICAL_SECTION_TRACKER */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_CONTEXT_SWITCH_STATS == 1 )
+
+    void vPortRecordContextSwitch( uint32_t ulStartTime,
+                                   uint32_t xSwitched )
+    {
+        const uint32_t ulCycles = portDWT_CYCCNT_REG - ulStartTime;
+        PortContextSwitchTimes_t * pxTimes;
+
+        /* PendSV runs at the lowest priority, so the readers, which mask
+         * interrupts, never see a partial update. */
+        if( xSwitched != 0 )
+        {
+            pxTimes = &( xContextSwitchStats.xSwitched );
+        }
+        else
+        {
+            pxTimes = &( xContextSwitchStats.xResumed );
+        }
+
+        if( ( pxTimes->ulCount == 0 ) || ( ulCycles < pxTimes->ulMinCycles ) )
+        {
+            pxTimes->ulMinCycles = ulCycles;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        if( ulCycles > pxTimes->ulMaxCycles )
+        {
+            pxTimes->ulMaxCycles = ulCycles;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        pxTimes->ulCount++;
+        pxTimes->ullTotalCycles += ulCycles;
+    }
+/*-----------------------------------------------------------*/
+
+    void vPortGetContextSwitchStats( PortContextSwitchStats_t * pxStats )
+    {
+        UBaseType_t uxSavedInterruptStatus;
+
+        uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+        {
+            *pxStats = xContextSwitchStats;
+        }
+        portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+    }
+/*-----------------------------------------------------------*/
+
+    void vPortResetContextSwitchStats( void )
+    {
+        const PortContextSwitchStats_t xEmptyStats = { 0 };
+        UBaseType_t uxSavedInterruptStatus;
+
+        uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+        {
+            xContextSwitchStats = xEmptyStats;
+        }
+        portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+    }
+
+#endif /* configUSE_CONTEXT_SWITCH_STATS */
+/*-----------------------------------------------------------*/
+
 #if ( configASSERT_DEFINED == 1 )
 
     void vPortValidateInterruptPriority( void )
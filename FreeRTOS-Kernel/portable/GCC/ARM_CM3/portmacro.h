@@ -119,6 +119,261 @@
         extern void vPortSuppressTicksAndSleep( TickType_t xExpectedIdleTime );
         #define portSUPPRESS_TICKS_AND_SLEEP( xExpectedIdleTime )    vPortSuppressTicksAndSleep( xExpectedIdleTime )
     #endif
+
+    #if ( configUSE_TICKLESS_IDLE == 1 )
+
+/* Time spent in each power state since the counters were last reset, used to
+ * measure the saving made by tickless idle.  All times are in ticks. */
+        typedef struct xPORT_LOW_POWER_STATS
+        {
+            uint32_t ulTicksAwake;       /*<< Ticks during which the tick interrupt was running. */
+            uint32_t ulTicksAsleep;      /*<< Ticks suppressed while sleeping with the SysTick as the wake up source. */
+            uint32_t ulTicksInDeepSleep; /*<< Ticks suppressed while sleeping with the alternate timebase as the wake up source. */
+            uint32_t ulSleepEntries;     /*<< Number of SysTick timed sleeps. */
+            uint32_t ulDeepSleepEntries; /*<< Number of alternate timebase timed sleeps. */
+            uint32_t ulAbortedEntries;   /*<< Number of sleeps abandoned because a task became ready. */
+        } PortLowPowerStats_t;
+
+        void vPortGetLowPowerStats( PortLowPowerStats_t * pxStats );
+        void vPortResetLowPowerStats( void );
+
+        #if ( configUSE_TICKLESS_ALT_TIMEBASE == 1 )
+
+/* Provided by the application when configUSE_TICKLESS_ALT_TIMEBASE is 1.
+ * Called with interrupts disabled and the SysTick stopped when the expected
+ * idle time is at least configTICKLESS_ALT_TIMEBASE_MIN_TICKS.  It must arm a
+ * wake up source that keeps running in the chosen sleep state (an RTC alarm for
+ * STOP mode, for example), sleep, restore the clocks and return the number of
+ * complete tick periods that passed, which must not exceed xExpectedIdleTime. */
+            TickType_t xPortAltTimebaseSleep( TickType_t xExpectedIdleTime );
+        #endif
+
+    #endif /* configUSE_TICKLESS_IDLE */
+/*-----------------------------------------------------------*/
+
+/* Run time stats clocked by the DWT cycle counter.  The 32-bit CYCCNT is
+ * extended to 64 bits in software, so configRUN_TIME_COUNTER_TYPE must be
+ * uint64_t.  Time spent in interrupts that are bracketed by
+ * portRUN_TIME_ISR_ENTER() and portRUN_TIME_ISR_EXIT() is not charged to the
+ * task that was interrupted.  Only interrupts at or below
+ * configMAX_SYSCALL_INTERRUPT_PRIORITY can be bracketed. */
+    #ifndef configUSE_DWT_RUN_TIME_COUNTER
+        #define configUSE_DWT_RUN_TIME_COUNTER    0
+    #endif
+
+/* Number of exception numbers (16 + IRQ number) for which the time spent in
+ * each interrupt is recorded separately.  0 records the total only. */
+    #ifndef configRUN_TIME_STATS_ISR_SLOTS
+        #define configRUN_TIME_STATS_ISR_SLOTS    0
+    #endif
+
+    #if ( configUSE_DWT_RUN_TIME_COUNTER == 1 )
+        typedef struct xPORT_RUN_TIME_STATS
+        {
+            uint64_t ullTotalCycles; /*<< Cycles since the counter was started. */
+            uint64_t ullISRCycles;   /*<< Cycles spent in instrumented interrupts, nested interrupts counted once. */
+            uint32_t ulISRCount;     /*<< Number of instrumented interrupt entries. */
+        } PortRunTimeStats_t;
+
+        void vPortConfigureRunTimeCounter( void );
+        uint64_t ullPortGetRunTimeCounter( void );
+        void vPortGetRunTimeStats( PortRunTimeStats_t * pxStats );
+        void vPortGetISRRunTime( uint32_t ulExceptionNumber,
+                                 uint32_t * pulCycles,
+                                 uint32_t * pulCount );
+        void vPortRunTimeISREnter( void );
+        void vPortRunTimeISRExit( void );
+
+        #define portCONFIGURE_TIMER_FOR_RUN_TIME_STATS()    vPortConfigureRunTimeCounter()
+        #define portGET_RUN_TIME_COUNTER_VALUE()            ullPortGetRunTimeCounter()
+        #define portRUN_TIME_ISR_ENTER()                    vPortRunTimeISREnter()
+        #define portRUN_TIME_ISR_EXIT()                     vPortRunTimeISRExit()
+    #else
+        #define portRUN_TIME_ISR_ENTER()
+        #define portRUN_TIME_ISR_EXIT()
+    #endif /* configUSE_DWT_RUN_TIME_COUNTER */
+
+/* Brackets a call made by an interrupt handler, for handlers that do nothing
+ * else, for example:
+ * void USART1_IRQHandler( void ) { portRUN_TIME_ISR( HAL_UART_IRQHandler( &huart1 ) ); } */
+    #define portRUN_TIME_ISR( xHandlerCall ) \
+    do {                                     \
+        portRUN_TIME_ISR_ENTER();            \
+        xHandlerCall;                        \
+        portRUN_TIME_ISR_EXIT();             \
+    } while( 0 )
+/*-----------------------------------------------------------*/
+
+/* Interrupt profiler.  For each interrupt bracketed by portRUN_TIME_ISR_ENTER()
+ * and portRUN_TIME_ISR_EXIT() it records the number of entries, the shortest,
+ * longest and total execution time and a histogram of execution times, all in
+ * CPU cycles.  It also records the deepest nesting of bracketed interrupts,
+ * the longest time interrupts were masked by taskENTER_CRITICAL() from a task,
+ * and the time the tick interrupt waited to be taken after the SysTick expired,
+ * the one entry latency the hardware lets software measure, in SysTick counts.
+ * taskENTER_CRITICAL() masks every interrupt at or below
+ * configMAX_SYSCALL_INTERRUPT_PRIORITY, so the longest critical section bounds
+ * their entry latency. */
+    #ifndef configUSE_ISR_PROFILER
+        #define configUSE_ISR_PROFILER    0
+    #endif
+
+/* Number of interrupts that are profiled, in the order they first occur. */
+    #ifndef configISR_PROFILER_MAX_IRQS
+        #define configISR_PROFILER_MAX_IRQS    8
+    #endif
+
+/* Bucket 0 counts execution times below 2^configISR_PROFILER_HISTOGRAM_SHIFT
+ * cycles, each further bucket twice the range of the one before, and the last
+ * one every longer time. */
+    #ifndef configISR_PROFILER_HISTOGRAM_BUCKETS
+        #define configISR_PROFILER_HISTOGRAM_BUCKETS    8
+    #endif
+
+    #ifndef configISR_PROFILER_HISTOGRAM_SHIFT
+        #define configISR_PROFILER_HISTOGRAM_SHIFT    6
+    #endif
+
+    #if ( configUSE_ISR_PROFILER == 1 )
+        #if ( configUSE_DWT_RUN_TIME_COUNTER == 0 )
+            #error configUSE_ISR_PROFILER requires configUSE_DWT_RUN_TIME_COUNTER to be set to 1
+        #endif
+
+        typedef struct xPORT_ISR_PROFILE
+        {
+            uint32_t ulExceptionNumber;                                  /*<< 16 + IRQ number, as IPSR. */
+            uint32_t ulCount;                                            /*<< Number of completed entries. */
+            uint32_t ulMinCycles;                                        /*<< Shortest execution time, nested interrupts included. */
+            uint32_t ulMaxCycles;                                        /*<< Longest execution time, nested interrupts included. */
+            uint64_t ullTotalCycles;                                     /*<< Divide by ulCount for the average. */
+            uint32_t ulHistogram[ configISR_PROFILER_HISTOGRAM_BUCKETS ]; /*<< Execution times, see configISR_PROFILER_HISTOGRAM_SHIFT. */
+        } PortISRProfile_t;
+
+        typedef struct xPORT_ISR_PROFILE_SUMMARY
+        {
+            UBaseType_t uxMaxNesting;         /*<< Most bracketed interrupts active at once. */
+            uint32_t ulMaxCriticalCycles;     /*<< Longest taskENTER_CRITICAL() section, outermost enter to outermost exit. */
+            uint32_t ulMaxTickLatency;        /*<< Longest delay from the SysTick expiring to its handler, in SysTick counts. */
+            uint32_t ulTickCount;             /*<< Ticks the latency was measured for. */
+            uint64_t ullTotalTickLatency;     /*<< Divide by ulTickCount for the average. */
+            uint32_t ulUnprofiledEntries;     /*<< Entries of interrupts beyond configISR_PROFILER_MAX_IRQS. */
+        } PortISRProfileSummary_t;
+
+        UBaseType_t uxPortGetISRProfile( PortISRProfile_t * pxProfiles,
+                                         UBaseType_t uxMaxProfiles,
+                                         PortISRProfileSummary_t * pxSummary );
+        void vPortResetISRProfile( void );
+    #endif /* configUSE_ISR_PROFILER */
+/*-----------------------------------------------------------*/
+
+/* Critical section tracker.  Records the function and the duration, in CPU
+ * cycles, of the longest taskENTER_CRITICAL() sections entered from tasks and of
+ * the longest windows with the scheduler suspended by vTaskSuspendAll(), one
+ * record per function, so a single offender cannot hide the others. */
+    #ifndef configUSE_CRITICAL_SECTION_TRACKER
+        #define configUSE_CRITICAL_SECTION_TRACKER    0
+    #endif
+
+/* Number of functions recorded for each kind of section. */
+    #ifndef configCRITICAL_SECTION_TRACKER_ENTRIES
+        #define configCRITICAL_SECTION_TRACKER_ENTRIES    4
+    #endif
+
+    #if ( configUSE_CRITICAL_SECTION_TRACKER == 1 )
+        #if ( configCRITICAL_SECTION_TRACKER_ENTRIES < 1 )
+            #error configCRITICAL_SECTION_TRACKER_ENTRIES must be at least 1
+        #endif
+
+        typedef struct xPORT_CRITICAL_SECTION_RECORD
+        {
+            uint32_t ulCaller; /*<< Return address into the function that entered the section, 0 for an unused record. */
+            uint32_t ulCycles; /*<< Longest duration of a section entered by that function. */
+        } PortCriticalSectionRecord_t;
+
+        typedef struct xPORT_CRITICAL_SECTION_STATS
+        {
+            PortCriticalSectionRecord_t xCritical[ configCRITICAL_SECTION_TRACKER_ENTRIES ];  /*<< Longest critical sections first. */
+            PortCriticalSectionRecord_t xSuspended[ configCRITICAL_SECTION_TRACKER_ENTRIES ]; /*<< Longest scheduler suspensions first. */
+            uint32_t ulCriticalSections;                                                      /*<< Outermost critical sections completed. */
+            uint32_t ulSchedulerSuspensions;                                                  /*<< Outermost scheduler suspensions completed. */
+        } PortCriticalSectionStats_t;
+
+        void vPortGetCriticalSectionStats( PortCriticalSectionStats_t * pxStats );
+        void vPortResetCriticalSectionStats( void );
+
+/* Called by the kernel, not the application. */
+        void vPortSchedulerSuspended( void * pvCaller );
+        void vPortSchedulerResumed( void );
+        void vPortRestartSchedulerSuspendedWindow( void );
+
+        #define portSCHEDULER_SUSPENDED_HOOK()    vPortSchedulerSuspended( __builtin_return_address( 0 ) )
+        #define portSCHEDULER_RESUMED_HOOK()      vPortSchedulerResumed()
+    #endif /* configUSE_CRITICAL_SECTION_TRACKER */
+/*-----------------------------------------------------------*/
+
+/* Lazy context switch.  The PendSV handler only saves r4-r11 of the task that
+ * was running once vTaskSwitchContext() has selected another task, so a yield
+ * that leaves the same task running, for example while the scheduler is
+ * suspended or when no other task of the same priority is ready, returns
+ * without touching the task's stack. */
+    #ifndef configUSE_LAZY_CONTEXT_SWITCH
+        #define configUSE_LAZY_CONTEXT_SWITCH    0
+    #endif
+
+/* Context switch statistics.  Counts the PendSV interrupts that switched to
+ * another task and those that resumed the task that was running, with the
+ * shortest, longest and total time of each, in CPU cycles, from the start of
+ * the handler to the point where the next task's registers are in place.  The
+ * exception entry and exit, 12 cycles each on the Cortex-M3 without wait
+ * states, are not included. */
+    #ifndef configUSE_CONTEXT_SWITCH_STATS
+        #define configUSE_CONTEXT_SWITCH_STATS    0
+    #endif
+
+    #if ( configUSE_CONTEXT_SWITCH_STATS == 1 )
+        typedef struct xPORT_CONTEXT_SWITCH_TIMES
+        {
+            uint32_t ulCount;        /*<< Number of PendSV interrupts. */
+            uint32_t ulMinCycles;    /*<< Shortest handler time. */
+            uint32_t ulMaxCycles;    /*<< Longest handler time. */
+            uint64_t ullTotalCycles; /*<< Divide by ulCount for the average. */
+        } PortContextSwitchTimes_t;
+
+        typedef struct xPORT_CONTEXT_SWITCH_STATS
+        {
+            PortContextSwitchTimes_t xSwitched; /*<< Another task was selected. */
+            PortContextSwitchTimes_t xResumed;  /*<< The task that was running was selected again. */
+        } PortContextSwitchStats_t;
+
+        void vPortGetContextSwitchStats( PortContextSwitchStats_t * pxStats );
+        void vPortResetContextSwitchStats( void );
+    #endif /* configUSE_CONTEXT_SWITCH_STATS */
+/*-----------------------------------------------------------*/
+
+/* 64-bit monotonic clock that starts from zero when the scheduler starts.  The
+ * tick interrupt anchors the DWT cycle counter to the tick count, and the time
+ * since the last tick is read from the cycle counter, so the clock has the
+ * resolution of the CPU clock and the long term accuracy of the tick, sleep
+ * included.  The read functions are lock free and can be called from tasks and
+ * from interrupts of any priority. */
+    #ifndef configUSE_MONOTONIC_CLOCK
+        #define configUSE_MONOTONIC_CLOCK    0
+    #endif
+
+    #if ( configUSE_MONOTONIC_CLOCK == 1 )
+        #define portCLOCK_NS_PER_SECOND    ( 1000000000UL )
+        #define portCLOCK_NS_PER_TICK      ( ( uint64_t ) portCLOCK_NS_PER_SECOND / ( uint64_t ) configTICK_RATE_HZ )
+
+        uint64_t ullPortGetClockCycles( void );
+        uint64_t ullPortGetClockNs( void );
+        uint64_t ullPortClockCyclesToNs( uint64_t ullCycles );
+        uint64_t ullPortClockNsToCycles( uint64_t ullNs );
+
+        #define portCLOCK_TICKS_TO_NS( xTicks )    ( ( uint64_t ) ( xTicks ) * portCLOCK_NS_PER_TICK )
+        #define portCLOCK_NS_TO_TICKS( ullNs )     ( ( TickType_t ) ( ( uint64_t ) ( ullNs ) / portCLOCK_NS_PER_TICK ) )
+        #define portCLOCK_NS_TO_US( ullNs )        ( ( uint64_t ) ( ullNs ) / 1000ULL )
+        #define portCLOCK_US_TO_NS( ullUs )        ( ( uint64_t ) ( ullUs ) * 1000ULL )
+    #endif /* configUSE_MONOTONIC_CLOCK */
 /*-----------------------------------------------------------*/
 
 /* Architecture specific optimisations. */
@@ -191,6 +446,45 @@
         return xReturn;
     }
 
+/*-----------------------------------------------------------*/
+
+/* Exclusive load/store used to build lock free structures.  The reservation
+ * taken by the load is lost on every exception entry and return, so the store
+ * fails if anything - including an interrupt that modified the same location -
+ * ran in between.  Unlike compare-and-swap this does not suffer from the ABA
+ * problem. */
+    #define portHAS_EXCLUSIVE_ACCESS    1
+
+    portFORCE_INLINE static uint32_t ulPortLoadExclusive( volatile uint32_t * pulAddress )
+    {
+        uint32_t ulValue;
+
+        __asm volatile ( "ldrex %0, [%1]" : "=r" ( ulValue ) : "r" ( pulAddress ) : "memory" );
+
+        return ulValue;
+    }
+
+/*-----------------------------------------------------------*/
+
+/* Returns pdTRUE if the store was made, pdFALSE if the reservation was lost. */
+    portFORCE_INLINE static BaseType_t xPortStoreExclusive( volatile uint32_t * pulAddress,
+                                                            uint32_t ulValue )
+    {
+        uint32_t ulFailed;
+
+        __asm volatile ( "strex %0, %2, [%1]" : "=&r" ( ulFailed ) : "r" ( pulAddress ), "r" ( ulValue ) : "memory" );
+
+        return ( ulFailed == 0UL ) ? pdTRUE : pdFALSE;
+    }
+
+/*-----------------------------------------------------------*/
+
+/* Drops the reservation when a load is not followed by a store. */
+    portFORCE_INLINE static void vPortClearExclusive( void )
+    {
+        __asm volatile ( "clrex" ::: "memory" );
+    }
+
 /*-----------------------------------------------------------*/
 
     portFORCE_INLINE static void vPortRaiseBASEPRI( void )
@@ -0,0 +1,573 @@
+/*
+ * FreeRTOS Kernel V10.5.1
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/*
+ * Fixed size block pools that heap_4.c, heap_5.c and heap_tlsf.c try before
+ * their own free lists when configUSE_BLOCK_POOLS is 1.
+ *
+ * Most kernel objects are small and of a handful of sizes.  Serving them from
+ * pools of 16, 32, 64 and 128 byte blocks takes constant time, needs no block
+ * header and cannot fragment the heap.  A request goes to the smallest pool its
+ * size fits, then to the larger pools if that one is empty, and only then to
+ * the heap.  Requests larger than the largest block go straight to the heap.
+ *
+ * Each pool keeps its free blocks on a singly linked list.  On ports that
+ * define portHAS_EXCLUSIVE_ACCESS the list is updated with exclusive
+ * load/store, so allocating and freeing never masks interrupts and is safe
+ * from any interrupt priority.  Other ports mask interrupts around the update.
+ *
+ * The number of blocks in each pool is set by configBLOCK_POOL_16_BLOCKS,
+ * configBLOCK_POOL_32_BLOCKS, configBLOCK_POOL_64_BLOCKS and
+ * configBLOCK_POOL_128_BLOCKS.  The pool memory is separate from the heap.
+ *
+ * Pool blocks have no header, so with configUSE_HEAP_TRACKING the owner tag the
+ * heap puts in its block headers is kept here, one HeapBlockTag_t per block,
+ * and the heap charges pool blocks to their owner like its own blocks.
+ */
+#include <stdlib.h>
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+ * all the API functions to use the MPU wrappers.  That should only be done when
+ * task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+#if ( configUSE_BLOCK_POOLS == 1 )
+
+#ifndef configBLOCK_POOL_16_BLOCKS
+    #define configBLOCK_POOL_16_BLOCKS    4
+#endif
+
+#ifndef configBLOCK_POOL_32_BLOCKS
+    #define configBLOCK_POOL_32_BLOCKS    4
+#endif
+
+#ifndef configBLOCK_POOL_64_BLOCKS
+    #define configBLOCK_POOL_64_BLOCKS    4
+#endif
+
+#ifndef configBLOCK_POOL_128_BLOCKS
+    #define configBLOCK_POOL_128_BLOCKS    4
+#endif
+
+#define poolNUMBER_OF_POOLS    4
+
+/* The pool memory is declared as uint64_t so every block is 8 byte aligned. */
+#define poolWORDS( xBlockSize, xBlocks )    ( ( ( xBlockSize ) / sizeof( uint64_t ) ) * ( xBlocks ) )
+
+/*-----------------------------------------------------------*/
+
+/* A free block holds the link to the next free block. */
+typedef struct A_POOL_BLOCK
+{
+    struct A_POOL_BLOCK * pxNextFreeBlock;
+} PoolBlock_t;
+
+typedef struct A_BLOCK_POOL
+{
+    PoolBlock_t * volatile pxFreeList; /*<< The first free block, NULL when the pool is empty. */
+    uint8_t * pucStart;                /*<< The first byte of the pool memory. */
+    uint8_t * pucEnd;                  /*<< One past the last byte of the pool memory. */
+    size_t xBlockSize;
+    size_t xNumberOfBlocks;
+    volatile uint32_t ulBlocksInUse;
+    volatile uint32_t ulMaximumBlocksInUse;
+    volatile uint32_t ulNumberOfAllocations;
+    volatile uint32_t ulNumberOfFailedAllocations;
+
+    #if ( configUSE_HEAP_TRACKING == 1 )
+        HeapBlockTag_t * pxTags; /*<< One tag per block, in block order. */
+    #endif
+} BlockPool_t;
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Thread the free list through the pool memory the first time a pool is used.
+ */
+static void prvPoolsInit( void ) PRIVILEGED_FUNCTION;
+
+/*
+ * Take a block from, or return a block to, a pool's free list.
+ */
+static void * prvPoolPop( BlockPool_t * pxPool ) PRIVILEGED_FUNCTION;
+static void prvPoolPush( BlockPool_t * pxPool,
+                         PoolBlock_t * pxBlock ) PRIVILEGED_FUNCTION;
+
+/*
+ * Interrupt safe updates of the pool counters.  prvCounterAdd() returns the
+ * new value.
+ */
+static uint32_t prvCounterAdd( volatile uint32_t * pulCounter,
+                               int32_t lDelta ) PRIVILEGED_FUNCTION;
+static void prvCounterMax( volatile uint32_t * pulCounter,
+                           uint32_t ulValue ) PRIVILEGED_FUNCTION;
+
+/*-----------------------------------------------------------*/
+
+#if ( configBLOCK_POOL_16_BLOCKS > 0 )
+    PRIVILEGED_DATA static uint64_t ullPool16[ poolWORDS( 16U, configBLOCK_POOL_16_BLOCKS ) ];
+#endif
+#if ( configBLOCK_POOL_32_BLOCKS > 0 )
+    PRIVILEGED_DATA static uint64_t ullPool32[ poolWORDS( 32U, configBLOCK_POOL_32_BLOCKS ) ];
+#endif
+#if ( configBLOCK_POOL_64_BLOCKS > 0 )
+    PRIVILEGED_DATA static uint64_t ullPool64[ poolWORDS( 64U, configBLOCK_POOL_64_BLOCKS ) ];
+#endif
+#if ( configBLOCK_POOL_128_BLOCKS > 0 )
+    PRIVILEGED_DATA static uint64_t ullPool128[ poolWORDS( 128U, configBLOCK_POOL_128_BLOCKS ) ];
+#endif
+
+#if ( configUSE_HEAP_TRACKING == 1 )
+    #if ( configBLOCK_POOL_16_BLOCKS > 0 )
+        PRIVILEGED_DATA static HeapBlockTag_t xTags16[ configBLOCK_POOL_16_BLOCKS ];
+    #endif
+    #if ( configBLOCK_POOL_32_BLOCKS > 0 )
+        PRIVILEGED_DATA static HeapBlockTag_t xTags32[ configBLOCK_POOL_32_BLOCKS ];
+    #endif
+    #if ( configBLOCK_POOL_64_BLOCKS > 0 )
+        PRIVILEGED_DATA static HeapBlockTag_t xTags64[ configBLOCK_POOL_64_BLOCKS ];
+    #endif
+    #if ( configBLOCK_POOL_128_BLOCKS > 0 )
+        PRIVILEGED_DATA static HeapBlockTag_t xTags128[ configBLOCK_POOL_128_BLOCKS ];
+    #endif
+#endif /* configUSE_HEAP_TRACKING */
+
+/* Ordered by block size, smallest first. */
+PRIVILEGED_DATA static BlockPool_t xPools[ poolNUMBER_OF_POOLS ];
+PRIVILEGED_DATA static volatile BaseType_t xPoolsInitialised = pdFALSE;
+
+/*-----------------------------------------------------------*/
+
+void * pvPortBlockPoolAlloc( size_t xSize )
+{
+    void * pvReturn = NULL;
+    UBaseType_t uxPool;
+    BaseType_t xFitted = pdFALSE;
+    uint32_t ulInUse;
+
+    if( xPoolsInitialised == pdFALSE )
+    {
+        prvPoolsInit();
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    if( xSize > 0 )
+    {
+        for( uxPool = 0; uxPool < poolNUMBER_OF_POOLS; uxPool++ )
+        {
+            if( ( xPools[ uxPool ].xNumberOfBlocks > 0 ) && ( xSize <= xPools[ uxPool ].xBlockSize ) )
+            {
+                if( xFitted == pdFALSE )
+                {
+                    /* Only the smallest pool that fits records a failure if it
+                     * is empty. */
+                    xFitted = pdTRUE;
+                    pvReturn = prvPoolPop( &( xPools[ uxPool ] ) );
+
+                    if( pvReturn == NULL )
+                    {
+                        ( void ) prvCounterAdd( &( xPools[ uxPool ].ulNumberOfFailedAllocations ), 1 );
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                else
+                {
+                    pvReturn = prvPoolPop( &( xPools[ uxPool ] ) );
+                }
+
+                if( pvReturn != NULL )
+                {
+                    ulInUse = prvCounterAdd( &( xPools[ uxPool ].ulBlocksInUse ), 1 );
+                    prvCounterMax( &( xPools[ uxPool ].ulMaximumBlocksInUse ), ulInUse );
+                    ( void ) prvCounterAdd( &( xPools[ uxPool ].ulNumberOfAllocations ), 1 );
+                    break;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    return pvReturn;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xPortBlockPoolFree( void * pv )
+{
+    BaseType_t xReturn = pdFALSE;
+    UBaseType_t uxPool;
+    uint8_t * puc = ( uint8_t * ) pv;
+
+    /* Nothing can have been allocated from the pools before they were set
+     * up. */
+    if( xPoolsInitialised != pdFALSE )
+    {
+        for( uxPool = 0; uxPool < poolNUMBER_OF_POOLS; uxPool++ )
+        {
+            if( ( puc >= xPools[ uxPool ].pucStart ) && ( puc < xPools[ uxPool ].pucEnd ) )
+            {
+                /* The pointer must be the start of a block. */
+                configASSERT( ( ( size_t ) ( puc - xPools[ uxPool ].pucStart ) % xPools[ uxPool ].xBlockSize ) == 0 );
+
+                prvPoolPush( &( xPools[ uxPool ] ), ( PoolBlock_t * ) pv );
+                ( void ) prvCounterAdd( &( xPools[ uxPool ].ulBlocksInUse ), -1 );
+                xReturn = pdTRUE;
+                break;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_HEAP_TRACKING == 1 )
+
+    HeapBlockTag_t * pxPortBlockPoolGetTag( const void * pv,
+                                            size_t * pxBlockSize )
+    {
+        HeapBlockTag_t * pxReturn = NULL;
+        UBaseType_t uxPool;
+        const uint8_t * puc = ( const uint8_t * ) pv;
+
+        if( xPoolsInitialised != pdFALSE )
+        {
+            for( uxPool = 0; uxPool < poolNUMBER_OF_POOLS; uxPool++ )
+            {
+                if( ( puc >= xPools[ uxPool ].pucStart ) && ( puc < xPools[ uxPool ].pucEnd ) )
+                {
+                    pxReturn = &( xPools[ uxPool ].pxTags[ ( size_t ) ( puc - xPools[ uxPool ].pucStart ) / xPools[ uxPool ].xBlockSize ] );
+                    *pxBlockSize = xPools[ uxPool ].xBlockSize;
+                    break;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return pxReturn;
+    }
+/*-----------------------------------------------------------*/
+
+#endif /* configUSE_HEAP_TRACKING */
+
+UBaseType_t uxPortGetNumberOfBlockPools( void )
+{
+    return poolNUMBER_OF_POOLS;
+}
+/*-----------------------------------------------------------*/
+
+void vPortGetBlockPoolStats( UBaseType_t uxPool,
+                             BlockPoolStats_t * pxPoolStats )
+{
+    configASSERT( uxPool < poolNUMBER_OF_POOLS );
+
+    if( xPoolsInitialised == pdFALSE )
+    {
+        prvPoolsInit();
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    /* Each counter is read atomically, but they are not a snapshot of one
+     * moment. */
+    pxPoolStats->xBlockSize = xPools[ uxPool ].xBlockSize;
+    pxPoolStats->xNumberOfBlocks = xPools[ uxPool ].xNumberOfBlocks;
+    pxPoolStats->xBlocksInUse = xPools[ uxPool ].ulBlocksInUse;
+    pxPoolStats->xMaximumBlocksInUse = xPools[ uxPool ].ulMaximumBlocksInUse;
+    pxPoolStats->xNumberOfAllocations = xPools[ uxPool ].ulNumberOfAllocations;
+    pxPoolStats->xNumberOfFailedAllocations = xPools[ uxPool ].ulNumberOfFailedAllocations;
+}
+/*-----------------------------------------------------------*/
+
+static void prvPoolsInit( void ) /* PRIVILEGED_FUNCTION */
+{
+    UBaseType_t uxSavedInterruptStatus, uxPool;
+    size_t xBlock;
+    BlockPool_t * pxPool;
+
+    /* An interrupt can make the first allocation, so mask interrupts while
+     * checking the flag again and setting the pools up. */
+    uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+    {
+        if( xPoolsInitialised == pdFALSE )
+        {
+            #if ( configBLOCK_POOL_16_BLOCKS > 0 )
+            {
+                xPools[ 0 ].pucStart = ( uint8_t * ) ullPool16;
+                xPools[ 0 ].xNumberOfBlocks = configBLOCK_POOL_16_BLOCKS;
+
+                #if ( configUSE_HEAP_TRACKING == 1 )
+                {
+                    xPools[ 0 ].pxTags = xTags16;
+                }
+                #endif
+            }
+            #endif
+            #if ( configBLOCK_POOL_32_BLOCKS > 0 )
+            {
+                xPools[ 1 ].pucStart = ( uint8_t * ) ullPool32;
+                xPools[ 1 ].xNumberOfBlocks = configBLOCK_POOL_32_BLOCKS;
+
+                #if ( configUSE_HEAP_TRACKING == 1 )
+                {
+                    xPools[ 1 ].pxTags = xTags32;
+                }
+                #endif
+            }
+            #endif
+            #if ( configBLOCK_POOL_64_BLOCKS > 0 )
+            {
+                xPools[ 2 ].pucStart = ( uint8_t * ) ullPool64;
+                xPools[ 2 ].xNumberOfBlocks = configBLOCK_POOL_64_BLOCKS;
+
+                #if ( configUSE_HEAP_TRACKING == 1 )
+                {
+                    xPools[ 2 ].pxTags = xTags64;
+                }
+                #endif
+            }
+            #endif
+            #if ( configBLOCK_POOL_128_BLOCKS > 0 )
+            {
+                xPools[ 3 ].pucStart = ( uint8_t * ) ullPool128;
+                xPools[ 3 ].xNumberOfBlocks = configBLOCK_POOL_128_BLOCKS;
+
+                #if ( configUSE_HEAP_TRACKING == 1 )
+                {
+                    xPools[ 3 ].pxTags = xTags128;
+                }
+                #endif
+            }
+            #endif
+
+            for( uxPool = 0; uxPool < poolNUMBER_OF_POOLS; uxPool++ )
+            {
+                pxPool = &( xPools[ uxPool ] );
+                pxPool->xBlockSize = ( size_t ) 16U << uxPool;
+                pxPool->pucEnd = pxPool->pucStart + ( pxPool->xBlockSize * pxPool->xNumberOfBlocks );
+                pxPool->pxFreeList = NULL;
+
+                /* Push the blocks last to first so they are handed out in
+                 * address order. */
+                for( xBlock = pxPool->xNumberOfBlocks; xBlock > 0; xBlock-- )
+                {
+                    prvPoolPush( pxPool, ( PoolBlock_t * ) ( void * ) ( pxPool->pucStart + ( ( xBlock - 1U ) * pxPool->xBlockSize ) ) );
+                }
+            }
+
+            xPoolsInitialised = pdTRUE;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+    portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+}
+/*-----------------------------------------------------------*/
+
+#if ( portHAS_EXCLUSIVE_ACCESS == 1 )
+
+    static void * prvPoolPop( BlockPool_t * pxPool ) /* PRIVILEGED_FUNCTION */
+    {
+        PoolBlock_t * pxBlock;
+
+        do
+        {
+            pxBlock = ( PoolBlock_t * ) ulPortLoadExclusive( ( volatile uint32_t * ) &( pxPool->pxFreeList ) );
+
+            if( pxBlock == NULL )
+            {
+                vPortClearExclusive();
+                break;
+            }
+
+            /* If anything pops or pushes between the load and the store the
+             * reservation is lost and the store fails, so pxNextFreeBlock is
+             * never stale when the store succeeds. */
+        } while( xPortStoreExclusive( ( volatile uint32_t * ) &( pxPool->pxFreeList ), ( uint32_t ) pxBlock->pxNextFreeBlock ) == pdFALSE );
+
+        return ( void * ) pxBlock;
+    }
+
+#else /* portHAS_EXCLUSIVE_ACCESS */
+
+    static void * prvPoolPop( BlockPool_t * pxPool ) /* PRIVILEGED_FUNCTION */
+    {
+        PoolBlock_t * pxBlock;
+        UBaseType_t uxSavedInterruptStatus;
+
+        uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+        {
+            pxBlock = pxPool->pxFreeList;
+
+            if( pxBlock != NULL )
+            {
+                pxPool->pxFreeList = pxBlock->pxNextFreeBlock;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+
+        return ( void * ) pxBlock;
+    }
+
+#endif /* portHAS_EXCLUSIVE_ACCESS */
+/*-----------------------------------------------------------*/
+
+#if ( portHAS_EXCLUSIVE_ACCESS == 1 )
+
+    static void prvPoolPush( BlockPool_t * pxPool,
+                             PoolBlock_t * pxBlock ) /* PRIVILEGED_FUNCTION */
+    {
+        do
+        {
+            pxBlock->pxNextFreeBlock = ( PoolBlock_t * ) ulPortLoadExclusive( ( volatile uint32_t * ) &( pxPool->pxFreeList ) );
+        } while( xPortStoreExclusive( ( volatile uint32_t * ) &( pxPool->pxFreeList ), ( uint32_t ) pxBlock ) == pdFALSE );
+    }
+
+#else /* portHAS_EXCLUSIVE_ACCESS */
+
+    static void prvPoolPush( BlockPool_t * pxPool,
+                             PoolBlock_t * pxBlock ) /* PRIVILEGED_FUNCTION */
+    {
+        UBaseType_t uxSavedInterruptStatus;
+
+        uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+        {
+            pxBlock->pxNextFreeBlock = pxPool->pxFreeList;
+            pxPool->pxFreeList = pxBlock;
+        }
+        portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+    }
+
+#endif /* portHAS_EXCLUSIVE_ACCESS */
+/*-----------------------------------------------------------*/
+
+static uint32_t prvCounterAdd( volatile uint32_t * pulCounter,
+                               int32_t lDelta ) /* PRIVILEGED_FUNCTION */
+{
+    uint32_t ulNewValue;
+
+    #if ( portHAS_EXCLUSIVE_ACCESS == 1 )
+    {
+        do
+        {
+            ulNewValue = ulPortLoadExclusive( pulCounter ) + ( uint32_t ) lDelta;
+        } while( xPortStoreExclusive( pulCounter, ulNewValue ) == pdFALSE );
+    }
+    #else
+    {
+        UBaseType_t uxSavedInterruptStatus;
+
+        uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+        {
+            ulNewValue = *pulCounter + ( uint32_t ) lDelta;
+            *pulCounter = ulNewValue;
+        }
+        portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+    }
+    #endif /* portHAS_EXCLUSIVE_ACCESS */
+
+    return ulNewValue;
+}
+/*-----------------------------------------------------------*/
+
+static void prvCounterMax( volatile uint32_t * pulCounter,
+                           uint32_t ulValue ) /* PRIVILEGED_FUNCTION */
+{
+    #if ( portHAS_EXCLUSIVE_ACCESS == 1 )
+    {
+        do
+        {
+            if( ulPortLoadExclusive( pulCounter ) >= ulValue )
+            {
+                vPortClearExclusive();
+                break;
+            }
+        } while( xPortStoreExclusive( pulCounter, ulValue ) == pdFALSE );
+    }
+    #else
+    {
+        UBaseType_t uxSavedInterruptStatus;
+
+        uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+        {
+            if( *pulCounter < ulValue )
+            {
+                *pulCounter = ulValue;
+            }
+        }
+        portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+    }
+    #endif /* portHAS_EXCLUSIVE_ACCESS */
+}
+/*-----------------------------------------------------------*/
+
+#endif /* configUSE_BLOCK_POOLS */
@@ -80,6 +80,27 @@
 #define heapALLOCATE_BLOCK( pxBlock )            ( ( pxBlock->xBlockSize ) |= heapBLOCK_ALLOCATED_BITMASK )
 #define heapFREE_BLOCK( pxBlock )                ( ( pxBlock->xBlockSize ) &= ~heapBLOCK_ALLOCATED_BITMASK )
 
+#if ( configUSE_HEAP_TRACKING == 1 )
+    #if ( configHEAP_TRACKING_MAX_TASKS < 1 ) || ( configHEAP_TRACKING_MAX_TASKS > 254 )
+        #error configHEAP_TRACKING_MAX_TASKS must be between 1 and 254
+    #endif
+
+    #if ( INCLUDE_xTaskGetSchedulerState == 0 ) && ( configUSE_TIMERS == 0 )
+        #error configUSE_HEAP_TRACKING requires INCLUDE_xTaskGetSchedulerState to be set to 1
+    #endif
+
+/* The owner recorded in blocks that could not be given an accounting slot. */
+    #define heapNO_OWNER    ( ( UBaseType_t ) portHEAP_TRACE_NO_TASK )
+
+/* The address the allocating or freeing call returns to.  It must be taken in
+ * pvPortMalloc() and vPortFree() themselves, not in a helper. */
+    #ifdef __GNUC__
+        #define heapCALLER_ADDRESS()    __builtin_return_address( 0 )
+    #else
+        #define heapCALLER_ADDRESS()    NULL
+    #endif
+#endif /* configUSE_HEAP_TRACKING */
+
 /*-----------------------------------------------------------*/
 
 /* Allocate the memory for the heap. */
@@ -98,6 +119,10 @@ typedef struct A_BLOCK_LINK
 {
     struct A_BLOCK_LINK * pxNextFreeBlock; /*<< The next free block in the list. */
     size_t xBlockSize;                     /*<< The size of the free block. */
+
+    #if ( configUSE_HEAP_TRACKING == 1 )
+        HeapBlockTag_t xTag; /*<< The owner, call-site and time of an allocated block. */
+    #endif
 } BlockLink_t;
 
 /*-----------------------------------------------------------*/
@@ -116,6 +141,72 @@ static void prvInsertBlockIntoFreeList( BlockLink_t * pxBlockToInsert ) PRIVILEG
  */
 static void prvHeapInit( void ) PRIVILEGED_FUNCTION;
 
+#if ( configUSE_HEAP_TRACKING == 1 )
+
+/*
+ * Tag a block of xBlockSize bytes that is being allocated at pv with its owner,
+ * call-site and time, and add it to the owner's live bytes.  pxTag is in the
+ * block header for heap blocks and kept by the pool for pool blocks.  Called
+ * with the scheduler suspended.
+ */
+    static void prvTrackAllocation( HeapBlockTag_t * pxTag,
+                                    const void * pv,
+                                    size_t xBlockSize,
+                                    void * pvCaller ) PRIVILEGED_FUNCTION;
+
+/*
+ * Remove a block that is being freed from its owner's live bytes.  Called with
+ * the scheduler suspended.
+ */
+    static void prvTrackFree( const HeapBlockTag_t * pxTag,
+                              const void * pv,
+                              size_t xBlockSize,
+                              void * pvCaller ) PRIVILEGED_FUNCTION;
+
+/*
+ * Return the accounting slot of the calling task, claiming a slot if the task
+ * does not have one yet.
+ */
+    static UBaseType_t prvGetOwnerSlot( void ) PRIVILEGED_FUNCTION;
+
+#endif /* configUSE_HEAP_TRACKING */
+
+#if ( configUSE_HEAP_FRAGMENTATION_STATS == 1 )
+
+/*
+ * Account for a block of xBlockSize bytes entering or leaving the free list.
+ * Called with the scheduler suspended.
+ */
+    static void prvFreeBlockAdded( size_t xBlockSize ) PRIVILEGED_FUNCTION;
+    static void prvFreeBlockRemoved( size_t xBlockSize ) PRIVILEGED_FUNCTION;
+
+/*
+ * Find the largest free block from the histogram, then update the
+ * fragmentation high water mark.  Called with the scheduler suspended at the
+ * end of every allocation and free.
+ */
+    static void prvUpdateFragmentationStats( void ) PRIVILEGED_FUNCTION;
+
+/*
+ * The current external fragmentation in 0.1% units.
+ */
+    static size_t prvFragmentationPermille( void ) PRIVILEGED_FUNCTION;
+
+#endif /* configUSE_HEAP_FRAGMENTATION_STATS */
+
+#if ( configUSE_HEAP_TRACE == 1 )
+
+/*
+ * Build a trace record and pass it to vApplicationHeapTraceHook().
+ */
+    static void prvTraceHeapEvent( uint8_t ucEvent,
+                                   const void * pv,
+                                   size_t xSize,
+                                   UBaseType_t uxOwner,
+                                   void * pvCaller ) PRIVILEGED_FUNCTION;
+
+#endif /* configUSE_HEAP_TRACE */
+
 /*-----------------------------------------------------------*/
 
 /* The size of the structure placed at the beginning of each allocated memory
@@ -133,6 +224,32 @@ PRIVILEGED_DATA static size_t xMinimumEverFreeBytesRemaining = 0U;
 PRIVILEGED_DATA static size_t xNumberOfSuccessfulAllocations = 0;
 PRIVILEGED_DATA static size_t xNumberOfSuccessfulFrees = 0;
 
+#if ( configUSE_HEAP_FRAGMENTATION_STATS == 1 )
+
+/* The free list summarised as it changes.  Bit n of uxNonEmptyBins is set
+ * while xFreeBlocksBySize[ n ] is not zero, and xLargestInBin[ n ] is the
+ * largest block counted in that entry, xLargestInBinCount[ n ] the number of
+ * free blocks of that size.  The largest free block is the largest of the
+ * highest entry in use.  When the last block of that size leaves an entry
+ * that still holds smaller blocks the count drops to zero, and only the blocks
+ * of that one entry are looked at again, when it is the highest entry. */
+    PRIVILEGED_DATA static size_t xNumberOfFreeBlocks = 0;
+    PRIVILEGED_DATA static size_t xLargestFreeBlock = 0;
+    PRIVILEGED_DATA static size_t xMaximumFragmentationPermille = 0;
+    PRIVILEGED_DATA static size_t xFreeBlocksBySize[ portHEAP_FRAGMENTATION_BINS ];
+    PRIVILEGED_DATA static size_t xLargestInBin[ portHEAP_FRAGMENTATION_BINS ];
+    PRIVILEGED_DATA static size_t xLargestInBinCount[ portHEAP_FRAGMENTATION_BINS ];
+    PRIVILEGED_DATA static UBaseType_t uxNonEmptyBins = 0;
+#endif
+
+#if ( configUSE_HEAP_TRACKING == 1 )
+
+/* Live and peak bytes per allocating task.  A slot is claimed by a task the
+ * first time it allocates, and only handed to another task once every block
+ * the previous owner allocated has been freed. */
+    PRIVILEGED_DATA static HeapTaskUsage_t xTaskUsage[ configHEAP_TRACKING_MAX_TASKS ];
+#endif
+
 /*-----------------------------------------------------------*/
 
 void * pvPortMalloc( size_t xWantedSize )
@@ -143,6 +260,51 @@ void * pvPortMalloc( size_t xWantedSize )
     void * pvReturn = NULL;
     size_t xAdditionalRequiredSize;
 
+    #if ( configUSE_HEAP_TRACKING == 1 )
+        void * pvCaller = heapCALLER_ADDRESS();
+    #endif
+
+    #if ( configUSE_HEAP_TRACKING == 1 ) && ( configUSE_BLOCK_POOLS == 1 )
+        HeapBlockTag_t * pxTag;
+        size_t xPoolBlockSize;
+    #endif
+
+    #if ( configUSE_HEAP_TRACE == 1 )
+        size_t xRequestedSize = xWantedSize;
+    #endif
+
+    #if ( configUSE_BLOCK_POOLS == 1 )
+    {
+        /* Small requests are served from the fixed size block pools when
+         * they have a free block, see block_pools.c. */
+        pvReturn = pvPortBlockPoolAlloc( xWantedSize );
+
+        if( pvReturn != NULL )
+        {
+            traceMALLOC( pvReturn, xWantedSize );
+
+            #if ( configUSE_HEAP_TRACKING == 1 )
+            {
+                /* Pool blocks have no header, the pool keeps their tags. */
+                vTaskSuspendAll();
+                {
+                    pxTag = pxPortBlockPoolGetTag( pvReturn, &xPoolBlockSize );
+                    configASSERT( pxTag );
+                    prvTrackAllocation( pxTag, pvReturn, xPoolBlockSize, pvCaller );
+                }
+                ( void ) xTaskResumeAll();
+            }
+            #endif
+
+            return pvReturn;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+    #endif /* configUSE_BLOCK_POOLS */
+
     vTaskSuspendAll();
     {
         /* If this is the first call to malloc then the heap will require
@@ -208,6 +370,12 @@ void * pvPortMalloc( size_t xWantedSize )
                      * of the list of free blocks. */
                     pxPreviousBlock->pxNextFreeBlock = pxBlock->pxNextFreeBlock;
 
+                    #if ( configUSE_HEAP_FRAGMENTATION_STATS == 1 )
+                    {
+                        prvFreeBlockRemoved( pxBlock->xBlockSize );
+                    }
+                    #endif
+
                     /* If the block is larger than required it can be split into
                      * two. */
                     if( ( pxBlock->xBlockSize - xWantedSize ) > heapMINIMUM_BLOCK_SIZE )
@@ -248,6 +416,21 @@ void * pvPortMalloc( size_t xWantedSize )
                     heapALLOCATE_BLOCK( pxBlock );
                     pxBlock->pxNextFreeBlock = NULL;
                     xNumberOfSuccessfulAllocations++;
+
+                    #if ( configUSE_HEAP_FRAGMENTATION_STATS == 1 )
+                    {
+                        prvUpdateFragmentationStats();
+                    }
+                    #endif
+
+                    #if ( configUSE_HEAP_TRACKING == 1 )
+                    {
+                        prvTrackAllocation( &( pxBlock->xTag ),
+                                            pvReturn,
+                                            pxBlock->xBlockSize & ~heapBLOCK_ALLOCATED_BITMASK,
+                                            pvCaller );
+                    }
+                    #endif
                 }
                 else
                 {
@@ -264,6 +447,19 @@ void * pvPortMalloc( size_t xWantedSize )
             mtCOVERAGE_TEST_MARKER();
         }
 
+        #if ( configUSE_HEAP_TRACE == 1 )
+        {
+            if( pvReturn == NULL )
+            {
+                prvTraceHeapEvent( portHEAP_TRACE_EVENT_MALLOC_FAILED, NULL, xRequestedSize, heapNO_OWNER, pvCaller );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        #endif /* configUSE_HEAP_TRACE */
+
         traceMALLOC( pvReturn, xWantedSize );
     }
     ( void ) xTaskResumeAll();
@@ -291,6 +487,50 @@ void vPortFree( void * pv )
     uint8_t * puc = ( uint8_t * ) pv;
     BlockLink_t * pxLink;
 
+    #if ( configUSE_HEAP_TRACKING == 1 )
+        void * pvCaller = heapCALLER_ADDRESS();
+    #endif
+
+    #if ( configUSE_HEAP_TRACKING == 1 ) && ( configUSE_BLOCK_POOLS == 1 )
+        HeapBlockTag_t * pxTag;
+        size_t xPoolBlockSize;
+    #endif
+
+    #if ( configUSE_BLOCK_POOLS == 1 )
+    {
+        #if ( configUSE_HEAP_TRACKING == 1 )
+        {
+            /* The tag of a pool block must be read before the block goes back
+             * to the pool, where it can be handed out again at once. */
+            pxTag = pxPortBlockPoolGetTag( pv, &xPoolBlockSize );
+
+            if( pxTag != NULL )
+            {
+                vTaskSuspendAll();
+                {
+                    prvTrackFree( pxTag, pv, xPoolBlockSize, pvCaller );
+                }
+                ( void ) xTaskResumeAll();
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        #endif
+
+        if( xPortBlockPoolFree( pv ) != pdFALSE )
+        {
+            traceFREE( pv, 0 );
+            return;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+    #endif /* configUSE_BLOCK_POOLS */
+
     if( pv != NULL )
     {
         /* The memory being freed will have an BlockLink_t structure immediately
@@ -321,8 +561,21 @@ void vPortFree( void * pv )
                     /* Add this block to the list of free blocks. */
                     xFreeBytesRemaining += pxLink->xBlockSize;
                     traceFREE( pv, pxLink->xBlockSize );
+
+                    #if ( configUSE_HEAP_TRACKING == 1 )
+                    {
+                        prvTrackFree( &( pxLink->xTag ), pv, pxLink->xBlockSize, pvCaller );
+                    }
+                    #endif
+
                     prvInsertBlockIntoFreeList( ( ( BlockLink_t * ) pxLink ) );
                     xNumberOfSuccessfulFrees++;
+
+                    #if ( configUSE_HEAP_FRAGMENTATION_STATS == 1 )
+                    {
+                        prvUpdateFragmentationStats();
+                    }
+                    #endif
                 }
                 ( void ) xTaskResumeAll();
             }
@@ -418,6 +671,12 @@ static void prvHeapInit( void ) /* PRIVILEGED_FUNCTION */
     /* Only one block exists - and it covers the entire usable heap space. */
     xMinimumEverFreeBytesRemaining = pxFirstFreeBlock->xBlockSize;
     xFreeBytesRemaining = pxFirstFreeBlock->xBlockSize;
+
+    #if ( configUSE_HEAP_FRAGMENTATION_STATS == 1 )
+    {
+        prvFreeBlockAdded( pxFirstFreeBlock->xBlockSize );
+    }
+    #endif
 }
 /*-----------------------------------------------------------*/
 
@@ -439,6 +698,13 @@ static void prvInsertBlockIntoFreeList( BlockLink_t * pxBlockToInsert ) /* PRIVI
 
     if( ( puc + pxIterator->xBlockSize ) == ( uint8_t * ) pxBlockToInsert )
     {
+        #if ( configUSE_HEAP_FRAGMENTATION_STATS == 1 )
+        {
+            /* The block in front grows, it is counted again below. */
+            prvFreeBlockRemoved( pxIterator->xBlockSize );
+        }
+        #endif
+
         pxIterator->xBlockSize += pxBlockToInsert->xBlockSize;
         pxBlockToInsert = pxIterator;
     }
@@ -456,6 +722,12 @@ static void prvInsertBlockIntoFreeList( BlockLink_t * pxBlockToInsert ) /* PRIVI
         if( pxIterator->pxNextFreeBlock != pxEnd )
         {
             /* Form one big block from the two blocks. */
+            #if ( configUSE_HEAP_FRAGMENTATION_STATS == 1 )
+            {
+                prvFreeBlockRemoved( pxIterator->pxNextFreeBlock->xBlockSize );
+            }
+            #endif
+
             pxBlockToInsert->xBlockSize += pxIterator->pxNextFreeBlock->xBlockSize;
             pxBlockToInsert->pxNextFreeBlock = pxIterator->pxNextFreeBlock->pxNextFreeBlock;
         }
@@ -481,6 +753,12 @@ static void prvInsertBlockIntoFreeList( BlockLink_t * pxBlockToInsert ) /* PRIVI
     {
         mtCOVERAGE_TEST_MARKER();
     }
+
+    #if ( configUSE_HEAP_FRAGMENTATION_STATS == 1 )
+    {
+        prvFreeBlockAdded( pxBlockToInsert->xBlockSize );
+    }
+    #endif
 }
 /*-----------------------------------------------------------*/
 
@@ -535,3 +813,382 @@ void vPortGetHeapStats( HeapStats_t * pxHeapStats )
     taskEXIT_CRITICAL();
 }
 /*-----------------------------------------------------------*/
+
+#if ( configUSE_HEAP_FRAGMENTATION_STATS == 1 )
+
+    static void prvFreeBlockAdded( size_t xBlockSize ) /* PRIVILEGED_FUNCTION */
+    {
+        const UBaseType_t uxBin = portHEAP_FRAGMENTATION_BIN( xBlockSize );
+
+        xNumberOfFreeBlocks++;
+        xFreeBlocksBySize[ uxBin ]++;
+        uxNonEmptyBins |= ( ( UBaseType_t ) 1 ) << uxBin;
+
+        /* If the count of the entry's largest size has dropped to zero its
+         * blocks are all smaller than xLargestInBin[ uxBin ], so the entry is
+         * correct again once a block at least that large is added. */
+        if( xBlockSize > xLargestInBin[ uxBin ] )
+        {
+            xLargestInBin[ uxBin ] = xBlockSize;
+            xLargestInBinCount[ uxBin ] = 1;
+        }
+        else if( xBlockSize == xLargestInBin[ uxBin ] )
+        {
+            xLargestInBinCount[ uxBin ]++;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        if( xBlockSize > xLargestFreeBlock )
+        {
+            xLargestFreeBlock = xBlockSize;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvFreeBlockRemoved( size_t xBlockSize ) /* PRIVILEGED_FUNCTION */
+    {
+        const UBaseType_t uxBin = portHEAP_FRAGMENTATION_BIN( xBlockSize );
+
+        xNumberOfFreeBlocks--;
+        xFreeBlocksBySize[ uxBin ]--;
+
+        if( xFreeBlocksBySize[ uxBin ] == 0 )
+        {
+            uxNonEmptyBins &= ~( ( ( UBaseType_t ) 1 ) << uxBin );
+            xLargestInBin[ uxBin ] = 0;
+            xLargestInBinCount[ uxBin ] = 0;
+        }
+        else if( xBlockSize == xLargestInBin[ uxBin ] )
+        {
+            /* If this was the last block of the largest size in the entry the
+             * next largest is found by prvUpdateFragmentationStats(), unless
+             * a block as large is added first - as happens when blocks are
+             * split or merged. */
+            xLargestInBinCount[ uxBin ]--;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvUpdateFragmentationStats( void ) /* PRIVILEGED_FUNCTION */
+    {
+        BlockLink_t * pxBlock;
+        UBaseType_t uxBin;
+        size_t xPermille;
+
+        if( uxNonEmptyBins == 0 )
+        {
+            xLargestFreeBlock = 0;
+        }
+        else
+        {
+            uxBin = ( UBaseType_t ) ( portHEAP_FRAGMENTATION_BINS - 1 );
+
+            while( ( uxNonEmptyBins & ( ( ( UBaseType_t ) 1 ) << uxBin ) ) == 0 )
+            {
+                uxBin--;
+            }
+
+            if( xLargestInBinCount[ uxBin ] == 0 )
+            {
+                /* Only the blocks of this entry can be the largest. */
+                xLargestInBin[ uxBin ] = 0;
+
+                for( pxBlock = xStart.pxNextFreeBlock; pxBlock != pxEnd; pxBlock = pxBlock->pxNextFreeBlock )
+                {
+                    if( portHEAP_FRAGMENTATION_BIN( pxBlock->xBlockSize ) == uxBin )
+                    {
+                        if( pxBlock->xBlockSize > xLargestInBin[ uxBin ] )
+                        {
+                            xLargestInBin[ uxBin ] = pxBlock->xBlockSize;
+                            xLargestInBinCount[ uxBin ] = 1;
+                        }
+                        else if( pxBlock->xBlockSize == xLargestInBin[ uxBin ] )
+                        {
+                            xLargestInBinCount[ uxBin ]++;
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            xLargestFreeBlock = xLargestInBin[ uxBin ];
+        }
+
+        xPermille = prvFragmentationPermille();
+
+        if( xPermille > xMaximumFragmentationPermille )
+        {
+            xMaximumFragmentationPermille = xPermille;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    static size_t prvFragmentationPermille( void ) /* PRIVILEGED_FUNCTION */
+    {
+        size_t xFree = xFreeBytesRemaining;
+        size_t xLargest = xLargestFreeBlock;
+
+        if( xFree == 0 )
+        {
+            return 0;
+        }
+
+        /* Scale both down rather than overflow on very large heaps. */
+        while( xFree > ( heapSIZE_MAX / ( size_t ) 1000 ) )
+        {
+            xFree >>= 1;
+            xLargest >>= 1;
+        }
+
+        return ( ( xFree - xLargest ) * ( size_t ) 1000 ) / xFree;
+    }
+/*-----------------------------------------------------------*/
+
+    void vPortGetHeapFragmentationStats( HeapFragmentationStats_t * pxFragmentationStats )
+    {
+        UBaseType_t ux;
+
+        taskENTER_CRITICAL();
+        {
+            pxFragmentationStats->xAvailableHeapSpaceInBytes = xFreeBytesRemaining;
+            pxFragmentationStats->xSizeOfLargestFreeBlockInBytes = xLargestFreeBlock;
+            pxFragmentationStats->xNumberOfFreeBlocks = xNumberOfFreeBlocks;
+            pxFragmentationStats->xFragmentationPermille = prvFragmentationPermille();
+            pxFragmentationStats->xMaximumFragmentationPermille = xMaximumFragmentationPermille;
+
+            for( ux = 0; ux < ( UBaseType_t ) portHEAP_FRAGMENTATION_BINS; ux++ )
+            {
+                pxFragmentationStats->xFreeBlocksBySize[ ux ] = xFreeBlocksBySize[ ux ];
+            }
+        }
+        taskEXIT_CRITICAL();
+    }
+/*-----------------------------------------------------------*/
+
+#endif /* configUSE_HEAP_FRAGMENTATION_STATS */
+
+#if ( configUSE_HEAP_TRACKING == 1 )
+
+    static UBaseType_t prvGetOwnerSlot( void ) /* PRIVILEGED_FUNCTION */
+    {
+        TaskHandle_t xTask = NULL;
+        UBaseType_t ux, uxUnused = heapNO_OWNER, uxIdle = heapNO_OWNER;
+
+        /* Allocations made before the scheduler starts, when creating the
+         * first tasks and queues, are accounted to a NULL task. */
+        if( xTaskGetSchedulerState() != taskSCHEDULER_NOT_STARTED )
+        {
+            xTask = xTaskGetCurrentTaskHandle();
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        for( ux = 0; ux < ( UBaseType_t ) configHEAP_TRACKING_MAX_TASKS; ux++ )
+        {
+            if( xTaskUsage[ ux ].xNumberOfAllocations == 0 )
+            {
+                if( uxUnused == heapNO_OWNER )
+                {
+                    uxUnused = ux;
+                }
+            }
+            else if( xTaskUsage[ ux ].xTask == xTask )
+            {
+                return ux;
+            }
+            else if( ( xTaskUsage[ ux ].xLiveBytes == 0 ) && ( uxIdle == heapNO_OWNER ) )
+            {
+                /* Nothing the owner of this slot allocated is still live, so
+                 * the slot can be handed over if no unused slot is left. */
+                uxIdle = ux;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+
+        if( uxUnused == heapNO_OWNER )
+        {
+            uxUnused = uxIdle;
+        }
+
+        if( uxUnused != heapNO_OWNER )
+        {
+            ( void ) memset( &( xTaskUsage[ uxUnused ] ), 0x00, sizeof( HeapTaskUsage_t ) );
+            xTaskUsage[ uxUnused ].xTask = xTask;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return uxUnused;
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvTrackAllocation( HeapBlockTag_t * pxTag,
+                                    const void * pv,
+                                    size_t xBlockSize,
+                                    void * pvCaller ) /* PRIVILEGED_FUNCTION */
+    {
+        HeapTaskUsage_t * pxUsage;
+
+        pxTag->pvCaller = pvCaller;
+        pxTag->xTimeStamp = xTaskGetTickCount();
+        pxTag->uxOwner = prvGetOwnerSlot();
+
+        if( pxTag->uxOwner != heapNO_OWNER )
+        {
+            pxUsage = &( xTaskUsage[ pxTag->uxOwner ] );
+            pxUsage->xLiveBytes += xBlockSize;
+            pxUsage->xNumberOfAllocations++;
+
+            if( pxUsage->xLiveBytes > pxUsage->xPeakLiveBytes )
+            {
+                pxUsage->xPeakLiveBytes = pxUsage->xLiveBytes;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        #if ( configUSE_HEAP_TRACE == 1 )
+        {
+            prvTraceHeapEvent( portHEAP_TRACE_EVENT_MALLOC, pv, xBlockSize, pxTag->uxOwner, pvCaller );
+        }
+        #else
+        {
+            ( void ) pv;
+        }
+        #endif
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvTrackFree( const HeapBlockTag_t * pxTag,
+                              const void * pv,
+                              size_t xBlockSize,
+                              void * pvCaller ) /* PRIVILEGED_FUNCTION */
+    {
+        HeapTaskUsage_t * pxUsage;
+
+        /* The block is charged back to the task that allocated it, which is
+         * not always the task freeing it - the idle task frees the TCB and
+         * stack of deleted tasks, for example. */
+        if( pxTag->uxOwner != heapNO_OWNER )
+        {
+            pxUsage = &( xTaskUsage[ pxTag->uxOwner ] );
+            configASSERT( pxUsage->xLiveBytes >= xBlockSize );
+            pxUsage->xLiveBytes -= xBlockSize;
+            pxUsage->xNumberOfFrees++;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        #if ( configUSE_HEAP_TRACE == 1 )
+        {
+            prvTraceHeapEvent( portHEAP_TRACE_EVENT_FREE, pv, xBlockSize, pxTag->uxOwner, pvCaller );
+        }
+        #else
+        {
+            ( void ) pv;
+            ( void ) pvCaller;
+        }
+        #endif
+    }
+/*-----------------------------------------------------------*/
+
+    UBaseType_t uxPortGetHeapTaskUsage( HeapTaskUsage_t * const pxTaskUsageArray,
+                                        const UBaseType_t uxArraySize )
+    {
+        UBaseType_t ux, uxCount = uxArraySize;
+
+        if( uxCount > ( UBaseType_t ) configHEAP_TRACKING_MAX_TASKS )
+        {
+            uxCount = ( UBaseType_t ) configHEAP_TRACKING_MAX_TASKS;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        vTaskSuspendAll();
+        {
+            for( ux = 0; ux < uxCount; ux++ )
+            {
+                pxTaskUsageArray[ ux ] = xTaskUsage[ ux ];
+            }
+        }
+        ( void ) xTaskResumeAll();
+
+        return uxCount;
+    }
+/*-----------------------------------------------------------*/
+
+#endif /* configUSE_HEAP_TRACKING */
+
+#if ( configUSE_HEAP_TRACE == 1 )
+
+    static void prvTraceHeapEvent( uint8_t ucEvent,
+                                   const void * pv,
+                                   size_t xSize,
+                                   UBaseType_t uxOwner,
+                                   void * pvCaller ) /* PRIVILEGED_FUNCTION */
+    {
+        HeapTraceRecord_t xRecord;
+
+        #if ( configUSE_MONOTONIC_CLOCK == 1 )
+        {
+            xRecord.ulTimeStamp = ( uint32_t ) portCLOCK_NS_TO_US( ullPortGetClockNs() );
+        }
+        #else
+        {
+            xRecord.ulTimeStamp = ( uint32_t ) xTaskGetTickCount();
+        }
+        #endif
+        xRecord.ulAddress = ( uint32_t ) ( portPOINTER_SIZE_TYPE ) pv;
+        xRecord.ulCaller = ( uint32_t ) ( portPOINTER_SIZE_TYPE ) pvCaller;
+        xRecord.usBlockSize = ( xSize > 0xffffU ) ? ( uint16_t ) 0xffffU : ( uint16_t ) xSize;
+        xRecord.ucEvent = ucEvent;
+        xRecord.ucTask = ( uint8_t ) uxOwner;
+
+        vApplicationHeapTraceHook( &xRecord );
+    }
+/*-----------------------------------------------------------*/
+
+#endif /* configUSE_HEAP_TRACE */
@@ -0,0 +1,1442 @@
+/*
+ * FreeRTOS Kernel V10.5.1
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/*
+ * A sample implementation of pvPortMalloc() and vPortFree() that combines
+ * (coalescences) adjacent memory blocks as they are freed, and in so doing
+ * limits memory fragmentation.
+ *
+ * This is heap_4.c extended to place the heap across multiple, non-adjacent
+ * memory regions.  The regions are defined by calling vPortDefineHeapRegions()
+ * before the first allocation - not creating a task, queue, semaphore, mutex,
+ * software timer, event group, etc. will call pvPortMalloc().
+ *
+ * Each region carries portHEAP_REGION_ attributes.  pvPortMallocWithHint()
+ * only allocates from regions that have all the requested attributes, for
+ * example DMA buffers.  pvPortMalloc() prefers regions without attributes and
+ * only falls back to the others when those are full, so the special regions
+ * are left for the allocations that need them.  vPortGetHeapRegionStats()
+ * reports the usage of each region.
+ *
+ * See heap_1.c, heap_2.c and heap_3.c for alternative implementations, and the
+ * memory management pages of https://www.FreeRTOS.org for more information.
+ */
+#include <stdlib.h>
+#include <string.h>
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+ * all the API functions to use the MPU wrappers.  That should only be done when
+ * task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+#if ( configSUPPORT_DYNAMIC_ALLOCATION == 0 )
+    #error This file must not be used if configSUPPORT_DYNAMIC_ALLOCATION is 0
+#endif
+
+#ifndef configHEAP_CLEAR_MEMORY_ON_FREE
+    #define configHEAP_CLEAR_MEMORY_ON_FREE    0
+#endif
+
+/* The largest number of regions vPortDefineHeapRegions() accepts. */
+#ifndef configHEAP_MAX_REGIONS
+    #define configHEAP_MAX_REGIONS    4
+#endif
+
+/* Block sizes must not get too small. */
+#define heapMINIMUM_BLOCK_SIZE    ( ( size_t ) ( xHeapStructSize << 1 ) )
+
+/* Assumes 8bit bytes! */
+#define heapBITS_PER_BYTE         ( ( size_t ) 8 )
+
+/* Max value that fits in a size_t type. */
+#define heapSIZE_MAX              ( ~( ( size_t ) 0 ) )
+
+/* Check if multiplying a and b will result in overflow. */
+#define heapMULTIPLY_WILL_OVERFLOW( a, b )    ( ( ( a ) > 0 ) && ( ( b ) > ( heapSIZE_MAX / ( a ) ) ) )
+
+/* Check if adding a and b will result in overflow. */
+#define heapADD_WILL_OVERFLOW( a, b )         ( ( a ) > ( heapSIZE_MAX - ( b ) ) )
+
+/* MSB of the xBlockSize member of an BlockLink_t structure is used to track
+ * the allocation status of a block.  When MSB of the xBlockSize member of
+ * an BlockLink_t structure is set then the block belongs to the application.
+ * When the bit is free the block is still part of the free heap space. */
+#define heapBLOCK_ALLOCATED_BITMASK    ( ( ( size_t ) 1 ) << ( ( sizeof( size_t ) * heapBITS_PER_BYTE ) - 1 ) )
+#define heapBLOCK_SIZE_IS_VALID( xBlockSize )    ( ( ( xBlockSize ) & heapBLOCK_ALLOCATED_BITMASK ) == 0 )
+#define heapBLOCK_IS_ALLOCATED( pxBlock )        ( ( ( pxBlock->xBlockSize ) & heapBLOCK_ALLOCATED_BITMASK ) != 0 )
+#define heapALLOCATE_BLOCK( pxBlock )            ( ( pxBlock->xBlockSize ) |= heapBLOCK_ALLOCATED_BITMASK )
+#define heapFREE_BLOCK( pxBlock )                ( ( pxBlock->xBlockSize ) &= ~heapBLOCK_ALLOCATED_BITMASK )
+
+#if ( configUSE_HEAP_TRACKING == 1 )
+    #if ( configHEAP_TRACKING_MAX_TASKS < 1 ) || ( configHEAP_TRACKING_MAX_TASKS > 254 )
+        #error configHEAP_TRACKING_MAX_TASKS must be between 1 and 254
+    #endif
+
+    #if ( INCLUDE_xTaskGetSchedulerState == 0 ) && ( configUSE_TIMERS == 0 )
+        #error configUSE_HEAP_TRACKING requires INCLUDE_xTaskGetSchedulerState to be set to 1
+    #endif
+
+/* The owner recorded in blocks that could not be given an accounting slot. */
+    #define heapNO_OWNER    ( ( UBaseType_t ) portHEAP_TRACE_NO_TASK )
+
+#endif /* configUSE_HEAP_TRACKING */
+
+/* The address the allocating or freeing call returns to.  It must be taken in
+ * the API functions themselves, not in a helper. */
+#if ( configUSE_HEAP_TRACKING == 1 ) && defined( __GNUC__ )
+    #define heapCALLER_ADDRESS()    __builtin_return_address( 0 )
+#else
+    #define heapCALLER_ADDRESS()    NULL
+#endif
+
+/*-----------------------------------------------------------*/
+
+/* Define the linked list structure.  This is used to link free blocks in order
+ * of their memory address. */
+typedef struct A_BLOCK_LINK
+{
+    struct A_BLOCK_LINK * pxNextFreeBlock; /*<< The next free block in the list. */
+    size_t xBlockSize;                     /*<< The size of the free block. */
+
+    #if ( configUSE_HEAP_TRACKING == 1 )
+        HeapBlockTag_t xTag; /*<< The owner, call-site and time of an allocated block. */
+    #endif
+} BlockLink_t;
+
+/* The bounds, attributes and usage of one heap region. */
+typedef struct A_HEAP_REGION
+{
+    uint8_t * pucStart;                    /*<< The first block of the region. */
+    uint8_t * pucEnd;                      /*<< The end marker of the region, no block extends past it. */
+    UBaseType_t uxAttributes;              /*<< The portHEAP_REGION_ attributes given to vPortDefineHeapRegions(). */
+    size_t xSizeInBytes;                   /*<< The bytes available for allocation when the region is empty. */
+    size_t xFreeBytes;                     /*<< The bytes currently free in the region. */
+    size_t xMinimumEverFreeBytes;          /*<< The lowest value xFreeBytes has reached. */
+    size_t xNumberOfSuccessfulAllocations; /*<< The number of blocks allocated from the region. */
+    size_t xNumberOfSuccessfulFrees;       /*<< The number of blocks returned to the region. */
+} HeapRegionInfo_t;
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Inserts a block of memory that is being freed into the correct position in
+ * the list of free memory blocks.  The block being freed will be merged with
+ * the block in front it and/or the block behind it if the memory blocks are
+ * adjacent to each other.
+ */
+static void prvInsertBlockIntoFreeList( BlockLink_t * pxBlockToInsert ) PRIVILEGED_FUNCTION;
+
+/*
+ * The allocation behind pvPortMalloc() and pvPortMallocWithHint().
+ */
+static void * prvHeapAllocate( size_t xWantedSize,
+                               UBaseType_t uxHint,
+                               void * pvCaller ) PRIVILEGED_FUNCTION;
+
+/*
+ * Find the first free block of at least xWantedSize bytes in a region whose
+ * attributes, masked with uxMask, equal uxMatch.  Returns pxEnd if there is
+ * none, otherwise sets *ppxPreviousBlock to the free block before it and
+ * *puxRegion to its region.
+ */
+static BlockLink_t * prvFindFreeBlock( size_t xWantedSize,
+                                       UBaseType_t uxMask,
+                                       UBaseType_t uxMatch,
+                                       BlockLink_t ** ppxPreviousBlock,
+                                       UBaseType_t * puxRegion ) PRIVILEGED_FUNCTION;
+
+/*
+ * The index of the region holding pxBlock.
+ */
+static UBaseType_t prvRegionOf( const BlockLink_t * pxBlock ) PRIVILEGED_FUNCTION;
+
+#if ( configUSE_HEAP_TRACKING == 1 )
+
+/*
+ * Tag a block of xBlockSize bytes that is being allocated at pv with its owner,
+ * call-site and time, and add it to the owner's live bytes.  pxTag is in the
+ * block header for heap blocks and kept by the pool for pool blocks.  Called
+ * with the scheduler suspended.
+ */
+    static void prvTrackAllocation( HeapBlockTag_t * pxTag,
+                                    const void * pv,
+                                    size_t xBlockSize,
+                                    void * pvCaller ) PRIVILEGED_FUNCTION;
+
+/*
+ * Remove a block that is being freed from its owner's live bytes.  Called with
+ * the scheduler suspended.
+ */
+    static void prvTrackFree( const HeapBlockTag_t * pxTag,
+                              const void * pv,
+                              size_t xBlockSize,
+                              void * pvCaller ) PRIVILEGED_FUNCTION;
+
+/*
+ * Return the accounting slot of the calling task, claiming a slot if the task
+ * does not have one yet.
+ */
+    static UBaseType_t prvGetOwnerSlot( void ) PRIVILEGED_FUNCTION;
+
+#endif /* configUSE_HEAP_TRACKING */
+
+#if ( configUSE_HEAP_FRAGMENTATION_STATS == 1 )
+
+/*
+ * Account for a block of xBlockSize bytes entering or leaving the free list.
+ * Called with the scheduler suspended.
+ */
+    static void prvFreeBlockAdded( size_t xBlockSize ) PRIVILEGED_FUNCTION;
+    static void prvFreeBlockRemoved( size_t xBlockSize ) PRIVILEGED_FUNCTION;
+
+/*
+ * Find the largest free block from the histogram, then update the
+ * fragmentation high water mark.  Called with the scheduler suspended at the
+ * end of every allocation and free.
+ */
+    static void prvUpdateFragmentationStats( void ) PRIVILEGED_FUNCTION;
+
+/*
+ * The current external fragmentation in 0.1% units.
+ */
+    static size_t prvFragmentationPermille( void ) PRIVILEGED_FUNCTION;
+
+#endif /* configUSE_HEAP_FRAGMENTATION_STATS */
+
+#if ( configUSE_HEAP_TRACE == 1 )
+
+/*
+ * Build a trace record and pass it to vApplicationHeapTraceHook().
+ */
+    static void prvTraceHeapEvent( uint8_t ucEvent,
+                                   const void * pv,
+                                   size_t xSize,
+                                   UBaseType_t uxOwner,
+                                   void * pvCaller ) PRIVILEGED_FUNCTION;
+
+#endif /* configUSE_HEAP_TRACE */
+
+/*-----------------------------------------------------------*/
+
+/* The size of the structure placed at the beginning of each allocated memory
+ * block must by correctly byte aligned. */
+static const size_t xHeapStructSize = ( sizeof( BlockLink_t ) + ( ( size_t ) ( portBYTE_ALIGNMENT - 1 ) ) ) & ~( ( size_t ) portBYTE_ALIGNMENT_MASK );
+
+/* Create a couple of list links to mark the start and end of the list. */
+PRIVILEGED_DATA static BlockLink_t xStart;
+PRIVILEGED_DATA static BlockLink_t * pxEnd = NULL;
+
+/* Keeps track of the number of calls to allocate and free memory as well as the
+ * number of free bytes remaining, but says nothing about fragmentation. */
+PRIVILEGED_DATA static size_t xFreeBytesRemaining = 0U;
+PRIVILEGED_DATA static size_t xMinimumEverFreeBytesRemaining = 0U;
+PRIVILEGED_DATA static size_t xNumberOfSuccessfulAllocations = 0;
+PRIVILEGED_DATA static size_t xNumberOfSuccessfulFrees = 0;
+
+/* The regions, in address order.  xHaveGeneralRegion is pdTRUE if at least
+ * one region has no attributes. */
+PRIVILEGED_DATA static HeapRegionInfo_t xRegions[ configHEAP_MAX_REGIONS ];
+PRIVILEGED_DATA static UBaseType_t uxNumberOfRegions = 0;
+PRIVILEGED_DATA static BaseType_t xHaveGeneralRegion = pdFALSE;
+
+#if ( configUSE_HEAP_FRAGMENTATION_STATS == 1 )
+
+/* The free list summarised as it changes.  Bit n of uxNonEmptyBins is set
+ * while xFreeBlocksBySize[ n ] is not zero, and xLargestInBin[ n ] is the
+ * largest block counted in that entry, xLargestInBinCount[ n ] the number of
+ * free blocks of that size.  The largest free block is the largest of the
+ * highest entry in use.  When the last block of that size leaves an entry
+ * that still holds smaller blocks the count drops to zero, and only the blocks
+ * of that one entry are looked at again, when it is the highest entry. */
+    PRIVILEGED_DATA static size_t xNumberOfFreeBlocks = 0;
+    PRIVILEGED_DATA static size_t xLargestFreeBlock = 0;
+    PRIVILEGED_DATA static size_t xMaximumFragmentationPermille = 0;
+    PRIVILEGED_DATA static size_t xFreeBlocksBySize[ portHEAP_FRAGMENTATION_BINS ];
+    PRIVILEGED_DATA static size_t xLargestInBin[ portHEAP_FRAGMENTATION_BINS ];
+    PRIVILEGED_DATA static size_t xLargestInBinCount[ portHEAP_FRAGMENTATION_BINS ];
+    PRIVILEGED_DATA static UBaseType_t uxNonEmptyBins = 0;
+#endif
+
+#if ( configUSE_HEAP_TRACKING == 1 )
+
+/* Live and peak bytes per allocating task.  A slot is claimed by a task the
+ * first time it allocates, and only handed to another task once every block
+ * the previous owner allocated has been freed. */
+    PRIVILEGED_DATA static HeapTaskUsage_t xTaskUsage[ configHEAP_TRACKING_MAX_TASKS ];
+#endif
+
+/*-----------------------------------------------------------*/
+
+void * pvPortMalloc( size_t xWantedSize )
+{
+    return prvHeapAllocate( xWantedSize, portHEAP_REGION_GENERAL, heapCALLER_ADDRESS() );
+}
+/*-----------------------------------------------------------*/
+
+void * pvPortMallocWithHint( size_t xWantedSize,
+                             UBaseType_t uxHint )
+{
+    return prvHeapAllocate( xWantedSize, uxHint, heapCALLER_ADDRESS() );
+}
+/*-----------------------------------------------------------*/
+
+static void * prvHeapAllocate( size_t xWantedSize,
+                               UBaseType_t uxHint,
+                               void * pvCaller ) /* PRIVILEGED_FUNCTION */
+{
+    BlockLink_t * pxBlock;
+    BlockLink_t * pxPreviousBlock;
+    BlockLink_t * pxNewBlockLink;
+    HeapRegionInfo_t * pxRegion;
+    UBaseType_t uxRegion = 0;
+    void * pvReturn = NULL;
+    size_t xAdditionalRequiredSize;
+
+    #if ( configUSE_HEAP_TRACE == 1 )
+        size_t xRequestedSize = xWantedSize;
+    #endif
+
+    #if ( configUSE_HEAP_TRACKING == 1 ) && ( configUSE_BLOCK_POOLS == 1 )
+        HeapBlockTag_t * pxTag;
+        size_t xPoolBlockSize;
+    #endif
+
+    #if ( configUSE_HEAP_TRACKING == 0 )
+        ( void ) pvCaller;
+    #endif
+
+    /* The heap must be initialised before the first call to create an object. */
+    configASSERT( pxEnd );
+
+    #if ( configUSE_BLOCK_POOLS == 1 )
+    {
+        /* Small requests are served from the fixed size block pools when
+         * they have a free block, see block_pools.c.  The pools are not part
+         * of any region, so they only serve requests without a hint. */
+        if( uxHint == portHEAP_REGION_GENERAL )
+        {
+            pvReturn = pvPortBlockPoolAlloc( xWantedSize );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        if( pvReturn != NULL )
+        {
+            traceMALLOC( pvReturn, xWantedSize );
+
+            #if ( configUSE_HEAP_TRACKING == 1 )
+            {
+                /* Pool blocks have no header, the pool keeps their tags. */
+                vTaskSuspendAll();
+                {
+                    pxTag = pxPortBlockPoolGetTag( pvReturn, &xPoolBlockSize );
+                    configASSERT( pxTag );
+                    prvTrackAllocation( pxTag, pvReturn, xPoolBlockSize, pvCaller );
+                }
+                ( void ) xTaskResumeAll();
+            }
+            #endif
+
+            return pvReturn;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+    #endif /* configUSE_BLOCK_POOLS */
+
+    vTaskSuspendAll();
+    {
+        if( xWantedSize > 0 )
+        {
+            /* The wanted size must be increased so it can contain a BlockLink_t
+             * structure in addition to the requested amount of bytes. Some
+             * additional increment may also be needed for alignment. */
+            xAdditionalRequiredSize = xHeapStructSize + portBYTE_ALIGNMENT - ( xWantedSize & portBYTE_ALIGNMENT_MASK );
+
+            if( heapADD_WILL_OVERFLOW( xWantedSize, xAdditionalRequiredSize ) == 0 )
+            {
+                xWantedSize += xAdditionalRequiredSize;
+            }
+            else
+            {
+                xWantedSize = 0;
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        /* Check the block size we are trying to allocate is not so large that the
+         * top bit is set.  The top bit of the block size member of the BlockLink_t
+         * structure is used to determine who owns the block - the application or
+         * the kernel, so it must be free. */
+        if( heapBLOCK_SIZE_IS_VALID( xWantedSize ) != 0 )
+        {
+            if( ( xWantedSize > 0 ) && ( xWantedSize <= xFreeBytesRemaining ) )
+            {
+                /* Traverse the list from the start (lowest address) block until
+                 * one of adequate size is found in a region the hint allows.
+                 * Requests without a hint look in the regions without
+                 * attributes first. */
+                if( uxHint != portHEAP_REGION_GENERAL )
+                {
+                    pxBlock = prvFindFreeBlock( xWantedSize, uxHint, uxHint, &pxPreviousBlock, &uxRegion );
+                }
+                else if( xHaveGeneralRegion != pdFALSE )
+                {
+                    pxBlock = prvFindFreeBlock( xWantedSize, ~( ( UBaseType_t ) 0 ), portHEAP_REGION_GENERAL, &pxPreviousBlock, &uxRegion );
+
+                    if( pxBlock == pxEnd )
+                    {
+                        pxBlock = prvFindFreeBlock( xWantedSize, 0, 0, &pxPreviousBlock, &uxRegion );
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                else
+                {
+                    pxBlock = prvFindFreeBlock( xWantedSize, 0, 0, &pxPreviousBlock, &uxRegion );
+                }
+
+                /* If the end marker was reached then a block of adequate size
+                 * was not found. */
+                if( pxBlock != pxEnd )
+                {
+                    /* Return the memory space pointed to - jumping over the
+                     * BlockLink_t structure at its start. */
+                    pvReturn = ( void * ) ( ( ( uint8_t * ) pxPreviousBlock->pxNextFreeBlock ) + xHeapStructSize );
+
+                    /* This block is being returned for use so must be taken out
+                     * of the list of free blocks. */
+                    pxPreviousBlock->pxNextFreeBlock = pxBlock->pxNextFreeBlock;
+
+                    #if ( configUSE_HEAP_FRAGMENTATION_STATS == 1 )
+                    {
+                        prvFreeBlockRemoved( pxBlock->xBlockSize );
+                    }
+                    #endif
+
+                    /* If the block is larger than required it can be split into
+                     * two. */
+                    if( ( pxBlock->xBlockSize - xWantedSize ) > heapMINIMUM_BLOCK_SIZE )
+                    {
+                        /* This block is to be split into two.  Create a new
+                         * block following the number of bytes requested. The void
+                         * cast is used to prevent byte alignment warnings from the
+                         * compiler. */
+                        pxNewBlockLink = ( void * ) ( ( ( uint8_t * ) pxBlock ) + xWantedSize );
+                        configASSERT( ( ( ( size_t ) pxNewBlockLink ) & portBYTE_ALIGNMENT_MASK ) == 0 );
+
+                        /* Calculate the sizes of two blocks split from the
+                         * single block. */
+                        pxNewBlockLink->xBlockSize = pxBlock->xBlockSize - xWantedSize;
+                        pxBlock->xBlockSize = xWantedSize;
+
+                        /* Insert the new block into the list of free blocks. */
+                        prvInsertBlockIntoFreeList( pxNewBlockLink );
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+
+                    xFreeBytesRemaining -= pxBlock->xBlockSize;
+
+                    if( xFreeBytesRemaining < xMinimumEverFreeBytesRemaining )
+                    {
+                        xMinimumEverFreeBytesRemaining = xFreeBytesRemaining;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+
+                    /* The block is being returned - it is allocated and owned
+                     * by the application and has no "next" block. */
+                    heapALLOCATE_BLOCK( pxBlock );
+                    pxBlock->pxNextFreeBlock = NULL;
+                    xNumberOfSuccessfulAllocations++;
+
+                    pxRegion = &( xRegions[ uxRegion ] );
+                    pxRegion->xFreeBytes -= pxBlock->xBlockSize & ~heapBLOCK_ALLOCATED_BITMASK;
+                    pxRegion->xNumberOfSuccessfulAllocations++;
+
+                    if( pxRegion->xFreeBytes < pxRegion->xMinimumEverFreeBytes )
+                    {
+                        pxRegion->xMinimumEverFreeBytes = pxRegion->xFreeBytes;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+
+                    #if ( configUSE_HEAP_FRAGMENTATION_STATS == 1 )
+                    {
+                        prvUpdateFragmentationStats();
+                    }
+                    #endif
+
+                    #if ( configUSE_HEAP_TRACKING == 1 )
+                    {
+                        prvTrackAllocation( &( pxBlock->xTag ),
+                                            pvReturn,
+                                            pxBlock->xBlockSize & ~heapBLOCK_ALLOCATED_BITMASK,
+                                            pvCaller );
+                    }
+                    #endif
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        #if ( configUSE_HEAP_TRACE == 1 )
+        {
+            if( pvReturn == NULL )
+            {
+                prvTraceHeapEvent( portHEAP_TRACE_EVENT_MALLOC_FAILED, NULL, xRequestedSize, heapNO_OWNER, pvCaller );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        #endif /* configUSE_HEAP_TRACE */
+
+        traceMALLOC( pvReturn, xWantedSize );
+    }
+    ( void ) xTaskResumeAll();
+
+    #if ( configUSE_MALLOC_FAILED_HOOK == 1 )
+    {
+        if( pvReturn == NULL )
+        {
+            vApplicationMallocFailedHook();
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+    #endif /* if ( configUSE_MALLOC_FAILED_HOOK == 1 ) */
+
+    configASSERT( ( ( ( size_t ) pvReturn ) & ( size_t ) portBYTE_ALIGNMENT_MASK ) == 0 );
+    return pvReturn;
+}
+/*-----------------------------------------------------------*/
+
+void vPortFree( void * pv )
+{
+    uint8_t * puc = ( uint8_t * ) pv;
+    BlockLink_t * pxLink;
+    HeapRegionInfo_t * pxRegion;
+
+    #if ( configUSE_HEAP_TRACKING == 1 )
+        void * pvCaller = heapCALLER_ADDRESS();
+    #endif
+
+    #if ( configUSE_HEAP_TRACKING == 1 ) && ( configUSE_BLOCK_POOLS == 1 )
+        HeapBlockTag_t * pxTag;
+        size_t xPoolBlockSize;
+    #endif
+
+    #if ( configUSE_BLOCK_POOLS == 1 )
+    {
+        #if ( configUSE_HEAP_TRACKING == 1 )
+        {
+            /* The tag of a pool block must be read before the block goes back
+             * to the pool, where it can be handed out again at once. */
+            pxTag = pxPortBlockPoolGetTag( pv, &xPoolBlockSize );
+
+            if( pxTag != NULL )
+            {
+                vTaskSuspendAll();
+                {
+                    prvTrackFree( pxTag, pv, xPoolBlockSize, pvCaller );
+                }
+                ( void ) xTaskResumeAll();
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        #endif
+
+        if( xPortBlockPoolFree( pv ) != pdFALSE )
+        {
+            traceFREE( pv, 0 );
+            return;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+    #endif /* configUSE_BLOCK_POOLS */
+
+    if( pv != NULL )
+    {
+        /* The memory being freed will have an BlockLink_t structure immediately
+         * before it. */
+        puc -= xHeapStructSize;
+
+        /* This casting is to keep the compiler from issuing warnings. */
+        pxLink = ( void * ) puc;
+
+        configASSERT( heapBLOCK_IS_ALLOCATED( pxLink ) != 0 );
+        configASSERT( pxLink->pxNextFreeBlock == NULL );
+
+        if( heapBLOCK_IS_ALLOCATED( pxLink ) != 0 )
+        {
+            if( pxLink->pxNextFreeBlock == NULL )
+            {
+                /* The block is being returned to the heap - it is no longer
+                 * allocated. */
+                heapFREE_BLOCK( pxLink );
+                #if ( configHEAP_CLEAR_MEMORY_ON_FREE == 1 )
+                {
+                    ( void ) memset( puc + xHeapStructSize, 0, pxLink->xBlockSize - xHeapStructSize );
+                }
+                #endif
+
+                vTaskSuspendAll();
+                {
+                    /* Add this block to the list of free blocks. */
+                    xFreeBytesRemaining += pxLink->xBlockSize;
+                    traceFREE( pv, pxLink->xBlockSize );
+
+                    pxRegion = &( xRegions[ prvRegionOf( pxLink ) ] );
+                    pxRegion->xFreeBytes += pxLink->xBlockSize;
+                    pxRegion->xNumberOfSuccessfulFrees++;
+
+                    #if ( configUSE_HEAP_TRACKING == 1 )
+                    {
+                        prvTrackFree( &( pxLink->xTag ), pv, pxLink->xBlockSize, pvCaller );
+                    }
+                    #endif
+
+                    prvInsertBlockIntoFreeList( ( ( BlockLink_t * ) pxLink ) );
+                    xNumberOfSuccessfulFrees++;
+
+                    #if ( configUSE_HEAP_FRAGMENTATION_STATS == 1 )
+                    {
+                        prvUpdateFragmentationStats();
+                    }
+                    #endif
+                }
+                ( void ) xTaskResumeAll();
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+}
+/*-----------------------------------------------------------*/
+
+size_t xPortGetFreeHeapSize( void )
+{
+    return xFreeBytesRemaining;
+}
+/*-----------------------------------------------------------*/
+
+size_t xPortGetMinimumEverFreeHeapSize( void )
+{
+    return xMinimumEverFreeBytesRemaining;
+}
+/*-----------------------------------------------------------*/
+
+void vPortInitialiseBlocks( void )
+{
+    /* This just exists to keep the linker quiet. */
+}
+/*-----------------------------------------------------------*/
+
+void * pvPortCalloc( size_t xNum,
+                     size_t xSize )
+{
+    void * pv = NULL;
+
+    if( heapMULTIPLY_WILL_OVERFLOW( xNum, xSize ) == 0 )
+    {
+        pv = pvPortMalloc( xNum * xSize );
+
+        if( pv != NULL )
+        {
+            ( void ) memset( pv, 0, xNum * xSize );
+        }
+    }
+
+    return pv;
+}
+/*-----------------------------------------------------------*/
+
+void vPortDefineHeapRegions( const HeapRegion_t * const pxHeapRegions ) /* PRIVILEGED_FUNCTION */
+{
+    BlockLink_t * pxFirstFreeBlockInRegion;
+    BlockLink_t * pxLastFreeBlock = NULL;
+    HeapRegionInfo_t * pxRegion;
+    portPOINTER_SIZE_TYPE uxAlignedHeap;
+    portPOINTER_SIZE_TYPE uxAddress;
+    size_t xTotalRegionSize, xTotalHeapSize = 0;
+    const HeapRegion_t * pxHeapRegion;
+
+    /* Can only call once! */
+    configASSERT( pxEnd == NULL );
+
+    pxHeapRegion = &( pxHeapRegions[ 0 ] );
+
+    while( pxHeapRegion->xSizeInBytes > 0 )
+    {
+        configASSERT( uxNumberOfRegions < ( UBaseType_t ) configHEAP_MAX_REGIONS );
+
+        xTotalRegionSize = pxHeapRegion->xSizeInBytes;
+
+        /* Ensure the heap region starts on a correctly aligned boundary. */
+        uxAddress = ( portPOINTER_SIZE_TYPE ) pxHeapRegion->pucStartAddress;
+
+        if( ( uxAddress & portBYTE_ALIGNMENT_MASK ) != 0 )
+        {
+            uxAddress += ( portBYTE_ALIGNMENT - 1 );
+            uxAddress &= ~( ( portPOINTER_SIZE_TYPE ) portBYTE_ALIGNMENT_MASK );
+
+            /* Adjust the size for the bytes lost to alignment. */
+            xTotalRegionSize -= ( size_t ) ( uxAddress - ( portPOINTER_SIZE_TYPE ) pxHeapRegion->pucStartAddress );
+        }
+
+        configASSERT( xTotalRegionSize > ( xHeapStructSize + heapMINIMUM_BLOCK_SIZE ) );
+
+        uxAlignedHeap = uxAddress;
+
+        if( pxEnd == NULL )
+        {
+            /* xStart is used to hold a pointer to the first item in the list
+             * of free blocks.  The void cast is used to prevent compiler
+             * warnings. */
+            xStart.pxNextFreeBlock = ( BlockLink_t * ) uxAlignedHeap;
+            xStart.xBlockSize = ( size_t ) 0;
+        }
+        else
+        {
+            /* Check blocks are passed in with increasing start addresses. */
+            configASSERT( uxAddress > ( portPOINTER_SIZE_TYPE ) pxEnd );
+        }
+
+        /* Each region ends with a marker.  The marker of the last region is
+         * pxEnd, which ends the free list.  The others are not on the free
+         * list at all, they only keep blocks either side of a region boundary
+         * from being merged. */
+        uxAddress = uxAlignedHeap + xTotalRegionSize;
+        uxAddress -= xHeapStructSize;
+        uxAddress &= ~( ( portPOINTER_SIZE_TYPE ) portBYTE_ALIGNMENT_MASK );
+        pxEnd = ( BlockLink_t * ) uxAddress;
+        pxEnd->xBlockSize = 0;
+        pxEnd->pxNextFreeBlock = NULL;
+
+        /* To start with there is a single free block in the region that is
+         * sized to take up the entire region, minus the space taken by its
+         * marker. */
+        pxFirstFreeBlockInRegion = ( BlockLink_t * ) uxAlignedHeap;
+        pxFirstFreeBlockInRegion->xBlockSize = ( size_t ) ( uxAddress - uxAlignedHeap );
+        pxFirstFreeBlockInRegion->pxNextFreeBlock = pxEnd;
+
+        /* Link the free block of the previous region past its marker to the
+         * free block of this region. */
+        if( pxLastFreeBlock != NULL )
+        {
+            pxLastFreeBlock->pxNextFreeBlock = pxFirstFreeBlockInRegion;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        pxLastFreeBlock = pxFirstFreeBlockInRegion;
+
+        pxRegion = &( xRegions[ uxNumberOfRegions ] );
+        pxRegion->pucStart = ( uint8_t * ) pxFirstFreeBlockInRegion;
+        pxRegion->pucEnd = ( uint8_t * ) pxEnd;
+        pxRegion->uxAttributes = pxHeapRegion->uxAttributes;
+        pxRegion->xSizeInBytes = pxFirstFreeBlockInRegion->xBlockSize;
+        pxRegion->xFreeBytes = pxFirstFreeBlockInRegion->xBlockSize;
+        pxRegion->xMinimumEverFreeBytes = pxFirstFreeBlockInRegion->xBlockSize;
+        pxRegion->xNumberOfSuccessfulAllocations = 0;
+        pxRegion->xNumberOfSuccessfulFrees = 0;
+
+        if( pxRegion->uxAttributes == portHEAP_REGION_GENERAL )
+        {
+            xHaveGeneralRegion = pdTRUE;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        #if ( configUSE_HEAP_FRAGMENTATION_STATS == 1 )
+        {
+            prvFreeBlockAdded( pxFirstFreeBlockInRegion->xBlockSize );
+        }
+        #endif
+
+        xTotalHeapSize += pxFirstFreeBlockInRegion->xBlockSize;
+
+        /* Move onto the next HeapRegion_t structure. */
+        uxNumberOfRegions++;
+        pxHeapRegion = &( pxHeapRegions[ uxNumberOfRegions ] );
+    }
+
+    xMinimumEverFreeBytesRemaining = xTotalHeapSize;
+    xFreeBytesRemaining = xTotalHeapSize;
+
+    /* Check something was actually defined before it is accessed. */
+    configASSERT( xTotalHeapSize );
+}
+/*-----------------------------------------------------------*/
+
+static BlockLink_t * prvFindFreeBlock( size_t xWantedSize,
+                                       UBaseType_t uxMask,
+                                       UBaseType_t uxMatch,
+                                       BlockLink_t ** ppxPreviousBlock,
+                                       UBaseType_t * puxRegion ) /* PRIVILEGED_FUNCTION */
+{
+    BlockLink_t * pxPreviousBlock = &xStart;
+    BlockLink_t * pxBlock = xStart.pxNextFreeBlock;
+    UBaseType_t uxRegion = 0;
+
+    while( pxBlock != pxEnd )
+    {
+        /* The free list and the regions are both in address order, so the
+         * region only ever moves forward. */
+        while( ( uint8_t * ) pxBlock >= xRegions[ uxRegion ].pucEnd )
+        {
+            uxRegion++;
+        }
+
+        if( ( pxBlock->xBlockSize >= xWantedSize ) &&
+            ( ( xRegions[ uxRegion ].uxAttributes & uxMask ) == uxMatch ) )
+        {
+            break;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        pxPreviousBlock = pxBlock;
+        pxBlock = pxBlock->pxNextFreeBlock;
+    }
+
+    *ppxPreviousBlock = pxPreviousBlock;
+    *puxRegion = uxRegion;
+
+    return pxBlock;
+}
+/*-----------------------------------------------------------*/
+
+static UBaseType_t prvRegionOf( const BlockLink_t * pxBlock ) /* PRIVILEGED_FUNCTION */
+{
+    UBaseType_t uxRegion = 0;
+
+    while( ( uxRegion < ( uxNumberOfRegions - 1U ) ) && ( ( const uint8_t * ) pxBlock >= xRegions[ uxRegion ].pucEnd ) )
+    {
+        uxRegion++;
+    }
+
+    return uxRegion;
+}
+/*-----------------------------------------------------------*/
+
+UBaseType_t uxPortGetNumberOfHeapRegions( void )
+{
+    return uxNumberOfRegions;
+}
+/*-----------------------------------------------------------*/
+
+void vPortGetHeapRegionStats( UBaseType_t uxRegion,
+                              HeapRegionStats_t * pxRegionStats )
+{
+    const HeapRegionInfo_t * pxRegion;
+
+    configASSERT( uxRegion < uxNumberOfRegions );
+
+    pxRegion = &( xRegions[ uxRegion ] );
+
+    taskENTER_CRITICAL();
+    {
+        pxRegionStats->pucStartAddress = pxRegion->pucStart;
+        pxRegionStats->xSizeInBytes = pxRegion->xSizeInBytes;
+        pxRegionStats->uxAttributes = pxRegion->uxAttributes;
+        pxRegionStats->xAvailableBytes = pxRegion->xFreeBytes;
+        pxRegionStats->xMinimumEverAvailableBytes = pxRegion->xMinimumEverFreeBytes;
+        pxRegionStats->xNumberOfSuccessfulAllocations = pxRegion->xNumberOfSuccessfulAllocations;
+        pxRegionStats->xNumberOfSuccessfulFrees = pxRegion->xNumberOfSuccessfulFrees;
+    }
+    taskEXIT_CRITICAL();
+}
+/*-----------------------------------------------------------*/
+
+static void prvInsertBlockIntoFreeList( BlockLink_t * pxBlockToInsert ) /* PRIVILEGED_FUNCTION */
+{
+    BlockLink_t * pxIterator;
+    uint8_t * puc;
+
+    /* Iterate through the list until a block is found that has a higher address
+     * than the block being inserted. */
+    for( pxIterator = &xStart; pxIterator->pxNextFreeBlock < pxBlockToInsert; pxIterator = pxIterator->pxNextFreeBlock )
+    {
+        /* Nothing to do here, just iterate to the right position. */
+    }
+
+    /* Do the block being inserted, and the block it is being inserted after
+     * make a contiguous block of memory? */
+    puc = ( uint8_t * ) pxIterator;
+
+    if( ( puc + pxIterator->xBlockSize ) == ( uint8_t * ) pxBlockToInsert )
+    {
+        #if ( configUSE_HEAP_FRAGMENTATION_STATS == 1 )
+        {
+            /* The block in front grows, it is counted again below. */
+            prvFreeBlockRemoved( pxIterator->xBlockSize );
+        }
+        #endif
+
+        pxIterator->xBlockSize += pxBlockToInsert->xBlockSize;
+        pxBlockToInsert = pxIterator;
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    /* Do the block being inserted, and the block it is being inserted before
+     * make a contiguous block of memory? */
+    puc = ( uint8_t * ) pxBlockToInsert;
+
+    if( ( puc + pxBlockToInsert->xBlockSize ) == ( uint8_t * ) pxIterator->pxNextFreeBlock )
+    {
+        if( pxIterator->pxNextFreeBlock != pxEnd )
+        {
+            /* Form one big block from the two blocks. */
+            #if ( configUSE_HEAP_FRAGMENTATION_STATS == 1 )
+            {
+                prvFreeBlockRemoved( pxIterator->pxNextFreeBlock->xBlockSize );
+            }
+            #endif
+
+            pxBlockToInsert->xBlockSize += pxIterator->pxNextFreeBlock->xBlockSize;
+            pxBlockToInsert->pxNextFreeBlock = pxIterator->pxNextFreeBlock->pxNextFreeBlock;
+        }
+        else
+        {
+            pxBlockToInsert->pxNextFreeBlock = pxEnd;
+        }
+    }
+    else
+    {
+        pxBlockToInsert->pxNextFreeBlock = pxIterator->pxNextFreeBlock;
+    }
+
+    /* If the block being inserted plugged a gab, so was merged with the block
+     * before and the block after, then it's pxNextFreeBlock pointer will have
+     * already been set, and should not be set here as that would make it point
+     * to itself. */
+    if( pxIterator != pxBlockToInsert )
+    {
+        pxIterator->pxNextFreeBlock = pxBlockToInsert;
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    #if ( configUSE_HEAP_FRAGMENTATION_STATS == 1 )
+    {
+        prvFreeBlockAdded( pxBlockToInsert->xBlockSize );
+    }
+    #endif
+}
+/*-----------------------------------------------------------*/
+
+void vPortGetHeapStats( HeapStats_t * pxHeapStats )
+{
+    BlockLink_t * pxBlock;
+    size_t xBlocks = 0, xMaxSize = 0, xMinSize = portMAX_DELAY; /* portMAX_DELAY used as a portable way of getting the maximum value. */
+
+    vTaskSuspendAll();
+    {
+        pxBlock = xStart.pxNextFreeBlock;
+
+        /* pxBlock will be NULL if the heap has not been initialised.  The heap
+         * is initialised automatically when the first allocation is made. */
+        if( pxBlock != NULL )
+        {
+            while( pxBlock != pxEnd )
+            {
+                /* Increment the number of blocks and record the largest block seen
+                 * so far. */
+                xBlocks++;
+
+                if( pxBlock->xBlockSize > xMaxSize )
+                {
+                    xMaxSize = pxBlock->xBlockSize;
+                }
+
+                if( pxBlock->xBlockSize < xMinSize )
+                {
+                    xMinSize = pxBlock->xBlockSize;
+                }
+
+                /* Move to the next block in the chain until the last block is
+                 * reached. */
+                pxBlock = pxBlock->pxNextFreeBlock;
+            }
+        }
+    }
+    ( void ) xTaskResumeAll();
+
+    pxHeapStats->xSizeOfLargestFreeBlockInBytes = xMaxSize;
+    pxHeapStats->xSizeOfSmallestFreeBlockInBytes = xMinSize;
+    pxHeapStats->xNumberOfFreeBlocks = xBlocks;
+
+    taskENTER_CRITICAL();
+    {
+        pxHeapStats->xAvailableHeapSpaceInBytes = xFreeBytesRemaining;
+        pxHeapStats->xNumberOfSuccessfulAllocations = xNumberOfSuccessfulAllocations;
+        pxHeapStats->xNumberOfSuccessfulFrees = xNumberOfSuccessfulFrees;
+        pxHeapStats->xMinimumEverFreeBytesRemaining = xMinimumEverFreeBytesRemaining;
+    }
+    taskEXIT_CRITICAL();
+}
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_HEAP_FRAGMENTATION_STATS == 1 )
+
+    static void prvFreeBlockAdded( size_t xBlockSize ) /* PRIVILEGED_FUNCTION */
+    {
+        const UBaseType_t uxBin = portHEAP_FRAGMENTATION_BIN( xBlockSize );
+
+        xNumberOfFreeBlocks++;
+        xFreeBlocksBySize[ uxBin ]++;
+        uxNonEmptyBins |= ( ( UBaseType_t ) 1 ) << uxBin;
+
+        /* If the count of the entry's largest size has dropped to zero its
+         * blocks are all smaller than xLargestInBin[ uxBin ], so the entry is
+         * correct again once a block at least that large is added. */
+        if( xBlockSize > xLargestInBin[ uxBin ] )
+        {
+            xLargestInBin[ uxBin ] = xBlockSize;
+            xLargestInBinCount[ uxBin ] = 1;
+        }
+        else if( xBlockSize == xLargestInBin[ uxBin ] )
+        {
+            xLargestInBinCount[ uxBin ]++;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        if( xBlockSize > xLargestFreeBlock )
+        {
+            xLargestFreeBlock = xBlockSize;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvFreeBlockRemoved( size_t xBlockSize ) /* PRIVILEGED_FUNCTION */
+    {
+        const UBaseType_t uxBin = portHEAP_FRAGMENTATION_BIN( xBlockSize );
+
+        xNumberOfFreeBlocks--;
+        xFreeBlocksBySize[ uxBin ]--;
+
+        if( xFreeBlocksBySize[ uxBin ] == 0 )
+        {
+            uxNonEmptyBins &= ~( ( ( UBaseType_t ) 1 ) << uxBin );
+            xLargestInBin[ uxBin ] = 0;
+            xLargestInBinCount[ uxBin ] = 0;
+        }
+        else if( xBlockSize == xLargestInBin[ uxBin ] )
+        {
+            /* If this was the last block of the largest size in the entry the
+             * next largest is found by prvUpdateFragmentationStats(), unless
+             * a block as large is added first - as happens when blocks are
+             * split or merged. */
+            xLargestInBinCount[ uxBin ]--;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvUpdateFragmentationStats( void ) /* PRIVILEGED_FUNCTION */
+    {
+        BlockLink_t * pxBlock;
+        UBaseType_t uxBin;
+        size_t xPermille;
+
+        if( uxNonEmptyBins == 0 )
+        {
+            xLargestFreeBlock = 0;
+        }
+        else
+        {
+            uxBin = ( UBaseType_t ) ( portHEAP_FRAGMENTATION_BINS - 1 );
+
+            while( ( uxNonEmptyBins & ( ( ( UBaseType_t ) 1 ) << uxBin ) ) == 0 )
+            {
+                uxBin--;
+            }
+
+            if( xLargestInBinCount[ uxBin ] == 0 )
+            {
+                /* Only the blocks of this entry can be the largest. */
+                xLargestInBin[ uxBin ] = 0;
+
+                for( pxBlock = xStart.pxNextFreeBlock; pxBlock != pxEnd; pxBlock = pxBlock->pxNextFreeBlock )
+                {
+                    if( portHEAP_FRAGMENTATION_BIN( pxBlock->xBlockSize ) == uxBin )
+                    {
+                        if( pxBlock->xBlockSize > xLargestInBin[ uxBin ] )
+                        {
+                            xLargestInBin[ uxBin ] = pxBlock->xBlockSize;
+                            xLargestInBinCount[ uxBin ] = 1;
+                        }
+                        else if( pxBlock->xBlockSize == xLargestInBin[ uxBin ] )
+                        {
+                            xLargestInBinCount[ uxBin ]++;
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            xLargestFreeBlock = xLargestInBin[ uxBin ];
+        }
+
+        xPermille = prvFragmentationPermille();
+
+        if( xPermille > xMaximumFragmentationPermille )
+        {
+            xMaximumFragmentationPermille = xPermille;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    static size_t prvFragmentationPermille( void ) /* PRIVILEGED_FUNCTION */
+    {
+        size_t xFree = xFreeBytesRemaining;
+        size_t xLargest = xLargestFreeBlock;
+
+        if( xFree == 0 )
+        {
+            return 0;
+        }
+
+        /* Scale both down rather than overflow on very large heaps. */
+        while( xFree > ( heapSIZE_MAX / ( size_t ) 1000 ) )
+        {
+            xFree >>= 1;
+            xLargest >>= 1;
+        }
+
+        return ( ( xFree - xLargest ) * ( size_t ) 1000 ) / xFree;
+    }
+/*-----------------------------------------------------------*/
+
+    void vPortGetHeapFragmentationStats( HeapFragmentationStats_t * pxFragmentationStats )
+    {
+        UBaseType_t ux;
+
+        taskENTER_CRITICAL();
+        {
+            pxFragmentationStats->xAvailableHeapSpaceInBytes = xFreeBytesRemaining;
+            pxFragmentationStats->xSizeOfLargestFreeBlockInBytes = xLargestFreeBlock;
+            pxFragmentationStats->xNumberOfFreeBlocks = xNumberOfFreeBlocks;
+            pxFragmentationStats->xFragmentationPermille = prvFragmentationPermille();
+            pxFragmentationStats->xMaximumFragmentationPermille = xMaximumFragmentationPermille;
+
+            for( ux = 0; ux < ( UBaseType_t ) portHEAP_FRAGMENTATION_BINS; ux++ )
+            {
+                pxFragmentationStats->xFreeBlocksBySize[ ux ] = xFreeBlocksBySize[ ux ];
+            }
+        }
+        taskEXIT_CRITICAL();
+    }
+/*-----------------------------------------------------------*/
+
+#endif /* configUSE_HEAP_FRAGMENTATION_STATS */
+
+#if ( configUSE_HEAP_TRACKING == 1 )
+
+    static UBaseType_t prvGetOwnerSlot( void ) /* PRIVILEGED_FUNCTION */
+    {
+        TaskHandle_t xTask = NULL;
+        UBaseType_t ux, uxUnused = heapNO_OWNER, uxIdle = heapNO_OWNER;
+
+        /* Allocations made before the scheduler starts, when creating the
+         * first tasks and queues, are accounted to a NULL task. */
+        if( xTaskGetSchedulerState() != taskSCHEDULER_NOT_STARTED )
+        {
+            xTask = xTaskGetCurrentTaskHandle();
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        for( ux = 0; ux < ( UBaseType_t ) configHEAP_TRACKING_MAX_TASKS; ux++ )
+        {
+            if( xTaskUsage[ ux ].xNumberOfAllocations == 0 )
+            {
+                if( uxUnused == heapNO_OWNER )
+                {
+                    uxUnused = ux;
+                }
+            }
+            else if( xTaskUsage[ ux ].xTask == xTask )
+            {
+                return ux;
+            }
+            else if( ( xTaskUsage[ ux ].xLiveBytes == 0 ) && ( uxIdle == heapNO_OWNER ) )
+            {
+                /* Nothing the owner of this slot allocated is still live, so
+                 * the slot can be handed over if no unused slot is left. */
+                uxIdle = ux;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+
+        if( uxUnused == heapNO_OWNER )
+        {
+            uxUnused = uxIdle;
+        }
+
+        if( uxUnused != heapNO_OWNER )
+        {
+            ( void ) memset( &( xTaskUsage[ uxUnused ] ), 0x00, sizeof( HeapTaskUsage_t ) );
+            xTaskUsage[ uxUnused ].xTask = xTask;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return uxUnused;
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvTrackAllocation( HeapBlockTag_t * pxTag,
+                                    const void * pv,
+                                    size_t xBlockSize,
+                                    void * pvCaller ) /* PRIVILEGED_FUNCTION */
+    {
+        HeapTaskUsage_t * pxUsage;
+
+        pxTag->pvCaller = pvCaller;
+        pxTag->xTimeStamp = xTaskGetTickCount();
+        pxTag->uxOwner = prvGetOwnerSlot();
+
+        if( pxTag->uxOwner != heapNO_OWNER )
+        {
+            pxUsage = &( xTaskUsage[ pxTag->uxOwner ] );
+            pxUsage->xLiveBytes += xBlockSize;
+            pxUsage->xNumberOfAllocations++;
+
+            if( pxUsage->xLiveBytes > pxUsage->xPeakLiveBytes )
+            {
+                pxUsage->xPeakLiveBytes = pxUsage->xLiveBytes;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        #if ( configUSE_HEAP_TRACE == 1 )
+        {
+            prvTraceHeapEvent( portHEAP_TRACE_EVENT_MALLOC, pv, xBlockSize, pxTag->uxOwner, pvCaller );
+        }
+        #else
+        {
+            ( void ) pv;
+        }
+        #endif
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvTrackFree( const HeapBlockTag_t * pxTag,
+                              const void * pv,
+                              size_t xBlockSize,
+                              void * pvCaller ) /* PRIVILEGED_FUNCTION */
+    {
+        HeapTaskUsage_t * pxUsage;
+
+        /* The block is charged back to the task that allocated it, which is
+         * not always the task freeing it - the idle task frees the TCB and
+         * stack of deleted tasks, for example. */
+        if( pxTag->uxOwner != heapNO_OWNER )
+        {
+            pxUsage = &( xTaskUsage[ pxTag->uxOwner ] );
+            configASSERT( pxUsage->xLiveBytes >= xBlockSize );
+            pxUsage->xLiveBytes -= xBlockSize;
+            pxUsage->xNumberOfFrees++;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        #if ( configUSE_HEAP_TRACE == 1 )
+        {
+            prvTraceHeapEvent( portHEAP_TRACE_EVENT_FREE, pv, xBlockSize, pxTag->uxOwner, pvCaller );
+        }
+        #else
+        {
+            ( void ) pv;
+            ( void ) pvCaller;
+        }
+        #endif
+    }
+/*-----------------------------------------------------------*/
+
+    UBaseType_t uxPortGetHeapTaskUsage( HeapTaskUsage_t * const pxTaskUsageArray,
+                                        const UBaseType_t uxArraySize )
+    {
+        UBaseType_t ux, uxCount = uxArraySize;
+
+        if( uxCount > ( UBaseType_t ) configHEAP_TRACKING_MAX_TASKS )
+        {
+            uxCount = ( UBaseType_t ) configHEAP_TRACKING_MAX_TASKS;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        vTaskSuspendAll();
+        {
+            for( ux = 0; ux < uxCount; ux++ )
+            {
+                pxTaskUsageArray[ ux ] = xTaskUsage[ ux ];
+            }
+        }
+        ( void ) xTaskResumeAll();
+
+        return uxCount;
+    }
+/*-----------------------------------------------------------*/
+
+#endif /* configUSE_HEAP_TRACKING */
+
+#if ( configUSE_HEAP_TRACE == 1 )
+
+    static void prvTraceHeapEvent( uint8_t ucEvent,
+                                   const void * pv,
+                                   size_t xSize,
+                                   UBaseType_t uxOwner,
+                                   void * pvCaller ) /* PRIVILEGED_FUNCTION */
+    {
+        HeapTraceRecord_t xRecord;
+
+        #if ( configUSE_MONOTONIC_CLOCK == 1 )
+        {
+            xRecord.ulTimeStamp = ( uint32_t ) portCLOCK_NS_TO_US( ullPortGetClockNs() );
+        }
+        #else
+        {
+            xRecord.ulTimeStamp = ( uint32_t ) xTaskGetTickCount();
+        }
+        #endif
+        xRecord.ulAddress = ( uint32_t ) ( portPOINTER_SIZE_TYPE ) pv;
+        xRecord.ulCaller = ( uint32_t ) ( portPOINTER_SIZE_TYPE ) pvCaller;
+        xRecord.usBlockSize = ( xSize > 0xffffU ) ? ( uint16_t ) 0xffffU : ( uint16_t ) xSize;
+        xRecord.ucEvent = ucEvent;
+        xRecord.ucTask = ( uint8_t ) uxOwner;
+
+        vApplicationHeapTraceHook( &xRecord );
+    }
+/*-----------------------------------------------------------*/
+
+#endif /* configUSE_HEAP_TRACE */
@@ -0,0 +1,1250 @@
+/*
+ * FreeRTOS Kernel V10.5.1
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/*
+ * A sample implementation of pvPortMalloc() and vPortFree() that uses a two
+ * level segregated fit (TLSF) allocator, so that both run in constant time
+ * regardless of how many free blocks the heap holds.
+ *
+ * Free blocks are kept in segregated lists.  The first level splits sizes by
+ * power of two, the second level splits each power of two range linearly into
+ * ( 1 << configTLSF_SL_INDEX_COUNT_LOG2 ) classes.  A bitmap per level records
+ * which lists are not empty, so a list holding a large enough block is found
+ * with two count-leading/trailing-zero operations instead of a walk.  Every
+ * block records the block physically before it, so freed blocks are merged
+ * with their neighbours in constant time too.
+ *
+ * Allocations are rounded up to the next size class before the search so any
+ * block in the list found is large enough ("good fit").  That wastes at most
+ * 1 / ( 1 << configTLSF_SL_INDEX_COUNT_LOG2 ) of the requested size.  If no
+ * class above the request holds a block, the class the request itself falls
+ * into is searched as well, so requests close to the size of the largest free
+ * block do not fail where heap_4.c would succeed.
+ *
+ * Select it in place of heap_4.c with "make HEAP=heap_tlsf".
+ *
+ * See heap_1.c, heap_2.c, heap_3.c, heap_4.c and heap_5.c for alternative
+ * implementations, and the memory management pages of https://www.FreeRTOS.org
+ * for more information.
+ */
+#include <stdlib.h>
+#include <string.h>
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+ * all the API functions to use the MPU wrappers.  That should only be done when
+ * task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+#if ( configSUPPORT_DYNAMIC_ALLOCATION == 0 )
+    #error This file must not be used if configSUPPORT_DYNAMIC_ALLOCATION is 0
+#endif
+
+#ifndef configHEAP_CLEAR_MEMORY_ON_FREE
+    #define configHEAP_CLEAR_MEMORY_ON_FREE    0
+#endif
+
+/* Log2 of the number of second level classes per power of two.  Higher values
+ * waste less memory per allocation but need more list heads. */
+#ifndef configTLSF_SL_INDEX_COUNT_LOG2
+    #define configTLSF_SL_INDEX_COUNT_LOG2    3
+#endif
+
+/* Blocks, and so the heap, must be smaller than ( 1 << configTLSF_FL_INDEX_MAX )
+ * bytes.  Every first level index costs ( 1 << configTLSF_SL_INDEX_COUNT_LOG2 )
+ * list heads, so keep this no larger than the heap needs. */
+#ifndef configTLSF_FL_INDEX_MAX
+    #define configTLSF_FL_INDEX_MAX    15
+#endif
+
+#if ( portBYTE_ALIGNMENT == 32 )
+    #define heapALIGNMENT_LOG2    5
+#elif ( portBYTE_ALIGNMENT == 16 )
+    #define heapALIGNMENT_LOG2    4
+#elif ( portBYTE_ALIGNMENT == 8 )
+    #define heapALIGNMENT_LOG2    3
+#elif ( portBYTE_ALIGNMENT == 4 )
+    #define heapALIGNMENT_LOG2    2
+#else
+    #error heap_tlsf.c does not support this portBYTE_ALIGNMENT
+#endif
+
+/* Sizes below heapSMALL_BLOCK_SIZE all go into first level list 0, split
+ * linearly into second level lists portBYTE_ALIGNMENT bytes apart. */
+#define heapSL_INDEX_COUNT        ( 1U << configTLSF_SL_INDEX_COUNT_LOG2 )
+#define heapFL_INDEX_SHIFT        ( configTLSF_SL_INDEX_COUNT_LOG2 + heapALIGNMENT_LOG2 )
+#define heapFL_INDEX_COUNT        ( configTLSF_FL_INDEX_MAX - heapFL_INDEX_SHIFT + 1 )
+#define heapSMALL_BLOCK_SIZE      ( ( size_t ) 1 << heapFL_INDEX_SHIFT )
+#define heapMAXIMUM_BLOCK_SIZE    ( ( ( size_t ) 1 << configTLSF_FL_INDEX_MAX ) - portBYTE_ALIGNMENT )
+
+#if ( heapFL_INDEX_COUNT > 32 ) || ( heapFL_INDEX_COUNT < 1 ) || ( heapSL_INDEX_COUNT > 32 )
+    #error configTLSF_FL_INDEX_MAX or configTLSF_SL_INDEX_COUNT_LOG2 is out of range
+#endif
+
+/* Block sizes must not get too small - a free block must hold the free list
+ * links as well as the header. */
+#define heapMINIMUM_BLOCK_SIZE    ( ( size_t ) ( xHeapStructSize << 1 ) )
+
+/* Assumes 8bit bytes! */
+#define heapBITS_PER_BYTE         ( ( size_t ) 8 )
+
+/* Max value that fits in a size_t type. */
+#define heapSIZE_MAX              ( ~( ( size_t ) 0 ) )
+
+/* Check if multiplying a and b will result in overflow. */
+#define heapMULTIPLY_WILL_OVERFLOW( a, b )    ( ( ( a ) > 0 ) && ( ( b ) > ( heapSIZE_MAX / ( a ) ) ) )
+
+/* Check if adding a and b will result in overflow. */
+#define heapADD_WILL_OVERFLOW( a, b )         ( ( a ) > ( heapSIZE_MAX - ( b ) ) )
+
+/* MSB of the xBlockSize member of a TlsfBlock_t structure is used to track
+ * the allocation status of a block, as in heap_4.c. */
+#define heapBLOCK_ALLOCATED_BITMASK    ( ( ( size_t ) 1 ) << ( ( sizeof( size_t ) * heapBITS_PER_BYTE ) - 1 ) )
+#define heapBLOCK_SIZE_IS_VALID( xBlockSize )    ( ( ( xBlockSize ) & heapBLOCK_ALLOCATED_BITMASK ) == 0 )
+#define heapBLOCK_IS_ALLOCATED( pxBlock )        ( ( ( pxBlock->xBlockSize ) & heapBLOCK_ALLOCATED_BITMASK ) != 0 )
+#define heapALLOCATE_BLOCK( pxBlock )            ( ( pxBlock->xBlockSize ) |= heapBLOCK_ALLOCATED_BITMASK )
+#define heapFREE_BLOCK( pxBlock )                ( ( pxBlock->xBlockSize ) &= ~heapBLOCK_ALLOCATED_BITMASK )
+#define heapBLOCK_SIZE( pxBlock )                ( ( pxBlock->xBlockSize ) & ~heapBLOCK_ALLOCATED_BITMASK )
+
+/* The block that physically follows pxBlock in the heap. */
+#define heapNEXT_PHYSICAL_BLOCK( pxBlock )       ( ( TlsfBlock_t * ) ( void * ) ( ( ( uint8_t * ) ( pxBlock ) ) + heapBLOCK_SIZE( pxBlock ) ) )
+
+/* Find last set and find first set bit, both of a non zero value. */
+#if defined( __GNUC__ )
+    #define heapFLS( x )    ( ( UBaseType_t ) ( 31 - __builtin_clz( ( unsigned int ) ( x ) ) ) )
+    #define heapFFS( x )    ( ( UBaseType_t ) __builtin_ctz( ( unsigned int ) ( x ) ) )
+#else
+    #define heapFLS( x )    prvFls( ( uint32_t ) ( x ) )
+    #define heapFFS( x )    prvFls( ( uint32_t ) ( x ) & ( ~( uint32_t ) ( x ) + 1U ) )
+#endif
+
+#if ( configUSE_HEAP_TRACKING == 1 )
+    #if ( configHEAP_TRACKING_MAX_TASKS < 1 ) || ( configHEAP_TRACKING_MAX_TASKS > 254 )
+        #error configHEAP_TRACKING_MAX_TASKS must be between 1 and 254
+    #endif
+
+    #if ( INCLUDE_xTaskGetSchedulerState == 0 ) && ( configUSE_TIMERS == 0 )
+        #error configUSE_HEAP_TRACKING requires INCLUDE_xTaskGetSchedulerState to be set to 1
+    #endif
+
+/* The owner recorded in blocks that could not be given an accounting slot. */
+    #define heapNO_OWNER    ( ( UBaseType_t ) portHEAP_TRACE_NO_TASK )
+
+/* The address the allocating or freeing call returns to.  It must be taken in
+ * pvPortMalloc() and vPortFree() themselves, not in a helper. */
+    #ifdef __GNUC__
+        #define heapCALLER_ADDRESS()    __builtin_return_address( 0 )
+    #else
+        #define heapCALLER_ADDRESS()    NULL
+    #endif
+#endif /* configUSE_HEAP_TRACKING */
+
+/*-----------------------------------------------------------*/
+
+/* Allocate the memory for the heap. */
+#if ( configAPPLICATION_ALLOCATED_HEAP == 1 )
+
+/* The application writer has already defined the array used for the RTOS
+* heap - probably so it can be placed in a special segment or address. */
+    extern uint8_t ucHeap[ configTOTAL_HEAP_SIZE ];
+#else
+    PRIVILEGED_DATA static uint8_t ucHeap[ configTOTAL_HEAP_SIZE ];
+#endif /* configAPPLICATION_ALLOCATED_HEAP */
+
+/* The header at the start of every block.  The free list links are only
+ * present in free blocks - in allocated blocks that space is returned to the
+ * application. */
+typedef struct A_TLSF_BLOCK
+{
+    struct A_TLSF_BLOCK * pxPrevPhysBlock; /*<< The block physically before this one, NULL for the first block. */
+    size_t xBlockSize;                     /*<< The size of the block, including this header. */
+
+    #if ( configUSE_HEAP_TRACKING == 1 )
+        HeapBlockTag_t xTag; /*<< The owner, call-site and time of an allocated block. */
+    #endif
+
+    struct A_TLSF_BLOCK * pxNextFreeBlock; /*<< The next block in the same free list. */
+    struct A_TLSF_BLOCK * pxPrevFreeBlock; /*<< The previous block in the same free list. */
+} TlsfBlock_t;
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Called automatically to setup the required heap structures the first time
+ * pvPortMalloc() is called.
+ */
+static void prvHeapInit( void ) PRIVILEGED_FUNCTION;
+
+/*
+ * Find the first and second level indexes of the list a free block of xSize
+ * bytes is kept in.
+ */
+static void prvMappingInsert( size_t xSize,
+                              UBaseType_t * puxFl,
+                              UBaseType_t * puxSl ) PRIVILEGED_FUNCTION;
+
+/*
+ * Find a free block of at least xSize bytes, or NULL if there is none.  The
+ * block is not removed from its free list.
+ */
+static TlsfBlock_t * prvFindSuitableBlock( size_t xSize ) PRIVILEGED_FUNCTION;
+
+/*
+ * Add a free block to, or remove it from, the free list for its size.
+ */
+static void prvInsertFreeBlock( TlsfBlock_t * pxBlock ) PRIVILEGED_FUNCTION;
+static void prvRemoveFreeBlock( TlsfBlock_t * pxBlock ) PRIVILEGED_FUNCTION;
+
+#if !defined( __GNUC__ )
+    static UBaseType_t prvFls( uint32_t ulValue ) PRIVILEGED_FUNCTION;
+#endif
+
+#if ( configUSE_HEAP_TRACKING == 1 )
+
+/*
+ * Tag a block of xBlockSize bytes that is being allocated at pv with its owner,
+ * call-site and time, and add it to the owner's live bytes.  pxTag is in the
+ * block header for heap blocks and kept by the pool for pool blocks.  Called
+ * with the scheduler suspended.
+ */
+    static void prvTrackAllocation( HeapBlockTag_t * pxTag,
+                                    const void * pv,
+                                    size_t xBlockSize,
+                                    void * pvCaller ) PRIVILEGED_FUNCTION;
+
+/*
+ * Remove a block that is being freed from its owner's live bytes.  Called with
+ * the scheduler suspended.
+ */
+    static void prvTrackFree( const HeapBlockTag_t * pxTag,
+                              const void * pv,
+                              size_t xBlockSize,
+                              void * pvCaller ) PRIVILEGED_FUNCTION;
+
+/*
+ * Return the accounting slot of the calling task, claiming a slot if the task
+ * does not have one yet.
+ */
+    static UBaseType_t prvGetOwnerSlot( void ) PRIVILEGED_FUNCTION;
+
+#endif /* configUSE_HEAP_TRACKING */
+
+#if ( configUSE_HEAP_TRACE == 1 )
+
+/*
+ * Build a trace record and pass it to vApplicationHeapTraceHook().
+ */
+    static void prvTraceHeapEvent( uint8_t ucEvent,
+                                   const void * pv,
+                                   size_t xSize,
+                                   UBaseType_t uxOwner,
+                                   void * pvCaller ) PRIVILEGED_FUNCTION;
+
+#endif /* configUSE_HEAP_TRACE */
+
+/*-----------------------------------------------------------*/
+
+/* The size of the block header that precedes each allocation - the free list
+ * links are not part of it. */
+static const size_t xHeapStructSize = ( offsetof( TlsfBlock_t, pxNextFreeBlock ) + ( ( size_t ) ( portBYTE_ALIGNMENT - 1 ) ) ) & ~( ( size_t ) portBYTE_ALIGNMENT_MASK );
+
+/* The free lists and the bitmaps recording which of them are not empty.  Bit n
+ * of uxFlBitmap is set when any bit of uxSlBitmap[ n ] is set. */
+PRIVILEGED_DATA static TlsfBlock_t * pxFreeLists[ heapFL_INDEX_COUNT ][ heapSL_INDEX_COUNT ];
+PRIVILEGED_DATA static uint32_t ulFlBitmap = 0U;
+PRIVILEGED_DATA static uint32_t ulSlBitmap[ heapFL_INDEX_COUNT ];
+
+/* Marks the end of the heap.  It is permanently allocated so the last real
+ * block is never merged past it. */
+PRIVILEGED_DATA static TlsfBlock_t * pxEnd = NULL;
+
+/* Keeps track of the number of calls to allocate and free memory as well as the
+ * number of free bytes remaining, but says nothing about fragmentation. */
+PRIVILEGED_DATA static size_t xFreeBytesRemaining = 0U;
+PRIVILEGED_DATA static size_t xMinimumEverFreeBytesRemaining = 0U;
+PRIVILEGED_DATA static size_t xNumberOfSuccessfulAllocations = 0;
+PRIVILEGED_DATA static size_t xNumberOfSuccessfulFrees = 0;
+PRIVILEGED_DATA static size_t xNumberOfFreeBlocks = 0;
+
+#if ( configUSE_HEAP_FRAGMENTATION_STATS == 1 )
+    PRIVILEGED_DATA static size_t xFreeBlocksBySize[ portHEAP_FRAGMENTATION_BINS ];
+    PRIVILEGED_DATA static size_t xMaximumFragmentationPermille = 0;
+#endif
+
+#if ( configUSE_HEAP_TRACKING == 1 )
+
+/* Live and peak bytes per allocating task.  A slot is claimed by a task the
+ * first time it allocates, and only handed to another task once every block
+ * the previous owner allocated has been freed. */
+    PRIVILEGED_DATA static HeapTaskUsage_t xTaskUsage[ configHEAP_TRACKING_MAX_TASKS ];
+#endif
+
+/*-----------------------------------------------------------*/
+
+void * pvPortMalloc( size_t xWantedSize )
+{
+    TlsfBlock_t * pxBlock;
+    TlsfBlock_t * pxNewBlock;
+    void * pvReturn = NULL;
+    size_t xAdditionalRequiredSize;
+
+    #if ( configUSE_HEAP_TRACKING == 1 )
+        void * pvCaller = heapCALLER_ADDRESS();
+    #endif
+
+    #if ( configUSE_HEAP_TRACKING == 1 ) && ( configUSE_BLOCK_POOLS == 1 )
+        HeapBlockTag_t * pxTag;
+        size_t xPoolBlockSize;
+    #endif
+
+    #if ( configUSE_HEAP_TRACE == 1 )
+        size_t xRequestedSize = xWantedSize;
+    #endif
+
+    #if ( configUSE_BLOCK_POOLS == 1 )
+    {
+        /* Small requests are served from the fixed size block pools when
+         * they have a free block, see block_pools.c. */
+        pvReturn = pvPortBlockPoolAlloc( xWantedSize );
+
+        if( pvReturn != NULL )
+        {
+            traceMALLOC( pvReturn, xWantedSize );
+
+            #if ( configUSE_HEAP_TRACKING == 1 )
+            {
+                /* Pool blocks have no header, the pool keeps their tags. */
+                vTaskSuspendAll();
+                {
+                    pxTag = pxPortBlockPoolGetTag( pvReturn, &xPoolBlockSize );
+                    configASSERT( pxTag );
+                    prvTrackAllocation( pxTag, pvReturn, xPoolBlockSize, pvCaller );
+                }
+                ( void ) xTaskResumeAll();
+            }
+            #endif
+
+            return pvReturn;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+    #endif /* configUSE_BLOCK_POOLS */
+
+    vTaskSuspendAll();
+    {
+        /* If this is the first call to malloc then the heap will require
+         * initialisation to setup the list of free blocks. */
+        if( pxEnd == NULL )
+        {
+            prvHeapInit();
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        if( xWantedSize > 0 )
+        {
+            /* The wanted size must be increased so it can contain the block
+             * header in addition to the requested amount of bytes. Some
+             * additional increment may also be needed for alignment. */
+            xAdditionalRequiredSize = xHeapStructSize + portBYTE_ALIGNMENT - ( xWantedSize & portBYTE_ALIGNMENT_MASK );
+
+            if( heapADD_WILL_OVERFLOW( xWantedSize, xAdditionalRequiredSize ) == 0 )
+            {
+                xWantedSize += xAdditionalRequiredSize;
+
+                /* A block must be able to hold the free list links once it is
+                 * freed again. */
+                if( xWantedSize < heapMINIMUM_BLOCK_SIZE )
+                {
+                    xWantedSize = heapMINIMUM_BLOCK_SIZE;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else
+            {
+                xWantedSize = 0;
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        if( ( xWantedSize > 0 ) && ( xWantedSize <= heapMAXIMUM_BLOCK_SIZE ) && ( xWantedSize <= xFreeBytesRemaining ) )
+        {
+            pxBlock = prvFindSuitableBlock( xWantedSize );
+
+            if( pxBlock != NULL )
+            {
+                /* This block is being returned for use so must be taken out
+                 * of the list of free blocks. */
+                prvRemoveFreeBlock( pxBlock );
+
+                /* If the block is larger than required it can be split into
+                 * two. */
+                if( ( pxBlock->xBlockSize - xWantedSize ) >= heapMINIMUM_BLOCK_SIZE )
+                {
+                    /* The void cast is used to prevent byte alignment warnings
+                     * from the compiler. */
+                    pxNewBlock = ( void * ) ( ( ( uint8_t * ) pxBlock ) + xWantedSize );
+                    configASSERT( ( ( ( size_t ) pxNewBlock ) & portBYTE_ALIGNMENT_MASK ) == 0 );
+
+                    pxNewBlock->xBlockSize = pxBlock->xBlockSize - xWantedSize;
+                    pxNewBlock->pxPrevPhysBlock = pxBlock;
+                    pxBlock->xBlockSize = xWantedSize;
+                    heapNEXT_PHYSICAL_BLOCK( pxNewBlock )->pxPrevPhysBlock = pxNewBlock;
+
+                    prvInsertFreeBlock( pxNewBlock );
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                xFreeBytesRemaining -= pxBlock->xBlockSize;
+
+                if( xFreeBytesRemaining < xMinimumEverFreeBytesRemaining )
+                {
+                    xMinimumEverFreeBytesRemaining = xFreeBytesRemaining;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                /* The block is being returned - it is allocated and owned by
+                 * the application.  Return the memory space following the
+                 * header. */
+                heapALLOCATE_BLOCK( pxBlock );
+                pvReturn = ( void * ) ( ( ( uint8_t * ) pxBlock ) + xHeapStructSize );
+                xNumberOfSuccessfulAllocations++;
+
+                #if ( configUSE_HEAP_TRACKING == 1 )
+                {
+                    prvTrackAllocation( &( pxBlock->xTag ), pvReturn, heapBLOCK_SIZE( pxBlock ), pvCaller );
+                }
+                #endif
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        #if ( configUSE_HEAP_TRACE == 1 )
+        {
+            if( pvReturn == NULL )
+            {
+                prvTraceHeapEvent( portHEAP_TRACE_EVENT_MALLOC_FAILED, NULL, xRequestedSize, heapNO_OWNER, pvCaller );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        #endif /* configUSE_HEAP_TRACE */
+
+        traceMALLOC( pvReturn, xWantedSize );
+    }
+    ( void ) xTaskResumeAll();
+
+    #if ( configUSE_MALLOC_FAILED_HOOK == 1 )
+    {
+        if( pvReturn == NULL )
+        {
+            vApplicationMallocFailedHook();
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+    #endif /* if ( configUSE_MALLOC_FAILED_HOOK == 1 ) */
+
+    configASSERT( ( ( ( size_t ) pvReturn ) & ( size_t ) portBYTE_ALIGNMENT_MASK ) == 0 );
+    return pvReturn;
+}
+/*-----------------------------------------------------------*/
+
+void vPortFree( void * pv )
+{
+    uint8_t * puc = ( uint8_t * ) pv;
+    TlsfBlock_t * pxBlock;
+    TlsfBlock_t * pxNeighbour;
+
+    #if ( configUSE_HEAP_TRACKING == 1 )
+        void * pvCaller = heapCALLER_ADDRESS();
+    #endif
+
+    #if ( configUSE_HEAP_TRACKING == 1 ) && ( configUSE_BLOCK_POOLS == 1 )
+        HeapBlockTag_t * pxTag;
+        size_t xPoolBlockSize;
+    #endif
+
+    #if ( configUSE_BLOCK_POOLS == 1 )
+    {
+        #if ( configUSE_HEAP_TRACKING == 1 )
+        {
+            /* The tag of a pool block must be read before the block goes back
+             * to the pool, where it can be handed out again at once. */
+            pxTag = pxPortBlockPoolGetTag( pv, &xPoolBlockSize );
+
+            if( pxTag != NULL )
+            {
+                vTaskSuspendAll();
+                {
+                    prvTrackFree( pxTag, pv, xPoolBlockSize, pvCaller );
+                }
+                ( void ) xTaskResumeAll();
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        #endif
+
+        if( xPortBlockPoolFree( pv ) != pdFALSE )
+        {
+            traceFREE( pv, 0 );
+            return;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+    #endif /* configUSE_BLOCK_POOLS */
+
+    if( pv != NULL )
+    {
+        /* The memory being freed will have a block header immediately before
+         * it. */
+        puc -= xHeapStructSize;
+
+        /* This casting is to keep the compiler from issuing warnings. */
+        pxBlock = ( void * ) puc;
+
+        configASSERT( heapBLOCK_IS_ALLOCATED( pxBlock ) != 0 );
+
+        if( heapBLOCK_IS_ALLOCATED( pxBlock ) != 0 )
+        {
+            /* The block is being returned to the heap - it is no longer
+             * allocated. */
+            heapFREE_BLOCK( pxBlock );
+            #if ( configHEAP_CLEAR_MEMORY_ON_FREE == 1 )
+            {
+                ( void ) memset( puc + xHeapStructSize, 0, pxBlock->xBlockSize - xHeapStructSize );
+            }
+            #endif
+
+            vTaskSuspendAll();
+            {
+                xFreeBytesRemaining += pxBlock->xBlockSize;
+                traceFREE( pv, pxBlock->xBlockSize );
+
+                #if ( configUSE_HEAP_TRACKING == 1 )
+                {
+                    prvTrackFree( &( pxBlock->xTag ), pv, pxBlock->xBlockSize, pvCaller );
+                }
+                #endif
+
+                /* Merge with the block before, if it is free. */
+                pxNeighbour = pxBlock->pxPrevPhysBlock;
+
+                if( ( pxNeighbour != NULL ) && ( heapBLOCK_IS_ALLOCATED( pxNeighbour ) == 0 ) )
+                {
+                    prvRemoveFreeBlock( pxNeighbour );
+                    pxNeighbour->xBlockSize += pxBlock->xBlockSize;
+                    pxBlock = pxNeighbour;
+                    heapNEXT_PHYSICAL_BLOCK( pxBlock )->pxPrevPhysBlock = pxBlock;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                /* Merge with the block after, if it is free.  pxEnd is always
+                 * allocated so is never merged. */
+                pxNeighbour = heapNEXT_PHYSICAL_BLOCK( pxBlock );
+
+                if( heapBLOCK_IS_ALLOCATED( pxNeighbour ) == 0 )
+                {
+                    prvRemoveFreeBlock( pxNeighbour );
+                    pxBlock->xBlockSize += pxNeighbour->xBlockSize;
+                    heapNEXT_PHYSICAL_BLOCK( pxBlock )->pxPrevPhysBlock = pxBlock;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                prvInsertFreeBlock( pxBlock );
+                xNumberOfSuccessfulFrees++;
+            }
+            ( void ) xTaskResumeAll();
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+}
+/*-----------------------------------------------------------*/
+
+size_t xPortGetFreeHeapSize( void )
+{
+    return xFreeBytesRemaining;
+}
+/*-----------------------------------------------------------*/
+
+size_t xPortGetMinimumEverFreeHeapSize( void )
+{
+    return xMinimumEverFreeBytesRemaining;
+}
+/*-----------------------------------------------------------*/
+
+void vPortInitialiseBlocks( void )
+{
+    /* This just exists to keep the linker quiet. */
+}
+/*-----------------------------------------------------------*/
+
+void * pvPortCalloc( size_t xNum,
+                     size_t xSize )
+{
+    void * pv = NULL;
+
+    if( heapMULTIPLY_WILL_OVERFLOW( xNum, xSize ) == 0 )
+    {
+        pv = pvPortMalloc( xNum * xSize );
+
+        if( pv != NULL )
+        {
+            ( void ) memset( pv, 0, xNum * xSize );
+        }
+    }
+
+    return pv;
+}
+/*-----------------------------------------------------------*/
+
+static void prvHeapInit( void ) /* PRIVILEGED_FUNCTION */
+{
+    TlsfBlock_t * pxFirstFreeBlock;
+    uint8_t * pucAlignedHeap;
+    portPOINTER_SIZE_TYPE uxAddress;
+    size_t xTotalHeapSize = configTOTAL_HEAP_SIZE;
+
+    /* Ensure the heap starts on a correctly aligned boundary. */
+    uxAddress = ( portPOINTER_SIZE_TYPE ) ucHeap;
+
+    if( ( uxAddress & portBYTE_ALIGNMENT_MASK ) != 0 )
+    {
+        uxAddress += ( portBYTE_ALIGNMENT - 1 );
+        uxAddress &= ~( ( portPOINTER_SIZE_TYPE ) portBYTE_ALIGNMENT_MASK );
+        xTotalHeapSize -= uxAddress - ( portPOINTER_SIZE_TYPE ) ucHeap;
+    }
+
+    pucAlignedHeap = ( uint8_t * ) uxAddress;
+
+    /* pxEnd is used to mark the end of the heap.  It is a header only block at
+     * the end of the heap space that is never freed. */
+    uxAddress = ( ( portPOINTER_SIZE_TYPE ) pucAlignedHeap ) + xTotalHeapSize;
+    uxAddress -= xHeapStructSize;
+    uxAddress &= ~( ( portPOINTER_SIZE_TYPE ) portBYTE_ALIGNMENT_MASK );
+
+    /* A heap larger than the largest block the lists can hold is only used up
+     * to that size - raise configTLSF_FL_INDEX_MAX to use all of it. */
+    configASSERT( ( uxAddress - ( portPOINTER_SIZE_TYPE ) pucAlignedHeap ) <= heapMAXIMUM_BLOCK_SIZE );
+
+    if( ( uxAddress - ( portPOINTER_SIZE_TYPE ) pucAlignedHeap ) > heapMAXIMUM_BLOCK_SIZE )
+    {
+        uxAddress = ( portPOINTER_SIZE_TYPE ) pucAlignedHeap + heapMAXIMUM_BLOCK_SIZE;
+    }
+
+    /* To start with there is a single free block that is sized to take up the
+     * entire heap space, minus the space taken by pxEnd. */
+    pxFirstFreeBlock = ( TlsfBlock_t * ) pucAlignedHeap;
+    pxFirstFreeBlock->xBlockSize = ( size_t ) ( uxAddress - ( portPOINTER_SIZE_TYPE ) pxFirstFreeBlock );
+    pxFirstFreeBlock->pxPrevPhysBlock = NULL;
+
+    pxEnd = ( TlsfBlock_t * ) uxAddress;
+    pxEnd->xBlockSize = 0;
+    pxEnd->pxPrevPhysBlock = pxFirstFreeBlock;
+    heapALLOCATE_BLOCK( pxEnd );
+
+    prvInsertFreeBlock( pxFirstFreeBlock );
+
+    /* Only one block exists - and it covers the entire usable heap space. */
+    xMinimumEverFreeBytesRemaining = pxFirstFreeBlock->xBlockSize;
+    xFreeBytesRemaining = pxFirstFreeBlock->xBlockSize;
+}
+/*-----------------------------------------------------------*/
+
+static void prvMappingInsert( size_t xSize,
+                              UBaseType_t * puxFl,
+                              UBaseType_t * puxSl ) /* PRIVILEGED_FUNCTION */
+{
+    UBaseType_t uxFls;
+
+    if( xSize < heapSMALL_BLOCK_SIZE )
+    {
+        /* Small blocks are spread linearly over the first list. */
+        *puxFl = 0;
+        *puxSl = ( UBaseType_t ) ( xSize >> heapALIGNMENT_LOG2 );
+    }
+    else
+    {
+        /* The first level is the power of two below xSize, the second level
+         * the configTLSF_SL_INDEX_COUNT_LOG2 bits that follow the top bit. */
+        uxFls = heapFLS( xSize );
+        *puxSl = ( UBaseType_t ) ( xSize >> ( uxFls - configTLSF_SL_INDEX_COUNT_LOG2 ) ) ^ heapSL_INDEX_COUNT;
+        *puxFl = uxFls - ( heapFL_INDEX_SHIFT - 1 );
+    }
+}
+/*-----------------------------------------------------------*/
+
+static TlsfBlock_t * prvFindSuitableBlock( size_t xSize ) /* PRIVILEGED_FUNCTION */
+{
+    TlsfBlock_t * pxBlock = NULL;
+    UBaseType_t uxFl, uxSl, uxSearchFl, uxSearchSl;
+    uint32_t ulMap;
+    size_t xRoundedSize = xSize;
+
+    /* Round the request up to the next class boundary, so every block in the
+     * class that is found is large enough. */
+    if( xSize >= heapSMALL_BLOCK_SIZE )
+    {
+        xRoundedSize += ( ( size_t ) 1 << ( heapFLS( xSize ) - configTLSF_SL_INDEX_COUNT_LOG2 ) ) - 1;
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    prvMappingInsert( xSize, &uxFl, &uxSl );
+
+    if( xRoundedSize <= heapMAXIMUM_BLOCK_SIZE )
+    {
+        prvMappingInsert( xRoundedSize, &uxSearchFl, &uxSearchSl );
+
+        /* First look for a non empty list in the same first level list, at or
+         * above the rounded second level index. */
+        ulMap = ulSlBitmap[ uxSearchFl ] & ( ~( uint32_t ) 0U << uxSearchSl );
+
+        if( ulMap == 0U )
+        {
+            /* Then in the first non empty first level list above it. */
+            if( ( uxSearchFl + 1U ) < 32U )
+            {
+                ulMap = ulFlBitmap & ( ~( uint32_t ) 0U << ( uxSearchFl + 1U ) );
+            }
+
+            if( ulMap != 0U )
+            {
+                uxSearchFl = heapFFS( ulMap );
+                ulMap = ulSlBitmap[ uxSearchFl ];
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        if( ulMap != 0U )
+        {
+            pxBlock = pxFreeLists[ uxSearchFl ][ heapFFS( ulMap ) ];
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    if( pxBlock == NULL )
+    {
+        /* Only blocks in the class of the request itself are left, some of
+         * which may still be large enough. */
+        for( pxBlock = pxFreeLists[ uxFl ][ uxSl ]; pxBlock != NULL; pxBlock = pxBlock->pxNextFreeBlock )
+        {
+            if( pxBlock->xBlockSize >= xSize )
+            {
+                break;
+            }
+        }
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    return pxBlock;
+}
+/*-----------------------------------------------------------*/
+
+static void prvInsertFreeBlock( TlsfBlock_t * pxBlock ) /* PRIVILEGED_FUNCTION */
+{
+    UBaseType_t uxFl, uxSl;
+    TlsfBlock_t * pxHead;
+
+    prvMappingInsert( pxBlock->xBlockSize, &uxFl, &uxSl );
+
+    pxHead = pxFreeLists[ uxFl ][ uxSl ];
+    pxBlock->pxNextFreeBlock = pxHead;
+    pxBlock->pxPrevFreeBlock = NULL;
+
+    if( pxHead != NULL )
+    {
+        pxHead->pxPrevFreeBlock = pxBlock;
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    pxFreeLists[ uxFl ][ uxSl ] = pxBlock;
+    ulFlBitmap |= ( uint32_t ) 1U << uxFl;
+    ulSlBitmap[ uxFl ] |= ( uint32_t ) 1U << uxSl;
+    xNumberOfFreeBlocks++;
+
+    #if ( configUSE_HEAP_FRAGMENTATION_STATS == 1 )
+    {
+        xFreeBlocksBySize[ portHEAP_FRAGMENTATION_BIN( pxBlock->xBlockSize ) ]++;
+    }
+    #endif
+}
+/*-----------------------------------------------------------*/
+
+static void prvRemoveFreeBlock( TlsfBlock_t * pxBlock ) /* PRIVILEGED_FUNCTION */
+{
+    UBaseType_t uxFl, uxSl;
+
+    prvMappingInsert( pxBlock->xBlockSize, &uxFl, &uxSl );
+
+    if( pxBlock->pxNextFreeBlock != NULL )
+    {
+        pxBlock->pxNextFreeBlock->pxPrevFreeBlock = pxBlock->pxPrevFreeBlock;
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    if( pxBlock->pxPrevFreeBlock != NULL )
+    {
+        pxBlock->pxPrevFreeBlock->pxNextFreeBlock = pxBlock->pxNextFreeBlock;
+    }
+    else
+    {
+        /* The block was the head of its list. */
+        pxFreeLists[ uxFl ][ uxSl ] = pxBlock->pxNextFreeBlock;
+
+        if( pxBlock->pxNextFreeBlock == NULL )
+        {
+            ulSlBitmap[ uxFl ] &= ~( ( uint32_t ) 1U << uxSl );
+
+            if( ulSlBitmap[ uxFl ] == 0U )
+            {
+                ulFlBitmap &= ~( ( uint32_t ) 1U << uxFl );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+
+    xNumberOfFreeBlocks--;
+
+    #if ( configUSE_HEAP_FRAGMENTATION_STATS == 1 )
+    {
+        xFreeBlocksBySize[ portHEAP_FRAGMENTATION_BIN( pxBlock->xBlockSize ) ]--;
+    }
+    #endif
+}
+/*-----------------------------------------------------------*/
+
+#if !defined( __GNUC__ )
+
+    static UBaseType_t prvFls( uint32_t ulValue ) /* PRIVILEGED_FUNCTION */
+    {
+        UBaseType_t uxBit = 0;
+
+        while( ulValue > 1U )
+        {
+            ulValue >>= 1;
+            uxBit++;
+        }
+
+        return uxBit;
+    }
+
+#endif /* __GNUC__ */
+/*-----------------------------------------------------------*/
+
+void vPortGetHeapStats( HeapStats_t * pxHeapStats )
+{
+    TlsfBlock_t * pxBlock;
+    UBaseType_t uxFl;
+    size_t xMaxSize = 0, xMinSize = portMAX_DELAY; /* portMAX_DELAY used as a portable way of getting the maximum value. */
+
+    vTaskSuspendAll();
+    {
+        /* The largest free block is in the highest non empty list and the
+         * smallest in the lowest, so only those two lists are walked. */
+        if( ulFlBitmap != 0U )
+        {
+            uxFl = heapFLS( ulFlBitmap );
+
+            for( pxBlock = pxFreeLists[ uxFl ][ heapFLS( ulSlBitmap[ uxFl ] ) ]; pxBlock != NULL; pxBlock = pxBlock->pxNextFreeBlock )
+            {
+                if( pxBlock->xBlockSize > xMaxSize )
+                {
+                    xMaxSize = pxBlock->xBlockSize;
+                }
+            }
+
+            uxFl = heapFFS( ulFlBitmap );
+
+            for( pxBlock = pxFreeLists[ uxFl ][ heapFFS( ulSlBitmap[ uxFl ] ) ]; pxBlock != NULL; pxBlock = pxBlock->pxNextFreeBlock )
+            {
+                if( pxBlock->xBlockSize < xMinSize )
+                {
+                    xMinSize = pxBlock->xBlockSize;
+                }
+            }
+        }
+    }
+    ( void ) xTaskResumeAll();
+
+    pxHeapStats->xSizeOfLargestFreeBlockInBytes = xMaxSize;
+    pxHeapStats->xSizeOfSmallestFreeBlockInBytes = xMinSize;
+
+    taskENTER_CRITICAL();
+    {
+        pxHeapStats->xNumberOfFreeBlocks = xNumberOfFreeBlocks;
+        pxHeapStats->xAvailableHeapSpaceInBytes = xFreeBytesRemaining;
+        pxHeapStats->xNumberOfSuccessfulAllocations = xNumberOfSuccessfulAllocations;
+        pxHeapStats->xNumberOfSuccessfulFrees = xNumberOfSuccessfulFrees;
+        pxHeapStats->xMinimumEverFreeBytesRemaining = xMinimumEverFreeBytesRemaining;
+    }
+    taskEXIT_CRITICAL();
+}
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_HEAP_FRAGMENTATION_STATS == 1 )
+
+    void vPortGetHeapFragmentationStats( HeapFragmentationStats_t * pxFragmentationStats )
+    {
+        TlsfBlock_t * pxBlock;
+        UBaseType_t ux;
+        size_t xFree, xLargest = 0;
+
+        vTaskSuspendAll();
+        {
+            /* The counts are kept by prvInsertFreeBlock() and
+             * prvRemoveFreeBlock().  The largest free block is found in the
+             * highest non empty list, as in vPortGetHeapStats(), so unlike
+             * heap_4.c the high water mark only covers the values seen by
+             * calls to this function. */
+            if( ulFlBitmap != 0U )
+            {
+                ux = heapFLS( ulFlBitmap );
+
+                for( pxBlock = pxFreeLists[ ux ][ heapFLS( ulSlBitmap[ ux ] ) ]; pxBlock != NULL; pxBlock = pxBlock->pxNextFreeBlock )
+                {
+                    if( pxBlock->xBlockSize > xLargest )
+                    {
+                        xLargest = pxBlock->xBlockSize;
+                    }
+                }
+            }
+
+            xFree = xFreeBytesRemaining;
+            pxFragmentationStats->xAvailableHeapSpaceInBytes = xFree;
+            pxFragmentationStats->xSizeOfLargestFreeBlockInBytes = xLargest;
+            pxFragmentationStats->xNumberOfFreeBlocks = xNumberOfFreeBlocks;
+            pxFragmentationStats->xFragmentationPermille = 0;
+
+            if( xFree != 0 )
+            {
+                while( xFree > ( heapSIZE_MAX / ( size_t ) 1000 ) )
+                {
+                    xFree >>= 1;
+                    xLargest >>= 1;
+                }
+
+                pxFragmentationStats->xFragmentationPermille = ( ( xFree - xLargest ) * ( size_t ) 1000 ) / xFree;
+            }
+
+            if( pxFragmentationStats->xFragmentationPermille > xMaximumFragmentationPermille )
+            {
+                xMaximumFragmentationPermille = pxFragmentationStats->xFragmentationPermille;
+            }
+
+            pxFragmentationStats->xMaximumFragmentationPermille = xMaximumFragmentationPermille;
+
+            for( ux = 0; ux < ( UBaseType_t ) portHEAP_FRAGMENTATION_BINS; ux++ )
+            {
+                pxFragmentationStats->xFreeBlocksBySize[ ux ] = xFreeBlocksBySize[ ux ];
+            }
+        }
+        ( void ) xTaskResumeAll();
+    }
+/*-----------------------------------------------------------*/
+
+#endif /* configUSE_HEAP_FRAGMENTATION_STATS */
+
+#if ( configUSE_HEAP_TRACKING == 1 )
+
+    static UBaseType_t prvGetOwnerSlot( void ) /* PRIVILEGED_FUNCTION */
+    {
+        TaskHandle_t xTask = NULL;
+        UBaseType_t ux, uxUnused = heapNO_OWNER, uxIdle = heapNO_OWNER;
+
+        /* Allocations made before the scheduler starts, when creating the
+         * first tasks and queues, are accounted to a NULL task. */
+        if( xTaskGetSchedulerState() != taskSCHEDULER_NOT_STARTED )
+        {
+            xTask = xTaskGetCurrentTaskHandle();
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        for( ux = 0; ux < ( UBaseType_t ) configHEAP_TRACKING_MAX_TASKS; ux++ )
+        {
+            if( xTaskUsage[ ux ].xNumberOfAllocations == 0 )
+            {
+                if( uxUnused == heapNO_OWNER )
+                {
+                    uxUnused = ux;
+                }
+            }
+            else if( xTaskUsage[ ux ].xTask == xTask )
+            {
+                return ux;
+            }
+            else if( ( xTaskUsage[ ux ].xLiveBytes == 0 ) && ( uxIdle == heapNO_OWNER ) )
+            {
+                /* Nothing the owner of this slot allocated is still live, so
+                 * the slot can be handed over if no unused slot is left. */
+                uxIdle = ux;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+
+        if( uxUnused == heapNO_OWNER )
+        {
+            uxUnused = uxIdle;
+        }
+
+        if( uxUnused != heapNO_OWNER )
+        {
+            ( void ) memset( &( xTaskUsage[ uxUnused ] ), 0x00, sizeof( HeapTaskUsage_t ) );
+            xTaskUsage[ uxUnused ].xTask = xTask;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return uxUnused;
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvTrackAllocation( HeapBlockTag_t * pxTag,
+                                    const void * pv,
+                                    size_t xBlockSize,
+                                    void * pvCaller ) /* PRIVILEGED_FUNCTION */
+    {
+        HeapTaskUsage_t * pxUsage;
+
+        pxTag->pvCaller = pvCaller;
+        pxTag->xTimeStamp = xTaskGetTickCount();
+        pxTag->uxOwner = prvGetOwnerSlot();
+
+        if( pxTag->uxOwner != heapNO_OWNER )
+        {
+            pxUsage = &( xTaskUsage[ pxTag->uxOwner ] );
+            pxUsage->xLiveBytes += xBlockSize;
+            pxUsage->xNumberOfAllocations++;
+
+            if( pxUsage->xLiveBytes > pxUsage->xPeakLiveBytes )
+            {
+                pxUsage->xPeakLiveBytes = pxUsage->xLiveBytes;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        #if ( configUSE_HEAP_TRACE == 1 )
+        {
+            prvTraceHeapEvent( portHEAP_TRACE_EVENT_MALLOC, pv, xBlockSize, pxTag->uxOwner, pvCaller );
+        }
+        #else
+        {
+            ( void ) pv;
+        }
+        #endif
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvTrackFree( const HeapBlockTag_t * pxTag,
+                              const void * pv,
+                              size_t xBlockSize,
+                              void * pvCaller ) /* PRIVILEGED_FUNCTION */
+    {
+        HeapTaskUsage_t * pxUsage;
+
+        /* The block is charged back to the task that allocated it, which is
+         * not always the task freeing it - the idle task frees the TCB and
+         * stack of deleted tasks, for example. */
+        if( pxTag->uxOwner != heapNO_OWNER )
+        {
+            pxUsage = &( xTaskUsage[ pxTag->uxOwner ] );
+            configASSERT( pxUsage->xLiveBytes >= xBlockSize );
+            pxUsage->xLiveBytes -= xBlockSize;
+            pxUsage->xNumberOfFrees++;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        #if ( configUSE_HEAP_TRACE == 1 )
+        {
+            prvTraceHeapEvent( portHEAP_TRACE_EVENT_FREE, pv, xBlockSize, pxTag->uxOwner, pvCaller );
+        }
+        #else
+        {
+            ( void ) pv;
+            ( void ) pvCaller;
+        }
+        #endif
+    }
+/*-----------------------------------------------------------*/
+
+    UBaseType_t uxPortGetHeapTaskUsage( HeapTaskUsage_t * const pxTaskUsageArray,
+                                        const UBaseType_t uxArraySize )
+    {
+        UBaseType_t ux, uxCount = uxArraySize;
+
+        if( uxCount > ( UBaseType_t ) configHEAP_TRACKING_MAX_TASKS )
+        {
+            uxCount = ( UBaseType_t ) configHEAP_TRACKING_MAX_TASKS;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        vTaskSuspendAll();
+        {
+            for( ux = 0; ux < uxCount; ux++ )
+            {
+                pxTaskUsageArray[ ux ] = xTaskUsage[ ux ];
+            }
+        }
+        ( void ) xTaskResumeAll();
+
+        return uxCount;
+    }
+/*-----------------------------------------------------------*/
+
+#endif /* configUSE_HEAP_TRACKING */
+
+#if ( configUSE_HEAP_TRACE == 1 )
+
+    static void prvTraceHeapEvent( uint8_t ucEvent,
+                                   const void * pv,
+                                   size_t xSize,
+                                   UBaseType_t uxOwner,
+                                   void * pvCaller ) /* PRIVILEGED_FUNCTION */
+    {
+        HeapTraceRecord_t xRecord;
+
+        #if ( configUSE_MONOTONIC_CLOCK == 1 )
+        {
+            xRecord.ulTimeStamp = ( uint32_t ) portCLOCK_NS_TO_US( ullPortGetClockNs() );
+        }
+        #else
+        {
+            xRecord.ulTimeStamp = ( uint32_t ) xTaskGetTickCount();
+        }
+        #endif
+        xRecord.ulAddress = ( uint32_t ) ( portPOINTER_SIZE_TYPE ) pv;
+        xRecord.ulCaller = ( uint32_t ) ( portPOINTER_SIZE_TYPE ) pvCaller;
+        xRecord.usBlockSize = ( xSize > 0xffffU ) ? ( uint16_t ) 0xffffU : ( uint16_t ) xSize;
+        xRecord.ucEvent = ucEvent;
+        xRecord.ucTask = ( uint8_t ) uxOwner;
+
+        vApplicationHeapTraceHook( &xRecord );
+    }
+/*-----------------------------------------------------------*/
+
+#endif /* configUSE_HEAP_TRACE */
@@ -37,6 +37,7 @@
 #include "FreeRTOS.h"
 #include "task.h"
 #include "queue.h"
+#include "object_registry.h"
 
 #if ( configUSE_CO_ROUTINES == 1 )
     #include "croutine.h"
@@ -130,6 +131,16 @@ typedef struct QueueDefinition /* The old naming convention is used to prevent b
         UBaseType_t uxQueueNumber;
         uint8_t ucQueueType;
     #endif
+
+    #if ( configUSE_MUTEX_STATS == 1 )
+        MutexStats_t xMutexStats;
+        configRUN_TIME_COUNTER_TYPE ulHoldStart; /*< When the current holder took the mutex. */
+        UBaseType_t uxLockOrderSlot;             /*< One more than the index of the mutex in pxLockOrderMutexes[], 0 if the mutex has no slot. */
+    #endif
+
+    #if ( configUSE_OBJECT_REGISTRY == 1 )
+        UBaseType_t uxMessagesWaitingHighWater; /*< The most items the queue has held at once. */
+    #endif
 } xQUEUE;
 
 /* The old xQUEUE name is maintained above then typedefed to the new Queue_t
@@ -242,6 +253,72 @@ static void prvInitialiseNewQueue( const UBaseType_t uxQueueLength,
  */
     static UBaseType_t prvGetDisinheritPriorityAfterTimeout( const Queue_t * const pxQueue ) PRIVILEGED_FUNCTION;
 #endif
+
+#if ( configMUTEX_INHERITANCE_CHAIN_DEPTH > 1 )
+
+/*
+ * Called after the running task raised the priority of xMutexHolder.  If
+ * xMutexHolder is itself blocked on a mutex, the holder of that mutex inherits
+ * the same priority, and so on along the chain for up to
+ * configMUTEX_INHERITANCE_CHAIN_DEPTH holders in total.
+ */
+    static void prvInheritAlongChain( TaskHandle_t xMutexHolder ) PRIVILEGED_FUNCTION;
+
+/*
+ * The reverse of prvInheritAlongChain(), called after the priority of
+ * xMutexHolder was lowered because a task waiting for its mutex timed out.
+ */
+    static void prvDisinheritAlongChain( TaskHandle_t xMutexHolder ) PRIVILEGED_FUNCTION;
+#endif
+
+#if ( configUSE_MUTEX_STATS == 1 )
+
+/*
+ * Update the statistics of a mutex when it is taken, when a take times out and
+ * when it is given.  All are called from critical sections.
+ */
+    static void prvMutexStatsTake( Queue_t * const pxQueue,
+                                   const BaseType_t xWaited,
+                                   const configRUN_TIME_COUNTER_TYPE ulWaitStart ) PRIVILEGED_FUNCTION;
+    static void prvMutexStatsTimeout( Queue_t * const pxQueue,
+                                      const configRUN_TIME_COUNTER_TYPE ulWaitStart ) PRIVILEGED_FUNCTION;
+    static void prvMutexStatsGive( Queue_t * const pxQueue ) PRIVILEGED_FUNCTION;
+#endif
+
+#if ( configUSE_MUTEX_STATS == 1 ) && ( configMUTEX_LOCK_ORDER_SLOTS > 0 )
+
+/*
+ * Called when the running task has taken pxQueue.  Records that pxQueue was
+ * taken after each of the other mutexes the task holds, and reports the pairs
+ * that were taken the other way round before.
+ */
+    static void prvCheckLockOrder( Queue_t * const pxQueue ) PRIVILEGED_FUNCTION;
+
+/*
+ * Forgets the lock order of a mutex that is being deleted.
+ */
+    static void prvReleaseLockOrderSlot( Queue_t * const pxQueue ) PRIVILEGED_FUNCTION;
+#endif
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_MUTEX_STATS == 1 )
+
+/* Time base of the mutex statistics. */
+    #if ( configGENERATE_RUN_TIME_STATS == 1 ) && defined( portGET_RUN_TIME_COUNTER_VALUE )
+        #define queueMUTEX_STATS_TIME()    ( ( configRUN_TIME_COUNTER_TYPE ) portGET_RUN_TIME_COUNTER_VALUE() )
+    #else
+        #define queueMUTEX_STATS_TIME()    ( ( configRUN_TIME_COUNTER_TYPE ) xTaskGetTickCount() )
+    #endif
+
+    #if ( configMUTEX_LOCK_ORDER_SLOTS > 0 )
+
+/* The mutexes whose lock order is tracked, in the order they were first
+ * taken.  Bit j of ulTakenWhileHolding[ i ] is set once the mutex in slot j
+ * has been taken by a task holding the mutex in slot i. */
+        PRIVILEGED_DATA static Queue_t * pxLockOrderMutexes[ configMUTEX_LOCK_ORDER_SLOTS ];
+        PRIVILEGED_DATA static uint32_t ulTakenWhileHolding[ configMUTEX_LOCK_ORDER_SLOTS ];
+    #endif
+#endif /* configUSE_MUTEX_STATS */
 /*-----------------------------------------------------------*/
 
 /*
@@ -533,6 +610,13 @@ static void prvInitialiseNewQueue( const UBaseType_t uxQueueLength,
     }
     #endif /* configUSE_QUEUE_SETS */
 
+    #if ( configUSE_OBJECT_REGISTRY == 1 )
+    {
+        pxNewQueue->uxMessagesWaitingHighWater = ( UBaseType_t ) 0U;
+        vObjectRegistryAdd( pxNewQueue, registryTYPE_QUEUE );
+    }
+    #endif
+
     traceQUEUE_CREATE( pxNewQueue );
 }
 /*-----------------------------------------------------------*/
@@ -553,6 +637,14 @@ static void prvInitialiseNewQueue( const UBaseType_t uxQueueLength,
             /* In case this is a recursive mutex. */
             pxNewQueue->u.xSemaphore.uxRecursiveCallCount = 0;
 
+            #if ( configUSE_MUTEX_STATS == 1 )
+            {
+                ( void ) memset( &( pxNewQueue->xMutexStats ), 0x00, sizeof( pxNewQueue->xMutexStats ) );
+                pxNewQueue->ulHoldStart = 0;
+                pxNewQueue->uxLockOrderSlot = 0;
+            }
+            #endif
+
             traceCREATE_MUTEX( pxNewQueue );
 
             /* Start with the semaphore in the expected state. */
@@ -1270,6 +1362,19 @@ BaseType_t xQueueGiveFromISR( QueueHandle_t xQueue,
              * messages (semaphores) available. */
             pxQueue->uxMessagesWaiting = uxMessagesWaiting + ( UBaseType_t ) 1;
 
+            #if ( configUSE_OBJECT_REGISTRY == 1 )
+            {
+                if( pxQueue->uxMessagesWaiting > pxQueue->uxMessagesWaitingHighWater )
+                {
+                    pxQueue->uxMessagesWaitingHighWater = pxQueue->uxMessagesWaiting;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            #endif
+
             /* The event list is not altered if the queue is locked.  This will
              * be done when the queue is unlocked later. */
             if( cTxLock == queueUNLOCKED )
@@ -1529,6 +1634,10 @@ BaseType_t xQueueSemaphoreTake( QueueHandle_t xQueue,
         BaseType_t xInheritanceOccurred = pdFALSE;
     #endif
 
+    #if ( configUSE_MUTEX_STATS == 1 )
+        configRUN_TIME_COUNTER_TYPE ulWaitStart = 0;
+    #endif
+
     /* Check the queue pointer is not NULL. */
     configASSERT( ( pxQueue ) );
 
@@ -1571,6 +1680,18 @@ BaseType_t xQueueSemaphoreTake( QueueHandle_t xQueue,
                         /* Record the information required to implement
                          * priority inheritance should it become necessary. */
                         pxQueue->u.xSemaphore.xMutexHolder = pvTaskIncrementMutexHeldCount();
+
+                        #if ( configMUTEX_INHERITANCE_CHAIN_DEPTH > 1 )
+                        {
+                            vTaskSetBlockedOnMutex( NULL );
+                        }
+                        #endif
+
+                        #if ( configUSE_MUTEX_STATS == 1 )
+                        {
+                            prvMutexStatsTake( pxQueue, xEntryTimeSet, ulWaitStart );
+                        }
+                        #endif
                     }
                     else
                     {
@@ -1616,6 +1737,12 @@ BaseType_t xQueueSemaphoreTake( QueueHandle_t xQueue,
                      * so configure the timeout structure ready to block. */
                     vTaskInternalSetTimeOutState( &xTimeOut );
                     xEntryTimeSet = pdTRUE;
+
+                    #if ( configUSE_MUTEX_STATS == 1 )
+                    {
+                        ulWaitStart = queueMUTEX_STATS_TIME();
+                    }
+                    #endif
                 }
                 else
                 {
@@ -1650,6 +1777,21 @@ BaseType_t xQueueSemaphoreTake( QueueHandle_t xQueue,
                         taskENTER_CRITICAL();
                         {
                             xInheritanceOccurred = xTaskPriorityInherit( pxQueue->u.xSemaphore.xMutexHolder );
+
+                            #if ( configMUTEX_INHERITANCE_CHAIN_DEPTH > 1 )
+                            {
+                                vTaskSetBlockedOnMutex( pxQueue );
+
+                                if( xInheritanceOccurred != pdFALSE )
+                                {
+                                    prvInheritAlongChain( pxQueue->u.xSemaphore.xMutexHolder );
+                                }
+                                else
+                                {
+                                    mtCOVERAGE_TEST_MARKER();
+                                }
+                            }
+                            #endif
                         }
                         taskEXIT_CRITICAL();
                     }
@@ -1692,6 +1834,33 @@ BaseType_t xQueueSemaphoreTake( QueueHandle_t xQueue,
              * queue being empty is equivalent to the semaphore count being 0. */
             if( prvIsQueueEmpty( pxQueue ) != pdFALSE )
             {
+                #if ( ( configMUTEX_INHERITANCE_CHAIN_DEPTH > 1 ) || ( configUSE_MUTEX_STATS == 1 ) )
+                {
+                    if( pxQueue->uxQueueType == queueQUEUE_IS_MUTEX )
+                    {
+                        taskENTER_CRITICAL();
+                        {
+                            #if ( configMUTEX_INHERITANCE_CHAIN_DEPTH > 1 )
+                            {
+                                vTaskSetBlockedOnMutex( NULL );
+                            }
+                            #endif
+
+                            #if ( configUSE_MUTEX_STATS == 1 )
+                            {
+                                prvMutexStatsTimeout( pxQueue, ulWaitStart );
+                            }
+                            #endif
+                        }
+                        taskEXIT_CRITICAL();
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                #endif /* if ( ( configMUTEX_INHERITANCE_CHAIN_DEPTH > 1 ) || ( configUSE_MUTEX_STATS == 1 ) ) */
+
                 #if ( configUSE_MUTEXES == 1 )
                 {
                     /* xInheritanceOccurred could only have be set if
@@ -1710,6 +1879,12 @@ BaseType_t xQueueSemaphoreTake( QueueHandle_t xQueue,
                              * task that is waiting for the same mutex. */
                             uxHighestWaitingPriority = prvGetDisinheritPriorityAfterTimeout( pxQueue );
                             vTaskPriorityDisinheritAfterTimeout( pxQueue->u.xSemaphore.xMutexHolder, uxHighestWaitingPriority );
+
+                            #if ( configMUTEX_INHERITANCE_CHAIN_DEPTH > 1 )
+                            {
+                                prvDisinheritAlongChain( pxQueue->u.xSemaphore.xMutexHolder );
+                            }
+                            #endif
                         }
                         taskEXIT_CRITICAL();
                     }
@@ -2085,6 +2260,25 @@ void vQueueDelete( QueueHandle_t xQueue )
     }
     #endif
 
+    #if ( configUSE_OBJECT_REGISTRY == 1 )
+    {
+        vObjectRegistryRemove( pxQueue );
+    }
+    #endif
+
+    #if ( configUSE_MUTEX_STATS == 1 ) && ( configMUTEX_LOCK_ORDER_SLOTS > 0 )
+    {
+        if( pxQueue->uxQueueType == queueQUEUE_IS_MUTEX )
+        {
+            prvReleaseLockOrderSlot( pxQueue );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+    #endif
+
     #if ( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 0 ) )
     {
         /* The queue can only have been allocated dynamically - free it
@@ -2145,6 +2339,49 @@ void vQueueDelete( QueueHandle_t xQueue )
 #endif /* configUSE_TRACE_FACILITY */
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_OBJECT_REGISTRY == 1 )
+
+    void vQueueGetObjectInfo( QueueHandle_t xQueue,
+                              ObjectInfo_t * pxInfo )
+    {
+        Queue_t * const pxQueue = xQueue;
+        UBaseType_t uxHighWater;
+
+        configASSERT( pxQueue );
+
+        taskENTER_CRITICAL();
+        {
+            /* A counting semaphore created with an initial count starts
+             * above its high-water mark. */
+            uxHighWater = configMAX( pxQueue->uxMessagesWaitingHighWater, pxQueue->uxMessagesWaiting );
+
+            pxInfo->usCapacity = ( uint16_t ) configMIN( pxQueue->uxLength, 0xFFFFU );
+            pxInfo->usLevel = ( uint16_t ) configMIN( pxQueue->uxMessagesWaiting, 0xFFFFU );
+            pxInfo->usHighWater = ( uint16_t ) configMIN( uxHighWater, 0xFFFFU );
+            pxInfo->ucWaitingToSend = ( uint8_t ) configMIN( listCURRENT_LIST_LENGTH( &( pxQueue->xTasksWaitingToSend ) ), 0xFFU );
+            pxInfo->ucWaitingToReceive = ( uint8_t ) configMIN( listCURRENT_LIST_LENGTH( &( pxQueue->xTasksWaitingToReceive ) ), 0xFFU );
+            pxInfo->ucState = pxQueue->ucQueueType;
+        }
+        taskEXIT_CRITICAL();
+
+        if( pxQueue->uxQueueType == queueQUEUE_IS_MUTEX )
+        {
+            pxInfo->ucType = registryTYPE_MUTEX;
+        }
+        else if( pxQueue->uxItemSize == ( UBaseType_t ) 0 )
+        {
+            pxInfo->ucType = registryTYPE_SEMAPHORE;
+        }
+        else
+        {
+            pxInfo->ucType = registryTYPE_QUEUE;
+            pxInfo->ulStorage = ( uint32_t ) ( portPOINTER_SIZE_TYPE ) pxQueue->pcHead;
+        }
+    }
+
+#endif /* configUSE_OBJECT_REGISTRY */
+/*-----------------------------------------------------------*/
+
 #if ( configUSE_MUTEXES == 1 )
 
     static UBaseType_t prvGetDisinheritPriorityAfterTimeout( const Queue_t * const pxQueue )
@@ -2172,6 +2409,288 @@ void vQueueDelete( QueueHandle_t xQueue )
 #endif /* configUSE_MUTEXES */
 /*-----------------------------------------------------------*/
 
+#if ( configMUTEX_INHERITANCE_CHAIN_DEPTH > 1 )
+
+    static void prvInheritAlongChain( TaskHandle_t xMutexHolder )
+    {
+        const Queue_t * pxBlockingMutex;
+        UBaseType_t uxDepth;
+
+        /* The direct holder has already inherited. */
+        for( uxDepth = ( UBaseType_t ) 1; uxDepth < ( UBaseType_t ) configMUTEX_INHERITANCE_CHAIN_DEPTH; uxDepth++ )
+        {
+            pxBlockingMutex = ( const Queue_t * ) pvTaskGetBlockedOnMutex( xMutexHolder );
+
+            if( pxBlockingMutex == NULL )
+            {
+                break;
+            }
+
+            /* Inheriting the priority of the running task raises the next
+             * holder to the priority just passed to the task blocked on its
+             * mutex.  A holder already at that priority has passed it on
+             * already. */
+            xMutexHolder = pxBlockingMutex->u.xSemaphore.xMutexHolder;
+
+            if( ( xMutexHolder == NULL ) || ( xTaskPriorityInherit( xMutexHolder ) == pdFALSE ) )
+            {
+                break;
+            }
+        }
+    }
+
+#endif /* configMUTEX_INHERITANCE_CHAIN_DEPTH */
+/*-----------------------------------------------------------*/
+
+#if ( configMUTEX_INHERITANCE_CHAIN_DEPTH > 1 )
+
+    static void prvDisinheritAlongChain( TaskHandle_t xMutexHolder )
+    {
+        const Queue_t * pxBlockingMutex;
+        UBaseType_t uxDepth;
+
+        for( uxDepth = ( UBaseType_t ) 1; uxDepth < ( UBaseType_t ) configMUTEX_INHERITANCE_CHAIN_DEPTH; uxDepth++ )
+        {
+            pxBlockingMutex = ( const Queue_t * ) pvTaskGetBlockedOnMutex( xMutexHolder );
+
+            if( pxBlockingMutex == NULL )
+            {
+                break;
+            }
+
+            xMutexHolder = pxBlockingMutex->u.xSemaphore.xMutexHolder;
+
+            /* A chain leading back to the running task is a deadlock, and the
+             * running task cannot disinherit its own priority. */
+            if( ( xMutexHolder == NULL ) || ( xMutexHolder == xTaskGetCurrentTaskHandle() ) )
+            {
+                break;
+            }
+
+            /* The task blocked on pxBlockingMutex may have just been lowered,
+             * so lower its holder to the highest priority still waiting. */
+            vTaskPriorityDisinheritAfterTimeout( xMutexHolder, prvGetDisinheritPriorityAfterTimeout( pxBlockingMutex ) );
+        }
+    }
+
+#endif /* configMUTEX_INHERITANCE_CHAIN_DEPTH */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_MUTEX_STATS == 1 )
+
+    static void prvMutexStatsTake( Queue_t * const pxQueue,
+                                   const BaseType_t xWaited,
+                                   const configRUN_TIME_COUNTER_TYPE ulWaitStart )
+    {
+        const configRUN_TIME_COUNTER_TYPE ulNow = queueMUTEX_STATS_TIME();
+        MutexStats_t * const pxStats = &( pxQueue->xMutexStats );
+
+        ( pxStats->ulTakes )++;
+
+        if( xWaited != pdFALSE )
+        {
+            ( pxStats->ulContendedTakes )++;
+            pxStats->ulTotalWaitTime += ulNow - ulWaitStart;
+
+            if( ( ulNow - ulWaitStart ) > pxStats->ulMaxWaitTime )
+            {
+                pxStats->ulMaxWaitTime = ulNow - ulWaitStart;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        pxQueue->ulHoldStart = ulNow;
+
+        #if ( configMUTEX_LOCK_ORDER_SLOTS > 0 )
+        {
+            prvCheckLockOrder( pxQueue );
+        }
+        #endif
+    }
+
+#endif /* configUSE_MUTEX_STATS */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_MUTEX_STATS == 1 )
+
+    static void prvMutexStatsTimeout( Queue_t * const pxQueue,
+                                      const configRUN_TIME_COUNTER_TYPE ulWaitStart )
+    {
+        const configRUN_TIME_COUNTER_TYPE ulWaited = queueMUTEX_STATS_TIME() - ulWaitStart;
+        MutexStats_t * const pxStats = &( pxQueue->xMutexStats );
+
+        ( pxStats->ulTimeouts )++;
+        pxStats->ulTotalWaitTime += ulWaited;
+
+        if( ulWaited > pxStats->ulMaxWaitTime )
+        {
+            pxStats->ulMaxWaitTime = ulWaited;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+
+#endif /* configUSE_MUTEX_STATS */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_MUTEX_STATS == 1 )
+
+    static void prvMutexStatsGive( Queue_t * const pxQueue )
+    {
+        configRUN_TIME_COUNTER_TYPE ulHeld;
+        MutexStats_t * const pxStats = &( pxQueue->xMutexStats );
+
+        /* The give made when the mutex is created has no holder. */
+        if( pxQueue->u.xSemaphore.xMutexHolder != NULL )
+        {
+            ulHeld = queueMUTEX_STATS_TIME() - pxQueue->ulHoldStart;
+            pxStats->ulTotalHoldTime += ulHeld;
+
+            if( ulHeld > pxStats->ulMaxHoldTime )
+            {
+                pxStats->ulMaxHoldTime = ulHeld;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+
+#endif /* configUSE_MUTEX_STATS */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_MUTEX_STATS == 1 ) && ( configMUTEX_LOCK_ORDER_SLOTS > 0 )
+
+    static void prvCheckLockOrder( Queue_t * const pxQueue )
+    {
+        const TaskHandle_t xHolder = pxQueue->u.xSemaphore.xMutexHolder;
+        Queue_t * pxHeld;
+        UBaseType_t uxSlot, x;
+
+        /* Give the mutex a slot the first time it is taken. */
+        if( pxQueue->uxLockOrderSlot == ( UBaseType_t ) 0 )
+        {
+            for( x = 0; x < ( UBaseType_t ) configMUTEX_LOCK_ORDER_SLOTS; x++ )
+            {
+                if( pxLockOrderMutexes[ x ] == NULL )
+                {
+                    pxLockOrderMutexes[ x ] = pxQueue;
+                    pxQueue->uxLockOrderSlot = x + ( UBaseType_t ) 1;
+                    break;
+                }
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        /* Mutexes taken once every slot is in use are not tracked. */
+        if( ( pxQueue->uxLockOrderSlot != ( UBaseType_t ) 0 ) && ( xHolder != NULL ) )
+        {
+            uxSlot = pxQueue->uxLockOrderSlot - ( UBaseType_t ) 1;
+
+            for( x = 0; x < ( UBaseType_t ) configMUTEX_LOCK_ORDER_SLOTS; x++ )
+            {
+                pxHeld = pxLockOrderMutexes[ x ];
+
+                if( ( x != uxSlot ) && ( pxHeld != NULL ) && ( pxHeld->u.xSemaphore.xMutexHolder == xHolder ) )
+                {
+                    if( ( ulTakenWhileHolding[ uxSlot ] & ( 1UL << x ) ) != 0UL )
+                    {
+                        ( pxQueue->xMutexStats.ulLockOrderInversions )++;
+                        ( pxHeld->xMutexStats.ulLockOrderInversions )++;
+                        traceMUTEX_LOCK_ORDER_INVERSION( pxHeld, pxQueue );
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+
+                    ulTakenWhileHolding[ x ] |= ( 1UL << uxSlot );
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+
+#endif /* ( configUSE_MUTEX_STATS == 1 ) && ( configMUTEX_LOCK_ORDER_SLOTS > 0 ) */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_MUTEX_STATS == 1 ) && ( configMUTEX_LOCK_ORDER_SLOTS > 0 )
+
+    static void prvReleaseLockOrderSlot( Queue_t * const pxQueue )
+    {
+        UBaseType_t uxSlot, x;
+
+        taskENTER_CRITICAL();
+        {
+            if( pxQueue->uxLockOrderSlot != ( UBaseType_t ) 0 )
+            {
+                uxSlot = pxQueue->uxLockOrderSlot - ( UBaseType_t ) 1;
+                pxLockOrderMutexes[ uxSlot ] = NULL;
+                ulTakenWhileHolding[ uxSlot ] = 0UL;
+
+                for( x = 0; x < ( UBaseType_t ) configMUTEX_LOCK_ORDER_SLOTS; x++ )
+                {
+                    ulTakenWhileHolding[ x ] &= ~( 1UL << uxSlot );
+                }
+
+                pxQueue->uxLockOrderSlot = 0;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        taskEXIT_CRITICAL();
+    }
+
+#endif /* ( configUSE_MUTEX_STATS == 1 ) && ( configMUTEX_LOCK_ORDER_SLOTS > 0 ) */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_MUTEX_STATS == 1 )
+
+    void vQueueGetMutexStats( QueueHandle_t xMutex,
+                              MutexStats_t * pxStats )
+    {
+        Queue_t * const pxMutex = ( Queue_t * ) xMutex;
+
+        configASSERT( pxMutex );
+        configASSERT( pxStats );
+        configASSERT( pxMutex->uxQueueType == queueQUEUE_IS_MUTEX );
+
+        taskENTER_CRITICAL();
+        {
+            *pxStats = pxMutex->xMutexStats;
+        }
+        taskEXIT_CRITICAL();
+    }
+
+#endif /* configUSE_MUTEX_STATS */
+/*-----------------------------------------------------------*/
+
 static BaseType_t prvCopyDataToQueue( Queue_t * const pxQueue,
                                       const void * pvItemToQueue,
                                       const BaseType_t xPosition )
@@ -2189,6 +2708,12 @@ static BaseType_t prvCopyDataToQueue( Queue_t * const pxQueue,
         {
             if( pxQueue->uxQueueType == queueQUEUE_IS_MUTEX )
             {
+                #if ( configUSE_MUTEX_STATS == 1 )
+                {
+                    prvMutexStatsGive( pxQueue );
+                }
+                #endif
+
                 /* The mutex is no longer being held. */
                 xReturn = xTaskPriorityDisinherit( pxQueue->u.xSemaphore.xMutexHolder );
                 pxQueue->u.xSemaphore.xMutexHolder = NULL;
@@ -2251,6 +2776,19 @@ static BaseType_t prvCopyDataToQueue( Queue_t * const pxQueue,
 
     pxQueue->uxMessagesWaiting = uxMessagesWaiting + ( UBaseType_t ) 1;
 
+    #if ( configUSE_OBJECT_REGISTRY == 1 )
+    {
+        if( pxQueue->uxMessagesWaiting > pxQueue->uxMessagesWaitingHighWater )
+        {
+            pxQueue->uxMessagesWaitingHighWater = pxQueue->uxMessagesWaiting;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+    #endif
+
     return xReturn;
 }
 /*-----------------------------------------------------------*/
@@ -2916,6 +3454,72 @@ BaseType_t xQueueIsQueueFullFromISR( const QueueHandle_t xQueue )
 #endif /* configUSE_TIMERS */
 /*-----------------------------------------------------------*/
 
+#if ( ( configUSE_TIMERS == 1 ) && ( configTIMER_COMMAND_BATCH_SIZE > 1 ) )
+
+    UBaseType_t uxQueueReceiveBatchRestricted( QueueHandle_t xQueue,
+                                               void * const pvBuffer,
+                                               const UBaseType_t uxMaxItems )
+    {
+        Queue_t * const pxQueue = xQueue;
+        uint8_t * pucBuffer = ( uint8_t * ) pvBuffer;
+        UBaseType_t uxReceived = ( UBaseType_t ) 0U;
+        BaseType_t xYieldRequired = pdFALSE;
+
+        /* This function should not be called by application code hence the
+         * 'Restricted' in its name.  It is not part of the public API.  It is
+         * used by the timer service task to drain several commands from the
+         * timer queue in one critical section rather than one queue receive per
+         * command.  It never blocks, and as uxMaxItems is a compile time
+         * constant the time spent in the critical section is bounded. */
+        configASSERT( pxQueue );
+        configASSERT( pvBuffer );
+
+        taskENTER_CRITICAL();
+        {
+            while( ( uxReceived < uxMaxItems ) && ( pxQueue->uxMessagesWaiting > ( UBaseType_t ) 0 ) )
+            {
+                prvCopyDataFromQueue( pxQueue, pucBuffer );
+                traceQUEUE_RECEIVE( pxQueue );
+                pxQueue->uxMessagesWaiting--;
+                pucBuffer += pxQueue->uxItemSize; /*lint !e9016 Pointer arithmetic on char types ok. */
+                uxReceived++;
+
+                /* Each item removed makes space for one task waiting to post
+                 * to the queue. */
+                if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToSend ) ) == pdFALSE )
+                {
+                    if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToSend ) ) != pdFALSE )
+                    {
+                        xYieldRequired = pdTRUE;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+
+            if( xYieldRequired != pdFALSE )
+            {
+                queueYIELD_IF_USING_PREEMPTION();
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        taskEXIT_CRITICAL();
+
+        return uxReceived;
+    }
+
+#endif /* ( configUSE_TIMERS == 1 ) && ( configTIMER_COMMAND_BATCH_SIZE > 1 ) */
+/*-----------------------------------------------------------*/
+
 #if ( ( configUSE_QUEUE_SETS == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
 
     QueueSetHandle_t xQueueCreateSet( const UBaseType_t uxEventQueueLength )
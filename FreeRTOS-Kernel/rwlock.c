@@ -0,0 +1,816 @@
+/*
+ * FreeRTOS Kernel V10.5.1
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/*
+ * Reader-writer locks, see rwlock.h.
+ *
+ * Readers and writers wait on separate event lists.  Whenever the lock is
+ * released, or a waiting writer gives up, prvWakeWaiters() hands the lock over
+ * to the tasks that should have it next before unblocking them: the writer at
+ * the head of xWritersWaiting once no reader is left, or, when no writer is
+ * waiting, as many readers from the head of xReadersWaiting as there are free
+ * reader slots.  An unblocked task finds itself already recorded as a holder,
+ * so a task that runs in between cannot take the lock from it.
+ *
+ * Each holder records whether it inherited a priority through the lock.  The
+ * first inheritance counts the lock in the holder's uxMutexesHeld, so the
+ * inherited priority is dropped by xTaskPriorityDisinherit() on unlock as it
+ * would be for a mutex.
+ */
+
+/* Standard includes. */
+#include <stdlib.h>
+#include <string.h>
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+ * all the API functions to use the MPU wrappers.  That should only be done when
+ * task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "rwlock.h"
+
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+#if ( configUSE_RW_LOCKS == 1 )
+
+typedef struct RWLockHolder
+{
+    TaskHandle_t xTask;     /*< The holding task, NULL if the slot is free. */
+    BaseType_t xInherited;  /*< pdTRUE once the holder has inherited a priority through the lock. */
+} RWLockHolder_t;
+
+typedef struct RWLockDef_t
+{
+    RWLockHolder_t xWriter;                               /*< The task holding the lock for writing. */
+    RWLockHolder_t xReaders[ configRWLOCK_MAX_READERS ];  /*< The tasks holding the lock for reading. */
+    UBaseType_t uxReaders;                                /*< The number of tasks holding the lock for reading. */
+    List_t xReadersWaiting;                               /*< Tasks blocked on a read lock, in priority order. */
+    List_t xWritersWaiting;                               /*< Tasks blocked on a write lock, in priority order. */
+    RWLockStats_t xStats;
+
+    #if ( ( configSUPPORT_STATIC_ALLOCATION == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
+        uint8_t ucStaticallyAllocated; /*< Set to pdTRUE if the lock is statically allocated to ensure no attempt is made to free the memory. */
+    #endif
+} RWLock_t;
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Common implementation of xRWLockReadLock() and xRWLockWriteLock().
+ */
+static BaseType_t prvLock( RWLock_t * pxLock,
+                           BaseType_t xWrite,
+                           TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/*
+ * Returns the slot recording xTask as a holder, NULL if xTask does not hold
+ * the lock in the given mode.  Called from within a critical section.
+ */
+static RWLockHolder_t * prvFindHolder( RWLock_t * pxLock,
+                                       BaseType_t xWrite,
+                                       TaskHandle_t xTask ) PRIVILEGED_FUNCTION;
+
+/*
+ * Returns pdTRUE if a task asking for the lock in the given mode can have it
+ * now.  Called from within a critical section.
+ */
+static BaseType_t prvCanLock( const RWLock_t * pxLock,
+                              BaseType_t xWrite ) PRIVILEGED_FUNCTION;
+
+/*
+ * Records xTask as a holder.  prvCanLock() must have returned pdTRUE.  Called
+ * from within a critical section.
+ */
+static void prvAddHolder( RWLock_t * pxLock,
+                          BaseType_t xWrite,
+                          TaskHandle_t xTask ) PRIVILEGED_FUNCTION;
+
+/*
+ * Hands the lock to the waiting tasks that should have it next and unblocks
+ * them.  Returns pdTRUE if one of them has a priority above the running task.
+ * Called from within a critical section.
+ */
+static BaseType_t prvWakeWaiters( RWLock_t * pxLock ) PRIVILEGED_FUNCTION;
+
+/*
+ * Raises the priority of the holders to that of the running task, which is
+ * about to block.  Returns pdTRUE if a holder inherited the priority.  Called
+ * from within a critical section.
+ */
+static BaseType_t prvInheritPriority( RWLock_t * pxLock ) PRIVILEGED_FUNCTION;
+
+/*
+ * Called by a task that gave up waiting after a holder inherited its priority.
+ * Lowers the holders to the priority of the highest priority task still
+ * waiting.  Called from within a critical section.
+ */
+static void prvDisinheritAfterTimeout( RWLock_t * pxLock ) PRIVILEGED_FUNCTION;
+
+/*
+ * Common implementation of xRWLockReadUnlock() and xRWLockWriteUnlock().
+ */
+static BaseType_t prvUnlock( RWLock_t * pxLock,
+                             BaseType_t xWrite ) PRIVILEGED_FUNCTION;
+
+/*-----------------------------------------------------------*/
+
+static void prvInitialiseLock( RWLock_t * pxLock ) /* PRIVILEGED_FUNCTION */
+{
+    ( void ) memset( &( pxLock->xWriter ), 0x00, sizeof( pxLock->xWriter ) );
+    ( void ) memset( pxLock->xReaders, 0x00, sizeof( pxLock->xReaders ) );
+    ( void ) memset( &( pxLock->xStats ), 0x00, sizeof( pxLock->xStats ) );
+    pxLock->uxReaders = 0;
+    vListInitialise( &( pxLock->xReadersWaiting ) );
+    vListInitialise( &( pxLock->xWritersWaiting ) );
+}
+/*-----------------------------------------------------------*/
+
+#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+
+    RWLockHandle_t xRWLockCreateStatic( StaticRWLock_t * pxLockBuffer )
+    {
+        RWLock_t * pxLock;
+
+        configASSERT( pxLockBuffer );
+
+        #if ( configASSERT_DEFINED == 1 )
+        {
+            /* Sanity check that the size of the structure used to declare a
+             * variable of type StaticRWLock_t equals the size of the real lock
+             * structure. */
+            volatile size_t xSize = sizeof( StaticRWLock_t );
+            configASSERT( xSize == sizeof( RWLock_t ) );
+        } /*lint !e529 xSize is referenced if configASSERT() is defined. */
+        #endif /* configASSERT_DEFINED */
+
+        pxLock = ( RWLock_t * ) pxLockBuffer; /*lint !e740 !e9087 RWLock_t and StaticRWLock_t are deliberately aliased for data hiding purposes and guaranteed to have the same size and alignment requirement - checked by configASSERT(). */
+
+        if( pxLock != NULL )
+        {
+            prvInitialiseLock( pxLock );
+
+            #if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+            {
+                pxLock->ucStaticallyAllocated = pdTRUE;
+            }
+            #endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+        }
+
+        return pxLock;
+    }
+
+#endif /* configSUPPORT_STATIC_ALLOCATION */
+/*-----------------------------------------------------------*/
+
+#if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+
+    RWLockHandle_t xRWLockCreate( void )
+    {
+        RWLock_t * pxLock;
+
+        pxLock = ( RWLock_t * ) pvPortMalloc( sizeof( RWLock_t ) );
+
+        if( pxLock != NULL )
+        {
+            prvInitialiseLock( pxLock );
+
+            #if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+            {
+                pxLock->ucStaticallyAllocated = pdFALSE;
+            }
+            #endif /* configSUPPORT_STATIC_ALLOCATION */
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return pxLock;
+    }
+
+#endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+/*-----------------------------------------------------------*/
+
+BaseType_t xRWLockReadLock( RWLockHandle_t xLock,
+                            TickType_t xTicksToWait )
+{
+    configASSERT( xLock );
+
+    return prvLock( xLock, pdFALSE, xTicksToWait );
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xRWLockWriteLock( RWLockHandle_t xLock,
+                             TickType_t xTicksToWait )
+{
+    configASSERT( xLock );
+
+    return prvLock( xLock, pdTRUE, xTicksToWait );
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xRWLockReadUnlock( RWLockHandle_t xLock )
+{
+    configASSERT( xLock );
+
+    return prvUnlock( xLock, pdFALSE );
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xRWLockWriteUnlock( RWLockHandle_t xLock )
+{
+    configASSERT( xLock );
+
+    return prvUnlock( xLock, pdTRUE );
+}
+/*-----------------------------------------------------------*/
+
+void vRWLockGetStats( RWLockHandle_t xLock,
+                      RWLockStats_t * pxStats )
+{
+    RWLock_t * const pxLock = xLock;
+
+    configASSERT( pxLock );
+    configASSERT( pxStats );
+
+    taskENTER_CRITICAL();
+    {
+        *pxStats = pxLock->xStats;
+    }
+    taskEXIT_CRITICAL();
+}
+/*-----------------------------------------------------------*/
+
+void vRWLockDelete( RWLockHandle_t xLock )
+{
+    RWLock_t * const pxLock = xLock;
+
+    configASSERT( pxLock );
+    configASSERT( ( pxLock->xWriter.xTask == NULL ) && ( pxLock->uxReaders == 0 ) );
+    configASSERT( listLIST_IS_EMPTY( &( pxLock->xReadersWaiting ) ) != pdFALSE );
+    configASSERT( listLIST_IS_EMPTY( &( pxLock->xWritersWaiting ) ) != pdFALSE );
+
+    #if ( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 0 ) )
+    {
+        vPortFree( pxLock );
+    }
+    #elif ( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) )
+    {
+        if( pxLock->ucStaticallyAllocated == ( uint8_t ) pdFALSE )
+        {
+            vPortFree( pxLock );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+    #endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvLock( RWLock_t * pxLock,
+                           BaseType_t xWrite,
+                           TickType_t xTicksToWait )
+{
+    const TaskHandle_t xSelf = xTaskGetCurrentTaskHandle();
+    List_t * const pxWaitList = ( xWrite != pdFALSE ) ? &( pxLock->xWritersWaiting ) : &( pxLock->xReadersWaiting );
+    BaseType_t xEntryTimeSet = pdFALSE;
+    BaseType_t xInheritanceOccurred = pdFALSE;
+    BaseType_t xBlock, xYieldRequired;
+    TimeOut_t xTimeOut;
+
+    #if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
+    {
+        configASSERT( !( ( xTaskGetSchedulerState() == taskSCHEDULER_SUSPENDED ) && ( xTicksToWait != 0 ) ) );
+    }
+    #endif
+
+    /* The lock is not recursive, and a reader cannot upgrade to a writer. */
+    configASSERT( prvFindHolder( pxLock, pdFALSE, xSelf ) == NULL );
+    configASSERT( prvFindHolder( pxLock, pdTRUE, xSelf ) == NULL );
+
+    /*lint -save -e904 This function relaxes the coding standard somewhat to allow return
+     * statements within the function itself.  This is done in the interest
+     * of execution time efficiency. */
+    for( ; ; )
+    {
+        taskENTER_CRITICAL();
+        {
+            /* Either the lock is available, or it was handed to this task by
+             * prvWakeWaiters() while this task was blocked. */
+            if( ( prvFindHolder( pxLock, xWrite, xSelf ) != NULL ) || ( prvCanLock( pxLock, xWrite ) != pdFALSE ) )
+            {
+                if( prvFindHolder( pxLock, xWrite, xSelf ) == NULL )
+                {
+                    prvAddHolder( pxLock, xWrite, xSelf );
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                if( xWrite != pdFALSE )
+                {
+                    pxLock->xStats.ulWriteLocks++;
+                }
+                else
+                {
+                    pxLock->xStats.ulReadLocks++;
+                }
+
+                taskEXIT_CRITICAL();
+                return pdPASS;
+            }
+            else if( xTicksToWait == ( TickType_t ) 0 )
+            {
+                xYieldRequired = pdFALSE;
+
+                if( xEntryTimeSet != pdFALSE )
+                {
+                    pxLock->xStats.ulTimeouts++;
+
+                    if( xInheritanceOccurred != pdFALSE )
+                    {
+                        prvDisinheritAfterTimeout( pxLock );
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+
+                    /* Readers held back only by this writer can go now. */
+                    xYieldRequired = prvWakeWaiters( pxLock );
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                #if ( configUSE_PREEMPTION == 1 )
+                {
+                    if( xYieldRequired != pdFALSE )
+                    {
+                        portYIELD_WITHIN_API();
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                #endif /* configUSE_PREEMPTION */
+
+                taskEXIT_CRITICAL();
+                return pdFAIL;
+            }
+            else if( xEntryTimeSet == pdFALSE )
+            {
+                vTaskInternalSetTimeOutState( &xTimeOut );
+                xEntryTimeSet = pdTRUE;
+
+                if( xWrite != pdFALSE )
+                {
+                    pxLock->xStats.ulContendedWriteLocks++;
+                }
+                else
+                {
+                    pxLock->xStats.ulContendedReadLocks++;
+                }
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        taskEXIT_CRITICAL();
+
+        vTaskSuspendAll();
+
+        if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE )
+        {
+            xBlock = pdFALSE;
+
+            /* The holders cannot run while the scheduler is suspended, so if
+             * the lock is unavailable here it is still unavailable when this
+             * task has been placed on the wait list. */
+            taskENTER_CRITICAL();
+            {
+                if( prvCanLock( pxLock, xWrite ) == pdFALSE )
+                {
+                    if( prvInheritPriority( pxLock ) != pdFALSE )
+                    {
+                        if( xInheritanceOccurred == pdFALSE )
+                        {
+                            xInheritanceOccurred = pdTRUE;
+                            pxLock->xStats.ulPriorityInheritances++;
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+
+                    xBlock = pdTRUE;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            taskEXIT_CRITICAL();
+
+            if( xBlock != pdFALSE )
+            {
+                vTaskPlaceOnEventList( pxWaitList, xTicksToWait );
+
+                if( xTaskResumeAll() == pdFALSE )
+                {
+                    portYIELD_WITHIN_API();
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else
+            {
+                ( void ) xTaskResumeAll();
+            }
+        }
+        else
+        {
+            /* Timed out.  The next pass of the loop still takes the lock if it
+             * was handed to this task as the block time expired. */
+            ( void ) xTaskResumeAll();
+        }
+    } /*lint -restore */
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvUnlock( RWLock_t * pxLock,
+                             BaseType_t xWrite )
+{
+    const TaskHandle_t xSelf = xTaskGetCurrentTaskHandle();
+    RWLockHolder_t * pxHolder;
+    BaseType_t xReturn = pdPASS;
+    BaseType_t xYieldRequired = pdFALSE;
+
+    taskENTER_CRITICAL();
+    {
+        pxHolder = prvFindHolder( pxLock, xWrite, xSelf );
+
+        if( pxHolder == NULL )
+        {
+            xReturn = pdFAIL;
+        }
+        else
+        {
+            if( pxHolder->xInherited != pdFALSE )
+            {
+                /* Balances the vTaskIncrementMutexHeldCountOf() made when the
+                 * priority was inherited. */
+                if( xTaskPriorityDisinherit( xSelf ) != pdFALSE )
+                {
+                    xYieldRequired = pdTRUE;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            pxHolder->xTask = NULL;
+            pxHolder->xInherited = pdFALSE;
+
+            if( xWrite == pdFALSE )
+            {
+                ( pxLock->uxReaders )--;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            if( prvWakeWaiters( pxLock ) != pdFALSE )
+            {
+                xYieldRequired = pdTRUE;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+    }
+    taskEXIT_CRITICAL();
+
+    #if ( configUSE_PREEMPTION == 1 )
+    {
+        if( xYieldRequired != pdFALSE )
+        {
+            portYIELD_WITHIN_API();
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+    #endif /* configUSE_PREEMPTION */
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+static RWLockHolder_t * prvFindHolder( RWLock_t * pxLock,
+                                       BaseType_t xWrite,
+                                       TaskHandle_t xTask )
+{
+    RWLockHolder_t * pxHolder = NULL;
+    UBaseType_t x;
+
+    if( xWrite != pdFALSE )
+    {
+        if( pxLock->xWriter.xTask == xTask )
+        {
+            pxHolder = &( pxLock->xWriter );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+    else
+    {
+        for( x = 0; x < ( UBaseType_t ) configRWLOCK_MAX_READERS; x++ )
+        {
+            if( pxLock->xReaders[ x ].xTask == xTask )
+            {
+                pxHolder = &( pxLock->xReaders[ x ] );
+                break;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+    }
+
+    return pxHolder;
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvCanLock( const RWLock_t * pxLock,
+                              BaseType_t xWrite )
+{
+    BaseType_t xReturn = pdFALSE;
+
+    if( pxLock->xWriter.xTask == NULL )
+    {
+        if( xWrite != pdFALSE )
+        {
+            if( pxLock->uxReaders == ( UBaseType_t ) 0 )
+            {
+                xReturn = pdTRUE;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            /* A waiting writer keeps new readers out. */
+            if( ( listLIST_IS_EMPTY( &( pxLock->xWritersWaiting ) ) != pdFALSE ) &&
+                ( pxLock->uxReaders < ( UBaseType_t ) configRWLOCK_MAX_READERS ) )
+            {
+                xReturn = pdTRUE;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+static void prvAddHolder( RWLock_t * pxLock,
+                          BaseType_t xWrite,
+                          TaskHandle_t xTask )
+{
+    RWLockHolder_t * pxHolder;
+
+    /* A free slot is one holding NULL. */
+    pxHolder = prvFindHolder( pxLock, xWrite, NULL );
+    configASSERT( pxHolder );
+
+    pxHolder->xTask = xTask;
+    pxHolder->xInherited = pdFALSE;
+
+    if( xWrite == pdFALSE )
+    {
+        ( pxLock->uxReaders )++;
+
+        if( ( uint32_t ) pxLock->uxReaders > pxLock->xStats.ulMaxConcurrentReaders )
+        {
+            pxLock->xStats.ulMaxConcurrentReaders = ( uint32_t ) pxLock->uxReaders;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvWakeWaiters( RWLock_t * pxLock )
+{
+    TaskHandle_t xTask;
+    BaseType_t xYieldRequired = pdFALSE;
+
+    if( pxLock->xWriter.xTask == NULL )
+    {
+        if( listLIST_IS_EMPTY( &( pxLock->xWritersWaiting ) ) == pdFALSE )
+        {
+            /* The writer goes first, once the readers have left. */
+            if( pxLock->uxReaders == ( UBaseType_t ) 0 )
+            {
+                xTask = listGET_OWNER_OF_HEAD_ENTRY( &( pxLock->xWritersWaiting ) );
+                prvAddHolder( pxLock, pdTRUE, xTask );
+                xYieldRequired = xTaskRemoveFromEventList( &( pxLock->xWritersWaiting ) );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            while( ( listLIST_IS_EMPTY( &( pxLock->xReadersWaiting ) ) == pdFALSE ) &&
+                   ( pxLock->uxReaders < ( UBaseType_t ) configRWLOCK_MAX_READERS ) )
+            {
+                xTask = listGET_OWNER_OF_HEAD_ENTRY( &( pxLock->xReadersWaiting ) );
+                prvAddHolder( pxLock, pdFALSE, xTask );
+
+                if( xTaskRemoveFromEventList( &( pxLock->xReadersWaiting ) ) != pdFALSE )
+                {
+                    xYieldRequired = pdTRUE;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+        }
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    return xYieldRequired;
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvInheritPriority( RWLock_t * pxLock )
+{
+    RWLockHolder_t * pxHolder;
+    BaseType_t xInheritanceOccurred = pdFALSE;
+    UBaseType_t x;
+
+    for( x = 0; x <= ( UBaseType_t ) configRWLOCK_MAX_READERS; x++ )
+    {
+        /* Slot configRWLOCK_MAX_READERS stands for the writer. */
+        pxHolder = ( x < ( UBaseType_t ) configRWLOCK_MAX_READERS ) ? &( pxLock->xReaders[ x ] ) : &( pxLock->xWriter );
+
+        if( pxHolder->xTask != NULL )
+        {
+            if( xTaskPriorityInherit( pxHolder->xTask ) != pdFALSE )
+            {
+                xInheritanceOccurred = pdTRUE;
+
+                /* Count the lock in the holder's uxMutexesHeld once, so
+                 * unlocking only restores the base priority when nothing else
+                 * the holder inherited through is held. */
+                if( pxHolder->xInherited == pdFALSE )
+                {
+                    vTaskIncrementMutexHeldCountOf( pxHolder->xTask );
+                    pxHolder->xInherited = pdTRUE;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+
+    return xInheritanceOccurred;
+}
+/*-----------------------------------------------------------*/
+
+static void prvDisinheritAfterTimeout( RWLock_t * pxLock )
+{
+    RWLockHolder_t * pxHolder;
+    UBaseType_t uxHighestPriorityOfWaitingTasks = tskIDLE_PRIORITY;
+    UBaseType_t uxPriority;
+    UBaseType_t x;
+
+    /* The task timing out is no longer on either wait list. */
+    if( listLIST_IS_EMPTY( &( pxLock->xReadersWaiting ) ) == pdFALSE )
+    {
+        uxHighestPriorityOfWaitingTasks = ( UBaseType_t ) configMAX_PRIORITIES - ( UBaseType_t ) listGET_ITEM_VALUE_OF_HEAD_ENTRY( &( pxLock->xReadersWaiting ) );
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    if( listLIST_IS_EMPTY( &( pxLock->xWritersWaiting ) ) == pdFALSE )
+    {
+        uxPriority = ( UBaseType_t ) configMAX_PRIORITIES - ( UBaseType_t ) listGET_ITEM_VALUE_OF_HEAD_ENTRY( &( pxLock->xWritersWaiting ) );
+
+        if( uxPriority > uxHighestPriorityOfWaitingTasks )
+        {
+            uxHighestPriorityOfWaitingTasks = uxPriority;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    for( x = 0; x <= ( UBaseType_t ) configRWLOCK_MAX_READERS; x++ )
+    {
+        pxHolder = ( x < ( UBaseType_t ) configRWLOCK_MAX_READERS ) ? &( pxLock->xReaders[ x ] ) : &( pxLock->xWriter );
+
+        if( pxHolder->xInherited != pdFALSE )
+        {
+            vTaskPriorityDisinheritAfterTimeout( pxHolder->xTask, uxHighestPriorityOfWaitingTasks );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+}
+/*-----------------------------------------------------------*/
+
+#endif /* configUSE_RW_LOCKS */
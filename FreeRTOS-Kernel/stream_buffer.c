@@ -39,6 +39,7 @@
 #include "FreeRTOS.h"
 #include "task.h"
 #include "stream_buffer.h"
+#include "object_registry.h"
 
 #if ( configUSE_TASK_NOTIFICATIONS != 1 )
     #error configUSE_TASK_NOTIFICATIONS must be set to 1 to build stream_buffer.c
@@ -239,6 +240,10 @@ typedef struct StreamBufferDef_t                 /*lint !e9058 Style convention
         StreamBufferCallbackFunction_t pxSendCompletedCallback;    /* Optional callback called on send complete. sbSEND_COMPLETED is called if this is NULL. */
         StreamBufferCallbackFunction_t pxReceiveCompletedCallback; /* Optional callback called on receive complete.  sbRECEIVE_COMPLETED is called if this is NULL. */
     #endif
+
+    #if ( configUSE_OBJECT_REGISTRY == 1 )
+        size_t xHighWaterBytes; /* The most bytes the buffer has held at once, cleared by a reset. */
+    #endif
 } StreamBuffer_t;
 
 /*
@@ -246,6 +251,58 @@ typedef struct StreamBufferDef_t                 /*lint !e9058 Style convention
  */
 static size_t prvBytesInBuffer( const StreamBuffer_t * const pxStreamBuffer ) PRIVILEGED_FUNCTION;
 
+/*
+ * Blocks the calling task for up to xTicksToWait ticks until at least
+ * xRequiredSpace bytes are free, then returns the number of free bytes.
+ */
+static size_t prvWaitForSpace( StreamBuffer_t * const pxStreamBuffer,
+                               size_t xRequiredSpace,
+                               TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/*
+ * Blocks the calling task for up to xTicksToWait ticks until more than
+ * xBytesToStoreMessageLength bytes are in the buffer, then returns the number
+ * of bytes in the buffer.
+ */
+static size_t prvWaitForData( StreamBuffer_t * const pxStreamBuffer,
+                              size_t xBytesToStoreMessageLength,
+                              TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/*
+ * Describes the xCount bytes of the storage area starting at index xStart, as
+ * one span or, if they wrap around the end of the storage area, two.
+ */
+static void prvGetSpans( const StreamBuffer_t * const pxStreamBuffer,
+                         size_t xStart,
+                         size_t xCount,
+                         StreamBufferSpans_t * const pxSpans ) PRIVILEGED_FUNCTION;
+
+/*
+ * Returns xIndex moved on by xCount bytes, wrapping at the end of the storage
+ * area.
+ */
+static size_t prvAdvanceIndex( const StreamBuffer_t * const pxStreamBuffer,
+                               size_t xIndex,
+                               size_t xCount ) PRIVILEGED_FUNCTION;
+
+/*
+ * Reads the length of the message stored at index xTail of a message buffer
+ * and describes its payload in *pxSpans.  Returns the length.
+ */
+static size_t prvPeekMessageAt( const StreamBuffer_t * const pxStreamBuffer,
+                                size_t xTail,
+                                StreamBufferSpans_t * const pxSpans ) PRIVILEGED_FUNCTION;
+
+/*
+ * Raises the high-water mark reported to the object registry to the number of
+ * bytes now in the buffer.  Called by the writer after it moves xHead.
+ */
+#if ( configUSE_OBJECT_REGISTRY == 1 )
+    static void prvUpdateHighWater( StreamBuffer_t * const pxStreamBuffer ) PRIVILEGED_FUNCTION;
+#else
+    #define prvUpdateHighWater( pxStreamBuffer )
+#endif
+
 /*
  * Add xCount bytes from pucData into the pxStreamBuffer's data storage area.
  * This function does not update the buffer's xHead pointer, so multiple writes
@@ -381,6 +438,12 @@ static void prvInitialiseNewStreamBuffer( StreamBuffer_t * const pxStreamBuffer,
                                           pxSendCompletedCallback,
                                           pxReceiveCompletedCallback );
 
+            #if ( configUSE_OBJECT_REGISTRY == 1 )
+            {
+                vObjectRegistryAdd( pucAllocatedMemory, registryTYPE_STREAM_BUFFER );
+            }
+            #endif
+
             traceSTREAM_BUFFER_CREATE( ( ( StreamBuffer_t * ) pucAllocatedMemory ), xIsMessageBuffer );
         }
         else
@@ -459,6 +522,12 @@ static void prvInitialiseNewStreamBuffer( StreamBuffer_t * const pxStreamBuffer,
              * again. */
             pxStreamBuffer->ucFlags |= sbFLAGS_IS_STATICALLY_ALLOCATED;
 
+            #if ( configUSE_OBJECT_REGISTRY == 1 )
+            {
+                vObjectRegistryAdd( pxStreamBuffer, registryTYPE_STREAM_BUFFER );
+            }
+            #endif
+
             traceSTREAM_BUFFER_CREATE( pxStreamBuffer, xIsMessageBuffer );
 
             xReturn = ( StreamBufferHandle_t ) pxStaticStreamBuffer; /*lint !e9087 Data hiding requires cast to opaque type. */
@@ -482,6 +551,12 @@ void vStreamBufferDelete( StreamBufferHandle_t xStreamBuffer )
 
     traceSTREAM_BUFFER_DELETE( xStreamBuffer );
 
+    #if ( configUSE_OBJECT_REGISTRY == 1 )
+    {
+        vObjectRegistryRemove( pxStreamBuffer );
+    }
+    #endif
+
     if( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_STATICALLY_ALLOCATED ) == ( uint8_t ) pdFALSE )
     {
         #if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
@@ -645,9 +720,8 @@ size_t xStreamBufferSend( StreamBufferHandle_t xStreamBuffer,
                           TickType_t xTicksToWait )
 {
     StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
-    size_t xReturn, xSpace = 0;
+    size_t xReturn, xSpace;
     size_t xRequiredSpace = xDataLengthBytes;
-    TimeOut_t xTimeOut;
     size_t xMaxReportedSpace = 0;
 
     configASSERT( pvTxData );
@@ -696,54 +770,7 @@ size_t xStreamBufferSend( StreamBufferHandle_t xStreamBuffer,
         }
     }
 
-    if( xTicksToWait != ( TickType_t ) 0 )
-    {
-        vTaskSetTimeOutState( &xTimeOut );
-
-        do
-        {
-            /* Wait until the required number of bytes are free in the message
-             * buffer. */
-            taskENTER_CRITICAL();
-            {
-                xSpace = xStreamBufferSpacesAvailable( pxStreamBuffer );
-
-                if( xSpace < xRequiredSpace )
-                {
-                    /* Clear notification state as going to wait for space. */
-                    ( void ) xTaskNotifyStateClear( NULL );
-
-                    /* Should only be one writer. */
-                    configASSERT( pxStreamBuffer->xTaskWaitingToSend == NULL );
-                    pxStreamBuffer->xTaskWaitingToSend = xTaskGetCurrentTaskHandle();
-                }
-                else
-                {
-                    taskEXIT_CRITICAL();
-                    break;
-                }
-            }
-            taskEXIT_CRITICAL();
-
-            traceBLOCKING_ON_STREAM_BUFFER_SEND( xStreamBuffer );
-            ( void ) xTaskNotifyWait( ( uint32_t ) 0, ( uint32_t ) 0, NULL, xTicksToWait );
-            pxStreamBuffer->xTaskWaitingToSend = NULL;
-        } while( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE );
-    }
-    else
-    {
-        mtCOVERAGE_TEST_MARKER();
-    }
-
-    if( xSpace == ( size_t ) 0 )
-    {
-        xSpace = xStreamBufferSpacesAvailable( pxStreamBuffer );
-    }
-    else
-    {
-        mtCOVERAGE_TEST_MARKER();
-    }
-
+    xSpace = prvWaitForSpace( pxStreamBuffer, xRequiredSpace, xTicksToWait );
     xReturn = prvWriteMessageToBuffer( pxStreamBuffer, pvTxData, xDataLengthBytes, xSpace, xRequiredSpace );
 
     if( xReturn > ( size_t ) 0 )
@@ -865,6 +892,7 @@ static size_t prvWriteMessageToBuffer( StreamBuffer_t * const pxStreamBuffer,
     {
         /* Write the data to the buffer. */
         pxStreamBuffer->xHead = prvWriteBytesToBuffer( pxStreamBuffer, ( const uint8_t * ) pvTxData, xDataLengthBytes, xNextHead ); /*lint !e9079 Storage buffer is implemented as uint8_t for ease of sizing, alignment and access. */
+        prvUpdateHighWater( pxStreamBuffer );
     }
 
     return xDataLengthBytes;
@@ -896,54 +924,7 @@ size_t xStreamBufferReceive( StreamBufferHandle_t xStreamBuffer,
         xBytesToStoreMessageLength = 0;
     }
 
-    if( xTicksToWait != ( TickType_t ) 0 )
-    {
-        /* Checking if there is data and clearing the notification state must be
-         * performed atomically. */
-        taskENTER_CRITICAL();
-        {
-            xBytesAvailable = prvBytesInBuffer( pxStreamBuffer );
-
-            /* If this function was invoked by a message buffer read then
-             * xBytesToStoreMessageLength holds the number of bytes used to hold
-             * the length of the next discrete message.  If this function was
-             * invoked by a stream buffer read then xBytesToStoreMessageLength will
-             * be 0. */
-            if( xBytesAvailable <= xBytesToStoreMessageLength )
-            {
-                /* Clear notification state as going to wait for data. */
-                ( void ) xTaskNotifyStateClear( NULL );
-
-                /* Should only be one reader. */
-                configASSERT( pxStreamBuffer->xTaskWaitingToReceive == NULL );
-                pxStreamBuffer->xTaskWaitingToReceive = xTaskGetCurrentTaskHandle();
-            }
-            else
-            {
-                mtCOVERAGE_TEST_MARKER();
-            }
-        }
-        taskEXIT_CRITICAL();
-
-        if( xBytesAvailable <= xBytesToStoreMessageLength )
-        {
-            /* Wait for data to be available. */
-            traceBLOCKING_ON_STREAM_BUFFER_RECEIVE( xStreamBuffer );
-            ( void ) xTaskNotifyWait( ( uint32_t ) 0, ( uint32_t ) 0, NULL, xTicksToWait );
-            pxStreamBuffer->xTaskWaitingToReceive = NULL;
-
-            /* Recheck the data available after blocking. */
-            xBytesAvailable = prvBytesInBuffer( pxStreamBuffer );
-        }
-        else
-        {
-            mtCOVERAGE_TEST_MARKER();
-        }
-    }
-    else
-    {
-        xBytesAvailable = prvBytesInBuffer( pxStreamBuffer );
-    }
+    xBytesAvailable = prvWaitForData( pxStreamBuffer, xBytesToStoreMessageLength, xTicksToWait );
 
     /* Whether receiving a discrete message (where xBytesToStoreMessageLength
      * holds the number of bytes used to store the message length) or a stream of
@@ -1072,6 +1053,283 @@ size_t xStreamBufferReceiveFromISR( StreamBufferHandle_t xStreamBuffer,
 }
 /*-----------------------------------------------------------*/
 
+size_t xStreamBufferAcquireWriteSpans( StreamBufferHandle_t xStreamBuffer,
+                                       StreamBufferSpans_t * const pxSpans,
+                                       TickType_t xTicksToWait )
+{
+    StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+    size_t xSpace;
+
+    configASSERT( pxStreamBuffer );
+    configASSERT( pxSpans );
+
+    /* Writing raw bytes would corrupt the length prefixes of a message
+     * buffer. */
+    configASSERT( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MESSAGE_BUFFER ) == ( uint8_t ) 0 );
+
+    xSpace = prvWaitForSpace( pxStreamBuffer, ( size_t ) 1, xTicksToWait );
+
+    /* Only the writer moves xHead, so the free space can only grow until the
+     * write is committed. */
+    prvGetSpans( pxStreamBuffer, pxStreamBuffer->xHead, xSpace, pxSpans );
+
+    return xSpace;
+}
+/*-----------------------------------------------------------*/
+
+void vStreamBufferCommitWrite( StreamBufferHandle_t xStreamBuffer,
+                               size_t xBytesWritten )
+{
+    StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+
+    configASSERT( pxStreamBuffer );
+    configASSERT( xBytesWritten <= xStreamBufferSpacesAvailable( pxStreamBuffer ) );
+
+    if( xBytesWritten > ( size_t ) 0 )
+    {
+        pxStreamBuffer->xHead = prvAdvanceIndex( pxStreamBuffer, pxStreamBuffer->xHead, xBytesWritten );
+        prvUpdateHighWater( pxStreamBuffer );
+        traceSTREAM_BUFFER_SEND( xStreamBuffer, xBytesWritten );
+
+        /* Was a task waiting for the data? */
+        if( prvBytesInBuffer( pxStreamBuffer ) >= pxStreamBuffer->xTriggerLevelBytes )
+        {
+            prvSEND_COMPLETED( pxStreamBuffer );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+}
+/*-----------------------------------------------------------*/
+
+void vStreamBufferCommitWriteFromISR( StreamBufferHandle_t xStreamBuffer,
+                                      size_t xBytesWritten,
+                                      BaseType_t * const pxHigherPriorityTaskWoken )
+{
+    StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+
+    configASSERT( pxStreamBuffer );
+    configASSERT( xBytesWritten <= xStreamBufferSpacesAvailable( pxStreamBuffer ) );
+
+    if( xBytesWritten > ( size_t ) 0 )
+    {
+        pxStreamBuffer->xHead = prvAdvanceIndex( pxStreamBuffer, pxStreamBuffer->xHead, xBytesWritten );
+        prvUpdateHighWater( pxStreamBuffer );
+
+        /* Was a task waiting for the data? */
+        if( prvBytesInBuffer( pxStreamBuffer ) >= pxStreamBuffer->xTriggerLevelBytes )
+        {
+            prvSEND_COMPLETE_FROM_ISR( pxStreamBuffer, pxHigherPriorityTaskWoken );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    traceSTREAM_BUFFER_SEND_FROM_ISR( xStreamBuffer, xBytesWritten );
+}
+/*-----------------------------------------------------------*/
+
+size_t xStreamBufferAcquireReadSpans( StreamBufferHandle_t xStreamBuffer,
+                                      StreamBufferSpans_t * const pxSpans,
+                                      TickType_t xTicksToWait )
+{
+    StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+    size_t xBytesAvailable;
+
+    configASSERT( pxStreamBuffer );
+    configASSERT( pxSpans );
+    configASSERT( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MESSAGE_BUFFER ) == ( uint8_t ) 0 );
+
+    xBytesAvailable = prvWaitForData( pxStreamBuffer, ( size_t ) 0, xTicksToWait );
+
+    /* Only the reader moves xTail, so the data can only grow until the read is
+     * released. */
+    prvGetSpans( pxStreamBuffer, pxStreamBuffer->xTail, xBytesAvailable, pxSpans );
+
+    return xBytesAvailable;
+}
+/*-----------------------------------------------------------*/
+
+void vStreamBufferReleaseRead( StreamBufferHandle_t xStreamBuffer,
+                               size_t xBytesRead )
+{
+    StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+
+    configASSERT( pxStreamBuffer );
+    configASSERT( xBytesRead <= prvBytesInBuffer( pxStreamBuffer ) );
+
+    if( xBytesRead > ( size_t ) 0 )
+    {
+        pxStreamBuffer->xTail = prvAdvanceIndex( pxStreamBuffer, pxStreamBuffer->xTail, xBytesRead );
+        traceSTREAM_BUFFER_RECEIVE( xStreamBuffer, xBytesRead );
+
+        /* Was a task waiting for space in the buffer? */
+        prvRECEIVE_COMPLETED( pxStreamBuffer );
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+}
+/*-----------------------------------------------------------*/
+
+void vStreamBufferReleaseReadFromISR( StreamBufferHandle_t xStreamBuffer,
+                                      size_t xBytesRead,
+                                      BaseType_t * const pxHigherPriorityTaskWoken )
+{
+    StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+
+    configASSERT( pxStreamBuffer );
+    configASSERT( xBytesRead <= prvBytesInBuffer( pxStreamBuffer ) );
+
+    if( xBytesRead > ( size_t ) 0 )
+    {
+        pxStreamBuffer->xTail = prvAdvanceIndex( pxStreamBuffer, pxStreamBuffer->xTail, xBytesRead );
+
+        /* Was a task waiting for space in the buffer? */
+        prvRECEIVE_COMPLETED_FROM_ISR( pxStreamBuffer, pxHigherPriorityTaskWoken );
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    traceSTREAM_BUFFER_RECEIVE_FROM_ISR( xStreamBuffer, xBytesRead );
+}
+/*-----------------------------------------------------------*/
+
+size_t xStreamBufferPeekMessage( StreamBufferHandle_t xStreamBuffer,
+                                 StreamBufferSpans_t * const pxSpans,
+                                 TickType_t xTicksToWait )
+{
+    StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+    size_t xBytesAvailable, xMessageLength = 0;
+
+    configASSERT( pxStreamBuffer );
+    configASSERT( pxSpans );
+    configASSERT( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MESSAGE_BUFFER ) != ( uint8_t ) 0 );
+
+    xBytesAvailable = prvWaitForData( pxStreamBuffer, sbBYTES_TO_STORE_MESSAGE_LENGTH, xTicksToWait );
+
+    /* Zero length messages are never stored, so a length prefix is always
+     * followed by at least one byte. */
+    if( xBytesAvailable > sbBYTES_TO_STORE_MESSAGE_LENGTH )
+    {
+        xMessageLength = prvPeekMessageAt( pxStreamBuffer, pxStreamBuffer->xTail, pxSpans );
+    }
+    else
+    {
+        prvGetSpans( pxStreamBuffer, pxStreamBuffer->xTail, 0, pxSpans );
+        traceSTREAM_BUFFER_RECEIVE_FAILED( xStreamBuffer );
+    }
+
+    return xMessageLength;
+}
+/*-----------------------------------------------------------*/
+
+void vStreamBufferReleaseMessage( StreamBufferHandle_t xStreamBuffer )
+{
+    StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+    StreamBufferSpans_t xSpans;
+    size_t xMessageLength;
+
+    configASSERT( pxStreamBuffer );
+    configASSERT( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MESSAGE_BUFFER ) != ( uint8_t ) 0 );
+    configASSERT( prvBytesInBuffer( pxStreamBuffer ) > sbBYTES_TO_STORE_MESSAGE_LENGTH );
+
+    xMessageLength = prvPeekMessageAt( pxStreamBuffer, pxStreamBuffer->xTail, &xSpans );
+    pxStreamBuffer->xTail = prvAdvanceIndex( pxStreamBuffer, pxStreamBuffer->xTail, sbBYTES_TO_STORE_MESSAGE_LENGTH + xMessageLength );
+    traceSTREAM_BUFFER_RECEIVE( xStreamBuffer, xMessageLength );
+
+    /* Was a task waiting for space in the buffer? */
+    prvRECEIVE_COMPLETED( pxStreamBuffer );
+}
+/*-----------------------------------------------------------*/
+
+void vStreamBufferReleaseMessageFromISR( StreamBufferHandle_t xStreamBuffer,
+                                         BaseType_t * const pxHigherPriorityTaskWoken )
+{
+    StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+    StreamBufferSpans_t xSpans;
+    size_t xMessageLength;
+
+    configASSERT( pxStreamBuffer );
+    configASSERT( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MESSAGE_BUFFER ) != ( uint8_t ) 0 );
+    configASSERT( prvBytesInBuffer( pxStreamBuffer ) > sbBYTES_TO_STORE_MESSAGE_LENGTH );
+
+    xMessageLength = prvPeekMessageAt( pxStreamBuffer, pxStreamBuffer->xTail, &xSpans );
+    pxStreamBuffer->xTail = prvAdvanceIndex( pxStreamBuffer, pxStreamBuffer->xTail, sbBYTES_TO_STORE_MESSAGE_LENGTH + xMessageLength );
+
+    /* Was a task waiting for space in the buffer? */
+    prvRECEIVE_COMPLETED_FROM_ISR( pxStreamBuffer, pxHigherPriorityTaskWoken );
+
+    traceSTREAM_BUFFER_RECEIVE_FROM_ISR( xStreamBuffer, xMessageLength );
+}
+/*-----------------------------------------------------------*/
+
+size_t xStreamBufferDrainMessages( StreamBufferHandle_t xStreamBuffer,
+                                   StreamBufferMessageCallback_t pxCallback,
+                                   void * pvContext,
+                                   TickType_t xTicksToWait )
+{
+    StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+    StreamBufferSpans_t xSpans;
+    size_t xBytesAvailable, xMessageLength, xTail;
+    size_t xMessagesDrained = 0, xBytesReleased = 0;
+    BaseType_t xContinue = pdTRUE;
+
+    configASSERT( pxStreamBuffer );
+    configASSERT( pxCallback );
+    configASSERT( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MESSAGE_BUFFER ) != ( uint8_t ) 0 );
+
+    xBytesAvailable = prvWaitForData( pxStreamBuffer, sbBYTES_TO_STORE_MESSAGE_LENGTH, xTicksToWait );
+    xTail = pxStreamBuffer->xTail;
+
+    /* Only the messages present on entry are drained, so a fast writer cannot
+     * keep the reader here.  xTail is written back once at the end, which
+     * leaves the messages in place for the callback and wakes the writer
+     * once. */
+    while( ( xContinue != pdFALSE ) && ( xBytesAvailable > sbBYTES_TO_STORE_MESSAGE_LENGTH ) )
+    {
+        xMessageLength = prvPeekMessageAt( pxStreamBuffer, xTail, &xSpans );
+        xContinue = pxCallback( &xSpans, xMessageLength, pvContext );
+
+        xTail = prvAdvanceIndex( pxStreamBuffer, xTail, sbBYTES_TO_STORE_MESSAGE_LENGTH + xMessageLength );
+        xBytesAvailable -= sbBYTES_TO_STORE_MESSAGE_LENGTH + xMessageLength;
+        xBytesReleased += sbBYTES_TO_STORE_MESSAGE_LENGTH + xMessageLength;
+        xMessagesDrained++;
+    }
+
+    if( xMessagesDrained > ( size_t ) 0 )
+    {
+        pxStreamBuffer->xTail = xTail;
+        traceSTREAM_BUFFER_RECEIVE( xStreamBuffer, xBytesReleased );
+        traceSTREAM_BUFFER_DRAIN( xStreamBuffer, xMessagesDrained );
+
+        /* Was a task waiting for space in the buffer? */
+        prvRECEIVE_COMPLETED( pxStreamBuffer );
+    }
+    else
+    {
+        traceSTREAM_BUFFER_RECEIVE_FAILED( xStreamBuffer );
+    }
+
+    return xMessagesDrained;
+}
+/*-----------------------------------------------------------*/
+
 static size_t prvReadMessageFromBuffer( StreamBuffer_t * pxStreamBuffer,
                                         void * pvRxData,
                                         size_t xBufferLengthBytes,
@@ -1335,6 +1593,188 @@ static size_t prvReadBytesFromBuffer( StreamBuffer_t * pxStreamBuffer,
 }
 /*-----------------------------------------------------------*/
 
+static size_t prvWaitForSpace( StreamBuffer_t * const pxStreamBuffer,
+                               size_t xRequiredSpace,
+                               TickType_t xTicksToWait )
+{
+    size_t xSpace = 0;
+    TimeOut_t xTimeOut;
+
+    if( xTicksToWait != ( TickType_t ) 0 )
+    {
+        vTaskSetTimeOutState( &xTimeOut );
+
+        do
+        {
+            /* Wait until the required number of bytes are free in the message
+             * buffer. */
+            taskENTER_CRITICAL();
+            {
+                xSpace = xStreamBufferSpacesAvailable( pxStreamBuffer );
+
+                if( xSpace < xRequiredSpace )
+                {
+                    /* Clear notification state as going to wait for space. */
+                    ( void ) xTaskNotifyStateClear( NULL );
+
+                    /* Should only be one writer. */
+                    configASSERT( pxStreamBuffer->xTaskWaitingToSend == NULL );
+                    pxStreamBuffer->xTaskWaitingToSend = xTaskGetCurrentTaskHandle();
+                }
+                else
+                {
+                    taskEXIT_CRITICAL();
+                    break;
+                }
+            }
+            taskEXIT_CRITICAL();
+
+            traceBLOCKING_ON_STREAM_BUFFER_SEND( pxStreamBuffer );
+            ( void ) xTaskNotifyWait( ( uint32_t ) 0, ( uint32_t ) 0, NULL, xTicksToWait );
+            pxStreamBuffer->xTaskWaitingToSend = NULL;
+        } while( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE );
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    if( xSpace == ( size_t ) 0 )
+    {
+        xSpace = xStreamBufferSpacesAvailable( pxStreamBuffer );
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    return xSpace;
+}
+/*-----------------------------------------------------------*/
+
+static size_t prvWaitForData( StreamBuffer_t * const pxStreamBuffer,
+                              size_t xBytesToStoreMessageLength,
+                              TickType_t xTicksToWait )
+{
+    size_t xBytesAvailable;
+
+    if( xTicksToWait != ( TickType_t ) 0 )
+    {
+        /* Checking if there is data and clearing the notification state must be
+         * performed atomically. */
+        taskENTER_CRITICAL();
+        {
+            xBytesAvailable = prvBytesInBuffer( pxStreamBuffer );
+
+            /* If this function was invoked by a message buffer read then
+             * xBytesToStoreMessageLength holds the number of bytes used to hold
+             * the length of the next discrete message.  If this function was
+             * invoked by a stream buffer read then xBytesToStoreMessageLength will
+             * be 0. */
+            if( xBytesAvailable <= xBytesToStoreMessageLength )
+            {
+                /* Clear notification state as going to wait for data. */
+                ( void ) xTaskNotifyStateClear( NULL );
+
+                /* Should only be one reader. */
+                configASSERT( pxStreamBuffer->xTaskWaitingToReceive == NULL );
+                pxStreamBuffer->xTaskWaitingToReceive = xTaskGetCurrentTaskHandle();
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        taskEXIT_CRITICAL();
+
+        if( xBytesAvailable <= xBytesToStoreMessageLength )
+        {
+            /* Wait for data to be available. */
+            traceBLOCKING_ON_STREAM_BUFFER_RECEIVE( pxStreamBuffer );
+            ( void ) xTaskNotifyWait( ( uint32_t ) 0, ( uint32_t ) 0, NULL, xTicksToWait );
+            pxStreamBuffer->xTaskWaitingToReceive = NULL;
+
+            /* Recheck the data available after blocking. */
+            xBytesAvailable = prvBytesInBuffer( pxStreamBuffer );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+    else
+    {
+        xBytesAvailable = prvBytesInBuffer( pxStreamBuffer );
+    }
+
+    return xBytesAvailable;
+}
+/*-----------------------------------------------------------*/
+
+static void prvGetSpans( const StreamBuffer_t * const pxStreamBuffer,
+                         size_t xStart,
+                         size_t xCount,
+                         StreamBufferSpans_t * const pxSpans )
+{
+    size_t xFirstLength;
+
+    /* The first span runs from xStart towards the end of the storage area,
+     * anything that does not fit wraps around to the start. */
+    xFirstLength = configMIN( xCount, pxStreamBuffer->xLength - xStart );
+
+    pxSpans->pucSpan[ 0 ] = &( pxStreamBuffer->pucBuffer[ xStart ] );
+    pxSpans->xSpanLength[ 0 ] = xFirstLength;
+
+    if( xCount > xFirstLength )
+    {
+        pxSpans->pucSpan[ 1 ] = pxStreamBuffer->pucBuffer;
+        pxSpans->xSpanLength[ 1 ] = xCount - xFirstLength;
+    }
+    else
+    {
+        pxSpans->pucSpan[ 1 ] = NULL;
+        pxSpans->xSpanLength[ 1 ] = 0;
+    }
+}
+/*-----------------------------------------------------------*/
+
+static size_t prvAdvanceIndex( const StreamBuffer_t * const pxStreamBuffer,
+                               size_t xIndex,
+                               size_t xCount )
+{
+    xIndex += xCount;
+
+    if( xIndex >= pxStreamBuffer->xLength )
+    {
+        xIndex -= pxStreamBuffer->xLength;
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    return xIndex;
+}
+/*-----------------------------------------------------------*/
+
+static size_t prvPeekMessageAt( const StreamBuffer_t * const pxStreamBuffer,
+                                size_t xTail,
+                                StreamBufferSpans_t * const pxSpans )
+{
+    configMESSAGE_BUFFER_LENGTH_TYPE xTempMessageLength;
+    size_t xMessageLength;
+
+    /* prvReadBytesFromBuffer() does not modify the stream buffer, it only
+     * returns the index following the length. */
+    xTail = prvReadBytesFromBuffer( ( StreamBuffer_t * ) pxStreamBuffer, ( uint8_t * ) &xTempMessageLength, sbBYTES_TO_STORE_MESSAGE_LENGTH, xTail ); /*lint !e9005 The buffer is only read. */
+    xMessageLength = ( size_t ) xTempMessageLength;
+
+    prvGetSpans( pxStreamBuffer, xTail, xMessageLength, pxSpans );
+
+    return xMessageLength;
+}
+/*-----------------------------------------------------------*/
+
 static size_t prvBytesInBuffer( const StreamBuffer_t * const pxStreamBuffer )
 {
 /* Returns the distance between xTail and xHead. */
@@ -1356,6 +1796,26 @@ static size_t prvBytesInBuffer( const StreamBuffer_t * const pxStreamBuffer )
 }
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_OBJECT_REGISTRY == 1 )
+
+    static void prvUpdateHighWater( StreamBuffer_t * const pxStreamBuffer )
+    {
+        const size_t xBytes = prvBytesInBuffer( pxStreamBuffer );
+
+        /* Only the writer raises the mark, so it needs no critical section. */
+        if( xBytes > pxStreamBuffer->xHighWaterBytes )
+        {
+            pxStreamBuffer->xHighWaterBytes = xBytes;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+
+#endif /* configUSE_OBJECT_REGISTRY */
+/*-----------------------------------------------------------*/
+
 static void prvInitialiseNewStreamBuffer( StreamBuffer_t * const pxStreamBuffer,
                                           uint8_t * const pucBuffer,
                                           size_t xBufferSizeBytes,
@@ -1425,3 +1885,38 @@ static void prvInitialiseNewStreamBuffer( StreamBuffer_t * const pxStreamBuffer,
 
 #endif /* configUSE_TRACE_FACILITY */
 /*-----------------------------------------------------------*/
+
+#if ( configUSE_OBJECT_REGISTRY == 1 )
+
+    void vStreamBufferGetObjectInfo( StreamBufferHandle_t xStreamBuffer,
+                                     ObjectInfo_t * pxInfo )
+    {
+        const StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+        size_t xBytes, xHighWater;
+
+        configASSERT( pxStreamBuffer );
+
+        xBytes = prvBytesInBuffer( pxStreamBuffer );
+        xHighWater = configMAX( pxStreamBuffer->xHighWaterBytes, xBytes );
+
+        pxInfo->ulStorage = ( uint32_t ) ( portPOINTER_SIZE_TYPE ) pxStreamBuffer->pucBuffer;
+        /* One byte of the storage area is never used, see
+         * xStreamBufferGenericCreate(). */
+        pxInfo->usCapacity = ( uint16_t ) configMIN( pxStreamBuffer->xLength - ( size_t ) 1, 0xFFFFU );
+        pxInfo->usLevel = ( uint16_t ) configMIN( xBytes, 0xFFFFU );
+        pxInfo->usHighWater = ( uint16_t ) configMIN( xHighWater, 0xFFFFU );
+        pxInfo->ucWaitingToSend = ( uint8_t ) ( ( pxStreamBuffer->xTaskWaitingToSend != NULL ) ? 1U : 0U );
+        pxInfo->ucWaitingToReceive = ( uint8_t ) ( ( pxStreamBuffer->xTaskWaitingToReceive != NULL ) ? 1U : 0U );
+
+        if( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MESSAGE_BUFFER ) != ( uint8_t ) 0 )
+        {
+            pxInfo->ucType = registryTYPE_MESSAGE_BUFFER;
+        }
+        else
+        {
+            pxInfo->ucType = registryTYPE_STREAM_BUFFER;
+        }
+    }
+
+#endif /* configUSE_OBJECT_REGISTRY */
+/*-----------------------------------------------------------*/
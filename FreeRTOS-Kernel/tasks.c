@@ -40,6 +40,7 @@
 #include "task.h"
 #include "timers.h"
 #include "stack_macros.h"
+#include "object_registry.h"
 
 /* Lint e9021, e961 and e750 are suppressed as a MISRA exception justified
  * because the MPU ports require MPU_WRAPPERS_INCLUDED_FROM_API_FILE to be defined
@@ -115,6 +116,53 @@
     #define configIDLE_TASK_NAME    "IDLE"
 #endif
 
+#if ( configUSE_EDF_SCHEDULING == 1 )
+
+/* pdTRUE if tick xA comes strictly before tick xB.  Valid while the two are
+ * less than half the tick range apart, so deadlines can wrap. */
+    #define taskDEADLINE_IS_BEFORE( xA, xB )    ( ( ( TickType_t ) ( ( TickType_t ) ( ( xB ) - ( xA ) ) - ( TickType_t ) 1 ) ) < ( ( TickType_t ) portMAX_DELAY >> 1 ) )
+
+/* The tasks at configEDF_PRIORITY are selected by deadline, all the others
+ * in turn. */
+    #define taskSELECT_TASK_WITHIN_PRIORITY( uxTopPriority )                                     \
+    {                                                                                            \
+        if( ( uxTopPriority ) == ( UBaseType_t ) configEDF_PRIORITY )                            \
+        {                                                                                        \
+            pxCurrentTCB = prvSelectEarliestDeadlineTask();                                      \
+        }                                                                                        \
+        else                                                                                     \
+        {                                                                                        \
+            listGET_OWNER_OF_NEXT_ENTRY( pxCurrentTCB, &( pxReadyTasksLists[ uxTopPriority ] ) ); \
+        }                                                                                        \
+    }
+
+/* pdTRUE if pxTCB, just made ready, should preempt the running task: it has
+ * a higher priority, or both are in the EDF class and pxTCB has the earlier
+ * deadline. */
+    #define taskPREEMPTS_RUNNING_TASK( pxTCB )                                                      \
+    ( ( ( pxTCB )->uxPriority > pxCurrentTCB->uxPriority ) ||                                       \
+      ( ( ( pxTCB )->uxPriority == ( UBaseType_t ) configEDF_PRIORITY ) &&                          \
+        ( pxCurrentTCB->uxPriority == ( UBaseType_t ) configEDF_PRIORITY ) &&                       \
+        ( pxCurrentTCB->xPeriod != ( TickType_t ) 0 ) &&                                            \
+        ( ( ( pxTCB )->xPeriod == ( TickType_t ) 0 ) ||                                             \
+          ( taskDEADLINE_IS_BEFORE( ( pxTCB )->xAbsoluteDeadline, pxCurrentTCB->xAbsoluteDeadline ) != pdFALSE ) ) ) )
+
+/* The EDF class is not time sliced, its tasks run until a task with an
+ * earlier deadline is released. */
+    #define taskIS_TIME_SLICED( uxPriority )    ( ( uxPriority ) != ( UBaseType_t ) configEDF_PRIORITY )
+
+#else /* configUSE_EDF_SCHEDULING */
+
+    #define taskSELECT_TASK_WITHIN_PRIORITY( uxTopPriority )    listGET_OWNER_OF_NEXT_ENTRY( pxCurrentTCB, &( pxReadyTasksLists[ uxTopPriority ] ) )
+
+    #define taskPREEMPTS_RUNNING_TASK( pxTCB )                  ( ( pxTCB )->uxPriority > pxCurrentTCB->uxPriority )
+
+    #define taskIS_TIME_SLICED( uxPriority )                    pdTRUE
+
+#endif /* configUSE_EDF_SCHEDULING */
+
+/*-----------------------------------------------------------*/
+
 #if ( configUSE_PORT_OPTIMISED_TASK_SELECTION == 0 )
 
 /* If configUSE_PORT_OPTIMISED_TASK_SELECTION is 0 then task selection is
@@ -145,9 +193,9 @@
         }                                                                     \
                                                                               \
         /* listGET_OWNER_OF_NEXT_ENTRY indexes through the list, so the tasks of \
-         * the  same priority get an equal share of the processor time. */                    \
-        listGET_OWNER_OF_NEXT_ENTRY( pxCurrentTCB, &( pxReadyTasksLists[ uxTopPriority ] ) ); \
-        uxTopReadyPriority = uxTopPriority;                                                   \
+         * the  same priority get an equal share of the processor time. */ \
+        taskSELECT_TASK_WITHIN_PRIORITY( uxTopPriority );                  \
+        uxTopReadyPriority = uxTopPriority;                                \
     } /* taskSELECT_HIGHEST_PRIORITY_TASK */
 
 /*-----------------------------------------------------------*/
@@ -176,7 +224,7 @@
         /* Find the highest priority list that contains ready tasks. */                         \
         portGET_HIGHEST_PRIORITY( uxTopPriority, uxTopReadyPriority );                          \
         configASSERT( listCURRENT_LIST_LENGTH( &( pxReadyTasksLists[ uxTopPriority ] ) ) > 0 ); \
-        listGET_OWNER_OF_NEXT_ENTRY( pxCurrentTCB, &( pxReadyTasksLists[ uxTopPriority ] ) );   \
+        taskSELECT_TASK_WITHIN_PRIORITY( uxTopPriority );                                       \
     } /* taskSELECT_HIGHEST_PRIORITY_TASK() */
 
 /*-----------------------------------------------------------*/
@@ -282,6 +330,10 @@ typedef struct tskTaskControlBlock       /* The old naming convention is used to
     #if ( configUSE_MUTEXES == 1 )
         UBaseType_t uxBasePriority; /*< The priority last assigned to the task - used by the priority inheritance mechanism. */
         UBaseType_t uxMutexesHeld;
+
+        #if ( configMUTEX_INHERITANCE_CHAIN_DEPTH > 1 )
+            void * pvBlockedOnMutex; /*< The mutex the task is blocked on, used to pass inherited priorities along chains of mutexes. */
+        #endif
     #endif
 
     #if ( configUSE_APPLICATION_TASK_TAG == 1 )
@@ -294,6 +346,7 @@ typedef struct tskTaskControlBlock       /* The old naming convention is used to
 
     #if ( configGENERATE_RUN_TIME_STATS == 1 )
         configRUN_TIME_COUNTER_TYPE ulRunTimeCounter; /*< Stores the amount of time the task has spent in the Running state. */
+        uint32_t ulContextSwitchCount;                /*< Stores the number of times the task has been switched in. */
     #endif
 
     #if ( ( configUSE_NEWLIB_REENTRANT == 1 ) || ( configUSE_C_RUNTIME_TLS_SUPPORT == 1 ) )
@@ -318,6 +371,16 @@ typedef struct tskTaskControlBlock       /* The old naming convention is used to
     #if ( configUSE_POSIX_ERRNO == 1 )
         int iTaskErrno;
     #endif
+
+    #if ( configUSE_EDF_SCHEDULING == 1 )
+        TickType_t xPeriod;           /*< 0 if the task is not periodic, see vTaskSetPeriod(). */
+        TickType_t xRelativeDeadline; /*< Deadline of each job relative to its release. */
+        TickType_t xReleaseTime;      /*< Release time of the current job. */
+        TickType_t xAbsoluteDeadline; /*< Deadline of the current job, the EDF class is scheduled by it. */
+        TickType_t xMaxLateness;      /*< Longest time a job completed after its deadline. */
+        uint32_t ulJobsCompleted;
+        uint32_t ulDeadlineMisses;
+    #endif
 } tskTCB;
 
 /* The old tskTCB name is maintained above then typedefed to the new TCB_t name
@@ -495,6 +558,29 @@ static void prvAddCurrentTaskToDelayedList( TickType_t xTicksToWait,
 
 #endif
 
+/*
+ * Returns the task to run from the ready list of configEDF_PRIORITY: a task
+ * that is not periodic if there is one, otherwise the task whose current job
+ * has the earliest deadline.
+ */
+#if ( configUSE_EDF_SCHEDULING == 1 )
+
+    static TCB_t * prvSelectEarliestDeadlineTask( void ) PRIVILEGED_FUNCTION;
+
+#endif
+
+/*
+ * Returns whichever of pxFoundTCB and the tasks referenced from pxList has the
+ * lowest task number above uxPreviousTaskNumber, or NULL if none has.
+ */
+#if ( INCLUDE_xTaskScanStack == 1 )
+
+    static TCB_t * prvSearchForNextTaskWithinSingleList( List_t * pxList,
+                                                         UBaseType_t uxPreviousTaskNumber,
+                                                         TCB_t * pxFoundTCB ) PRIVILEGED_FUNCTION;
+
+#endif
+
 /*
  * Return the amount of time, in ticks, that will pass before the kernel will
  * next move a task from the Blocked state to the Running state.
@@ -1025,6 +1111,12 @@ static void prvInitialiseNewTask( TaskFunction_t pxTaskCode,
 
 static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB )
 {
+    #if ( configUSE_OBJECT_REGISTRY == 1 )
+    {
+        vObjectRegistryAdd( pxNewTCB, registryTYPE_TASK );
+    }
+    #endif
+
     /* Ensure interrupts don't access the task lists while the lists are being
      * updated. */
     taskENTER_CRITICAL();
@@ -1091,7 +1183,7 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB )
     {
         /* If the created task is of a higher priority than the current task
          * then it should run now. */
-        if( pxCurrentTCB->uxPriority < pxNewTCB->uxPriority )
+        if( taskPREEMPTS_RUNNING_TASK( pxNewTCB ) )
         {
             taskYIELD_IF_USING_PREEMPTION();
         }
@@ -1119,6 +1211,12 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB )
              * being deleted. */
             pxTCB = prvGetTCBFromHandle( xTaskToDelete );
 
+            #if ( configUSE_OBJECT_REGISTRY == 1 )
+            {
+                vObjectRegistryRemove( pxTCB );
+            }
+            #endif
+
             /* Remove task from the ready/delayed list. */
             if( uxListRemove( &( pxTCB->xStateListItem ) ) == ( UBaseType_t ) 0 )
             {
@@ -1341,6 +1439,145 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB )
 #endif /* INCLUDE_vTaskDelay */
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_EDF_SCHEDULING == 1 )
+
+    void vTaskSetPeriod( TaskHandle_t xTask,
+                         TickType_t xPeriod,
+                         TickType_t xRelativeDeadline )
+    {
+        TCB_t * pxTCB;
+
+        if( xRelativeDeadline == ( TickType_t ) 0 )
+        {
+            xRelativeDeadline = xPeriod;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        configASSERT( xRelativeDeadline <= xPeriod );
+        configASSERT( xPeriod < ( portMAX_DELAY >> 1 ) );
+
+        taskENTER_CRITICAL();
+        {
+            pxTCB = prvGetTCBFromHandle( xTask );
+
+            /* The first job is released now. */
+            pxTCB->xPeriod = xPeriod;
+            pxTCB->xRelativeDeadline = xRelativeDeadline;
+            pxTCB->xReleaseTime = xTickCount;
+            pxTCB->xAbsoluteDeadline = xTickCount + xRelativeDeadline;
+            pxTCB->xMaxLateness = 0;
+            pxTCB->ulJobsCompleted = 0;
+            pxTCB->ulDeadlineMisses = 0;
+        }
+        taskEXIT_CRITICAL();
+
+        /* The deadline order of the EDF class may have changed. */
+        if( xSchedulerRunning != pdFALSE )
+        {
+            taskYIELD_IF_USING_PREEMPTION();
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    void vTaskWaitForNextPeriod( void )
+    {
+        TickType_t xLateness;
+        BaseType_t xAlreadyYielded;
+
+        configASSERT( pxCurrentTCB->xPeriod != ( TickType_t ) 0 );
+        configASSERT( uxSchedulerSuspended == 0 );
+
+        vTaskSuspendAll();
+        {
+            /* Minor optimisation.  The tick count cannot change in this
+             * block. */
+            const TickType_t xConstTickCount = xTickCount;
+
+            /* The current job is complete. */
+            pxCurrentTCB->ulJobsCompleted++;
+
+            if( taskDEADLINE_IS_BEFORE( pxCurrentTCB->xAbsoluteDeadline, xConstTickCount ) != pdFALSE )
+            {
+                xLateness = xConstTickCount - pxCurrentTCB->xAbsoluteDeadline;
+                pxCurrentTCB->ulDeadlineMisses++;
+
+                if( xLateness > pxCurrentTCB->xMaxLateness )
+                {
+                    pxCurrentTCB->xMaxLateness = xLateness;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            /* Release times follow the period even after an overrun, so a
+             * late task catches up rather than drifting. */
+            pxCurrentTCB->xReleaseTime += pxCurrentTCB->xPeriod;
+            pxCurrentTCB->xAbsoluteDeadline = pxCurrentTCB->xReleaseTime + pxCurrentTCB->xRelativeDeadline;
+
+            if( taskDEADLINE_IS_BEFORE( xConstTickCount, pxCurrentTCB->xReleaseTime ) != pdFALSE )
+            {
+                traceTASK_DELAY_UNTIL( pxCurrentTCB->xReleaseTime );
+
+                prvAddCurrentTaskToDelayedList( pxCurrentTCB->xReleaseTime - xConstTickCount, pdFALSE );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        xAlreadyYielded = xTaskResumeAll();
+
+        /* Force a reschedule if xTaskResumeAll has not already done so.  The
+         * task either blocked or, if the next job is already released, has a
+         * later deadline than before. */
+        if( xAlreadyYielded == pdFALSE )
+        {
+            portYIELD_WITHIN_API();
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    void vTaskGetPeriodStats( TaskHandle_t xTask,
+                              TaskPeriodStats_t * pxPeriodStats )
+    {
+        TCB_t * pxTCB;
+
+        configASSERT( pxPeriodStats );
+
+        taskENTER_CRITICAL();
+        {
+            pxTCB = prvGetTCBFromHandle( xTask );
+
+            pxPeriodStats->xPeriod = pxTCB->xPeriod;
+            pxPeriodStats->xRelativeDeadline = pxTCB->xRelativeDeadline;
+            pxPeriodStats->xAbsoluteDeadline = pxTCB->xAbsoluteDeadline;
+            pxPeriodStats->xMaxLateness = pxTCB->xMaxLateness;
+            pxPeriodStats->ulJobsCompleted = pxTCB->ulJobsCompleted;
+            pxPeriodStats->ulDeadlineMisses = pxTCB->ulDeadlineMisses;
+        }
+        taskEXIT_CRITICAL();
+    }
+
+#endif /* configUSE_EDF_SCHEDULING */
+/*-----------------------------------------------------------*/
+
 #if ( ( INCLUDE_eTaskGetState == 1 ) || ( configUSE_TRACE_FACILITY == 1 ) || ( INCLUDE_xTaskAbortDelay == 1 ) )
 
     eTaskState eTaskGetState( TaskHandle_t xTask )
@@ -2105,6 +2342,15 @@ void vTaskSuspendAll( void )
     /* Enforces ordering for ports and optimised compilers that may otherwise place
      * the above increment elsewhere. */
     portMEMORY_BARRIER();
+
+    if( uxSchedulerSuspended == ( UBaseType_t ) 1U )
+    {
+        portSCHEDULER_SUSPENDED_HOOK();
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
 }
 /*----------------------------------------------------------*/
 
@@ -2191,6 +2437,8 @@ BaseType_t xTaskResumeAll( void )
 
         if( uxSchedulerSuspended == ( UBaseType_t ) pdFALSE )
         {
+            portSCHEDULER_RESUMED_HOOK();
+
             if( uxCurrentNumberOfTasks > ( UBaseType_t ) 0U )
             {
                 /* Move any readied tasks from the pending list into the
@@ -2691,7 +2939,7 @@ BaseType_t xTaskCatchUpTicks( TickType_t xTicksToCatchUp )
                     /* Preemption is on, but a context switch should only be
                      * performed if the unblocked task has a priority that is
                      * higher than the currently executing task. */
-                    if( pxTCB->uxPriority > pxCurrentTCB->uxPriority )
+                    if( taskPREEMPTS_RUNNING_TASK( pxTCB ) )
                     {
                         /* Pend the yield to be performed when the scheduler
                          * is unsuspended. */
@@ -2819,7 +3067,7 @@ BaseType_t xTaskIncrementTick( void )
                          * processing time (which happens when both
                          * preemption and time slicing are on) is
                          * handled below.*/
-                        if( pxTCB->uxPriority > pxCurrentTCB->uxPriority )
+                        if( taskPREEMPTS_RUNNING_TASK( pxTCB ) )
                         {
                             xSwitchRequired = pdTRUE;
                         }
@@ -2838,7 +3086,8 @@ BaseType_t xTaskIncrementTick( void )
          * writer has not explicitly turned time slicing off. */
         #if ( ( configUSE_PREEMPTION == 1 ) && ( configUSE_TIME_SLICING == 1 ) )
         {
-            if( listCURRENT_LIST_LENGTH( &( pxReadyTasksLists[ pxCurrentTCB->uxPriority ] ) ) > ( UBaseType_t ) 1 )
+            if( ( listCURRENT_LIST_LENGTH( &( pxReadyTasksLists[ pxCurrentTCB->uxPriority ] ) ) > ( UBaseType_t ) 1 ) &&
+                ( taskIS_TIME_SLICED( pxCurrentTCB->uxPriority ) != pdFALSE ) )
             {
                 xSwitchRequired = pdTRUE;
             }
@@ -3006,8 +3255,52 @@ BaseType_t xTaskIncrementTick( void )
 #endif /* configUSE_APPLICATION_TASK_TAG */
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_EDF_SCHEDULING == 1 )
+
+    static TCB_t * prvSelectEarliestDeadlineTask( void )
+    {
+        List_t * const pxList = &( pxReadyTasksLists[ configEDF_PRIORITY ] );
+        const ListItem_t * const pxEndMarker = listGET_END_MARKER( pxList );
+        const ListItem_t * pxItem;
+        TCB_t * pxTCB;
+        TCB_t * pxEarliestTCB = NULL;
+
+        for( pxItem = listGET_HEAD_ENTRY( pxList ); pxItem != pxEndMarker; pxItem = listGET_NEXT( pxItem ) )
+        {
+            pxTCB = listGET_LIST_ITEM_OWNER( pxItem ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+
+            /* A task without a period, such as a lower priority task that
+             * inherited this priority, goes first. */
+            if( pxTCB->xPeriod == ( TickType_t ) 0 )
+            {
+                pxEarliestTCB = pxTCB;
+                break;
+            }
+            else if( ( pxEarliestTCB == NULL ) ||
+                     ( taskDEADLINE_IS_BEFORE( pxTCB->xAbsoluteDeadline, pxEarliestTCB->xAbsoluteDeadline ) != pdFALSE ) )
+            {
+                pxEarliestTCB = pxTCB;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+
+        configASSERT( pxEarliestTCB );
+
+        return pxEarliestTCB;
+    }
+
+#endif /* configUSE_EDF_SCHEDULING */
+/*-----------------------------------------------------------*/
+
 void vTaskSwitchContext( void )
 {
+    #if ( configGENERATE_RUN_TIME_STATS == 1 )
+        TCB_t * pxPreviousTCB;
+    #endif
+
     if( uxSchedulerSuspended != ( UBaseType_t ) pdFALSE )
     {
         /* The scheduler is currently suspended - do not allow a context
@@ -3044,6 +3337,7 @@ void vTaskSwitchContext( void )
             }
 
             ulTaskSwitchedInTime = ulTotalRunTime;
+            pxPreviousTCB = pxCurrentTCB;
         }
         #endif /* configGENERATE_RUN_TIME_STATS */
 
@@ -3062,6 +3356,20 @@ void vTaskSwitchContext( void )
         taskSELECT_HIGHEST_PRIORITY_TASK(); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
         traceTASK_SWITCHED_IN();
 
+        #if ( configGENERATE_RUN_TIME_STATS == 1 )
+        {
+            /* Only count a switch if a different task was selected. */
+            if( pxCurrentTCB != pxPreviousTCB )
+            {
+                pxCurrentTCB->ulContextSwitchCount++;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        #endif /* configGENERATE_RUN_TIME_STATS */
+
         /* After the new task is switched in, update the global errno. */
         #if ( configUSE_POSIX_ERRNO == 1 )
         {
@@ -3214,7 +3522,7 @@ BaseType_t xTaskRemoveFromEventList( const List_t * const pxEventList )
         listINSERT_END( &( xPendingReadyList ), &( pxUnblockedTCB->xEventListItem ) );
     }
 
-    if( pxUnblockedTCB->uxPriority > pxCurrentTCB->uxPriority )
+    if( taskPREEMPTS_RUNNING_TASK( pxUnblockedTCB ) )
     {
         /* Return true if the task removed from the event list has a higher
          * priority than the calling task.  This allows the calling task to know if
@@ -3272,7 +3580,7 @@ void vTaskRemoveFromUnorderedEventList( ListItem_t * pxEventListItem,
     listREMOVE_ITEM( &( pxUnblockedTCB->xStateListItem ) );
     prvAddTaskToReadyList( pxUnblockedTCB );
 
-    if( pxUnblockedTCB->uxPriority > pxCurrentTCB->uxPriority )
+    if( taskPREEMPTS_RUNNING_TASK( pxUnblockedTCB ) )
     {
         /* The unblocked task has a priority above that of the calling task, so
          * a context switch is required.  This function is called with the
@@ -3749,10 +4057,12 @@ static void prvCheckTasksWaitingTermination( void )
         #if ( configGENERATE_RUN_TIME_STATS == 1 )
         {
             pxTaskStatus->ulRunTimeCounter = pxTCB->ulRunTimeCounter;
+            pxTaskStatus->ulContextSwitchCount = pxTCB->ulContextSwitchCount;
         }
         #else
         {
             pxTaskStatus->ulRunTimeCounter = ( configRUN_TIME_COUNTER_TYPE ) 0;
+            pxTaskStatus->ulContextSwitchCount = 0;
         }
         #endif
 
@@ -3941,6 +4251,128 @@ static void prvCheckTasksWaitingTermination( void )
 #endif /* INCLUDE_uxTaskGetStackHighWaterMark */
 /*-----------------------------------------------------------*/
 
+#if ( INCLUDE_xTaskScanStack == 1 )
+
+    static TCB_t * prvSearchForNextTaskWithinSingleList( List_t * pxList,
+                                                         UBaseType_t uxPreviousTaskNumber,
+                                                         TCB_t * pxFoundTCB )
+    {
+        configLIST_VOLATILE TCB_t * pxNextTCB;
+        configLIST_VOLATILE TCB_t * pxFirstTCB;
+
+        if( listCURRENT_LIST_LENGTH( pxList ) > ( UBaseType_t ) 0 )
+        {
+            listGET_OWNER_OF_NEXT_ENTRY( pxFirstTCB, pxList ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+
+            do
+            {
+                listGET_OWNER_OF_NEXT_ENTRY( pxNextTCB, pxList ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+
+                if( ( pxNextTCB->uxTCBNumber > uxPreviousTaskNumber ) &&
+                    ( ( pxFoundTCB == NULL ) || ( pxNextTCB->uxTCBNumber < pxFoundTCB->uxTCBNumber ) ) )
+                {
+                    pxFoundTCB = ( TCB_t * ) pxNextTCB;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            } while( pxNextTCB != pxFirstTCB );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return pxFoundTCB;
+    }
+/*-----------------------------------------------------------*/
+
+    BaseType_t xTaskScanStack( UBaseType_t uxPreviousTaskNumber,
+                               TaskStackUsage_t * pxStackUsage )
+    {
+        /* A word holding tskSTACK_FILL_BYTE in each of its bytes. */
+        const StackType_t xFillWord = ( StackType_t ) ( ( ( StackType_t ) ~( StackType_t ) 0 / ( StackType_t ) 0xffU ) * ( StackType_t ) tskSTACK_FILL_BYTE );
+        TCB_t * pxTCB = NULL;
+        const StackType_t * pxStackWord;
+        configSTACK_DEPTH_TYPE uxFreeWords = 0;
+        UBaseType_t uxQueue = configMAX_PRIORITIES;
+        BaseType_t xReturn = pdFALSE;
+
+        configASSERT( pxStackUsage );
+
+        vTaskSuspendAll();
+        {
+            /* Tasks waiting termination are not searched, their stacks are
+             * about to be freed. */
+            do
+            {
+                uxQueue--;
+                pxTCB = prvSearchForNextTaskWithinSingleList( &( pxReadyTasksLists[ uxQueue ] ), uxPreviousTaskNumber, pxTCB );
+            } while( uxQueue > ( UBaseType_t ) tskIDLE_PRIORITY ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
+
+            pxTCB = prvSearchForNextTaskWithinSingleList( ( List_t * ) pxDelayedTaskList, uxPreviousTaskNumber, pxTCB );
+            pxTCB = prvSearchForNextTaskWithinSingleList( ( List_t * ) pxOverflowDelayedTaskList, uxPreviousTaskNumber, pxTCB );
+
+            #if ( INCLUDE_vTaskSuspend == 1 )
+            {
+                pxTCB = prvSearchForNextTaskWithinSingleList( &xSuspendedTaskList, uxPreviousTaskNumber, pxTCB );
+            }
+            #endif
+
+            if( pxTCB != NULL )
+            {
+                /* Count the painted words from the end the stack grows
+                 * towards, a word rather than a byte at a time. */
+                #if ( portSTACK_GROWTH < 0 )
+                {
+                    pxStackWord = pxTCB->pxStack;
+
+                    while( ( pxStackWord <= pxTCB->pxEndOfStack ) && ( *pxStackWord == xFillWord ) )
+                    {
+                        pxStackWord++;
+                        uxFreeWords++;
+                    }
+
+                    pxStackUsage->uxStackInUse = ( configSTACK_DEPTH_TYPE ) ( pxTCB->pxEndOfStack - pxTCB->pxTopOfStack );
+                }
+                #else /* if ( portSTACK_GROWTH < 0 ) */
+                {
+                    pxStackWord = pxTCB->pxEndOfStack;
+
+                    while( ( pxStackWord >= pxTCB->pxStack ) && ( *pxStackWord == xFillWord ) )
+                    {
+                        pxStackWord--;
+                        uxFreeWords++;
+                    }
+
+                    pxStackUsage->uxStackInUse = ( configSTACK_DEPTH_TYPE ) ( pxTCB->pxTopOfStack - pxTCB->pxStack );
+                }
+                #endif /* if ( portSTACK_GROWTH < 0 ) */
+
+                pxStackUsage->xHandle = ( TaskHandle_t ) pxTCB;
+                /* The name is copied while the scheduler is suspended, the
+                 * task can be deleted as soon as it resumes. */
+                ( void ) memcpy( pxStackUsage->pcTaskName, pxTCB->pcTaskName, sizeof( pxStackUsage->pcTaskName ) );
+                pxStackUsage->xTaskNumber = pxTCB->uxTCBNumber;
+                pxStackUsage->uxStackDepth = ( configSTACK_DEPTH_TYPE ) ( ( pxTCB->pxEndOfStack - pxTCB->pxStack ) + 1 );
+                pxStackUsage->uxStackHighWaterMark = uxFreeWords;
+
+                xReturn = pdTRUE;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        ( void ) xTaskResumeAll();
+
+        return xReturn;
+    }
+
+#endif /* INCLUDE_xTaskScanStack */
+/*-----------------------------------------------------------*/
+
 #if ( INCLUDE_vTaskDelete == 1 )
 
     static void prvDeleteTCB( TCB_t * pxTCB )
@@ -4686,6 +5118,47 @@ TickType_t uxTaskResetEventItemValue( void )
 #endif /* configUSE_MUTEXES */
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_MUTEXES == 1 )
+
+    void vTaskIncrementMutexHeldCountOf( TaskHandle_t xMutexHolder )
+    {
+        TCB_t * const pxTCB = xMutexHolder;
+
+        /* Used by locks that do not count themselves in uxMutexesHeld when they
+         * are taken, but must be counted once their holder has inherited a
+         * priority so that xTaskPriorityDisinherit() and
+         * vTaskPriorityDisinheritAfterTimeout() see every lock the holder has. */
+        configASSERT( pxTCB );
+        ( pxTCB->uxMutexesHeld )++;
+    }
+
+#endif /* configUSE_MUTEXES */
+/*-----------------------------------------------------------*/
+
+#if ( configMUTEX_INHERITANCE_CHAIN_DEPTH > 1 )
+
+    void vTaskSetBlockedOnMutex( void * pvMutex )
+    {
+        pxCurrentTCB->pvBlockedOnMutex = pvMutex;
+    }
+
+#endif /* configMUTEX_INHERITANCE_CHAIN_DEPTH */
+/*-----------------------------------------------------------*/
+
+#if ( configMUTEX_INHERITANCE_CHAIN_DEPTH > 1 )
+
+    void * pvTaskGetBlockedOnMutex( TaskHandle_t xTask )
+    {
+        TCB_t const * const pxTCB = xTask;
+
+        configASSERT( pxTCB );
+
+        return pxTCB->pvBlockedOnMutex;
+    }
+
+#endif /* configMUTEX_INHERITANCE_CHAIN_DEPTH */
+/*-----------------------------------------------------------*/
+
 #if ( configUSE_TASK_NOTIFICATIONS == 1 )
 
     uint32_t ulTaskGenericNotifyTake( UBaseType_t uxIndexToWait,
@@ -4943,7 +5416,7 @@ TickType_t uxTaskResetEventItemValue( void )
                 }
                 #endif
 
-                if( pxTCB->uxPriority > pxCurrentTCB->uxPriority )
+                if( taskPREEMPTS_RUNNING_TASK( pxTCB ) )
                 {
                     /* The notified task has a priority above the currently
                      * executing task so a yield is required. */
@@ -5078,7 +5551,7 @@ TickType_t uxTaskResetEventItemValue( void )
                     listINSERT_END( &( xPendingReadyList ), &( pxTCB->xEventListItem ) );
                 }
 
-                if( pxTCB->uxPriority > pxCurrentTCB->uxPriority )
+                if( taskPREEMPTS_RUNNING_TASK( pxTCB ) )
                 {
                     /* The notified task has a priority above the currently
                      * executing task so a yield is required. */
@@ -5169,7 +5642,7 @@ TickType_t uxTaskResetEventItemValue( void )
                     listINSERT_END( &( xPendingReadyList ), &( pxTCB->xEventListItem ) );
                 }
 
-                if( pxTCB->uxPriority > pxCurrentTCB->uxPriority )
+                if( taskPREEMPTS_RUNNING_TASK( pxTCB ) )
                 {
                     /* The notified task has a priority above the currently
                      * executing task so a yield is required. */
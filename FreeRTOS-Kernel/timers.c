@@ -28,6 +28,7 @@
 
 /* Standard includes. */
 #include <stdlib.h>
+#include <string.h>
 
 /* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
  * all the API functions to use the MPU wrappers.  That should only be done when
@@ -38,6 +39,7 @@
 #include "task.h"
 #include "queue.h"
 #include "timers.h"
+#include "object_registry.h"
 
 #if ( INCLUDE_xTimerPendFunctionCall == 1 ) && ( configUSE_TIMERS == 0 )
     #error configUSE_TIMERS must be set to 1 to make the xTimerPendFunctionCall() function available.
@@ -60,6 +62,10 @@
     #define tmrNO_DELAY                    ( ( TickType_t ) 0U )
     #define tmrMAX_TIME_BEFORE_OVERFLOW    ( ( TickType_t ) -1 )
 
+/* Marks a command within a batch that was made redundant by a later command
+ * for the same timer, and so must not be processed. */
+    #define tmrCOMMAND_COALESCED           ( ( BaseType_t ) -128 )
+
 /* The name assigned to the timer service task.  This can be overridden by
  * defining trmTIMER_SERVICE_TASK_NAME in FreeRTOSConfig.h. */
     #ifndef configTIMER_SERVICE_TASK_NAME
@@ -71,6 +77,32 @@
     #define tmrSTATUS_IS_STATICALLY_ALLOCATED    ( ( uint8_t ) 0x02 )
     #define tmrSTATUS_IS_AUTORELOAD              ( ( uint8_t ) 0x04 )
 
+    #if ( configUSE_TIMER_PAIRING_HEAP == 1 )
+
+/* When configUSE_TIMER_PAIRING_HEAP is 1 the active timers are held in a
+ * pairing heap rather than in a sorted list.  Inserting into the heap is O(1)
+ * and removing a timer is O(log n) amortised, so starting, resetting or
+ * changing the period of a timer no longer costs a walk of every active timer
+ * inside the (high priority) timer service task.  The expiry time is still
+ * held in the xTimerListItem of the owning timer so xTimerGetExpiryTime() and
+ * kernel aware debuggers continue to find it in the usual place. */
+        typedef struct tmrTimerHeapNode
+        {
+            struct tmrTimerHeapNode * pxChild;   /*<< Leftmost child of this node. */
+            struct tmrTimerHeapNode * pxSibling; /*<< Next sibling to the right. */
+            struct tmrTimerHeapNode * pxPrev;    /*<< The parent if this is the leftmost child, otherwise the sibling to the left. */
+            struct tmrTimerHeap * pxHeap;        /*<< The heap the node is referenced from, or NULL if the timer is not in a heap. */
+            UBaseType_t uxInsertOrder;           /*<< Orders timers with equal expiry times by insertion, as vListInsert() does. */
+        } TimerHeapNode_t;
+
+        typedef struct tmrTimerHeap
+        {
+            TimerHeapNode_t * pxRoot;    /*<< The node with the nearest expiry time. */
+            UBaseType_t uxNumberOfItems; /*<< The number of timers referenced from the heap. */
+        } TimerHeap_t;
+
+    #endif /* configUSE_TIMER_PAIRING_HEAP */
+
 /* The definition of the timers themselves. */
     typedef struct tmrTimerControl                  /* The old naming convention is used to prevent breaking kernel aware debuggers. */
     {
@@ -82,6 +114,9 @@
         #if ( configUSE_TRACE_FACILITY == 1 )
             UBaseType_t uxTimerNumber;              /*<< An ID assigned by trace tools such as FreeRTOS+Trace */
         #endif
+        #if ( configUSE_TIMER_PAIRING_HEAP == 1 )
+            TimerHeapNode_t xTimerHeapNode;         /*<< Links the timer into the heap of active timers. */
+        #endif
         uint8_t ucStatus;                           /*<< Holds bits to say if the timer was statically allocated or not, and if it is active or not. */
     } xTIMER;
 
@@ -89,6 +124,32 @@
  * name below to enable the use of older kernel aware debuggers. */
     typedef xTIMER Timer_t;
 
+/* Access to the structures that hold the active timers goes through the
+ * following macros so the timer service task is written once for both the
+ * list and the pairing heap implementations. */
+    #if ( configUSE_TIMER_PAIRING_HEAP == 1 )
+        typedef TimerHeap_t ActiveTimerList_t;
+
+        #define tmrGET_TIMER_FROM_HEAP_NODE( pxNode )       ( ( Timer_t * ) ( ( ( uint8_t * ) ( pxNode ) ) - offsetof( Timer_t, xTimerHeapNode ) ) )
+        #define tmrACTIVE_LIST_INITIALISE( pxList )         prvHeapInitialise( pxList )
+        #define tmrACTIVE_LIST_IS_EMPTY( pxList )           ( ( ( pxList )->pxRoot == NULL ) ? pdTRUE : pdFALSE )
+        #define tmrACTIVE_LIST_GET_HEAD_TIMER( pxList )     tmrGET_TIMER_FROM_HEAP_NODE( ( pxList )->pxRoot )
+        #define tmrACTIVE_LIST_INSERT( pxList, pxTimer )    prvHeapInsert( ( pxList ), ( pxTimer ) )
+        #define tmrACTIVE_LIST_REMOVE( pxTimer )            prvHeapRemove( pxTimer )
+        #define tmrIS_IN_ACTIVE_LIST( pxTimer )             ( ( ( pxTimer )->xTimerHeapNode.pxHeap != NULL ) ? pdTRUE : pdFALSE )
+    #else
+        typedef List_t ActiveTimerList_t;
+
+        #define tmrACTIVE_LIST_INITIALISE( pxList )         vListInitialise( pxList )
+        #define tmrACTIVE_LIST_IS_EMPTY( pxList )           listLIST_IS_EMPTY( pxList )
+        #define tmrACTIVE_LIST_GET_HEAD_TIMER( pxList )     ( ( Timer_t * ) listGET_OWNER_OF_HEAD_ENTRY( pxList ) )
+        #define tmrACTIVE_LIST_INSERT( pxList, pxTimer )    vListInsert( ( pxList ), &( ( pxTimer )->xTimerListItem ) )
+        #define tmrACTIVE_LIST_REMOVE( pxTimer )            ( void ) uxListRemove( &( ( pxTimer )->xTimerListItem ) )
+        #define tmrIS_IN_ACTIVE_LIST( pxTimer )             ( ( listIS_CONTAINED_WITHIN( NULL, &( ( pxTimer )->xTimerListItem ) ) == pdFALSE ) ? pdTRUE : pdFALSE ) /*lint !e961. The cast is only redundant when NULL is passed into the macro. */
+    #endif /* configUSE_TIMER_PAIRING_HEAP */
+
+    #define tmrACTIVE_LIST_GET_HEAD_EXPIRY_TIME( pxList )    listGET_LIST_ITEM_VALUE( &( tmrACTIVE_LIST_GET_HEAD_TIMER( pxList )->xTimerListItem ) )
+
 /* The definition of messages that can be sent and received on the timer queue.
  * Two types of message can be queued - messages that manipulate a software timer,
  * and messages that request the execution of a non-timer related callback.  The
@@ -134,15 +195,19 @@
  * xActiveTimerList1 and xActiveTimerList2 could be at function scope but that
  * breaks some kernel aware debuggers, and debuggers that reply on removing the
  * static qualifier. */
-    PRIVILEGED_DATA static List_t xActiveTimerList1;
-    PRIVILEGED_DATA static List_t xActiveTimerList2;
-    PRIVILEGED_DATA static List_t * pxCurrentTimerList;
-    PRIVILEGED_DATA static List_t * pxOverflowTimerList;
+    PRIVILEGED_DATA static ActiveTimerList_t xActiveTimerList1;
+    PRIVILEGED_DATA static ActiveTimerList_t xActiveTimerList2;
+    PRIVILEGED_DATA static ActiveTimerList_t * pxCurrentTimerList;
+    PRIVILEGED_DATA static ActiveTimerList_t * pxOverflowTimerList;
 
 /* A queue that is used to send commands to the timer service task. */
     PRIVILEGED_DATA static QueueHandle_t xTimerQueue = NULL;
     PRIVILEGED_DATA static TaskHandle_t xTimerTaskHandle = NULL;
 
+    #if ( configUSE_TIMER_COMMAND_STATS == 1 )
+        PRIVILEGED_DATA static TimerCommandStats_t xTimerCommandStats = { 0 };
+    #endif
+
 /*lint -restore */
 
 /*-----------------------------------------------------------*/
@@ -166,6 +231,32 @@
  */
     static void prvProcessReceivedCommands( void ) PRIVILEGED_FUNCTION;
 
+/*
+ * Process a single command received on the timer queue.
+ */
+    static void prvProcessCommand( const DaemonTaskMessage_t * const pxMessage ) PRIVILEGED_FUNCTION;
+
+    #if ( configTIMER_COMMAND_BATCH_SIZE > 1 )
+
+/*
+ * Mark the commands within a batch that have no lasting effect because a
+ * later command in the same batch acts on the same timer.
+ */
+        static void prvCoalesceCommands( DaemonTaskMessage_t * const pxBatch,
+                                         const UBaseType_t uxCommands ) PRIVILEGED_FUNCTION;
+
+    #endif /* configTIMER_COMMAND_BATCH_SIZE */
+
+    #if ( configUSE_TIMER_COMMAND_STATS == 1 )
+
+/*
+ * Count a command that could not be posted because the timer queue was full.
+ * Can be called from a task or an interrupt.
+ */
+        static void prvRecordSendFailure( void ) PRIVILEGED_FUNCTION;
+
+    #endif /* configUSE_TIMER_COMMAND_STATS */
+
 /*
  * Insert the timer into either xActiveTimerList1, or xActiveTimerList2,
  * depending on if the expire time causes a timer counter overflow.
@@ -228,6 +319,22 @@
                                        void * const pvTimerID,
                                        TimerCallbackFunction_t pxCallbackFunction,
                                        Timer_t * pxNewTimer ) PRIVILEGED_FUNCTION;
+
+    #if ( configUSE_TIMER_PAIRING_HEAP == 1 )
+
+/*
+ * Pairing heap primitives used in place of the list functions when
+ * configUSE_TIMER_PAIRING_HEAP is 1.
+ */
+        static void prvHeapInitialise( TimerHeap_t * const pxHeap ) PRIVILEGED_FUNCTION;
+        static void prvHeapInsert( TimerHeap_t * const pxHeap,
+                                   Timer_t * const pxTimer ) PRIVILEGED_FUNCTION;
+        static void prvHeapRemove( Timer_t * const pxTimer ) PRIVILEGED_FUNCTION;
+        static TimerHeapNode_t * prvHeapMeld( TimerHeapNode_t * pxFirst,
+                                              TimerHeapNode_t * pxSecond ) PRIVILEGED_FUNCTION;
+        static TimerHeapNode_t * prvHeapMergePairs( TimerHeapNode_t * pxFirstSibling ) PRIVILEGED_FUNCTION;
+
+    #endif /* configUSE_TIMER_PAIRING_HEAP */
 /*-----------------------------------------------------------*/
 
     BaseType_t xTimerCreateTimerTask( void )
@@ -374,11 +481,23 @@
         pxNewTimer->pxCallbackFunction = pxCallbackFunction;
         vListInitialiseItem( &( pxNewTimer->xTimerListItem ) );
 
+        #if ( configUSE_TIMER_PAIRING_HEAP == 1 )
+        {
+            pxNewTimer->xTimerHeapNode.pxHeap = NULL;
+        }
+        #endif
+
         if( xAutoReload != pdFALSE )
         {
             pxNewTimer->ucStatus |= tmrSTATUS_IS_AUTORELOAD;
         }
 
+        #if ( configUSE_OBJECT_REGISTRY == 1 )
+        {
+            vObjectRegistryAdd( pxNewTimer, registryTYPE_TIMER );
+        }
+        #endif
+
         traceTIMER_CREATE( pxNewTimer );
     }
 /*-----------------------------------------------------------*/
@@ -419,6 +538,15 @@
                 xReturn = xQueueSendToBackFromISR( xTimerQueue, &xMessage, pxHigherPriorityTaskWoken );
             }
 
+            #if ( configUSE_TIMER_COMMAND_STATS == 1 )
+            {
+                if( xReturn != pdPASS )
+                {
+                    prvRecordSendFailure();
+                }
+            }
+            #endif
+
             traceTIMER_COMMAND_SEND( xTimer, xCommandID, xOptionalValue, xReturn );
         }
         else
@@ -541,12 +669,12 @@
     static void prvProcessExpiredTimer( const TickType_t xNextExpireTime,
                                         const TickType_t xTimeNow )
     {
-        Timer_t * const pxTimer = ( Timer_t * ) listGET_OWNER_OF_HEAD_ENTRY( pxCurrentTimerList ); /*lint !e9087 !e9079 void * is used as this macro is used with tasks and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+        Timer_t * const pxTimer = tmrACTIVE_LIST_GET_HEAD_TIMER( pxCurrentTimerList ); /*lint !e9087 !e9079 void * is used as this macro is used with tasks and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
 
         /* Remove the timer from the list of active timers.  A check has already
          * been performed to ensure the list is not empty. */
 
-        ( void ) uxListRemove( &( pxTimer->xTimerListItem ) );
+        tmrACTIVE_LIST_REMOVE( pxTimer );
 
         /* If the timer is an auto-reload timer then calculate the next
          * expiry time and re-insert the timer in the list of active timers. */
@@ -636,7 +764,7 @@
                     {
                         /* The current timer list is empty - is the overflow list
                          * also empty? */
-                        xListWasEmpty = listLIST_IS_EMPTY( pxOverflowTimerList );
+                        xListWasEmpty = tmrACTIVE_LIST_IS_EMPTY( pxOverflowTimerList );
                     }
 
                     vQueueWaitForMessageRestricted( xTimerQueue, ( xNextExpireTime - xTimeNow ), xListWasEmpty );
@@ -674,11 +802,11 @@
          * this task to unblock when the tick count overflows, at which point the
          * timer lists will be switched and the next expiry time can be
          * re-assessed.  */
-        *pxListWasEmpty = listLIST_IS_EMPTY( pxCurrentTimerList );
+        *pxListWasEmpty = tmrACTIVE_LIST_IS_EMPTY( pxCurrentTimerList );
 
         if( *pxListWasEmpty == pdFALSE )
         {
-            xNextExpireTime = listGET_ITEM_VALUE_OF_HEAD_ENTRY( pxCurrentTimerList );
+            xNextExpireTime = tmrACTIVE_LIST_GET_HEAD_EXPIRY_TIME( pxCurrentTimerList );
         }
         else
         {
@@ -735,7 +863,7 @@
             }
             else
             {
-                vListInsert( pxOverflowTimerList, &( pxTimer->xTimerListItem ) );
+                tmrACTIVE_LIST_INSERT( pxOverflowTimerList, pxTimer );
             }
         }
         else
@@ -749,7 +877,7 @@
             }
             else
             {
-                vListInsert( pxCurrentTimerList, &( pxTimer->xTimerListItem ) );
+                tmrACTIVE_LIST_INSERT( pxCurrentTimerList, pxTimer );
             }
         }
 
@@ -757,166 +885,388 @@
     }
 /*-----------------------------------------------------------*/
 
-    static void prvProcessReceivedCommands( void )
+    static void prvProcessCommand( const DaemonTaskMessage_t * const pxMessage )
     {
-        DaemonTaskMessage_t xMessage;
         Timer_t * pxTimer;
         BaseType_t xTimerListsWereSwitched;
         TickType_t xTimeNow;
 
-        while( xQueueReceive( xTimerQueue, &xMessage, tmrNO_DELAY ) != pdFAIL ) /*lint !e603 xMessage does not have to be initialised as it is passed out, not in, and it is not used unless xQueueReceive() returns pdTRUE. */
+        #if ( INCLUDE_xTimerPendFunctionCall == 1 )
         {
-            #if ( INCLUDE_xTimerPendFunctionCall == 1 )
+            /* Negative commands are pended function calls rather than timer
+             * commands. */
+            if( pxMessage->xMessageID < ( BaseType_t ) 0 )
             {
-                /* Negative commands are pended function calls rather than timer
-                 * commands. */
-                if( xMessage.xMessageID < ( BaseType_t ) 0 )
-                {
-                    const CallbackParameters_t * const pxCallback = &( xMessage.u.xCallbackParameters );
+                const CallbackParameters_t * const pxCallback = &( pxMessage->u.xCallbackParameters );
 
-                    /* The timer uses the xCallbackParameters member to request a
-                     * callback be executed.  Check the callback is not NULL. */
-                    configASSERT( pxCallback );
+                /* The timer uses the xCallbackParameters member to request a
+                 * callback be executed.  Check the callback is not NULL. */
+                configASSERT( pxCallback );
 
-                    /* Call the function. */
-                    pxCallback->pxCallbackFunction( pxCallback->pvParameter1, pxCallback->ulParameter2 );
-                }
-                else
-                {
-                    mtCOVERAGE_TEST_MARKER();
-                }
+                /* Call the function. */
+                pxCallback->pxCallbackFunction( pxCallback->pvParameter1, pxCallback->ulParameter2 );
             }
-            #endif /* INCLUDE_xTimerPendFunctionCall */
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        #endif /* INCLUDE_xTimerPendFunctionCall */
+
+        /* Commands that are positive are timer commands rather than pended
+         * function calls. */
+        if( pxMessage->xMessageID >= ( BaseType_t ) 0 )
+        {
+            /* The messages uses the xTimerParameters member to work on a
+             * software timer. */
+            pxTimer = pxMessage->u.xTimerParameters.pxTimer;
+
+            if( tmrIS_IN_ACTIVE_LIST( pxTimer ) != pdFALSE )
+            {
+                /* The timer is in a list, remove it. */
+                tmrACTIVE_LIST_REMOVE( pxTimer );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            traceTIMER_COMMAND_RECEIVED( pxTimer, pxMessage->xMessageID, pxMessage->u.xTimerParameters.xMessageValue );
 
-            /* Commands that are positive are timer commands rather than pended
-             * function calls. */
-            if( xMessage.xMessageID >= ( BaseType_t ) 0 )
+            /* In this case the xTimerListsWereSwitched parameter is not used, but
+             *  it must be present in the function call.  prvSampleTimeNow() must be
+             *  called after the message is received from xTimerQueue so there is no
+             *  possibility of a higher priority task adding a message to the message
+             *  queue with a time that is ahead of the timer daemon task (because it
+             *  pre-empted the timer daemon task after the xTimeNow value was set). */
+            xTimeNow = prvSampleTimeNow( &xTimerListsWereSwitched );
+
+            switch( pxMessage->xMessageID )
             {
-                /* The messages uses the xTimerParameters member to work on a
-                 * software timer. */
-                pxTimer = xMessage.u.xTimerParameters.pxTimer;
+                case tmrCOMMAND_START:
+                case tmrCOMMAND_START_FROM_ISR:
+                case tmrCOMMAND_RESET:
+                case tmrCOMMAND_RESET_FROM_ISR:
+                    /* Start or restart a timer. */
+                    pxTimer->ucStatus |= tmrSTATUS_IS_ACTIVE;
+
+                    if( prvInsertTimerInActiveList( pxTimer, pxMessage->u.xTimerParameters.xMessageValue + pxTimer->xTimerPeriodInTicks, xTimeNow, pxMessage->u.xTimerParameters.xMessageValue ) != pdFALSE )
+                    {
+                        /* The timer expired before it was added to the active
+                         * timer list.  Process it now. */
+                        if( ( pxTimer->ucStatus & tmrSTATUS_IS_AUTORELOAD ) != 0 )
+                        {
+                            prvReloadTimer( pxTimer, pxMessage->u.xTimerParameters.xMessageValue + pxTimer->xTimerPeriodInTicks, xTimeNow );
+                        }
+                        else
+                        {
+                            pxTimer->ucStatus &= ( ( uint8_t ) ~tmrSTATUS_IS_ACTIVE );
+                        }
 
-                if( listIS_CONTAINED_WITHIN( NULL, &( pxTimer->xTimerListItem ) ) == pdFALSE ) /*lint !e961. The cast is only redundant when NULL is passed into the macro. */
-                {
-                    /* The timer is in a list, remove it. */
-                    ( void ) uxListRemove( &( pxTimer->xTimerListItem ) );
-                }
-                else
+                        /* Call the timer callback. */
+                        traceTIMER_EXPIRED( pxTimer );
+                        pxTimer->pxCallbackFunction( ( TimerHandle_t ) pxTimer );
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+
+                    break;
+
+                case tmrCOMMAND_STOP:
+                case tmrCOMMAND_STOP_FROM_ISR:
+                    /* The timer has already been removed from the active list. */
+                    pxTimer->ucStatus &= ( ( uint8_t ) ~tmrSTATUS_IS_ACTIVE );
+                    break;
+
+                case tmrCOMMAND_CHANGE_PERIOD:
+                case tmrCOMMAND_CHANGE_PERIOD_FROM_ISR:
+                    pxTimer->ucStatus |= tmrSTATUS_IS_ACTIVE;
+                    pxTimer->xTimerPeriodInTicks = pxMessage->u.xTimerParameters.xMessageValue;
+                    configASSERT( ( pxTimer->xTimerPeriodInTicks > 0 ) );
+
+                    /* The new period does not really have a reference, and can
+                     * be longer or shorter than the old one.  The command time is
+                     * therefore set to the current time, and as the period cannot
+                     * be zero the next expiry time can only be in the future,
+                     * meaning (unlike for the xTimerStart() case above) there is
+                     * no fail case that needs to be handled here. */
+                    ( void ) prvInsertTimerInActiveList( pxTimer, ( xTimeNow + pxTimer->xTimerPeriodInTicks ), xTimeNow, xTimeNow );
+                    break;
+
+                case tmrCOMMAND_DELETE:
+                    #if ( configUSE_OBJECT_REGISTRY == 1 )
+                    {
+                        vObjectRegistryRemove( pxTimer );
+                    }
+                    #endif
+
+                    #if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+                    {
+                        /* The timer has already been removed from the active list,
+                         * just free up the memory if the memory was dynamically
+                         * allocated. */
+                        if( ( pxTimer->ucStatus & tmrSTATUS_IS_STATICALLY_ALLOCATED ) == ( uint8_t ) 0 )
+                        {
+                            vPortFree( pxTimer );
+                        }
+                        else
+                        {
+                            pxTimer->ucStatus &= ( ( uint8_t ) ~tmrSTATUS_IS_ACTIVE );
+                        }
+                    }
+                    #else /* if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) */
+                    {
+                        /* If dynamic allocation is not enabled, the memory
+                         * could not have been dynamically allocated. So there is
+                         * no need to free the memory - just mark the timer as
+                         * "not active". */
+                        pxTimer->ucStatus &= ( ( uint8_t ) ~tmrSTATUS_IS_ACTIVE );
+                    }
+                    #endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+                    break;
+
+                default:
+                    /* Don't expect to get here. */
+                    break;
+            }
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    #if ( configTIMER_COMMAND_BATCH_SIZE > 1 )
+
+        static void prvCoalesceCommands( DaemonTaskMessage_t * const pxBatch,
+                                         const UBaseType_t uxCommands )
+        {
+            UBaseType_t uxCommand, uxLater, uxEarlier;
+            BaseType_t xSuperseded, xPeriodChangedEarlier;
+            const Timer_t * pxTimer;
+            TickType_t xTimeNow;
+
+            /* All the commands in the batch were issued at or before this time. */
+            xTimeNow = xTaskGetTickCount();
+
+            for( uxCommand = ( UBaseType_t ) 0U; uxCommand < uxCommands; uxCommand++ )
+            {
+                if( pxBatch[ uxCommand ].xMessageID < ( BaseType_t ) 0 )
                 {
-                    mtCOVERAGE_TEST_MARKER();
+                    /* Pended function calls are always processed. */
+                    continue;
                 }
 
-                traceTIMER_COMMAND_RECEIVED( pxTimer, xMessage.xMessageID, xMessage.u.xTimerParameters.xMessageValue );
-
-                /* In this case the xTimerListsWereSwitched parameter is not used, but
-                 *  it must be present in the function call.  prvSampleTimeNow() must be
-                 *  called after the message is received from xTimerQueue so there is no
-                 *  possibility of a higher priority task adding a message to the message
-                 *  queue with a time that is ahead of the timer daemon task (because it
-                 *  pre-empted the timer daemon task after the xTimeNow value was set). */
-                xTimeNow = prvSampleTimeNow( &xTimerListsWereSwitched );
+                pxTimer = pxBatch[ uxCommand ].u.xTimerParameters.pxTimer;
+                xSuperseded = pdFALSE;
 
-                switch( xMessage.xMessageID )
+                /* Look for a later command on the same timer.  Pended function
+                 * calls may inspect timers, so do not look past one. */
+                for( uxLater = uxCommand + ( UBaseType_t ) 1U; ( uxLater < uxCommands ) && ( xSuperseded == pdFALSE ); uxLater++ )
                 {
-                    case tmrCOMMAND_START:
-                    case tmrCOMMAND_START_FROM_ISR:
-                    case tmrCOMMAND_RESET:
-                    case tmrCOMMAND_RESET_FROM_ISR:
-                        /* Start or restart a timer. */
-                        pxTimer->ucStatus |= tmrSTATUS_IS_ACTIVE;
-
-                        if( prvInsertTimerInActiveList( pxTimer, xMessage.u.xTimerParameters.xMessageValue + pxTimer->xTimerPeriodInTicks, xTimeNow, xMessage.u.xTimerParameters.xMessageValue ) != pdFALSE )
+                    if( pxBatch[ uxLater ].xMessageID < ( BaseType_t ) 0 )
+                    {
+                        if( pxBatch[ uxLater ].xMessageID != tmrCOMMAND_COALESCED )
                         {
-                            /* The timer expired before it was added to the active
-                             * timer list.  Process it now. */
-                            if( ( pxTimer->ucStatus & tmrSTATUS_IS_AUTORELOAD ) != 0 )
-                            {
-                                prvReloadTimer( pxTimer, xMessage.u.xTimerParameters.xMessageValue + pxTimer->xTimerPeriodInTicks, xTimeNow );
-                            }
-                            else
-                            {
-                                pxTimer->ucStatus &= ( ( uint8_t ) ~tmrSTATUS_IS_ACTIVE );
-                            }
-
-                            /* Call the timer callback. */
-                            traceTIMER_EXPIRED( pxTimer );
-                            pxTimer->pxCallbackFunction( ( TimerHandle_t ) pxTimer );
+                            break;
                         }
                         else
                         {
-                            mtCOVERAGE_TEST_MARKER();
+                            continue;
                         }
+                    }
 
-                        break;
+                    if( ( pxBatch[ uxLater ].u.xTimerParameters.pxTimer != pxTimer ) ||
+                        ( pxBatch[ uxLater ].xMessageID == tmrCOMMAND_START_DONT_TRACE ) )
+                    {
+                        continue;
+                    }
 
-                    case tmrCOMMAND_STOP:
-                    case tmrCOMMAND_STOP_FROM_ISR:
-                        /* The timer has already been removed from the active list. */
-                        pxTimer->ucStatus &= ( ( uint8_t ) ~tmrSTATUS_IS_ACTIVE );
-                        break;
-
-                    case tmrCOMMAND_CHANGE_PERIOD:
-                    case tmrCOMMAND_CHANGE_PERIOD_FROM_ISR:
-                        pxTimer->ucStatus |= tmrSTATUS_IS_ACTIVE;
-                        pxTimer->xTimerPeriodInTicks = xMessage.u.xTimerParameters.xMessageValue;
-                        configASSERT( ( pxTimer->xTimerPeriodInTicks > 0 ) );
-
-                        /* The new period does not really have a reference, and can
-                         * be longer or shorter than the old one.  The command time is
-                         * therefore set to the current time, and as the period cannot
-                         * be zero the next expiry time can only be in the future,
-                         * meaning (unlike for the xTimerStart() case above) there is
-                         * no fail case that needs to be handled here. */
-                        ( void ) prvInsertTimerInActiveList( pxTimer, ( xTimeNow + pxTimer->xTimerPeriodInTicks ), xTimeNow, xTimeNow );
-                        break;
-
-                    case tmrCOMMAND_DELETE:
-                        #if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
-                        {
-                            /* The timer has already been removed from the active list,
-                             * just free up the memory if the memory was dynamically
-                             * allocated. */
-                            if( ( pxTimer->ucStatus & tmrSTATUS_IS_STATICALLY_ALLOCATED ) == ( uint8_t ) 0 )
+                    switch( pxBatch[ uxCommand ].xMessageID )
+                    {
+                        case tmrCOMMAND_STOP:
+                        case tmrCOMMAND_STOP_FROM_ISR:
+
+                            /* Every command removes the timer from the active
+                             * list before acting on it, so a stop followed by
+                             * any other command has no effect. */
+                            xSuperseded = pdTRUE;
+                            break;
+
+                        case tmrCOMMAND_CHANGE_PERIOD:
+                        case tmrCOMMAND_CHANGE_PERIOD_FROM_ISR:
+
+                            /* The new period outlives a later stop, start or
+                             * reset, so only a later period change replaces it.
+                             * This is the case of an event loop time event being
+                             * re-armed several times in quick succession. */
+                            if( ( pxBatch[ uxLater ].xMessageID == tmrCOMMAND_CHANGE_PERIOD ) ||
+                                ( pxBatch[ uxLater ].xMessageID == tmrCOMMAND_CHANGE_PERIOD_FROM_ISR ) )
                             {
-                                vPortFree( pxTimer );
+                                xSuperseded = pdTRUE;
                             }
-                            else
+
+                            break;
+
+                        case tmrCOMMAND_START:
+                        case tmrCOMMAND_START_FROM_ISR:
+                        case tmrCOMMAND_RESET:
+                        case tmrCOMMAND_RESET_FROM_ISR:
+
+                            /* A start or reset that was issued so long ago that
+                             * the timer has already expired calls the callback
+                             * when it is processed, so must be kept.  The period
+                             * used for that test may be changed by an earlier
+                             * command in the same batch, in which case keep the
+                             * command too. */
+                            xPeriodChangedEarlier = pdFALSE;
+
+                            for( uxEarlier = ( UBaseType_t ) 0U; uxEarlier < uxCommand; uxEarlier++ )
                             {
-                                pxTimer->ucStatus &= ( ( uint8_t ) ~tmrSTATUS_IS_ACTIVE );
+                                if( ( pxBatch[ uxEarlier ].u.xTimerParameters.pxTimer == pxTimer ) &&
+                                    ( ( pxBatch[ uxEarlier ].xMessageID == tmrCOMMAND_CHANGE_PERIOD ) ||
+                                      ( pxBatch[ uxEarlier ].xMessageID == tmrCOMMAND_CHANGE_PERIOD_FROM_ISR ) ) )
+                                {
+                                    xPeriodChangedEarlier = pdTRUE;
+                                }
                             }
-                        }
-                        #else /* if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) */
-                        {
-                            /* If dynamic allocation is not enabled, the memory
-                             * could not have been dynamically allocated. So there is
-                             * no need to free the memory - just mark the timer as
-                             * "not active". */
-                            pxTimer->ucStatus &= ( ( uint8_t ) ~tmrSTATUS_IS_ACTIVE );
-                        }
-                        #endif /* configSUPPORT_DYNAMIC_ALLOCATION */
-                        break;
 
-                    default:
-                        /* Don't expect to get here. */
-                        break;
+                            if( ( xPeriodChangedEarlier == pdFALSE ) &&
+                                ( ( ( TickType_t ) ( xTimeNow - pxBatch[ uxCommand ].u.xTimerParameters.xMessageValue ) ) < pxTimer->xTimerPeriodInTicks ) )
+                            {
+                                xSuperseded = pdTRUE;
+                            }
+
+                            break;
+
+                        default:
+
+                            /* Deletes are always processed. */
+                            break;
+                    }
+
+                    /* Only the next command for the same timer is of interest,
+                     * any others are considered when that one is. */
+                    break;
+                }
+
+                if( xSuperseded != pdFALSE )
+                {
+                    pxBatch[ uxCommand ].xMessageID = tmrCOMMAND_COALESCED;
+
+                    #if ( configUSE_TIMER_COMMAND_STATS == 1 )
+                    {
+                        xTimerCommandStats.ulCommandsCoalesced++;
+                    }
+                    #endif
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
                 }
             }
         }
+
+    #endif /* configTIMER_COMMAND_BATCH_SIZE */
+/*-----------------------------------------------------------*/
+
+    static void prvProcessReceivedCommands( void )
+    {
+        #if ( configTIMER_COMMAND_BATCH_SIZE > 1 )
+        {
+            /* Only the timer service task accesses the batch, so it is kept off
+             * the task's stack. */
+            PRIVILEGED_DATA static DaemonTaskMessage_t xBatch[ configTIMER_COMMAND_BATCH_SIZE ]; /*lint !e956 Variable is only accessible to one task. */
+            UBaseType_t uxCommands, uxCommand;
+
+            for( ; ; )
+            {
+                #if ( configUSE_TIMER_COMMAND_STATS == 1 )
+                {
+                    const UBaseType_t uxWaiting = uxQueueMessagesWaiting( xTimerQueue );
+
+                    if( uxWaiting > xTimerCommandStats.uxQueueHighWaterMark )
+                    {
+                        xTimerCommandStats.uxQueueHighWaterMark = uxWaiting;
+                    }
+                }
+                #endif
+
+                /* Remove as many commands as will fit in the batch in one go.
+                 * As with the single command case below, prvSampleTimeNow() is
+                 * only called once the commands are out of the queue. */
+                uxCommands = uxQueueReceiveBatchRestricted( xTimerQueue, xBatch, ( UBaseType_t ) configTIMER_COMMAND_BATCH_SIZE );
+
+                if( uxCommands == ( UBaseType_t ) 0U )
+                {
+                    break;
+                }
+
+                #if ( configUSE_TIMER_COMMAND_STATS == 1 )
+                {
+                    xTimerCommandStats.ulCommandsReceived += ( uint32_t ) uxCommands;
+                    xTimerCommandStats.ulBatchesProcessed++;
+
+                    if( uxCommands > xTimerCommandStats.uxLargestBatch )
+                    {
+                        xTimerCommandStats.uxLargestBatch = uxCommands;
+                    }
+                }
+                #endif
+
+                prvCoalesceCommands( xBatch, uxCommands );
+
+                for( uxCommand = ( UBaseType_t ) 0U; uxCommand < uxCommands; uxCommand++ )
+                {
+                    if( xBatch[ uxCommand ].xMessageID != tmrCOMMAND_COALESCED )
+                    {
+                        prvProcessCommand( &( xBatch[ uxCommand ] ) );
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+            }
+        }
+        #else /* if ( configTIMER_COMMAND_BATCH_SIZE > 1 ) */
+        {
+            DaemonTaskMessage_t xMessage;
+
+            while( xQueueReceive( xTimerQueue, &xMessage, tmrNO_DELAY ) != pdFAIL ) /*lint !e603 xMessage does not have to be initialised as it is passed out, not in, and it is not used unless xQueueReceive() returns pdTRUE. */
+            {
+                #if ( configUSE_TIMER_COMMAND_STATS == 1 )
+                {
+                    xTimerCommandStats.ulCommandsReceived++;
+                    xTimerCommandStats.ulBatchesProcessed++;
+                    xTimerCommandStats.uxLargestBatch = ( UBaseType_t ) 1U;
+
+                    /* The command just removed was also waiting. */
+                    if( ( uxQueueMessagesWaiting( xTimerQueue ) + ( UBaseType_t ) 1U ) > xTimerCommandStats.uxQueueHighWaterMark )
+                    {
+                        xTimerCommandStats.uxQueueHighWaterMark = uxQueueMessagesWaiting( xTimerQueue ) + ( UBaseType_t ) 1U;
+                    }
+                }
+                #endif
+
+                prvProcessCommand( &xMessage );
+            }
+        }
+        #endif /* configTIMER_COMMAND_BATCH_SIZE */
     }
 /*-----------------------------------------------------------*/
 
     static void prvSwitchTimerLists( void )
     {
         TickType_t xNextExpireTime;
-        List_t * pxTemp;
+        ActiveTimerList_t * pxTemp;
 
         /* The tick count has overflowed.  The timer lists must be switched.
          * If there are any timers still referenced from the current timer list
          * then they must have expired and should be processed before the lists
          * are switched. */
-        while( listLIST_IS_EMPTY( pxCurrentTimerList ) == pdFALSE )
+        while( tmrACTIVE_LIST_IS_EMPTY( pxCurrentTimerList ) == pdFALSE )
         {
-            xNextExpireTime = listGET_ITEM_VALUE_OF_HEAD_ENTRY( pxCurrentTimerList );
+            xNextExpireTime = tmrACTIVE_LIST_GET_HEAD_EXPIRY_TIME( pxCurrentTimerList );
 
             /* Process the expired timer.  For auto-reload timers, be careful to
              * process only expirations that occur on the current list.  Further
@@ -939,8 +1289,8 @@
         {
             if( xTimerQueue == NULL )
             {
-                vListInitialise( &xActiveTimerList1 );
-                vListInitialise( &xActiveTimerList2 );
+                tmrACTIVE_LIST_INITIALISE( &xActiveTimerList1 );
+                tmrACTIVE_LIST_INITIALISE( &xActiveTimerList2 );
                 pxCurrentTimerList = &xActiveTimerList1;
                 pxOverflowTimerList = &xActiveTimerList2;
 
@@ -981,6 +1331,201 @@
     }
 /*-----------------------------------------------------------*/
 
+    #if ( configUSE_TIMER_PAIRING_HEAP == 1 )
+
+        static void prvHeapInitialise( TimerHeap_t * const pxHeap )
+        {
+            pxHeap->pxRoot = NULL;
+            pxHeap->uxNumberOfItems = ( UBaseType_t ) 0U;
+        }
+
+    #endif /* configUSE_TIMER_PAIRING_HEAP */
+/*-----------------------------------------------------------*/
+
+    #if ( configUSE_TIMER_PAIRING_HEAP == 1 )
+
+        static TimerHeapNode_t * prvHeapMeld( TimerHeapNode_t * pxFirst,
+                                              TimerHeapNode_t * pxSecond )
+        {
+            const TickType_t xFirstExpiry = listGET_LIST_ITEM_VALUE( &( tmrGET_TIMER_FROM_HEAP_NODE( pxFirst )->xTimerListItem ) );
+            const TickType_t xSecondExpiry = listGET_LIST_ITEM_VALUE( &( tmrGET_TIMER_FROM_HEAP_NODE( pxSecond )->xTimerListItem ) );
+            TimerHeapNode_t * pxTemp;
+
+            /* Make pxFirst the node that expires first.  Equal expiry times are
+             * ordered by insertion so timers that expire on the same tick are
+             * processed in the same order as they would be from a list. */
+            if( ( xSecondExpiry < xFirstExpiry ) ||
+                ( ( xSecondExpiry == xFirstExpiry ) && ( ( BaseType_t ) ( pxSecond->uxInsertOrder - pxFirst->uxInsertOrder ) < ( BaseType_t ) 0 ) ) )
+            {
+                pxTemp = pxFirst;
+                pxFirst = pxSecond;
+                pxSecond = pxTemp;
+            }
+
+            /* The later node becomes the leftmost child of the earlier node.  The
+             * sibling and previous links of pxFirst are left for the caller. */
+            pxSecond->pxSibling = pxFirst->pxChild;
+
+            if( pxFirst->pxChild != NULL )
+            {
+                pxFirst->pxChild->pxPrev = pxSecond;
+            }
+
+            pxSecond->pxPrev = pxFirst;
+            pxFirst->pxChild = pxSecond;
+
+            return pxFirst;
+        }
+
+    #endif /* configUSE_TIMER_PAIRING_HEAP */
+/*-----------------------------------------------------------*/
+
+    #if ( configUSE_TIMER_PAIRING_HEAP == 1 )
+
+        static TimerHeapNode_t * prvHeapMergePairs( TimerHeapNode_t * pxFirstSibling )
+        {
+            TimerHeapNode_t * pxPairs = NULL;
+            TimerHeapNode_t * pxRoot = NULL;
+            TimerHeapNode_t * pxFirst;
+            TimerHeapNode_t * pxSecond;
+            TimerHeapNode_t * pxNext;
+
+            /* First pass - meld the siblings in pairs from left to right, building
+             * a stack of the results linked through pxSibling.  This is the
+             * standard two pass pairing that gives the O(log n) amortised bound,
+             * done iteratively so the daemon stack usage does not depend on the
+             * number of active timers. */
+            while( pxFirstSibling != NULL )
+            {
+                pxFirst = pxFirstSibling;
+                pxSecond = pxFirst->pxSibling;
+
+                if( pxSecond != NULL )
+                {
+                    pxFirstSibling = pxSecond->pxSibling;
+                    pxFirst = prvHeapMeld( pxFirst, pxSecond );
+                }
+                else
+                {
+                    pxFirstSibling = NULL;
+                }
+
+                pxFirst->pxSibling = pxPairs;
+                pxPairs = pxFirst;
+            }
+
+            /* Second pass - meld the pairs from right to left into one tree. */
+            while( pxPairs != NULL )
+            {
+                pxNext = pxPairs->pxSibling;
+                pxPairs->pxSibling = NULL;
+
+                if( pxRoot == NULL )
+                {
+                    pxRoot = pxPairs;
+                }
+                else
+                {
+                    pxRoot = prvHeapMeld( pxRoot, pxPairs );
+                }
+
+                pxPairs = pxNext;
+            }
+
+            if( pxRoot != NULL )
+            {
+                pxRoot->pxPrev = NULL;
+            }
+
+            return pxRoot;
+        }
+
+    #endif /* configUSE_TIMER_PAIRING_HEAP */
+/*-----------------------------------------------------------*/
+
+    #if ( configUSE_TIMER_PAIRING_HEAP == 1 )
+
+        static void prvHeapInsert( TimerHeap_t * const pxHeap,
+                                   Timer_t * const pxTimer )
+        {
+            PRIVILEGED_DATA static UBaseType_t uxNextInsertOrder = ( UBaseType_t ) 0U; /*lint !e956 Variable is only accessible to one task. */
+            TimerHeapNode_t * const pxNode = &( pxTimer->xTimerHeapNode );
+
+            pxNode->pxChild = NULL;
+            pxNode->pxSibling = NULL;
+            pxNode->pxPrev = NULL;
+            pxNode->pxHeap = pxHeap;
+            pxNode->uxInsertOrder = uxNextInsertOrder;
+            uxNextInsertOrder++;
+
+            if( pxHeap->pxRoot == NULL )
+            {
+                pxHeap->pxRoot = pxNode;
+            }
+            else
+            {
+                pxHeap->pxRoot = prvHeapMeld( pxHeap->pxRoot, pxNode );
+                pxHeap->pxRoot->pxPrev = NULL;
+            }
+
+            ( pxHeap->uxNumberOfItems )++;
+        }
+
+    #endif /* configUSE_TIMER_PAIRING_HEAP */
+/*-----------------------------------------------------------*/
+
+    #if ( configUSE_TIMER_PAIRING_HEAP == 1 )
+
+        static void prvHeapRemove( Timer_t * const pxTimer )
+        {
+            TimerHeapNode_t * const pxNode = &( pxTimer->xTimerHeapNode );
+            TimerHeap_t * const pxHeap = pxNode->pxHeap;
+            TimerHeapNode_t * pxSubHeap;
+
+            configASSERT( pxHeap );
+
+            if( pxHeap->pxRoot == pxNode )
+            {
+                pxHeap->pxRoot = prvHeapMergePairs( pxNode->pxChild );
+            }
+            else
+            {
+                /* Unlink the node, and with it its sub-heap, from the list of
+                 * siblings it is in. */
+                if( pxNode->pxPrev->pxChild == pxNode )
+                {
+                    pxNode->pxPrev->pxChild = pxNode->pxSibling;
+                }
+                else
+                {
+                    pxNode->pxPrev->pxSibling = pxNode->pxSibling;
+                }
+
+                if( pxNode->pxSibling != NULL )
+                {
+                    pxNode->pxSibling->pxPrev = pxNode->pxPrev;
+                }
+
+                /* Put the children of the removed node back into the heap. */
+                pxSubHeap = prvHeapMergePairs( pxNode->pxChild );
+
+                if( pxSubHeap != NULL )
+                {
+                    pxHeap->pxRoot = prvHeapMeld( pxHeap->pxRoot, pxSubHeap );
+                    pxHeap->pxRoot->pxPrev = NULL;
+                }
+            }
+
+            pxNode->pxChild = NULL;
+            pxNode->pxSibling = NULL;
+            pxNode->pxPrev = NULL;
+            pxNode->pxHeap = NULL;
+            ( pxHeap->uxNumberOfItems )--;
+        }
+
+    #endif /* configUSE_TIMER_PAIRING_HEAP */
+/*-----------------------------------------------------------*/
+
     BaseType_t xTimerIsTimerActive( TimerHandle_t xTimer )
     {
         BaseType_t xReturn;
@@ -1057,6 +1602,15 @@
 
             xReturn = xQueueSendFromISR( xTimerQueue, &xMessage, pxHigherPriorityTaskWoken );
 
+            #if ( configUSE_TIMER_COMMAND_STATS == 1 )
+            {
+                if( xReturn != pdPASS )
+                {
+                    prvRecordSendFailure();
+                }
+            }
+            #endif
+
             tracePEND_FUNC_CALL_FROM_ISR( xFunctionToPend, pvParameter1, ulParameter2, xReturn );
 
             return xReturn;
@@ -1089,6 +1643,15 @@
 
             xReturn = xQueueSendToBack( xTimerQueue, &xMessage, xTicksToWait );
 
+            #if ( configUSE_TIMER_COMMAND_STATS == 1 )
+            {
+                if( xReturn != pdPASS )
+                {
+                    prvRecordSendFailure();
+                }
+            }
+            #endif
+
             tracePEND_FUNC_CALL( xFunctionToPend, pvParameter1, ulParameter2, xReturn );
 
             return xReturn;
@@ -1097,6 +1660,54 @@
     #endif /* INCLUDE_xTimerPendFunctionCall */
 /*-----------------------------------------------------------*/
 
+    #if ( configUSE_TIMER_COMMAND_STATS == 1 )
+
+        static void prvRecordSendFailure( void )
+        {
+            UBaseType_t uxSavedInterruptStatus;
+
+            /* Commands are posted from tasks and interrupts, so mask interrupts
+             * rather than entering a critical section. */
+            uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+            {
+                xTimerCommandStats.ulSendFailures++;
+            }
+            portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+        }
+
+    #endif /* configUSE_TIMER_COMMAND_STATS */
+/*-----------------------------------------------------------*/
+
+    #if ( configUSE_TIMER_COMMAND_STATS == 1 )
+
+        void vTimerGetCommandStats( TimerCommandStats_t * pxStats )
+        {
+            configASSERT( pxStats );
+
+            taskENTER_CRITICAL();
+            {
+                *pxStats = xTimerCommandStats;
+            }
+            taskEXIT_CRITICAL();
+        }
+
+    #endif /* configUSE_TIMER_COMMAND_STATS */
+/*-----------------------------------------------------------*/
+
+    #if ( configUSE_TIMER_COMMAND_STATS == 1 )
+
+        void vTimerResetCommandStats( void )
+        {
+            taskENTER_CRITICAL();
+            {
+                ( void ) memset( &xTimerCommandStats, 0x00, sizeof( xTimerCommandStats ) );
+            }
+            taskEXIT_CRITICAL();
+        }
+
+    #endif /* configUSE_TIMER_COMMAND_STATS */
+/*-----------------------------------------------------------*/
+
     #if ( configUSE_TRACE_FACILITY == 1 )
 
         UBaseType_t uxTimerGetTimerNumber( TimerHandle_t xTimer )
@@ -0,0 +1,518 @@
+/*
+ * FreeRTOS Kernel V10.5.1
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/*
+ * Work queues for deferred interrupt handling, see workqueue.h.
+ *
+ * A work queue is an intrusive singly linked FIFO of WorkItem_t, threaded
+ * through the items themselves so submitting never allocates and never finds
+ * the queue full.  Items are linked and unlinked inside critical sections,
+ * which on this port only mask interrupts up to
+ * configMAX_SYSCALL_INTERRUPT_PRIORITY, and the pending state of an item is
+ * its pvOwner pointer, tested and set in the same critical section, so two
+ * interrupts submitting the same item cannot both link it.
+ *
+ * The worker is only notified when an item is linked into an empty queue.  It
+ * keeps taking items until the queue is empty before it blocks again, so at
+ * worst it wakes once more to find an item it already ran.
+ */
+
+/* Standard includes. */
+#include <stdlib.h>
+#include <string.h>
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+ * all the API functions to use the MPU wrappers.  That should only be done when
+ * task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "workqueue.h"
+
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+#if ( configUSE_WORK_QUEUES == 1 )
+
+typedef struct WorkQueueDef_t
+{
+    WorkItem_t * pxHead;     /*< The item that runs next, NULL when the queue is empty. */
+    WorkItem_t * pxTail;     /*< The item submitted last. */
+    TaskHandle_t xWorker;    /*< The task that runs the items. */
+    WorkQueueStats_t xStats;
+
+    #if ( ( configSUPPORT_STATIC_ALLOCATION == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
+        uint8_t ucStaticallyAllocated; /*< Set to pdTRUE if the work queue is statically allocated to ensure no attempt is made to free the memory. */
+    #endif
+} WorkQueue_t;
+
+/*-----------------------------------------------------------*/
+
+/*
+ * The worker task, one per work queue.
+ */
+static portTASK_FUNCTION_PROTO( prvWorkerTask, pvParameters ) PRIVILEGED_FUNCTION;
+
+/*
+ * Links pxItem at the tail of the queue unless it is already pending.  Must be
+ * called from a critical section.  Sets *pxWakeWorker to pdTRUE if the queue
+ * was empty.
+ */
+static BaseType_t prvLinkItem( WorkQueue_t * pxQueue,
+                               WorkItem_t * pxItem,
+                               BaseType_t * pxWakeWorker ) PRIVILEGED_FUNCTION;
+
+/*
+ * Unlinks the item at the head of the queue and records its latency, or
+ * returns NULL if the queue is empty.
+ */
+static WorkItem_t * prvUnlinkHead( WorkQueue_t * pxQueue ) PRIVILEGED_FUNCTION;
+
+/*-----------------------------------------------------------*/
+
+static void prvInitialiseWorkQueue( WorkQueue_t * pxQueue ) /* PRIVILEGED_FUNCTION */
+{
+    pxQueue->pxHead = NULL;
+    pxQueue->pxTail = NULL;
+    pxQueue->xWorker = NULL;
+    ( void ) memset( &( pxQueue->xStats ), 0x00, sizeof( pxQueue->xStats ) );
+}
+/*-----------------------------------------------------------*/
+
+void vWorkItemInitialise( WorkItem_t * pxItem,
+                          WorkFunction_t pxFunction,
+                          void * pvParameter )
+{
+    configASSERT( pxItem );
+    configASSERT( pxFunction );
+
+    pxItem->pxNext = NULL;
+    pxItem->pxFunction = pxFunction;
+    pxItem->pvParameter = pvParameter;
+    pxItem->pvOwner = NULL;
+    pxItem->ulSubmitTime = 0UL;
+}
+/*-----------------------------------------------------------*/
+
+#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+
+    WorkQueueHandle_t xWorkQueueCreateStatic( const char * const pcName,
+                                              UBaseType_t uxPriority,
+                                              uint32_t ulStackDepth,
+                                              StackType_t * puxStackBuffer,
+                                              StaticTask_t * pxTaskBuffer,
+                                              StaticWorkQueue_t * pxWorkQueueBuffer )
+    {
+        WorkQueue_t * pxQueue;
+
+        configASSERT( pxWorkQueueBuffer );
+        configASSERT( puxStackBuffer );
+        configASSERT( pxTaskBuffer );
+
+        #if ( configASSERT_DEFINED == 1 )
+        {
+            /* Sanity check that the size of the structure used to declare a
+             * variable of type StaticWorkQueue_t equals the size of the real
+             * work queue structure. */
+            volatile size_t xSize = sizeof( StaticWorkQueue_t );
+            configASSERT( xSize == sizeof( WorkQueue_t ) );
+        } /*lint !e529 xSize is referenced if configASSERT() is defined. */
+        #endif /* configASSERT_DEFINED */
+
+        pxQueue = ( WorkQueue_t * ) pxWorkQueueBuffer; /*lint !e740 !e9087 WorkQueue_t and StaticWorkQueue_t are deliberately aliased for data hiding purposes and guaranteed to have the same size and alignment requirement - checked by configASSERT(). */
+
+        prvInitialiseWorkQueue( pxQueue );
+
+        #if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+        {
+            pxQueue->ucStaticallyAllocated = pdTRUE;
+        }
+        #endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+
+        pxQueue->xWorker = xTaskCreateStatic( prvWorkerTask, pcName, ulStackDepth, ( void * ) pxQueue, uxPriority, puxStackBuffer, pxTaskBuffer );
+        configASSERT( pxQueue->xWorker );
+
+        return pxQueue;
+    }
+
+#endif /* configSUPPORT_STATIC_ALLOCATION */
+/*-----------------------------------------------------------*/
+
+#if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+
+    WorkQueueHandle_t xWorkQueueCreate( const char * const pcName,
+                                        UBaseType_t uxPriority,
+                                        configSTACK_DEPTH_TYPE usStackDepth )
+    {
+        WorkQueue_t * pxQueue;
+
+        pxQueue = ( WorkQueue_t * ) pvPortMalloc( sizeof( WorkQueue_t ) );
+
+        if( pxQueue != NULL )
+        {
+            prvInitialiseWorkQueue( pxQueue );
+
+            #if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+            {
+                pxQueue->ucStaticallyAllocated = pdFALSE;
+            }
+            #endif /* configSUPPORT_STATIC_ALLOCATION */
+
+            if( xTaskCreate( prvWorkerTask, pcName, usStackDepth, ( void * ) pxQueue, uxPriority, &( pxQueue->xWorker ) ) != pdPASS )
+            {
+                vPortFree( pxQueue );
+                pxQueue = NULL;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return pxQueue;
+    }
+
+#endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvLinkItem( WorkQueue_t * pxQueue,
+                               WorkItem_t * pxItem,
+                               BaseType_t * pxWakeWorker )
+{
+    BaseType_t xReturn;
+
+    if( pxItem->pvOwner == NULL )
+    {
+        pxItem->pvOwner = pxQueue;
+        pxItem->pxNext = NULL;
+        pxItem->ulSubmitTime = configWORK_QUEUE_GET_TIME();
+
+        if( pxQueue->pxTail == NULL )
+        {
+            pxQueue->pxHead = pxItem;
+            *pxWakeWorker = pdTRUE;
+        }
+        else
+        {
+            pxQueue->pxTail->pxNext = pxItem;
+        }
+
+        pxQueue->pxTail = pxItem;
+
+        pxQueue->xStats.ulSubmitted++;
+        pxQueue->xStats.uxDepth++;
+
+        if( pxQueue->xStats.uxDepth > pxQueue->xStats.uxMaxDepth )
+        {
+            pxQueue->xStats.uxMaxDepth = pxQueue->xStats.uxDepth;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        xReturn = pdPASS;
+    }
+    else
+    {
+        /* Already pending, the work it describes will be done once. */
+        pxQueue->xStats.ulCoalesced++;
+        xReturn = pdFAIL;
+    }
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+static WorkItem_t * prvUnlinkHead( WorkQueue_t * pxQueue )
+{
+    WorkItem_t * pxItem;
+    uint32_t ulLatency;
+
+    taskENTER_CRITICAL();
+    {
+        pxItem = pxQueue->pxHead;
+
+        if( pxItem != NULL )
+        {
+            pxQueue->pxHead = pxItem->pxNext;
+
+            if( pxQueue->pxHead == NULL )
+            {
+                pxQueue->pxTail = NULL;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            /* The item may be submitted again from here on, including by its
+             * own function. */
+            pxItem->pxNext = NULL;
+            pxItem->pvOwner = NULL;
+
+            ulLatency = configWORK_QUEUE_GET_TIME() - pxItem->ulSubmitTime;
+
+            pxQueue->xStats.uxDepth--;
+            pxQueue->xStats.ulExecuted++;
+            pxQueue->xStats.ulLastLatency = ulLatency;
+            pxQueue->xStats.ullTotalLatency += ulLatency;
+
+            if( ulLatency > pxQueue->xStats.ulMaxLatency )
+            {
+                pxQueue->xStats.ulMaxLatency = ulLatency;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+    taskEXIT_CRITICAL();
+
+    return pxItem;
+}
+/*-----------------------------------------------------------*/
+
+static portTASK_FUNCTION( prvWorkerTask, pvParameters )
+{
+    WorkQueue_t * const pxQueue = ( WorkQueue_t * ) pvParameters;
+    WorkItem_t * pxItem;
+    WorkFunction_t pxFunction;
+    void * pvParameter;
+    uint32_t ulStartTime, ulRunTime;
+
+    for( ; ; )
+    {
+        ( void ) ulTaskNotifyTake( pdTRUE, portMAX_DELAY );
+
+        while( ( pxItem = prvUnlinkHead( pxQueue ) ) != NULL )
+        {
+            /* Copied first, the item belongs to the application again as soon
+             * as it has been unlinked. */
+            pxFunction = pxItem->pxFunction;
+            pvParameter = pxItem->pvParameter;
+
+            ulStartTime = configWORK_QUEUE_GET_TIME();
+            pxFunction( pvParameter );
+            ulRunTime = configWORK_QUEUE_GET_TIME() - ulStartTime;
+
+            taskENTER_CRITICAL();
+            {
+                if( ulRunTime > pxQueue->xStats.ulMaxRunTime )
+                {
+                    pxQueue->xStats.ulMaxRunTime = ulRunTime;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            taskEXIT_CRITICAL();
+        }
+    }
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xWorkQueueSubmit( WorkQueueHandle_t xWorkQueue,
+                             WorkItem_t * pxItem )
+{
+    WorkQueue_t * const pxQueue = xWorkQueue;
+    BaseType_t xReturn, xWakeWorker = pdFALSE;
+
+    configASSERT( pxQueue );
+    configASSERT( pxItem );
+    configASSERT( pxItem->pxFunction );
+
+    taskENTER_CRITICAL();
+    {
+        xReturn = prvLinkItem( pxQueue, pxItem, &xWakeWorker );
+    }
+    taskEXIT_CRITICAL();
+
+    if( xWakeWorker != pdFALSE )
+    {
+        ( void ) xTaskNotifyGive( pxQueue->xWorker );
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xWorkQueueSubmitFromISR( WorkQueueHandle_t xWorkQueue,
+                                    WorkItem_t * pxItem,
+                                    BaseType_t * pxHigherPriorityTaskWoken )
+{
+    WorkQueue_t * const pxQueue = xWorkQueue;
+    BaseType_t xReturn, xWakeWorker = pdFALSE;
+    UBaseType_t uxSavedInterruptStatus;
+
+    configASSERT( pxQueue );
+    configASSERT( pxItem );
+    configASSERT( pxItem->pxFunction );
+
+    portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
+
+    uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+    {
+        xReturn = prvLinkItem( pxQueue, pxItem, &xWakeWorker );
+    }
+    portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+
+    if( xWakeWorker != pdFALSE )
+    {
+        vTaskNotifyGiveFromISR( pxQueue->xWorker, pxHigherPriorityTaskWoken );
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xWorkQueueCancel( WorkQueueHandle_t xWorkQueue,
+                             WorkItem_t * pxItem )
+{
+    WorkQueue_t * const pxQueue = xWorkQueue;
+    WorkItem_t * pxPrevious = NULL;
+    WorkItem_t * pxIterator;
+    BaseType_t xReturn = pdFAIL;
+
+    configASSERT( pxQueue );
+    configASSERT( pxItem );
+
+    taskENTER_CRITICAL();
+    {
+        if( pxItem->pvOwner == ( void * ) pxQueue )
+        {
+            for( pxIterator = pxQueue->pxHead; pxIterator != pxItem; pxIterator = pxIterator->pxNext )
+            {
+                pxPrevious = pxIterator;
+            }
+
+            if( pxPrevious == NULL )
+            {
+                pxQueue->pxHead = pxItem->pxNext;
+            }
+            else
+            {
+                pxPrevious->pxNext = pxItem->pxNext;
+            }
+
+            if( pxQueue->pxTail == pxItem )
+            {
+                pxQueue->pxTail = pxPrevious;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            pxItem->pxNext = NULL;
+            pxItem->pvOwner = NULL;
+            pxQueue->xStats.uxDepth--;
+
+            xReturn = pdPASS;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+    taskEXIT_CRITICAL();
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xWorkItemIsPending( const WorkItem_t * pxItem )
+{
+    configASSERT( pxItem );
+
+    return ( pxItem->pvOwner != NULL ) ? pdTRUE : pdFALSE;
+}
+/*-----------------------------------------------------------*/
+
+TaskHandle_t xWorkQueueGetWorkerHandle( WorkQueueHandle_t xWorkQueue )
+{
+    configASSERT( xWorkQueue );
+
+    return xWorkQueue->xWorker;
+}
+/*-----------------------------------------------------------*/
+
+void vWorkQueueGetStats( WorkQueueHandle_t xWorkQueue,
+                         WorkQueueStats_t * pxStats )
+{
+    WorkQueue_t * const pxQueue = xWorkQueue;
+
+    configASSERT( pxQueue );
+    configASSERT( pxStats );
+
+    taskENTER_CRITICAL();
+    {
+        *pxStats = pxQueue->xStats;
+    }
+    taskEXIT_CRITICAL();
+}
+/*-----------------------------------------------------------*/
+
+void vWorkQueueResetStats( WorkQueueHandle_t xWorkQueue )
+{
+    WorkQueue_t * const pxQueue = xWorkQueue;
+    UBaseType_t uxDepth;
+
+    configASSERT( pxQueue );
+
+    taskENTER_CRITICAL();
+    {
+        uxDepth = pxQueue->xStats.uxDepth;
+        ( void ) memset( &( pxQueue->xStats ), 0x00, sizeof( pxQueue->xStats ) );
+        pxQueue->xStats.uxDepth = uxDepth;
+        pxQueue->xStats.uxMaxDepth = uxDepth;
+    }
+    taskEXIT_CRITICAL();
+}
+/*-----------------------------------------------------------*/
+
+#endif /* configUSE_WORK_QUEUES */